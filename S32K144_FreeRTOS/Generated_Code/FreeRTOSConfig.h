@@ -84,14 +84,14 @@
  *----------------------------------------------------------*/
 
 #define configUSE_PREEMPTION                     1
-#define configUSE_IDLE_HOOK                      0
+#define configUSE_IDLE_HOOK                      1
 #define configUSE_TICK_HOOK                      0
 #define configCPU_CLOCK_HZ                       ( 48000000UL )
 #define configBUS_CLOCK_HZ                       24000000
 #define configTICK_RATE_HZ                       ( ( TickType_t ) 1000 )
 #define configMAX_PRIORITIES                     ( 8 )
 #define configMINIMAL_STACK_SIZE                 ( ( unsigned short ) 200 )
-#define configTOTAL_HEAP_SIZE                    ( ( size_t ) 8192 )
+#define configTOTAL_HEAP_SIZE                    ( ( size_t ) 12288 )
 #define configMAX_TASK_NAME_LEN                  ( 12 )
 #define configUSE_TRACE_FACILITY                 0
 #define configUSE_16_BIT_TICKS                   0
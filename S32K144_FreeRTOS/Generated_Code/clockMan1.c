@@ -182,11 +182,11 @@ clock_manager_user_config_t clockMan1_InitConfig0 = {
             .locked           = false,                               /*!< LK         */
             /* SPLLCFG */
             .prediv           = 0U,                                  /*!< PREDIV     */
-            .mult             = 12U,                                 /*!< MULT       */
+            .mult             = 24U,                                 /*!< MULT       */
             .src              = 0U,                                  /*!< SOURCE     */
             /* SPLLDIV */
-            .div1             = SCG_ASYNC_CLOCK_DIV_BY_1,            /*!< SPLLDIV1   */
-            .div2             = SCG_ASYNC_CLOCK_DIV_BY_1,            /*!< SPLLDIV2   */
+            .div1             = SCG_ASYNC_CLOCK_DIV_BY_2,            /*!< SPLLDIV1   */
+            .div2             = SCG_ASYNC_CLOCK_DIV_BY_4,            /*!< SPLLDIV2   */
         },
         .clockOutConfig =
         {
@@ -198,10 +198,10 @@ clock_manager_user_config_t clockMan1_InitConfig0 = {
             .initialize       = true,                                /*!< Initialize */
             .rccrConfig =              /*!< RCCR - Run Clock Control Register          */
             {
-                .src          = SCG_SYSTEM_CLOCK_SRC_FIRC,           /*!< SCS        */
-                .divCore      = SCG_SYSTEM_CLOCK_DIV_BY_1,           /*!< DIVCORE    */
+                .src          = SCG_SYSTEM_CLOCK_SRC_SYS_PLL,        /*!< SCS        */
+                .divCore      = SCG_SYSTEM_CLOCK_DIV_BY_2,           /*!< DIVCORE    */
                 .divBus       = SCG_SYSTEM_CLOCK_DIV_BY_2,           /*!< DIVBUS     */
-                .divSlow      = SCG_SYSTEM_CLOCK_DIV_BY_2,           /*!< DIVSLOW    */
+                .divSlow      = SCG_SYSTEM_CLOCK_DIV_BY_4,           /*!< DIVSLOW    */
             },
             .vccrConfig =              /*!< VCCR - VLPR Clock Control Register         */
             {
@@ -0,0 +1,59 @@
+/*!
+ 	 \file FreeRTOS.h
+
+ 	 \brief This is the host replacement of the FreeRTOS configuration for the bootloader
+ 	 	 	 harness. The kernel calls of the bootloader are implemented by
+ 	 	 	 flash_sim_run.c over the simulated time.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef FREERTOS_H_
+#define FREERTOS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/** Defines the maximum time to wait*/
+#define portMAX_DELAY								((TickType_t)0xFFFFFFFFU)
+/** Defines the false value of the kernel*/
+#define pdFALSE										(0)
+/** Defines the true value of the kernel*/
+#define pdTRUE										(1)
+/** Defines the pass value of the kernel*/
+#define pdPASS										(pdTRUE)
+/** Defines the minimal stack of a thread*/
+#define configMINIMAL_STACK_SIZE					(200)
+/** Defines the priority of the interrupts that use the kernel*/
+#define configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY	(1)
+
+/** Ticks of the kernel*/
+typedef uint32_t TickType_t;
+/** Signed base type of the kernel*/
+typedef long BaseType_t;
+/** Unsigned base type of the kernel*/
+typedef unsigned long UBaseType_t;
+/** Handle of a thread*/
+typedef void* TaskHandle_t;
+/** Handle of a queue*/
+typedef void* QueueHandle_t;
+/** Handle of a semaphore*/
+typedef void* SemaphoreHandle_t;
+/** Handle of a timer*/
+typedef void* TimerHandle_t;
+/** Handle of an event group*/
+typedef void* EventGroupHandle_t;
+/** Bits of an event group*/
+typedef uint32_t EventBits_t;
+/** Function of a thread*/
+typedef void (*TaskFunction_t)(void*);
+
+/** Requests a context switch at the end of an interruption*/
+void portYIELD_FROM_ISR(BaseType_t woken);
+
+#endif /* FREERTOS_H_ */
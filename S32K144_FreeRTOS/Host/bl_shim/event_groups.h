@@ -0,0 +1,20 @@
+/*!
+ 	 \file event_groups.h
+
+ 	 \brief This is the host replacement of the FreeRTOS event group API (Not used by
+ 	 	 	 the bootloader).
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef EVENT_GROUPS_H_
+#define EVENT_GROUPS_H_
+
+#include "FreeRTOS.h"
+
+#endif /* EVENT_GROUPS_H_ */
@@ -0,0 +1,19 @@
+/*!
+ 	 \file projdefs.h
+
+ 	 \brief This is the host replacement of the FreeRTOS definitions.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef PROJDEFS_H_
+#define PROJDEFS_H_
+
+#include "FreeRTOS.h"
+
+#endif /* PROJDEFS_H_ */
@@ -0,0 +1,26 @@
+/*!
+ 	 \file queue.h
+
+ 	 \brief This is the host replacement of the FreeRTOS queue API.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef QUEUE_H_
+#define QUEUE_H_
+
+#include "FreeRTOS.h"
+
+/** Creates a queue*/
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size);
+/** Copies an item to the back of a queue*/
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks);
+/** Takes the item from the front of a queue*/
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticks);
+
+#endif /* QUEUE_H_ */
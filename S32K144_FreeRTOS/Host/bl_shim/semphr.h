@@ -0,0 +1,26 @@
+/*!
+ 	 \file semphr.h
+
+ 	 \brief This is the host replacement of the FreeRTOS semaphore API.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef SEMPHR_H_
+#define SEMPHR_H_
+
+#include "queue.h"
+
+/** Creates a binary semaphore*/
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+/** Takes a semaphore, waiting some ticks at most*/
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks);
+/** Gives a semaphore from an interruption*/
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore, BaseType_t* woken);
+
+#endif /* SEMPHR_H_ */
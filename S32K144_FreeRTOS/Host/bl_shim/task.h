@@ -0,0 +1,24 @@
+/*!
+ 	 \file task.h
+
+ 	 \brief This is the host replacement of the FreeRTOS thread API.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef TASK_H_
+#define TASK_H_
+
+#include "FreeRTOS.h"
+
+/** Blocks the thread for some ticks*/
+void vTaskDelay(TickType_t ticks);
+/** Returns the ticks since the scheduler started*/
+TickType_t xTaskGetTickCount(void);
+
+#endif /* TASK_H_ */
@@ -0,0 +1,20 @@
+/*!
+ 	 \file timers.h
+
+ 	 \brief This is the host replacement of the FreeRTOS timer API (Not used by the
+ 	 	 	 bootloader).
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef TIMERS_H_
+#define TIMERS_H_
+
+#include "FreeRTOS.h"
+
+#endif /* TIMERS_H_ */
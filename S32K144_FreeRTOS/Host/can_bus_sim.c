@@ -0,0 +1,158 @@
+/*!
+ 	 \file can_bus_sim.c
+
+ 	 \brief This is the source file of the simulated CAN bus. The ID function vector
+ 	 	 	 and the queue of the frames sent by the node are found in this source file.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include "can_bus_sim.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL							(0)
+/** Defines a flag as set*/
+#define FLAG_SET							(1)
+/** Defines a flag as cleared*/
+#define FLAG_CLEAR							(0)
+
+/*********************************************************************************************/
+
+/** ID function vector*/
+static ID_function_t can_bus_sim_ID_function[CAN_BUS_SIM_ID_VECTOR_SIZE];
+/** ID function vector counter*/
+static uint8_t can_bus_sim_ID_counter = INIT_VAL;
+/** Frames sent by the node*/
+static CAN_BUS_SIM_frame_t can_bus_sim_queue[CAN_BUS_SIM_QUEUE_SIZE];
+/** Position of the oldest frame in the queue*/
+static uint32_t can_bus_sim_head = INIT_VAL;
+/** Frames in the queue*/
+static uint32_t can_bus_sim_count = INIT_VAL;
+/** Frames lost because the queue was full*/
+static uint32_t can_bus_sim_overruns = INIT_VAL;
+/** First address of the RAM of the node*/
+static uint32_t can_bus_sim_ram_start = INIT_VAL;
+/** Address after the RAM of the node*/
+static uint32_t can_bus_sim_ram_end = INIT_VAL;
+
+/*********************************************************************************************/
+
+/** This function adds an ID and a callback to the ID function vector*/
+ID_func_vector_state_t rtos_add_ID_function(ID_function_t ID_func)
+{
+	/** Counter for the ID function vector*/
+	uint8_t counter = INIT_VAL;
+
+	for(counter = INIT_VAL ; counter < can_bus_sim_ID_counter ; counter ++)
+	{
+		if(ID_func.ID == can_bus_sim_ID_function[counter].ID)
+		{
+			return ID_already_exist;
+		}
+	}
+
+	if(CAN_BUS_SIM_ID_VECTOR_SIZE <= can_bus_sim_ID_counter)
+	{
+		return ID_func_vector_full;
+	}
+
+	can_bus_sim_ID_function[can_bus_sim_ID_counter ++] = ID_func;
+
+	return ID_func_vector_success;
+}
+
+/** This function queues a frame sent by the node*/
+void rtos_can_transmit(can_message_tx_config_t can_message_tx)
+{
+	/** Frame being queued*/
+	CAN_BUS_SIM_frame_t* frame;
+	/** Counter for the data*/
+	uint8_t counter = INIT_VAL;
+
+	if(CAN_BUS_SIM_QUEUE_SIZE <= can_bus_sim_count)
+	{
+		can_bus_sim_overruns ++;
+		return;
+	}
+
+	frame = &can_bus_sim_queue[(can_bus_sim_head + can_bus_sim_count) % CAN_BUS_SIM_QUEUE_SIZE];
+	frame->ID = can_message_tx.ID;
+	frame->DLC = (CAN_BUS_SIM_FRAME_SIZE < can_message_tx.DLC) ? CAN_BUS_SIM_FRAME_SIZE : can_message_tx.DLC;
+
+	for(counter = INIT_VAL ; counter < frame->DLC ; counter ++)
+	{
+		frame->data[counter] = can_message_tx.msg[counter];
+	}
+
+	can_bus_sim_count ++;
+}
+
+/** This function sends a frame of the stand-in to the node*/
+void CAN_BUS_SIM_send(uint16_t ID, const uint8_t* data, uint8_t DLC)
+{
+	/** Frame as received by the RX thread*/
+	can_message_rx_config_t rx_message = { NULL };
+	/** Counter for the data and the ID function vector*/
+	uint8_t counter = INIT_VAL;
+
+	rx_message.ID = ID;
+	rx_message.DLC = (CAN_BUS_SIM_FRAME_SIZE < DLC) ? CAN_BUS_SIM_FRAME_SIZE : DLC;
+
+	for(counter = INIT_VAL ; counter < rx_message.DLC ; counter ++)
+	{
+		rx_message.msg[counter] = data[counter];
+	}
+
+	for(counter = INIT_VAL ; counter < can_bus_sim_ID_counter ; counter ++)
+	{
+		if(ID == can_bus_sim_ID_function[counter].ID)
+		{
+			can_bus_sim_ID_function[counter].ID_func(rx_message);
+		}
+	}
+}
+
+/** This function reads the oldest frame sent by the node*/
+uint8_t CAN_BUS_SIM_receive(CAN_BUS_SIM_frame_t* frame)
+{
+	if(INIT_VAL == can_bus_sim_count)
+	{
+		return FLAG_CLEAR;
+	}
+
+	*frame = can_bus_sim_queue[can_bus_sim_head];
+	can_bus_sim_head = (can_bus_sim_head + 1U) % CAN_BUS_SIM_QUEUE_SIZE;
+	can_bus_sim_count --;
+
+	return FLAG_SET;
+}
+
+/** This function sets the RAM of the node*/
+void CAN_BUS_SIM_set_ram(const volatile void* start, uint32_t size)
+{
+	can_bus_sim_ram_start = (uint32_t)(uintptr_t)start;
+	can_bus_sim_ram_end = can_bus_sim_ram_start + size;
+}
+
+/** This function gets the first address of the RAM of the node*/
+uint32_t CAN_BUS_SIM_get_ram_start(void)
+{
+	return can_bus_sim_ram_start;
+}
+
+/** This function gets the address after the RAM of the node*/
+uint32_t CAN_BUS_SIM_get_ram_end(void)
+{
+	return can_bus_sim_ram_end;
+}
+
+/** This function gets the frames lost*/
+uint32_t CAN_BUS_SIM_get_overruns(void)
+{
+	return can_bus_sim_overruns;
+}
@@ -0,0 +1,186 @@
+/*!
+ 	 \file can_bus_sim.h
+
+ 	 \brief This is the header file of the simulated CAN bus. It replaces the RTOS
+ 	 	 	 CAN driver for the modules that only use its ID function vector and
+ 	 	 	 its transmission (e.g. the XCP slave), so they can run on a host
+ 	 	 	 against a stand-in of the other node.
+
+ 	 \note The frames sent by the node are queued until the stand-in reads them,
+ 	 	 	 and the frames of the stand-in call the ID function vector right away,
+ 	 	 	 as the RX thread does.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef CAN_BUS_SIM_H_
+#define CAN_BUS_SIM_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/** Defines the frames queued from the node to the stand-in*/
+#define CAN_BUS_SIM_QUEUE_SIZE				(64)
+/** Defines the maximum size of the ID function vector (Same as the RTOS CAN driver)*/
+#define CAN_BUS_SIM_ID_VECTOR_SIZE			(15)
+/** Defines the size of a CAN frame*/
+#define CAN_BUS_SIM_FRAME_SIZE				(8)
+
+/** There are no critical sections on the host, the stand-in and the node run in turns*/
+#define taskENTER_CRITICAL()				do { } while(0)
+/** There are no critical sections on the host, the stand-in and the node run in turns*/
+#define taskEXIT_CRITICAL()					do { } while(0)
+/** There are no threads on the host, the stand-in calls the functions of the threads*/
+#define portMAX_DELAY						(0xFFFFFFFFU)
+
+/*!
+ 	 \brief Simulated semaphore, the stand-in calls the functions of the threads itself.
+ */
+typedef void* SemaphoreHandle_t;
+
+/** The semaphores are never taken on the host*/
+#define xSemaphoreCreateBinary()			(NULL)
+/** The semaphores are never taken on the host*/
+#define xSemaphoreGive(semaphore)			((void)(semaphore))
+/** The semaphores are never taken on the host*/
+#define xSemaphoreTake(semaphore, ticks)	((void)(semaphore), (void)(ticks))
+
+/*!
+ 	 \brief Simulated CAN module, only its address is used.
+ */
+typedef struct
+{
+	uint32_t index;	/*!< Number of the module*/
+}CAN_Type;
+
+/*!
+ 	 \brief Enumerator to define the states of the ID function vector (Same as the RTOS CAN driver).
+ */
+typedef enum
+{
+	ID_func_vector_success,	/*!< ID vector configuration successful*/
+	ID_func_vector_full,	/*!< ID vector is full*/
+	ID_func_vector_empty,	/*!< ID vector is empty*/
+	ID_not_allowed,			/*!< ID not allowed to be set*/
+	ID_does_not_exist,		/*!< ID does not exists in the ID vector*/
+	ID_already_exist		/*!< ID already exists in the ID vector*/
+}ID_func_vector_state_t;
+
+/*!
+ 	 \brief Arguments to handle tx messages of CAN (Same as the CAN driver).
+ */
+typedef struct
+{
+	CAN_Type* base;	/*!< CAN from which the message will be sent from*/
+	uint16_t ID;	/*!< ID of the message to be sent*/
+	uint8_t* msg;	/*!< Message to be sent*/
+	uint8_t DLC;	/*!< DLC of the message to be sent*/
+}can_message_tx_config_t;
+
+/*!
+ 	 \brief Arguments to handle rx messages of CAN (Same as the CAN driver).
+ */
+typedef struct
+{
+	CAN_Type* base;		/*!< CAN which will receive the message*/
+	uint16_t ID;		/*!< ID received*/
+	uint8_t msg[8];		/*!< Message received*/
+	uint8_t DLC;		/*!< DLC received*/
+	uint16_t timestamp;	/*!< Value of the free running timer when the message was received*/
+}can_message_rx_config_t;
+
+/*!
+ 	 \brief Structure to define the ID vector (Same as the RTOS CAN driver).
+ */
+typedef struct
+{
+	uint16_t ID;												/*!< ID to be stored*/
+	void (*ID_func)(can_message_rx_config_t can_message_rx);	/*!< Pointer to the function to be executed*/
+}ID_function_t;
+
+/*!
+ 	 \brief Structure for a frame on the simulated bus.
+ */
+typedef struct
+{
+	uint16_t ID;							/*!< ID of the frame*/
+	uint8_t DLC;							/*!< DLC of the frame*/
+	uint8_t data[CAN_BUS_SIM_FRAME_SIZE];	/*!< Data of the frame*/
+}CAN_BUS_SIM_frame_t;
+
+/*!
+ 	 \brief This function adds an ID and a callback to the simulated ID function vector.
+
+ 	 \param[in] ID_func ID and callback function to be stored.
+
+ 	 \return ID_func_vector_success, ID_func_vector_full or ID_already_exist.
+ */
+ID_func_vector_state_t rtos_add_ID_function(ID_function_t ID_func);
+
+/*!
+ 	 \brief This function queues a frame sent by the node, for the stand-in.
+
+ 	 \param[in] can_message_tx Message structure with the data to be transmitted.
+
+ 	 \return void.
+ */
+void rtos_can_transmit(can_message_tx_config_t can_message_tx);
+
+/*!
+ 	 \brief This function sends a frame of the stand-in to the node. The callback of
+ 	 	 	 its ID is called before it returns.
+
+ 	 \param[in] ID ID of the frame.
+ 	 \param[in] data Data of the frame.
+ 	 \param[in] DLC DLC of the frame.
+
+ 	 \return void.
+ */
+void CAN_BUS_SIM_send(uint16_t ID, const uint8_t* data, uint8_t DLC);
+
+/*!
+ 	 \brief This function reads the oldest frame sent by the node.
+
+ 	 \param[out] frame Frame read.
+
+ 	 \return 1 if a frame was read, 0 if the queue is empty.
+ */
+uint8_t CAN_BUS_SIM_receive(CAN_BUS_SIM_frame_t* frame);
+
+/*!
+ 	 \brief This function sets the RAM of the node, the memory the XCP slave can read and write.
+
+ 	 \param[in] start First address of the RAM.
+ 	 \param[in] size Size of the RAM in bytes.
+
+ 	 \return void.
+ */
+void CAN_BUS_SIM_set_ram(const volatile void* start, uint32_t size);
+
+/*!
+ 	 \brief This function gets the first address of the RAM of the node.
+
+ 	 \return First address of the RAM, 0 if it was not set.
+ */
+uint32_t CAN_BUS_SIM_get_ram_start(void);
+
+/*!
+ 	 \brief This function gets the address after the RAM of the node.
+
+ 	 \return Address after the RAM, 0 if it was not set.
+ */
+uint32_t CAN_BUS_SIM_get_ram_end(void);
+
+/*!
+ 	 \brief This function gets the frames lost because the queue was full.
+
+ 	 \return Frames lost since the start.
+ */
+uint32_t CAN_BUS_SIM_get_overruns(void);
+
+#endif /* CAN_BUS_SIM_H_ */
@@ -0,0 +1,445 @@
+#!/usr/bin/env python3
+"""
+    \file dbc_codegen.py
+
+    \brief Generates the pack and unpack functions of the CAN signals from a
+            DBC file. Every function is straight-line code specialized for its
+            message (no tables nor loops over the signals), handling the bit
+            offset, the byte order, the sign, the scale/offset and the
+            saturation to the range of the signal.
+
+    \note Usage (From the project folder):
+            python3 Host/dbc_codegen.py Host/motor.dbc Sources/can_signals
+            It writes Sources/can_signals.h and Sources/can_signals.c.
+
+    \author HEMI team
+            Arpio Fernandez, Leon               ie702086@iteso.mx
+            Barragan Alvarez, Daniel            ie702554@iteso.mx
+            Delsordo Bustillo, Jose Ricardo     ie702570@iteso.mx
+
+    \date   19/10/2026
+"""
+
+import os
+import re
+import sys
+
+# Message line: BO_ <ID> <name>: <DLC> <sender>
+MESSAGE_RE = re.compile(r'^BO_\s+(\d+)\s+(\w+)\s*:\s*(\d+)\s+(\w+)')
+# Signal line: SG_ <name> : <start>|<length>@<order><sign> (<factor>,<offset>) [<min>|<max>] "<unit>" <receivers>
+SIGNAL_RE = re.compile(r'^SG_\s+(\w+)\s*:\s*(\d+)\|(\d+)@([01])([+-])\s*\(([^,]+),([^)]+)\)\s*'
+                       r'\[([^|]+)\|([^\]]+)\]\s*"([^"]*)"')
+# Comment line of a message: CM_ BO_ <ID> "<text>";
+COMMENT_RE = re.compile(r'^CM_\s+BO_\s+(\d+)\s+"([^"]*)"')
+
+# Extended IDs have the bit 31 set in the DBC
+EXTENDED_ID_FLAG = 0x80000000
+
+HEADER_TEMPLATE = """/*!
+ 	 \\file {base}.h
+
+ 	 \\brief This is the header file of the CAN signals. It has the pack and unpack
+ 	 	 	 functions of the messages of {dbc}.
+
+ 	 \\note Generated by Host/dbc_codegen.py, do not modify it by hand.
+
+ 	 \\author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \\date 	19/10/2026
+ */
+
+#ifndef {guard}
+#define {guard}
+
+#include <stdint.h>
+{body}
+#endif /* {guard} */
+"""
+
+SOURCE_TEMPLATE = """/*!
+ 	 \\file {base}.c
+
+ 	 \\brief This is the source file of the CAN signals. The pack and unpack
+ 	 	 	 functions of the messages of {dbc} are found in this source file.
+
+ 	 \\note Generated by Host/dbc_codegen.py, do not modify it by hand.
+
+ 	 \\author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \\date 	19/10/2026
+ */
+
+#include "{base}.h"
+{body}"""
+
+
+class Signal:
+    """Signal of a message."""
+
+    def __init__(self, match):
+        self.name = match.group(1)
+        self.start = int(match.group(2))
+        self.length = int(match.group(3))
+        self.little_endian = match.group(4) == '1'
+        self.signed = match.group(5) == '-'
+        self.factor = float(match.group(6))
+        self.offset = float(match.group(7))
+        self.minimum = float(match.group(8))
+        self.maximum = float(match.group(9))
+        self.unit = match.group(10)
+
+        if not 1 <= self.length <= 64:
+            raise ValueError('signal %s: length %d out of range' % (self.name, self.length))
+
+    def is_integer(self):
+        """The physical value is the raw value, so it is kept as an integer."""
+        return self.factor == 1.0 and self.offset == 0.0 and \
+            self.minimum.is_integer() and self.maximum.is_integer()
+
+    def raw_type(self):
+        """Unsigned type that holds the raw bits."""
+        return 'uint32_t' if self.length <= 32 else 'uint64_t'
+
+    def c_type(self):
+        """Type of the physical value in the message structure."""
+        if not self.is_integer():
+            return 'float'
+
+        for bits in (8, 16, 32, 64):
+            if self.length <= bits:
+                return ('int%d_t' if self.signed else 'uint%d_t') % bits
+
+    def raw_limits(self):
+        """Lowest and highest raw value that fit in the length."""
+        if self.signed:
+            return -(1 << (self.length - 1)), (1 << (self.length - 1)) - 1
+
+        return 0, (1 << self.length) - 1
+
+    def bit_positions(self):
+        """Absolute bit (byte * 8 + bit) of every raw bit, from the LSB."""
+        if self.little_endian:
+            return [self.start + bit for bit in range(self.length)]
+
+        # Motorola: the start bit is the MSB, the next bits go down the byte and then to the next byte
+        positions = []
+        position = self.start
+
+        for _ in range(self.length):
+            positions.append(position)
+            position = position + 15 if position % 8 == 0 else position - 1
+
+        positions.reverse()
+        return positions
+
+    def chunks(self):
+        """Runs of raw bits in each byte: (byte, bit in byte, raw bit, width)."""
+        per_byte = {}
+
+        for raw_bit, position in enumerate(self.bit_positions()):
+            per_byte.setdefault(position // 8, []).append((position % 8, raw_bit))
+
+        result = []
+
+        for byte in sorted(per_byte):
+            bits = sorted(per_byte[byte])
+            result.append((byte, bits[0][0], bits[0][1], len(bits)))
+
+        return result
+
+
+class Message:
+    """Message of the DBC."""
+
+    def __init__(self, match):
+        self.ID = int(match.group(1))
+        self.name = match.group(2)
+        self.DLC = int(match.group(3))
+        self.sender = match.group(4)
+        self.comment = None
+        self.signals = []
+
+    def lower(self):
+        return self.name.lower()
+
+    def check(self):
+        """Checks that the signals fit in the DLC and do not overlap."""
+        used = set()
+
+        for signal in self.signals:
+            for position in signal.bit_positions():
+                if position < 0 or position >= self.DLC * 8:
+                    raise ValueError('%s.%s does not fit in %d bytes' % (self.name, signal.name, self.DLC))
+
+                if position in used:
+                    raise ValueError('%s.%s overlaps another signal' % (self.name, signal.name))
+
+                used.add(position)
+
+
+def parse(path):
+    """Returns the messages of a DBC file."""
+    messages = []
+    by_ID = {}
+
+    with open(path) as dbc:
+        for line in dbc:
+            line = line.strip()
+            match = MESSAGE_RE.match(line)
+
+            if match:
+                messages.append(Message(match))
+                by_ID[messages[-1].ID] = messages[-1]
+                continue
+
+            match = SIGNAL_RE.match(line)
+
+            if match:
+                if not messages:
+                    raise ValueError('signal outside of a message: %s' % line)
+
+                messages[-1].signals.append(Signal(match))
+                continue
+
+            match = COMMENT_RE.match(line)
+
+            if match and int(match.group(1)) in by_ID:
+                by_ID[int(match.group(1))].comment = match.group(2)
+
+    for message in messages:
+        message.check()
+
+    return messages
+
+
+def c_number(value, as_float):
+    """Formats a number as a C literal."""
+    if as_float:
+        return repr(float(value)) + 'F'
+
+    return str(int(value))
+
+
+def shift(expression, amount, left):
+    """Shifts an expression, skipping the shifts by 0."""
+    if amount == 0:
+        return expression
+
+    return '(%s %s %d)' % (expression, '<<' if left else '>>', amount)
+
+
+def pack_function(message):
+    """Straight-line pack function of a message."""
+    lines = ['/** This function packs the %s message*/' % message.name,
+             'void CAN_SIG_pack_%s(uint8_t* data, const can_sig_%s_t* msg)' % (message.lower(), message.lower()),
+             '{']
+    contributions = {byte: [] for byte in range(message.DLC)}
+
+    for signal in message.signals:
+        raw = 'raw_%s' % signal.name
+        lines.append('\t/** Raw value of %s*/' % signal.name)
+        lines.append('\t%s %s;' % (signal.raw_type(), raw))
+
+    for signal in message.signals:
+        raw = 'raw_%s' % signal.name
+        value = 'msg->%s' % signal.name
+        raw_low, raw_high = signal.raw_limits()
+        lines.append('')
+        lines.append('\t/** %s: saturates to [%g, %g] and converts to raw*/' % (signal.name, signal.minimum, signal.maximum))
+
+        if signal.is_integer():
+            low = max(signal.minimum, raw_low)
+            high = min(signal.maximum, raw_high)
+            clamped = value
+            bits = int(re.search(r'\d+', signal.c_type()).group(0))
+            type_low, type_high = (-(1 << (bits - 1)), (1 << (bits - 1)) - 1) if signal.signed else (0, (1 << bits) - 1)
+
+            if high < type_high:
+                clamped = '((%s > %d) ? %d : %s)' % (value, high, high, clamped)
+
+            if low > type_low:
+                clamped = '((%s < %d) ? %d : %s)' % (value, low, low, clamped)
+
+            # Signed values are widened first, so the two's complement is kept in the raw bits
+            cast = '(%s)(int64_t)' % signal.raw_type() if signal.signed else '(%s)' % signal.raw_type()
+            lines.append('\t%s = %s%s;' % (raw, cast, clamped))
+        else:
+            scaled = 'scaled_%s' % signal.name
+            lines.append('\t{')
+            lines.append('\t\t/** Value in raw units, rounded to the nearest*/')
+            lines.append('\t\tfloat %s = ((%s < %s) ? %s : ((%s > %s) ? %s : %s));' % (
+                scaled, value, c_number(signal.minimum, True), c_number(signal.minimum, True),
+                value, c_number(signal.maximum, True), c_number(signal.maximum, True), value))
+            lines.append('\t\t%s = (%s %s %s) / %s;' % (scaled, scaled, '+' if signal.offset < 0 else '-',
+                                                      c_number(abs(signal.offset), True), c_number(signal.factor, True)))
+            lines.append('\t\t%s = (%s < %s) ? %s : ((%s > %s) ? %s : %s);' % (
+                scaled, scaled, c_number(raw_low, True), c_number(raw_low, True),
+                scaled, c_number(raw_high, True), c_number(raw_high, True), scaled))
+            lines.append('\t\t%s = (%s)(int64_t)((%s >= 0.0F) ? (%s + 0.5F) : (%s - 0.5F));' % (
+                raw, signal.raw_type(), scaled, scaled, scaled))
+            lines.append('\t}')
+
+        for byte, bit_in_byte, raw_bit, width in signal.chunks():
+            part = shift(raw, raw_bit, False)
+
+            if raw_bit + width < signal.length or signal.signed:
+                part = '(%s & 0x%XU)' % (part, (1 << width) - 1)
+
+            contributions[byte].append(shift(part, bit_in_byte, True))
+
+    lines.append('')
+    lines.append('\t/** Writes every byte once, the unused bits are 0*/')
+
+    for byte in range(message.DLC):
+        parts = contributions[byte] or ['0U']
+        lines.append('\tdata[%d] = (uint8_t)(%s);' % (byte, ' | '.join(parts)))
+
+    lines.append('}')
+    return lines
+
+
+def unpack_function(message):
+    """Straight-line unpack function of a message."""
+    lines = ['/** This function unpacks the %s message*/' % message.name,
+             'void CAN_SIG_unpack_%s(const uint8_t* data, can_sig_%s_t* msg)' % (message.lower(), message.lower()),
+             '{']
+
+    for signal in message.signals:
+        lines.append('\t/** Raw value of %s*/' % signal.name)
+        lines.append('\t%s raw_%s;' % (signal.raw_type(), signal.name))
+
+    for signal in message.signals:
+        raw = 'raw_%s' % signal.name
+        parts = []
+
+        for byte, bit_in_byte, raw_bit, width in signal.chunks():
+            part = shift('(%s)data[%d]' % (signal.raw_type(), byte), bit_in_byte, False)
+
+            if bit_in_byte + width < 8:
+                part = '(%s & 0x%XU)' % (part, (1 << width) - 1)
+
+            parts.append(shift(part, raw_bit, True))
+
+        lines.append('')
+        lines.append('\t/** %s: gathers the raw bits, then converts and saturates to [%g, %g]*/' % (
+            signal.name, signal.minimum, signal.maximum))
+        lines.append('\t%s = %s;' % (raw, ' | '.join(parts)))
+
+        if signal.signed:
+            sign = '0x%XU' % (1 << (signal.length - 1))
+            if signal.length > 32:
+                sign += 'LL'
+            lines.append('\t%s = (%s ^ %s) - %s;' % (raw, raw, sign, sign))
+
+        signed_raw = '(int64_t)(%s)%s' % ('int64_t' if signal.length > 32 else 'int32_t', raw) if signal.signed else raw
+
+        if signal.is_integer():
+            raw_low, raw_high = signal.raw_limits()
+            value = '(%s)%s' % (signal.c_type(), signed_raw if signal.signed else raw)
+            lines.append('\tmsg->%s = %s;' % (signal.name, value))
+
+            if signal.maximum < raw_high:
+                lines.append('\tmsg->%s = (msg->%s > %d) ? %d : msg->%s;' % (
+                    signal.name, signal.name, signal.maximum, signal.maximum, signal.name))
+
+            if signal.minimum > raw_low:
+                lines.append('\tmsg->%s = (msg->%s < %d) ? %d : msg->%s;' % (
+                    signal.name, signal.name, signal.minimum, signal.minimum, signal.name))
+        else:
+            lines.append('\tmsg->%s = ((float)%s * %s) + %s;' % (
+                signal.name, signed_raw, c_number(signal.factor, True), c_number(signal.offset, True)))
+            lines.append('\tmsg->%s = (msg->%s < %s) ? %s : ((msg->%s > %s) ? %s : msg->%s);' % (
+                signal.name, signal.name, c_number(signal.minimum, True), c_number(signal.minimum, True),
+                signal.name, c_number(signal.maximum, True), c_number(signal.maximum, True), signal.name))
+
+    lines.append('}')
+    return lines
+
+
+def header_body(messages):
+    """Defines, structures and prototypes of the messages."""
+    lines = []
+
+    for message in messages:
+        upper = message.name.upper()
+        lower = message.lower()
+        ID = message.ID & ~EXTENDED_ID_FLAG
+        lines.append('')
+        lines.append('/** Defines the ID of the %s message*/' % message.name)
+        lines.append('#define CAN_SIG_%s_ID%s(0x%03X)' % (upper, '\t' * max(1, (36 - len('#define CAN_SIG_%s_ID' % upper) + 3) // 4), ID))
+        lines.append('/** Defines the DLC of the %s message*/' % message.name)
+        lines.append('#define CAN_SIG_%s_DLC%s(%d)' % (upper, '\t' * max(1, (36 - len('#define CAN_SIG_%s_DLC' % upper) + 3) // 4), message.DLC))
+        lines.append('')
+        lines.append('/*!')
+        lines.append(' \t \\brief Signals of the %s message%s.' % (message.name, (' (' + message.comment + ')') if message.comment else ''))
+        lines.append(' */')
+        lines.append('typedef struct')
+        lines.append('{')
+
+        for signal in message.signals:
+            unit = (' [' + signal.unit + ']') if signal.unit else ''
+            lines.append('\t%s %s;\t/*!< Bits %d to %d, %s%s*/' % (
+                signal.c_type(), signal.name, min(signal.bit_positions()), max(signal.bit_positions()),
+                'Intel' if signal.little_endian else 'Motorola', unit))
+
+        lines.append('}can_sig_%s_t;' % lower)
+        lines.append('')
+        lines.append('/*!')
+        lines.append(' \t \\brief This function packs the %s message, saturating every signal to its range.' % message.name)
+        lines.append('')
+        lines.append(' \t \\param[out] data Payload of %d bytes.' % message.DLC)
+        lines.append(' \t \\param[in] msg Signals to be packed.')
+        lines.append('')
+        lines.append(' \t \\return void.')
+        lines.append(' */')
+        lines.append('void CAN_SIG_pack_%s(uint8_t* data, const can_sig_%s_t* msg);' % (lower, lower))
+        lines.append('')
+        lines.append('/*!')
+        lines.append(' \t \\brief This function unpacks the %s message, saturating every signal to its range.' % message.name)
+        lines.append('')
+        lines.append(' \t \\param[in] data Payload of %d bytes.' % message.DLC)
+        lines.append(' \t \\param[out] msg Signals unpacked.')
+        lines.append('')
+        lines.append(' \t \\return void.')
+        lines.append(' */')
+        lines.append('void CAN_SIG_unpack_%s(const uint8_t* data, can_sig_%s_t* msg);' % (lower, lower))
+
+    lines.append('')
+    return '\n'.join(lines)
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.stderr.write('usage: %s <file.dbc> <output base path>\n' % sys.argv[0])
+        return 1
+
+    dbc_path, output = sys.argv[1], sys.argv[2]
+    messages = parse(dbc_path)
+    base = os.path.basename(output)
+    dbc = os.path.basename(dbc_path)
+
+    source = []
+
+    for message in messages:
+        source.append('')
+        source.extend(pack_function(message))
+        source.append('')
+        source.extend(unpack_function(message))
+
+    with open(output + '.h', 'w') as header:
+        header.write(HEADER_TEMPLATE.format(base=base, dbc=dbc, guard=base.upper() + '_H_', body=header_body(messages)))
+
+    with open(output + '.c', 'w') as c_file:
+        c_file.write(SOURCE_TEMPLATE.format(base=base, dbc=dbc, body='\n'.join(source) + '\n'))
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,371 @@
+#!/usr/bin/env python3
+"""
+    \file dbc_codegen_test.py
+
+    \brief Round-trip test and benchmark of the code generated by dbc_codegen.py.
+            For every signal of the DBC files it generates random values (Also
+            out of range, to check the saturation) and random payloads, and
+            checks the generated pack and unpack functions against a reference
+            model that works on the whole payload as a single integer (Intel:
+            little endian, Motorola: big endian), independent of the bit chunks
+            of the generator. Then it measures the time of every function.
+
+    \note Usage (From the project folder, it needs gcc):
+            python3 Host/dbc_codegen_test.py [vectors per message]
+            It tests Host/motor.dbc and Host/codec_test.dbc (Signed, Motorola,
+            scaled and wider than 32 bits signals), and checks that the
+            committed Sources/can_signals.[ch] match the generator.
+
+    \author HEMI team
+            Arpio Fernandez, Leon               ie702086@iteso.mx
+            Barragan Alvarez, Daniel            ie702554@iteso.mx
+            Delsordo Bustillo, Jose Ricardo     ie702570@iteso.mx
+
+    \date   19/10/2026
+"""
+
+import os
+import random
+import re
+import subprocess
+import sys
+import tempfile
+
+import dbc_codegen
+
+HOST_DIR = os.path.dirname(os.path.abspath(__file__))
+PROJECT_DIR = os.path.dirname(HOST_DIR)
+
+# DBC files tested, the first one is the one of the firmware
+DBC_FILES = ('motor.dbc', 'codec_test.dbc')
+# Generated files of the firmware
+FIRMWARE_OUTPUT = os.path.join(PROJECT_DIR, 'Sources', 'can_signals')
+
+# Default number of vectors per message
+DEFAULT_VECTORS = 2000
+# Calls of every function in the benchmark
+BENCH_CALLS = 2000000
+# Share of the values generated out of the range of the signal
+OUT_OF_RANGE_SHARE = 0.1
+
+HARNESS_TEMPLATE = """#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include "{base}.h"
+
+static int failures = 0;
+static volatile uint8_t sink;
+
+static double seconds(void)
+{{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return now.tv_sec + now.tv_nsec * 1e-9;
+}}
+
+static void check_bytes(const char* what, int vector, const uint8_t* data, const uint8_t* expected, int DLC)
+{{
+	int byte;
+
+	for(byte = 0 ; byte < DLC ; byte ++)
+	{{
+		if(data[byte] != expected[byte])
+		{{
+			printf("FAIL: %s vector %d byte %d: 0x%02X, expected 0x%02X\\n", what, vector, byte, data[byte], expected[byte]);
+			failures ++;
+			return;
+		}}
+	}}
+}}
+
+static void check_value(const char* what, int vector, double value, double expected, double tolerance)
+{{
+	double error = value - expected;
+
+	if((error > tolerance) || (error < -tolerance))
+	{{
+		printf("FAIL: %s vector %d: %.9g, expected %.9g\\n", what, vector, value, expected);
+		failures ++;
+	}}
+}}
+{body}
+int main(void)
+{{
+{calls}
+	printf("%d failures\\n", failures);
+
+	return (0 == failures) ? 0 : 1;
+}}
+"""
+
+
+def raw_to_bits(signal, raw):
+    """Two's complement bits of a raw value."""
+    return raw & ((1 << signal.length) - 1)
+
+
+def bits_to_raw(signal, bits):
+    """Raw value of the bits of a signal."""
+    if signal.signed and bits & (1 << (signal.length - 1)):
+        return bits - (1 << signal.length)
+
+    return bits
+
+
+def reference_insert(signal, payload, DLC, raw):
+    """Inserts the raw value in the payload, as a single integer."""
+    bits = raw_to_bits(signal, raw)
+
+    if signal.little_endian:
+        value = int.from_bytes(payload, 'little')
+        value |= bits << signal.start
+        return bytearray(value.to_bytes(DLC, 'little'))
+
+    # Motorola: the start bit is the MSB, counted from the MSB of the big endian payload
+    msb = (signal.start // 8) * 8 + (7 - signal.start % 8)
+    value = int.from_bytes(payload, 'big')
+    value |= bits << (DLC * 8 - msb - signal.length)
+    return bytearray(value.to_bytes(DLC, 'big'))
+
+
+def reference_extract(signal, payload, DLC):
+    """Extracts the raw value from the payload, as a single integer."""
+    mask = (1 << signal.length) - 1
+
+    if signal.little_endian:
+        bits = (int.from_bytes(payload, 'little') >> signal.start) & mask
+    else:
+        msb = (signal.start // 8) * 8 + (7 - signal.start % 8)
+        bits = (int.from_bytes(payload, 'big') >> (DLC * 8 - msb - signal.length)) & mask
+
+    return bits_to_raw(signal, bits)
+
+
+def physical_to_raw(signal, value):
+    """Raw value sent for a physical value, saturated to the range and to the bits."""
+    raw_low, raw_high = signal.raw_limits()
+    value = min(max(value, signal.minimum), signal.maximum)
+
+    if signal.is_integer():
+        return int(min(max(value, raw_low), raw_high))
+
+    return int(round(min(max((value - signal.offset) / signal.factor, raw_low), raw_high)))
+
+
+def raw_to_physical(signal, raw):
+    """Physical value received for a raw value, saturated to the range."""
+    value = raw * signal.factor + signal.offset if not signal.is_integer() else raw
+
+    return min(max(value, signal.minimum), signal.maximum)
+
+
+def random_value(signal, rng):
+    """Random physical value, away from the rounding edges of the raw values."""
+    raw_low, raw_high = signal.raw_limits()
+
+    if signal.is_integer():
+        if rng.random() < OUT_OF_RANGE_SHARE:
+            # Beyond the DBC range, but inside the C type
+            bits = int(re.search(r'\d+', signal.c_type()).group(0))
+            type_low, type_high = (-(1 << (bits - 1)), (1 << (bits - 1)) - 1) if signal.signed else (0, (1 << bits) - 1)
+            return rng.choice((type_low, type_high, rng.randint(type_low, type_high)))
+
+        return rng.randint(int(max(signal.minimum, raw_low)), int(min(signal.maximum, raw_high)))
+
+    if rng.random() < OUT_OF_RANGE_SHARE:
+        span = signal.maximum - signal.minimum
+        return rng.choice((signal.minimum - span, signal.maximum + span))
+
+    low = max(raw_low, int(round((signal.minimum - signal.offset) / signal.factor)))
+    high = min(raw_high, int(round((signal.maximum - signal.offset) / signal.factor)))
+    raw = rng.randint(low, high)
+    value = raw * signal.factor + signal.offset + rng.uniform(-0.3, 0.3) * signal.factor
+
+    return min(max(value, signal.minimum), signal.maximum)
+
+
+def c_literal(signal, value):
+    """C literal of a physical value."""
+    if not signal.is_integer():
+        return repr(float(value)) + 'F'
+
+    if signal.length > 32:
+        return '%dLL' % value if signal.signed else '%dULL' % value
+
+    return '%dLL' % value if value < -(1 << 31) else '%d' % value
+
+
+def c_tolerance(signal, expected):
+    """C expression of the error allowed on an unpacked value (The float of the target has 24 bits)."""
+    if signal.is_integer():
+        return '0.0'
+
+    return '%r * ((%s < 0.0) ? -%s : %s) + %r' % (2.0 ** -22, expected, expected, expected, signal.factor * 1e-3)
+
+
+def message_test(message, rng, vectors):
+    """Test and benchmark of a message, as C code, and the lines to call them."""
+    lower = message.lower()
+    DLC = message.DLC
+    lines = ['', 'static void test_%s(void)' % lower, '{']
+    packed = []
+    values = []
+    payloads = []
+    unpacked = []
+
+    for _ in range(vectors):
+        # Pack: random physical values against the reference payload
+        vector = [random_value(signal, rng) for signal in message.signals]
+        payload = bytearray(DLC)
+
+        for signal, value in zip(message.signals, vector):
+            payload = reference_insert(signal, payload, DLC, physical_to_raw(signal, value))
+
+        values.append(vector)
+        packed.append(payload)
+
+        # Unpack: random payloads against the reference values
+        payload = bytearray(rng.getrandbits(8) for _ in range(DLC))
+        payloads.append(payload)
+        unpacked.append([raw_to_physical(signal, reference_extract(signal, payload, DLC)) for signal in message.signals])
+
+    def c_bytes(rows):
+        return ',\n'.join('\t\t{%s}' % ', '.join('0x%02X' % byte for byte in row) for row in rows)
+
+    def c_structs(rows):
+        return ',\n'.join('\t\t{%s}' % ', '.join(c_literal(signal, value) for signal, value in zip(message.signals, row))
+                          for row in rows)
+
+    lines.append('\tstatic const can_sig_%s_t values[%d] =\n\t{\n%s\n\t};' % (lower, vectors, c_structs(values)))
+    lines.append('\tstatic const uint8_t packed[%d][%d] =\n\t{\n%s\n\t};' % (vectors, DLC, c_bytes(packed)))
+    lines.append('\tstatic const uint8_t payloads[%d][%d] =\n\t{\n%s\n\t};' % (vectors, DLC, c_bytes(payloads)))
+    lines.append('\tstatic const double unpacked[%d][%d] =\n\t{\n%s\n\t};' % (
+        vectors, len(message.signals), ',\n'.join('\t\t{%s}' % ', '.join(repr(float(value)) for value in row)
+                                                 for row in unpacked)))
+    lines.append('\tuint8_t data[%d];' % DLC)
+    lines.append('\tcan_sig_%s_t msg;' % lower)
+    lines.append('\tint vector;')
+    lines.append('\tlong call;')
+    lines.append('\tdouble start;')
+    lines.append('')
+    lines.append('\tfor(vector = 0 ; vector < %d ; vector ++)' % vectors)
+    lines.append('\t{')
+    lines.append('\t\tCAN_SIG_pack_%s(data, &values[vector]);' % lower)
+    lines.append('\t\tcheck_bytes("pack %s", vector, data, packed[vector], %d);' % (message.name, DLC))
+    lines.append('')
+    lines.append('\t\tCAN_SIG_unpack_%s(payloads[vector], &msg);' % lower)
+
+    for index, signal in enumerate(message.signals):
+        expected = 'unpacked[vector][%d]' % index
+        lines.append('\t\tcheck_value("unpack %s.%s", vector, (double)msg.%s, %s, %s);' % (
+            message.name, signal.name, signal.name, expected, c_tolerance(signal, expected)))
+
+    lines.append('')
+    lines.append('\t\t/** Round trip: the values unpacked are packed into the same raw bits*/')
+    lines.append('\t\tCAN_SIG_pack_%s(data, &msg);' % lower)
+    lines.append('\t\tCAN_SIG_unpack_%s(data, &msg);' % lower)
+
+    for index, signal in enumerate(message.signals):
+        expected = 'unpacked[vector][%d]' % index
+        lines.append('\t\tcheck_value("round trip %s.%s", vector, (double)msg.%s, %s, %s);' % (
+            message.name, signal.name, signal.name, expected, c_tolerance(signal, expected)))
+
+    lines.append('\t}')
+    lines.append('')
+    lines.append('\tstart = seconds();')
+    lines.append('\tfor(call = 0 ; call < %d ; call ++)' % BENCH_CALLS)
+    lines.append('\t{')
+    lines.append('\t\tCAN_SIG_pack_%s(data, &values[call %% %d]);' % (lower, vectors))
+    lines.append('\t\tsink ^= data[0];')
+    lines.append('\t}')
+    lines.append('\tprintf("%%-10s pack   %%6.2f ns\\n", "%s", (seconds() - start) * 1e9 / %d);' % (message.name, BENCH_CALLS))
+    lines.append('')
+    lines.append('\tstart = seconds();')
+    lines.append('\tfor(call = 0 ; call < %d ; call ++)' % BENCH_CALLS)
+    lines.append('\t{')
+    lines.append('\t\tCAN_SIG_unpack_%s(payloads[call %% %d], &msg);' % (lower, vectors))
+    lines.append('\t\tsink ^= *(volatile uint8_t*)&msg;')
+    lines.append('\t}')
+    lines.append('\tprintf("%%-10s unpack %%6.2f ns\\n", "%s", (seconds() - start) * 1e9 / %d);' % (message.name, BENCH_CALLS))
+    lines.append('}')
+
+    return lines, '\ttest_%s();' % lower
+
+
+def generate(dbc_path, output):
+    """Writes the code of a DBC file, as dbc_codegen.py does."""
+    saved = sys.argv
+    sys.argv = ['dbc_codegen.py', dbc_path, output]
+
+    try:
+        dbc_codegen.main()
+    finally:
+        sys.argv = saved
+
+
+def test_dbc(dbc_path, work_dir, rng, vectors):
+    """Generates, builds and runs the test of a DBC file, it returns whether it passed."""
+    base = os.path.splitext(os.path.basename(dbc_path))[0] + '_signals'
+    output = os.path.join(work_dir, base)
+    messages = dbc_codegen.parse(dbc_path)
+    body = []
+    calls = []
+
+    generate(dbc_path, output)
+
+    for message in messages:
+        lines, call = message_test(message, rng, vectors)
+        body.extend(lines)
+        calls.append(call)
+
+    harness = os.path.join(work_dir, base + '_test.c')
+    executable = os.path.join(work_dir, base + '_test')
+
+    with open(harness, 'w') as c_file:
+        c_file.write(HARNESS_TEMPLATE.format(base=base, body='\n'.join(body) + '\n', calls='\n'.join(calls)))
+
+    subprocess.check_call(['gcc', '-std=c99', '-O2', '-Wall', '-Wextra', '-Werror', '-I' + work_dir,
+                           harness, output + '.c', '-o', executable])
+
+    signals = sum(len(message.signals) for message in messages)
+    print('%s: %d messages, %d signals, %d vectors per message' % (os.path.basename(dbc_path), len(messages), signals, vectors))
+    sys.stdout.flush()
+
+    return subprocess.call([executable]) == 0
+
+
+def firmware_is_current(work_dir):
+    """Checks that the committed code matches the generator."""
+    output = os.path.join(work_dir, 'can_signals')
+    generate(os.path.join(HOST_DIR, DBC_FILES[0]), output)
+    current = True
+
+    for extension in ('.h', '.c'):
+        with open(output + extension) as generated, open(FIRMWARE_OUTPUT + extension) as committed:
+            if generated.read() != committed.read():
+                print('FAIL: Sources/can_signals%s does not match the generator' % extension)
+                current = False
+
+    return current
+
+
+def main():
+    vectors = int(sys.argv[1]) if len(sys.argv) > 1 else DEFAULT_VECTORS
+    rng = random.Random(1)
+    passed = True
+
+    with tempfile.TemporaryDirectory() as work_dir:
+        passed = firmware_is_current(work_dir) and passed
+
+        for dbc in DBC_FILES:
+            passed = test_dbc(os.path.join(HOST_DIR, dbc), work_dir, rng, vectors) and passed
+
+    print('PASSED' if passed else 'FAILED')
+    return 0 if passed else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
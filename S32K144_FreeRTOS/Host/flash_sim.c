@@ -0,0 +1,240 @@
+/*!
+ 	 \file flash_sim.c
+
+ 	 \brief This is the source file of the simulated FTFC. The erase and program
+ 	 	 	 operations over the RAM array are found in this source file.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include <string.h>
+#include "flash_sim.h"
+
+/** Defines the value of an erased byte*/
+#define ERASED_BYTE							(0xFF)
+/** Defines the initial value for the variables*/
+#define INIT_VAL							(0)
+
+/*********************************************************************************************/
+
+/*!
+ 	 \brief This function erases a simulated sector.
+
+ 	 \param[in] address Address of the sector.
+
+ 	 \return Result of the erase.
+ */
+static flash_status_t flash_sim_erase_sector(uint32_t address);
+
+/*!
+ 	 \brief This function programs a simulated phrase.
+
+ 	 \note As in the real flash, programming can only clear bits, so a phrase that
+ 	 	 	 was not erased fails the verify.
+
+ 	 \param[in] address Address of the phrase.
+ 	 \param[in] data Phrase to be programmed.
+
+ 	 \return Result of the programming.
+ */
+static flash_status_t flash_sim_program_phrase(uint32_t address, const uint8_t* data);
+
+/*!
+ 	 \brief This function starts the busy time of an operation, its result is known
+ 	 	 	 once the time runs (FLASH_SIM_run_us).
+
+ 	 \param[in] status Result of the operation.
+ 	 \param[in] time Time the operation takes, in microseconds.
+
+ 	 \return flash_busy.
+ */
+static flash_status_t flash_sim_start(flash_status_t status, uint64_t time);
+
+/*!
+ 	 \brief This function returns the result of the last operation.
+
+ 	 \return Result of the last operation, flash_busy while it runs.
+ */
+static flash_status_t flash_sim_poll(void);
+
+/*!
+ 	 \brief This function returns a pointer to read the simulated flash.
+
+ 	 \param[in] address Address to be read.
+
+ 	 \return Pointer to the address.
+ */
+static const uint8_t* flash_sim_read(uint32_t address);
+
+/*!
+ 	 \brief This function sets the function called when an operation ends.
+
+ 	 \param[in] callback Function to be called.
+
+ 	 \return void.
+ */
+static void flash_sim_set_done_callback(void (*callback)(void));
+
+/*********************************************************************************************/
+
+/** Contents of the simulated flash*/
+static uint8_t flash_sim_memory[FLASH_SIM_SIZE];
+/** Time the simulated flash has been busy*/
+static uint64_t flash_sim_busy_time_us = INIT_VAL;
+/** Result of the last operation*/
+static flash_status_t flash_sim_last_status = flash_success;
+/** Time until the operation in progress ends*/
+static uint64_t flash_sim_remaining_us = INIT_VAL;
+/** Function called when an operation ends*/
+static void (*flash_sim_done_callback)(void) = NULL;
+
+/** Flash interface of the simulated flash*/
+static const flash_if_t flash_sim_if =
+{
+	INIT_VAL,
+	FLASH_SIM_SIZE,
+	FLASH_SIM_SECTOR_SIZE,
+	FLASH_SIM_PHRASE_SIZE,
+	flash_sim_erase_sector,
+	flash_sim_program_phrase,
+	flash_sim_poll,
+	flash_sim_read,
+	flash_sim_set_done_callback
+};
+
+/*********************************************************************************************/
+
+/** This function returns the flash interface*/
+const flash_if_t* FLASH_SIM_get_flash_if(void)
+{
+	return &flash_sim_if;
+}
+
+/** This function returns the busy time*/
+uint64_t FLASH_SIM_get_busy_time_us(void)
+{
+	return flash_sim_busy_time_us;
+}
+
+/** This function resets the simulated flash*/
+void FLASH_SIM_reset(void)
+{
+	memset(flash_sim_memory, ERASED_BYTE, sizeof(flash_sim_memory));
+	flash_sim_busy_time_us = INIT_VAL;
+	flash_sim_last_status = flash_success;
+	flash_sim_remaining_us = INIT_VAL;
+}
+
+/** This function lets the time run for the flash*/
+void FLASH_SIM_run_us(uint64_t time)
+{
+	if(INIT_VAL == flash_sim_remaining_us)
+	{
+		return;
+	}
+
+	if(time < flash_sim_remaining_us)
+	{
+		flash_sim_remaining_us -= time;
+		return;
+	}
+
+	/** The operation ends, as the command complete interruption*/
+	flash_sim_remaining_us = INIT_VAL;
+
+	if(NULL != flash_sim_done_callback)
+	{
+		flash_sim_done_callback();
+	}
+}
+
+/** This function returns the time until the operation ends*/
+uint64_t FLASH_SIM_get_remaining_us(void)
+{
+	return flash_sim_remaining_us;
+}
+
+/** This function starts the busy time of an operation*/
+static flash_status_t flash_sim_start(flash_status_t status, uint64_t time)
+{
+	flash_sim_last_status = status;
+	flash_sim_remaining_us = time;
+	flash_sim_busy_time_us += time;
+
+	return flash_busy;
+}
+
+/** This function erases a sector*/
+static flash_status_t flash_sim_erase_sector(uint32_t address)
+{
+	if((INIT_VAL != (address % FLASH_SIM_SECTOR_SIZE)) || (FLASH_SIM_SIZE <= address))
+	{
+		return flash_address_error;
+	}
+
+	/** A command is still running, as the FTFC*/
+	if(INIT_VAL != flash_sim_remaining_us)
+	{
+		return flash_access_error;
+	}
+
+	memset(&flash_sim_memory[address], ERASED_BYTE, FLASH_SIM_SECTOR_SIZE);
+
+	return flash_sim_start(flash_success, FLASH_SIM_ERASE_TIME_US);
+}
+
+/** This function programs a phrase*/
+static flash_status_t flash_sim_program_phrase(uint32_t address, const uint8_t* data)
+{
+	/** Counter for the bytes of the phrase*/
+	uint8_t counter;
+
+	/** Result of the programming*/
+	flash_status_t status = flash_success;
+
+	if((INIT_VAL != (address % FLASH_SIM_PHRASE_SIZE)) || (FLASH_SIM_SIZE <= address))
+	{
+		return flash_address_error;
+	}
+
+	/** A command is still running, as the FTFC*/
+	if(INIT_VAL != flash_sim_remaining_us)
+	{
+		return flash_access_error;
+	}
+
+	for(counter = INIT_VAL ; counter < FLASH_SIM_PHRASE_SIZE ; counter ++)
+	{
+		flash_sim_memory[address + counter] &= data[counter];
+
+		if(flash_sim_memory[address + counter] != data[counter])
+		{
+			status = flash_verify_error;
+		}
+	}
+
+	return flash_sim_start(status, FLASH_SIM_PROGRAM_TIME_US);
+}
+
+/** This function returns the result of the last operation*/
+static flash_status_t flash_sim_poll(void)
+{
+	return (INIT_VAL != flash_sim_remaining_us) ? flash_busy : flash_sim_last_status;
+}
+
+/** This function returns a pointer to the simulated flash*/
+static const uint8_t* flash_sim_read(uint32_t address)
+{
+	return &flash_sim_memory[address];
+}
+
+/** This function sets the done callback*/
+static void flash_sim_set_done_callback(void (*callback)(void))
+{
+	flash_sim_done_callback = callback;
+}
@@ -0,0 +1,78 @@
+/*!
+ 	 \file flash_sim.h
+
+ 	 \brief This is the header file of the simulated FTFC. It implements the flash
+ 	 	 	 interface over a RAM array, so the bootloader can be run and its
+ 	 	 	 throughput measured on a host.
+
+ 	 \note Build it with the host compiler, e.g. gcc -I../Sources -c flash_sim.c.
+ 	 	 	 The commands take the typical timings of the S32K144 datasheet: they
+ 	 	 	 return flash_busy, and end (Calling the done callback, as the command
+ 	 	 	 complete interruption) once FLASH_SIM_run_us lets the time run.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef FLASH_SIM_H_
+#define FLASH_SIM_H_
+
+#include "flash_if.h"
+
+/** Defines the size of the simulated flash (Same as the program flash)*/
+#define FLASH_SIM_SIZE						(0x00080000U)
+/** Defines the size of a simulated sector*/
+#define FLASH_SIM_SECTOR_SIZE				(4096U)
+/** Defines the size of a simulated phrase*/
+#define FLASH_SIM_PHRASE_SIZE				(8U)
+
+/** Defines the typical time of a sector erase, in microseconds*/
+#define FLASH_SIM_ERASE_TIME_US				(12000U)
+/** Defines the typical time of a phrase program, in microseconds*/
+#define FLASH_SIM_PROGRAM_TIME_US			(36U)
+
+/*!
+ 	 \brief This function returns the flash interface of the simulated flash.
+
+ 	 \return Pointer to the flash interface.
+ */
+const flash_if_t* FLASH_SIM_get_flash_if(void);
+
+/*!
+ 	 \brief This function lets the simulated time run for the flash. If the operation
+ 	 	 	 in progress ends, the done callback is called.
+
+ 	 \param[in] time Time that passed, in microseconds.
+
+ 	 \return void.
+ */
+void FLASH_SIM_run_us(uint64_t time);
+
+/*!
+ 	 \brief This function returns the time until the operation in progress ends.
+
+ 	 \return Time in microseconds, 0 if the flash is not busy.
+ */
+uint64_t FLASH_SIM_get_remaining_us(void);
+
+/*!
+ 	 \brief This function returns the time the simulated flash has been busy.
+
+ 	 \return Busy time in microseconds since the last reset.
+ */
+uint64_t FLASH_SIM_get_busy_time_us(void);
+
+/*!
+ 	 \brief This function erases the whole simulated flash and clears the busy time.
+
+ 	 \note Call it once before using the interface, so the flash starts erased (0xFF).
+
+ 	 \return void.
+ */
+void FLASH_SIM_reset(void);
+
+#endif /* FLASH_SIM_H_ */
@@ -0,0 +1,602 @@
+/*!
+ 	 \file flash_sim_run.c
+
+ 	 \brief This is the throughput harness of the CAN bootloader. It runs BL_init and
+ 	 	 	 BL_thread of bootloader.c over the simulated flash, plays the tester side
+ 	 	 	 of the ISO-TP session, checks the answers and the flash contents, and
+ 	 	 	 reports the time of the update on the simulated time.
+
+ 	 \note The kernel and ISO-TP calls of the bootloader are implemented here: the
+ 	 	 	 time runs while the thread blocks (On the flash semaphore, on the request
+ 	 	 	 queue or on a delay), the flash ends its operations with the done callback,
+ 	 	 	 and the requests are written in the rx buffer of the session when their
+ 	 	 	 last frame arrives, so the next block is received while one is programmed.
+ 	 	 	 Build and run it with the host compiler from the Host directory:
+ 	 	 	 gcc -std=c99 -O2 -Wno-attributes -DCPU_S32K144HFT0VLLT -I. -Ibl_shim
+ 	 	 	 -I../Sources -I../Generated_Code -I../SDK/platform/devices
+ 	 	 	 -I../SDK/platform/devices/common -I../SDK/platform/devices/S32K144/include
+ 	 	 	 -I../SDK/platform/devices/S32K144/startup -I../SDK/platform/drivers/inc
+ 	 	 	 -I../SDK/platform/hal/inc flash_sim_run.c flash_sim.c ../Sources/bootloader.c
+ 	 	 	 -o flash_sim_run
+ 	 	 	 ./flash_sim_run [image size in bytes]
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+#include "flash_sim.h"
+#include "bootloader.h"
+#include "clock_policy.h"
+#include "tick_period.h"
+#include "semphr.h"
+
+/** Defines the size of the header of a data request (Command and address)*/
+#define DATA_HEADER_SIZE					(5U)
+/** Defines the largest request of the tester*/
+#define MAX_REQUEST_SIZE					(DATA_HEADER_SIZE + BL_BLOCK_DATA_SIZE)
+/** Defines the largest script of the tester (Start, the blocks and end)*/
+#define MAX_STEPS							(((BL_APP_END_ADDRESS - BL_APP_START_ADDRESS) / BL_BLOCK_DATA_SIZE) + 2U)
+/** Defines the largest item of the simulated queue*/
+#define MAX_ITEM_SIZE						(32U)
+/** Defines the length of the simulated queue*/
+#define MAX_QUEUE_LENGTH					(4U)
+
+/** Defines the data of a single frame of an ISO-TP message*/
+#define SF_MAX_DATA							(7U)
+/** Defines the data of the first frame of an ISO-TP message*/
+#define FF_DATA								(6U)
+/** Defines the data of a consecutive frame*/
+#define CF_MAX_DATA							(7U)
+/** Defines the largest STmin in milliseconds (ISO 15765-2 encoding)*/
+#define STMIN_MAX_MS						(0x7FU)
+/** Defines the first STmin in hundreds of microseconds*/
+#define STMIN_US_FIRST						(0xF1U)
+/** Defines the last STmin in hundreds of microseconds*/
+#define STMIN_US_LAST						(0xF9U)
+/** Defines the offset of the STmin in hundreds of microseconds*/
+#define STMIN_US_OFFSET						(0xF0U)
+
+/** Defines the bit time of the bus (500 kbit/s), in microseconds*/
+#define BIT_TIME_US							(2U)
+/** Defines the length of a frame with 8 bytes and its worst stuffing, in microseconds*/
+#define FRAME_TIME_US						(135U * BIT_TIME_US)
+/** Defines the time the node takes to answer a frame (The Rx FIFO interruption wakes up the RX thread)*/
+#define NODE_LATENCY_US						(200U)
+/** Defines the time the tester takes to answer a frame (A USB CAN adapter)*/
+#define TESTER_LATENCY_US					(1000U)
+/** Defines the cycles the CRC of the end request takes per byte (Bitwise, 8 iterations)*/
+#define CRC_CYCLES_PER_BYTE					(50U)
+/** Defines the core clock of the RUN level, in MHz*/
+#define CORE_CLOCK_MHZ						(80U)
+
+/** Defines the microseconds of a millisecond*/
+#define US_IN_MS							(1000.0)
+/** Defines the microseconds of a second*/
+#define US_IN_S								(1000000.0)
+/** Defines the bytes of a KB*/
+#define BYTES_IN_KB							(1024.0)
+
+/*********************************************************************************************/
+
+/*!
+ 	 \brief Structure for a request of the tester and the answer it expects.
+ */
+typedef struct
+{
+	uint8_t command;		/*!< Command of the request*/
+	uint32_t address;		/*!< Address of the request*/
+	uint32_t size;			/*!< Size of the image (Start) or of the data (Data)*/
+	BL_status_t expected;	/*!< Status expected in the answer*/
+	uint8_t refuse;			/*!< Set to make the node fail to change its rx buffer*/
+}flash_sim_run_step_t;
+
+/*********************************************************************************************/
+
+/** Image sent to the bootloader*/
+static uint8_t flash_sim_run_image[BL_APP_END_ADDRESS - BL_APP_START_ADDRESS];
+/** Phrase of the older image*/
+static const uint8_t flash_sim_run_old_phrase[FLASH_SIM_PHRASE_SIZE] = { 0 };
+
+/** Simulated time*/
+static uint64_t flash_sim_run_now_us;
+/** Returns to main once the tester has nothing else to send*/
+static jmp_buf flash_sim_run_end;
+
+/** Items of the request queue*/
+static uint8_t flash_sim_run_queue[MAX_QUEUE_LENGTH][MAX_ITEM_SIZE];
+/** Length and item size of the request queue*/
+static uint32_t flash_sim_run_queue_length;
+static uint32_t flash_sim_run_item_size;
+/** Items in the request queue*/
+static uint32_t flash_sim_run_queue_count;
+/** Set when the flash semaphore is given*/
+static uint8_t flash_sim_run_given;
+/** Flash waits that ended by timeout (A lost done callback)*/
+static uint32_t flash_sim_run_timeouts;
+/** RUN level holds of the clock policy not released*/
+static int32_t flash_sim_run_holds;
+
+/** Configuration of the bootloader session*/
+static ISOTP_session_config_t flash_sim_run_session;
+
+/** Script of the tester*/
+static flash_sim_run_step_t flash_sim_run_steps[MAX_STEPS];
+static uint32_t flash_sim_run_step_count;
+/** Step waiting for its answer*/
+static uint32_t flash_sim_run_step;
+/** Request on the bus*/
+static uint8_t flash_sim_run_request[MAX_REQUEST_SIZE];
+static uint16_t flash_sim_run_request_length;
+/** Set while a request is on the bus*/
+static uint8_t flash_sim_run_pending;
+/** Time the last frame of the request is received by the node*/
+static uint64_t flash_sim_run_arrival_us;
+/** Time the request being executed was received*/
+static uint64_t flash_sim_run_received_us;
+
+/** Time of the start request, from its reception to its answer*/
+static uint64_t flash_sim_run_erase_us;
+/** Time of the end request, from its reception to its answer*/
+static uint64_t flash_sim_run_end_us;
+/** Bus time of the data requests*/
+static uint64_t flash_sim_run_transfer_us;
+/** Time the thread programs the data requests, from their answer to the next request*/
+static uint64_t flash_sim_run_program_us;
+/** Time the last data request was answered, 0 if it is not being programmed*/
+static uint64_t flash_sim_run_program_start_us;
+/** Answers that were not the expected ones*/
+static int flash_sim_run_failures;
+
+/*********************************************************************************************/
+
+/** This function returns the bus time of a request, from its first frame to its last one*/
+static uint64_t flash_sim_run_bus_us(uint16_t length)
+{
+	/** Consecutive frames of the request*/
+	uint32_t cfs;
+	/** Flow controls of the request, one after the first frame and one after every block*/
+	uint32_t fcs;
+	/** STmin of the session in microseconds*/
+	uint32_t st_min_us = 0;
+	/** Time of the first frame*/
+	uint64_t time = FRAME_TIME_US;
+
+	if(SF_MAX_DATA >= length)
+	{
+		return time;
+	}
+
+	cfs = (length - FF_DATA + CF_MAX_DATA - 1U) / CF_MAX_DATA;
+	fcs = (0U == flash_sim_run_session.block_size) ? 1U :
+		  (cfs + flash_sim_run_session.block_size - 1U) / flash_sim_run_session.block_size;
+
+	if(STMIN_MAX_MS >= flash_sim_run_session.st_min)
+	{
+		st_min_us = flash_sim_run_session.st_min * (uint32_t)US_IN_MS;
+	}
+
+	else if((STMIN_US_FIRST <= flash_sim_run_session.st_min) && (STMIN_US_LAST >= flash_sim_run_session.st_min))
+	{
+		st_min_us = (flash_sim_run_session.st_min - STMIN_US_OFFSET) * 100U;
+	}
+
+	/** Every flow control is sent by the node and read by the tester*/
+	time += (uint64_t)fcs * (NODE_LATENCY_US + FRAME_TIME_US + TESTER_LATENCY_US);
+
+	/** The first consecutive frame of a block follows the flow control, the rest wait STmin*/
+	time += (uint64_t)cfs * FRAME_TIME_US + (uint64_t)(cfs - fcs) * st_min_us;
+
+	return time;
+}
+
+/** This function writes a big endian field*/
+static void flash_sim_run_put_u32(uint8_t* data, uint32_t value)
+{
+	data[0] = (uint8_t)(value >> 24);
+	data[1] = (uint8_t)(value >> 16);
+	data[2] = (uint8_t)(value >> 8);
+	data[3] = (uint8_t)value;
+}
+
+/** This function puts the request of the next step on the bus, once the tester read the answer at the time*/
+static void flash_sim_run_send_next(uint64_t time)
+{
+	const flash_sim_run_step_t* step;
+	uint64_t bus_us;
+
+	if(flash_sim_run_step >= flash_sim_run_step_count)
+	{
+		return;
+	}
+
+	step = &flash_sim_run_steps[flash_sim_run_step];
+	flash_sim_run_request[0] = step->command;
+
+	switch(step->command)
+	{
+		case BL_CMD_START:
+			flash_sim_run_put_u32(&flash_sim_run_request[1], step->address);
+			flash_sim_run_put_u32(&flash_sim_run_request[5], step->size);
+			flash_sim_run_request_length = 9U;
+		break;
+
+		case BL_CMD_DATA:
+			flash_sim_run_put_u32(&flash_sim_run_request[1], step->address);
+			memcpy(&flash_sim_run_request[DATA_HEADER_SIZE], &flash_sim_run_image[step->address - BL_APP_START_ADDRESS], step->size);
+			flash_sim_run_request_length = (uint16_t)(DATA_HEADER_SIZE + step->size);
+		break;
+
+		default:
+			flash_sim_run_put_u32(&flash_sim_run_request[1], BL_crc32(flash_sim_run_image, step->size));
+			flash_sim_run_request_length = 5U;
+		break;
+	}
+
+	bus_us = flash_sim_run_bus_us(flash_sim_run_request_length);
+
+	if(BL_CMD_DATA == step->command)
+	{
+		flash_sim_run_transfer_us += bus_us;
+	}
+
+	flash_sim_run_arrival_us = time + TESTER_LATENCY_US + bus_us + NODE_LATENCY_US;
+	flash_sim_run_pending = 1;
+}
+
+/** This function writes the request in the rx buffer of the session, as the RX thread once the last frame arrives*/
+static void flash_sim_run_deliver(void)
+{
+	flash_sim_run_pending = 0;
+
+	if(flash_sim_run_request_length > flash_sim_run_session.rx_buffer_size)
+	{
+		flash_sim_run_session.rx_callback(BL_ISOTP_SESSION, flash_sim_run_session.rx_buffer, 0, isotp_buffer_overflow);
+		return;
+	}
+
+	memcpy(flash_sim_run_session.rx_buffer, flash_sim_run_request, flash_sim_run_request_length);
+	flash_sim_run_session.rx_callback(BL_ISOTP_SESSION, flash_sim_run_session.rx_buffer,
+									  flash_sim_run_request_length, isotp_success);
+}
+
+/** This function lets the time run until the time, delivering the requests and ending the flash operations*/
+static void flash_sim_run_advance(uint64_t time)
+{
+	uint64_t step;
+
+	while(flash_sim_run_now_us < time)
+	{
+		step = time - flash_sim_run_now_us;
+
+		if(flash_sim_run_pending && ((flash_sim_run_arrival_us - flash_sim_run_now_us) < step))
+		{
+			step = flash_sim_run_arrival_us - flash_sim_run_now_us;
+		}
+
+		FLASH_SIM_run_us(step);
+		flash_sim_run_now_us += step;
+
+		if(flash_sim_run_pending && (flash_sim_run_now_us >= flash_sim_run_arrival_us))
+		{
+			flash_sim_run_deliver();
+		}
+	}
+}
+
+/** This function converts ticks to the simulated time*/
+static uint64_t flash_sim_run_ticks_to_us(TickType_t ticks)
+{
+	return (uint64_t)(ticks * (US_IN_MS / FIX_PERIOD));
+}
+
+/** This function runs a script on the bootloader, it returns once the tester has nothing else to send*/
+static void flash_sim_run_script(void)
+{
+	flash_sim_run_queue_count = 0;
+	flash_sim_run_given = 0;
+	flash_sim_run_step = 0;
+	flash_sim_run_pending = 0;
+	flash_sim_run_program_start_us = 0;
+	flash_sim_run_now_us = 0;
+
+	if(isotp_success != BL_init(CAN0, FLASH_SIM_get_flash_if()))
+	{
+		printf("FAIL: the session was not opened\n");
+		flash_sim_run_failures ++;
+		return;
+	}
+
+	flash_sim_run_send_next(0);
+
+	if(0 == setjmp(flash_sim_run_end))
+	{
+		BL_thread(NULL);
+	}
+}
+
+/*********************************************************************************************/
+
+/** Kernel calls of the bootloader*/
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size)
+{
+	if((MAX_QUEUE_LENGTH < length) || (MAX_ITEM_SIZE < item_size))
+	{
+		return NULL;
+	}
+
+	flash_sim_run_queue_length = length;
+	flash_sim_run_item_size = item_size;
+
+	return flash_sim_run_queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks)
+{
+	if(flash_sim_run_queue_count >= flash_sim_run_queue_length)
+	{
+		printf("FAIL: the request was dropped, the queue is full\n");
+		flash_sim_run_failures ++;
+		return pdFALSE;
+	}
+
+	memcpy(flash_sim_run_queue[flash_sim_run_queue_count ++], item, flash_sim_run_item_size);
+
+	return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticks)
+{
+	/** The data request answered before is programmed until the thread takes the next one*/
+	if(0 != flash_sim_run_program_start_us)
+	{
+		flash_sim_run_program_us += flash_sim_run_now_us - flash_sim_run_program_start_us;
+		flash_sim_run_program_start_us = 0;
+	}
+
+	if((0 == flash_sim_run_queue_count) && flash_sim_run_pending)
+	{
+		flash_sim_run_advance(flash_sim_run_arrival_us);
+	}
+
+	if(0 == flash_sim_run_queue_count)
+	{
+		longjmp(flash_sim_run_end, 1);
+	}
+
+	memcpy(item, flash_sim_run_queue[0], flash_sim_run_item_size);
+	memmove(flash_sim_run_queue[0], flash_sim_run_queue[1], (-- flash_sim_run_queue_count) * MAX_ITEM_SIZE);
+	flash_sim_run_received_us = flash_sim_run_now_us;
+
+	return pdTRUE;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+	return &flash_sim_run_given;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks)
+{
+	uint64_t deadline = flash_sim_run_now_us + flash_sim_run_ticks_to_us(ticks);
+	uint64_t remaining;
+
+	/** The time runs until the flash ends its operation (Its done callback gives the semaphore) or the timeout*/
+	while((0 == flash_sim_run_given) && (flash_sim_run_now_us < deadline))
+	{
+		remaining = FLASH_SIM_get_remaining_us();
+		flash_sim_run_advance(((0 != remaining) && ((flash_sim_run_now_us + remaining) < deadline)) ?
+							  (flash_sim_run_now_us + remaining) : deadline);
+	}
+
+	if(0 == flash_sim_run_given)
+	{
+		flash_sim_run_timeouts ++;
+		return pdFALSE;
+	}
+
+	flash_sim_run_given = 0;
+
+	return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore, BaseType_t* woken)
+{
+	flash_sim_run_given = 1;
+	*woken = pdTRUE;
+
+	return pdTRUE;
+}
+
+void portYIELD_FROM_ISR(BaseType_t woken)
+{
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+	flash_sim_run_advance(flash_sim_run_now_us + flash_sim_run_ticks_to_us(ticks));
+}
+
+void INT_SYS_DisableIRQGlobal(void)
+{
+}
+
+status_t CLOCK_POLICY_hold(void)
+{
+	flash_sim_run_holds ++;
+
+	return STATUS_SUCCESS;
+}
+
+void CLOCK_POLICY_release(void)
+{
+	flash_sim_run_holds --;
+}
+
+/** ISO-TP calls of the bootloader*/
+ISOTP_status_t ISOTP_open_session(uint8_t session, ISOTP_session_config_t config)
+{
+	flash_sim_run_session = config;
+
+	return isotp_success;
+}
+
+ISOTP_status_t ISOTP_set_rx_buffer(uint8_t session, uint8_t* buffer, uint16_t size)
+{
+	/** The session is still receiving into the old buffer*/
+	if(flash_sim_run_steps[flash_sim_run_step].refuse)
+	{
+		return isotp_busy;
+	}
+
+	flash_sim_run_session.rx_buffer = buffer;
+	flash_sim_run_session.rx_buffer_size = size;
+
+	return isotp_success;
+}
+
+ISOTP_status_t ISOTP_send(uint8_t session, const uint8_t* data, uint16_t length)
+{
+	const flash_sim_run_step_t* step = &flash_sim_run_steps[flash_sim_run_step];
+
+	switch(step->command)
+	{
+		case BL_CMD_START:
+			flash_sim_run_erase_us = flash_sim_run_now_us - flash_sim_run_received_us;
+		break;
+
+		case BL_CMD_DATA:
+			flash_sim_run_program_start_us = flash_sim_run_now_us;
+		break;
+
+		default:
+			/** The CRC of the image is calculated before the answer*/
+			flash_sim_run_advance(flash_sim_run_now_us + (uint64_t)step->size * CRC_CYCLES_PER_BYTE / CORE_CLOCK_MHZ);
+			flash_sim_run_end_us = flash_sim_run_now_us - flash_sim_run_received_us;
+		break;
+	}
+
+	if((2U != length) || ((step->command | BL_RESPONSE_MASK) != data[0]) || (step->expected != data[1]))
+	{
+		printf("FAIL: step %u (0x%02X) answered 0x%02X status %u, expected status %u\n", (unsigned)flash_sim_run_step,
+			   step->command, data[0], data[1], step->expected);
+		flash_sim_run_failures ++;
+	}
+
+	flash_sim_run_step ++;
+	flash_sim_run_send_next(flash_sim_run_now_us + FRAME_TIME_US);
+
+	return isotp_success;
+}
+
+/*********************************************************************************************/
+
+int main(int argc, char** argv)
+{
+	const flash_if_t* flash = FLASH_SIM_get_flash_if();
+	uint32_t image_size = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : sizeof(flash_sim_run_image);
+	uint32_t address;
+	uint32_t offset;
+	uint32_t blocks = 0;
+	uint64_t total_us;
+
+	if((0U == image_size) || (sizeof(flash_sim_run_image) < image_size))
+	{
+		printf("The image must be between 1 and %u bytes\n", (unsigned)sizeof(flash_sim_run_image));
+		return 1;
+	}
+
+	/** The image is a multiple of the phrase, as the bootloader requires*/
+	image_size = (image_size + FLASH_SIM_PHRASE_SIZE - 1U) / FLASH_SIM_PHRASE_SIZE * FLASH_SIM_PHRASE_SIZE;
+
+	srand(1);
+	for(offset = 0 ; offset < image_size ; offset ++)
+	{
+		flash_sim_run_image[offset] = (uint8_t)rand();
+	}
+
+	/** The flash holds an older image (All bits cleared), the phrases fail the verify unless they are erased*/
+	FLASH_SIM_reset();
+	for(address = BL_APP_START_ADDRESS ; address < BL_APP_END_ADDRESS ; address += FLASH_SIM_PHRASE_SIZE)
+	{
+		flash->program_phrase(address, flash_sim_run_old_phrase);
+		FLASH_SIM_run_us(FLASH_SIM_get_remaining_us());
+	}
+
+	/** Update: the start request erases the image, every block is answered and programmed while the next one is received*/
+	flash_sim_run_steps[flash_sim_run_step_count ++] = (flash_sim_run_step_t){ BL_CMD_START, BL_APP_START_ADDRESS, image_size, bl_ok, 0 };
+	for(offset = 0 ; offset < image_size ; offset += BL_BLOCK_DATA_SIZE)
+	{
+		flash_sim_run_steps[flash_sim_run_step_count ++] = (flash_sim_run_step_t){ BL_CMD_DATA, BL_APP_START_ADDRESS + offset,
+			((image_size - offset) < BL_BLOCK_DATA_SIZE) ? (image_size - offset) : BL_BLOCK_DATA_SIZE, bl_ok, 0 };
+		blocks ++;
+	}
+	flash_sim_run_steps[flash_sim_run_step_count ++] = (flash_sim_run_step_t){ BL_CMD_END, BL_APP_START_ADDRESS, image_size, bl_ok, 0 };
+
+	flash_sim_run_script();
+	total_us = flash_sim_run_now_us;
+
+	if(flash_sim_run_step != flash_sim_run_step_count)
+	{
+		printf("FAIL: %u of %u requests were answered\n", (unsigned)flash_sim_run_step, (unsigned)flash_sim_run_step_count);
+		flash_sim_run_failures ++;
+	}
+
+	if(0 != memcmp(flash->read(BL_APP_START_ADDRESS), flash_sim_run_image, image_size))
+	{
+		printf("FAIL: the flash does not hold the image\n");
+		flash_sim_run_failures ++;
+	}
+
+	if(0 != flash_sim_run_holds)
+	{
+		printf("FAIL: the RUN level is still held after the update\n");
+		flash_sim_run_failures ++;
+	}
+
+	printf("Image: %u bytes in %u blocks of %u bytes (BS %u, STmin 0x%02X)\n", (unsigned)image_size, (unsigned)blocks,
+		   BL_BLOCK_DATA_SIZE, flash_sim_run_session.block_size, flash_sim_run_session.st_min);
+	printf("Start (erase): %.1f ms\n", flash_sim_run_erase_us / US_IN_MS);
+	printf("Per block: transfer %.1f ms, programming %.1f ms (%s bound)\n",
+		   flash_sim_run_transfer_us / US_IN_MS / blocks, flash_sim_run_program_us / US_IN_MS / blocks,
+		   (flash_sim_run_transfer_us > flash_sim_run_program_us) ? "bus" : "flash");
+	printf("End (CRC): %.1f ms\n", flash_sim_run_end_us / US_IN_MS);
+	printf("Total: %.2f s, %.2f KB/s\n", total_us / US_IN_S, (image_size / BYTES_IN_KB) / (total_us / US_IN_S));
+
+	/** A block that can not be received in the other buffer aborts the image, the next block is out of sequence*/
+	flash_sim_run_step_count = 0;
+	flash_sim_run_steps[flash_sim_run_step_count ++] = (flash_sim_run_step_t){ BL_CMD_START, BL_APP_START_ADDRESS, FLASH_SIM_SECTOR_SIZE, bl_ok, 0 };
+	flash_sim_run_steps[flash_sim_run_step_count ++] = (flash_sim_run_step_t){ BL_CMD_DATA, BL_APP_START_ADDRESS, BL_BLOCK_DATA_SIZE, bl_transfer_error, 1 };
+	flash_sim_run_steps[flash_sim_run_step_count ++] = (flash_sim_run_step_t){ BL_CMD_DATA, BL_APP_START_ADDRESS, BL_BLOCK_DATA_SIZE, bl_sequence_error, 0 };
+
+	flash_sim_run_script();
+
+	if(flash_sim_run_step != flash_sim_run_step_count)
+	{
+		printf("FAIL: %u of %u requests were answered after the refused buffer\n", (unsigned)flash_sim_run_step, (unsigned)flash_sim_run_step_count);
+		flash_sim_run_failures ++;
+	}
+
+	if(0 != flash_sim_run_holds)
+	{
+		printf("FAIL: the RUN level is still held after the refused buffer\n");
+		flash_sim_run_failures ++;
+	}
+
+	if(0 != flash_sim_run_timeouts)
+	{
+		printf("FAIL: %u flash waits ended by timeout\n", (unsigned)flash_sim_run_timeouts);
+		flash_sim_run_failures ++;
+	}
+
+	printf("%d failures\n", flash_sim_run_failures);
+
+	return (0 == flash_sim_run_failures) ? 0 : 1;
+}
@@ -0,0 +1,420 @@
+/*!
+ 	 \file ftm_shim.c
+
+ 	 \brief This is the source file of the host simulation of the FTMs, the tick and
+ 	 	 	 the interrupts.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include <math.h>
+#include <string.h>
+#include "ftm_shim.h"
+#include "task.h"
+#include "interrupt_manager.h"
+#include "adc_scan.h"
+#include "xcp.h"
+
+/** Defines the range of a 16 bit counter*/
+#define COUNTER_RANGE						(65536.0)
+/** Defines the states of the phases in a cycle of the encoder*/
+#define QUAD_STATES							(4)
+/** Defines the state reached when phase A rises moving forward (A is high on 1 and 2)*/
+#define PHASE_A_RISE_FORWARD				(1)
+/** Defines the state left when phase A rises moving in reverse (From 3 to 2)*/
+#define PHASE_A_RISE_REVERSE				(3)
+
+/*!
+ 	 \brief Enumerator to define the mode of a simulated FTM.
+ */
+typedef enum
+{
+	sim_ftm_none,			/*!< Initialized, not running*/
+	sim_ftm_pwm,			/*!< PWM*/
+	sim_ftm_input_capture,	/*!< Input capture*/
+	sim_ftm_quadrature		/*!< Quadrature decoder*/
+}sim_ftm_mode_t;
+
+/*!
+ 	 \brief Structure for the state of a simulated FTM.
+ */
+typedef struct
+{
+	sim_ftm_mode_t mode;									/*!< Mode of the FTM*/
+	uint16_t pending_CnV[FEATURE_FTM_CHANNEL_COUNT];		/*!< Channel values loaded by the software trigger*/
+	double counter;											/*!< Counter, with the fraction to the next count*/
+	uint16_t measurement[FEATURE_FTM_CHANNEL_COUNT];		/*!< Captures of the channels*/
+	ftm_channel_event_callback_t callback;					/*!< Callback of the input capture channel*/
+	void* callback_param;									/*!< Parameter of the callback*/
+	uint8_t channel;										/*!< Input capture channel*/
+}sim_ftm_t;
+
+/** Overflow handler of FTM 2 (Defined by the speed measurement)*/
+void FTM2_Ovf_Reload_IRQHandler(void);
+
+/** Registers of the FTMs*/
+static FTM_Type sim_registers[FTM_INSTANCE_COUNT];
+/** Pointers to the registers, as the SDK*/
+FTM_Type * const g_ftmBase[FTM_INSTANCE_COUNT] = { &sim_registers[0], &sim_registers[1], &sim_registers[2], &sim_registers[3] };
+/** State of the FTMs*/
+static sim_ftm_t sim_ftm[FTM_INSTANCE_COUNT];
+/** Tick of the kernel*/
+static TickType_t sim_tick;
+/** Encoder position at the end of the last step*/
+static double sim_counts;
+
+/** Configurations of the generated components*/
+ftm_user_config_t flexTimer1_InitConfig = { 0U };
+ftm_user_config_t flexTimer2_InitConfig = { 0U };
+ftm_user_config_t flexTimer3_InitConfig = { 2U };
+ftm_pwm_param_t flexTimer1_PwmConfig = { 20000U };
+ftm_pwm_param_t flexTimer2_PwmConfig = { 20000U };
+
+/*!
+ 	 \brief This function returns the drive of a PWM timer.
+
+ 	 \param[in] instance PWM timer.
+
+ 	 \return Drive from 0 to 1.
+ */
+static double sim_pwm_drive(uint32_t instance);
+
+/*!
+ 	 \brief This function advances the counter of the input capture and generates
+ 	 	 	 its overflows, up to a fraction of the step.
+
+ 	 \param[in] sim FTM of the encoder.
+ 	 \param[in] ticks Counts of the counter to be advanced.
+
+ 	 \return void.
+ */
+static void sim_advance_counter(sim_ftm_t* sim, double ticks);
+
+/** This function clears the simulation*/
+void SIM_shim_reset(void)
+{
+	memset(sim_registers, 0, sizeof(sim_registers));
+	memset(sim_ftm, 0, sizeof(sim_ftm));
+	sim_tick = 0;
+	sim_counts = 0.0;
+}
+
+/** This function returns the drive of the H bridge*/
+double SIM_shim_get_drive(void)
+{
+	return sim_pwm_drive(0U) - sim_pwm_drive(1U);
+}
+
+/** This function moves the encoder over a step*/
+void SIM_shim_encoder(double counts, double dt)
+{
+	sim_ftm_t* sim = &sim_ftm[SIM_ENCODER_INSTANCE];
+	FTM_Type* base = g_ftmBase[SIM_ENCODER_INSTANCE];
+	/** Counts of the step boundaries*/
+	double first = floor(sim_counts);
+	double last = floor(counts);
+	/** Count crossed, and the fraction of the step where it was crossed*/
+	double boundary;
+	double fraction;
+	/** Fraction of the step already advanced*/
+	double advanced = 0.0;
+	/** State of the phases after the boundary*/
+	int state;
+
+	if(sim_ftm_quadrature == sim->mode)
+	{
+		sim->counter = fmod(last, COUNTER_RANGE);
+
+		if(0.0 > sim->counter)
+		{
+			sim->counter += COUNTER_RANGE;
+		}
+	}
+
+	else if(sim_ftm_input_capture == sim->mode)
+	{
+		/** Each count crossed is a change of one phase, only the rises of phase A are captured*/
+		for(boundary = (last > first) ? (first + 1.0) : first; (last > first) ? (boundary <= last) : (boundary > last);
+			boundary += (last > first) ? 1.0 : -1.0)
+		{
+			state = (int)fmod(fmod(boundary, QUAD_STATES) + QUAD_STATES, QUAD_STATES);
+
+			if(((last > first) && (PHASE_A_RISE_FORWARD == state)) || ((last < first) && (PHASE_A_RISE_REVERSE == state)))
+			{
+				fraction = (boundary - sim_counts) / (counts - sim_counts);
+				sim_advance_counter(sim, (fraction - advanced) * dt * (SIM_FTM_CLOCK_HZ >> base->PS));
+				advanced = fraction;
+
+				sim->measurement[sim->channel] = (uint16_t)sim->counter;
+
+				if(NULL != sim->callback)
+				{
+					sim->callback(sim->callback_param);
+				}
+			}
+		}
+
+		/** The rest of the step, with the prescaler set by the callbacks*/
+		sim_advance_counter(sim, (1.0 - advanced) * dt * (SIM_FTM_CLOCK_HZ >> base->PS));
+	}
+
+	sim_counts = counts;
+}
+
+/** This function advances the tick*/
+void SIM_shim_tick(void)
+{
+	sim_tick ++;
+}
+
+/** This function returns the tick*/
+TickType_t SIM_shim_get_tick(void)
+{
+	return sim_tick;
+}
+
+/*********************************************************************************************/
+/* FreeRTOS and interrupt manager */
+
+TickType_t xTaskGetTickCount(void)
+{
+	return sim_tick;
+}
+
+TickType_t xTaskGetTickCountFromISR(void)
+{
+	return sim_tick;
+}
+
+void vTaskDelayUntil(TickType_t* pxPreviousWakeTime, TickType_t xTimeIncrement)
+{
+	/** The threads are not run, the simulation calls the steps*/
+	(void)pxPreviousWakeTime;
+	(void)xTimeIncrement;
+}
+
+void INT_SYS_EnableIRQ(IRQn_Type irqNumber)
+{
+	(void)irqNumber;
+}
+
+void INT_SYS_SetPriority(IRQn_Type irqNumber, uint8_t priority)
+{
+	(void)irqNumber;
+	(void)priority;
+}
+
+/*********************************************************************************************/
+/* ADC scan (The current and the potentiometer are not simulated) */
+
+void ADC_SCAN_sync(uint32_t instance)
+{
+	(void)instance;
+}
+
+/*********************************************************************************************/
+/* XCP (There is no master) */
+
+void XCP_event(uint8_t event)
+{
+	(void)event;
+}
+
+/*********************************************************************************************/
+/* FTM driver */
+
+status_t FTM_DRV_Init(uint32_t instance, const ftm_user_config_t * info, void * state)
+{
+	(void)state;
+	memset(&sim_ftm[instance], 0, sizeof(sim_ftm_t));
+	memset(g_ftmBase[instance], 0, sizeof(FTM_Type));
+	g_ftmBase[instance]->PS = info->ftmPrescaler;
+
+	return STATUS_SUCCESS;
+}
+
+status_t FTM_DRV_InitPwm(uint32_t instance, const ftm_pwm_param_t * param)
+{
+	(void)param;
+	sim_ftm[instance].mode = sim_ftm_pwm;
+	g_ftmBase[instance]->MOD = SIM_PWM_MOD;
+
+	return STATUS_SUCCESS;
+}
+
+status_t FTM_DRV_DeinitPwm(uint32_t instance)
+{
+	sim_ftm[instance].mode = sim_ftm_none;
+	memset(g_ftmBase[instance]->CnV, 0, sizeof(g_ftmBase[instance]->CnV));
+
+	return STATUS_SUCCESS;
+}
+
+status_t FTM_DRV_UpdatePwmChannel(uint32_t instance, uint8_t channel, ftm_pwm_update_option_t typeOfUpdate,
+								  uint16_t firstEdge, uint16_t secondEdge, bool softwareTrigger)
+{
+	FTM_Type* base = g_ftmBase[instance];
+
+	(void)secondEdge;
+	sim_ftm[instance].pending_CnV[channel] = (FTM_PWM_UPDATE_IN_DUTY_CYCLE == typeOfUpdate) ?
+											 (uint16_t)(((uint32_t)base->MOD * firstEdge) >> 15) : firstEdge;
+
+	/** As the SDK, the 100% exceeds the modulo*/
+	if((FTM_PWM_UPDATE_IN_DUTY_CYCLE == typeOfUpdate) && (FTM_MAX_DUTY_CYCLE == firstEdge))
+	{
+		sim_ftm[instance].pending_CnV[channel] ++;
+	}
+	FTM_HAL_SetSoftwareTriggerCmd(base, softwareTrigger);
+
+	return STATUS_SUCCESS;
+}
+
+status_t FTM_DRV_SetSync(uint32_t instance, const ftm_pwm_sync_t * param)
+{
+	(void)instance;
+	(void)param;
+
+	return STATUS_SUCCESS;
+}
+
+status_t FTM_DRV_InitInputCapture(uint32_t instance, const ftm_input_param_t * param)
+{
+	sim_ftm_t* sim = &sim_ftm[instance];
+
+	sim->mode = sim_ftm_input_capture;
+	sim->channel = param->inputChConfig[0].hwChannelId;
+	sim->callback = param->inputChConfig[0].channelsCallbacks;
+	sim->callback_param = param->inputChConfig[0].channelsCallbacksParams;
+	g_ftmBase[instance]->MOD = param->nMaxCountValue;
+
+	return STATUS_SUCCESS;
+}
+
+uint16_t FTM_DRV_GetInputCaptureMeasurement(uint32_t instance, uint8_t channel)
+{
+	return sim_ftm[instance].measurement[channel];
+}
+
+uint32_t FTM_DRV_GetFrequency(uint32_t instance)
+{
+	return SIM_FTM_CLOCK_HZ >> g_ftmBase[instance]->PS;
+}
+
+status_t FTM_DRV_QuadDecodeStart(uint32_t instance, const ftm_quad_decode_config_t * config)
+{
+	sim_ftm[instance].mode = sim_ftm_quadrature;
+	sim_ftm[instance].counter = config->initialVal;
+	g_ftmBase[instance]->MOD = config->maxVal;
+
+	return STATUS_SUCCESS;
+}
+
+/*********************************************************************************************/
+/* FTM HAL */
+
+uint16_t FTM_HAL_GetMod(const FTM_Type * ftmBase)
+{
+	return ftmBase->MOD;
+}
+
+void FTM_HAL_SetChnCountVal(FTM_Type * ftmBase, uint8_t channel, uint16_t value)
+{
+	sim_ftm[ftmBase - sim_registers].pending_CnV[channel] = value;
+}
+
+void FTM_HAL_SetSoftwareTriggerCmd(FTM_Type * ftmBase, bool enable)
+{
+	/** The loading point is a PWM period, much shorter than a step of the simulation*/
+	if(enable)
+	{
+		memcpy(ftmBase->CnV, sim_ftm[ftmBase - sim_registers].pending_CnV, sizeof(ftmBase->CnV));
+	}
+}
+
+uint16_t FTM_HAL_GetCounter(const FTM_Type * ftmBase)
+{
+	return (uint16_t)sim_ftm[ftmBase - sim_registers].counter;
+}
+
+uint8_t FTM_HAL_GetClockPs(const FTM_Type * ftmBase)
+{
+	return ftmBase->PS;
+}
+
+void FTM_HAL_SetClockPs(FTM_Type * ftmBase, ftm_clock_ps_t ps)
+{
+	ftmBase->PS = ps;
+}
+
+ftm_clock_source_t FTM_HAL_GetClockSource(const FTM_Type * ftmBase)
+{
+	return (ftm_clock_source_t)ftmBase->CLKS;
+}
+
+void FTM_HAL_SetClockSource(FTM_Type * ftmBase, ftm_clock_source_t clock)
+{
+	ftmBase->CLKS = (uint8_t)clock;
+}
+
+bool FTM_HAL_HasTimerOverflowed(const FTM_Type * ftmBase)
+{
+	return ftmBase->TOF;
+}
+
+void FTM_HAL_ClearTimerOverflow(FTM_Type * ftmBase)
+{
+	ftmBase->TOF = false;
+}
+
+void FTM_HAL_SetTimerOverflowInt(FTM_Type * ftmBase, bool state)
+{
+	ftmBase->TOIE = state;
+}
+
+/*********************************************************************************************/
+
+/** This function returns the drive of a PWM timer*/
+static double sim_pwm_drive(uint32_t instance)
+{
+	FTM_Type* base = g_ftmBase[instance];
+	/** Drive of the timer (Stopped is 0)*/
+	double drive = 0.0;
+
+	if((sim_ftm_pwm == sim_ftm[instance].mode) && (0U != base->MOD))
+	{
+		/** The duty cycle is inverted, a CnV of 0 is the full drive*/
+		drive = 1.0 - ((double)base->CnV[0] / base->MOD);
+
+		if(0.0 > drive)
+		{
+			drive = 0.0;
+		}
+	}
+
+	return drive;
+}
+
+/** This function advances the counter of the input capture*/
+static void sim_advance_counter(sim_ftm_t* sim, double ticks)
+{
+	FTM_Type* base = g_ftmBase[SIM_ENCODER_INSTANCE];
+
+	sim->counter += ticks;
+
+	/** Every overflow interrupts on its own (There is at most one per step)*/
+	while(COUNTER_RANGE <= sim->counter)
+	{
+		sim->counter -= COUNTER_RANGE;
+		base->TOF = true;
+
+		if(base->TOIE)
+		{
+			FTM2_Ovf_Reload_IRQHandler();
+		}
+	}
+}
@@ -0,0 +1,76 @@
+/*!
+ 	 \file ftm_shim.h
+
+ 	 \brief This is the header file of the host simulation of the FTMs, the tick and
+ 	 	 	 the interrupts. The motor control modules run unchanged on top of it:
+ 	 	 	 the PWM timers give the drive of the motor, and the encoder timer
+ 	 	 	 gets the edges of the motor model as captures or quadrature counts.
+
+ 	 \note The interrupts (Edge callback and counter overflow) run at the exact time
+ 	 	 	 of their event, in time order, without latency.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef FTM_SHIM_H_
+#define FTM_SHIM_H_
+
+#include "ftm_driver.h"
+#include "FreeRTOS.h"
+
+/** Defines the clock of the FTMs before the prescaler, in Hz*/
+#define SIM_FTM_CLOCK_HZ					(8000000U)
+/** Defines the modulo of the PWM timers*/
+#define SIM_PWM_MOD							(2000U)
+/** Defines the FTM of the encoder*/
+#define SIM_ENCODER_INSTANCE				(2U)
+
+/*!
+ 	 \brief This function clears all the FTMs, the tick and the encoder position.
+
+ 	 \return void.
+ */
+void SIM_shim_reset(void);
+
+/*!
+ 	 \brief This function returns the drive of the H bridge from the PWM timers
+ 	 	 	 (FTM 0 is forward and FTM 1 is reverse, the duty cycle is inverted).
+
+ 	 \return Fraction of the supply applied, negative is reverse and 0 is open.
+ */
+double SIM_shim_get_drive(void);
+
+/*!
+ 	 \brief This function moves the encoder over a step. The edges and overflows
+ 	 	 	 of the step are generated for the input capture, or the counter is
+ 	 	 	 updated for the quadrature decoder.
+
+ 	 \note The encoder can move less than a count per step (Linear interpolation).
+
+ 	 \param[in] counts Position of the encoder at the end of the step.
+ 	 \param[in] dt Step, in seconds.
+
+ 	 \return void.
+ */
+void SIM_shim_encoder(double counts, double dt);
+
+/*!
+ 	 \brief This function advances the tick of the kernel.
+
+ 	 \return void.
+ */
+void SIM_shim_tick(void);
+
+/*!
+ 	 \brief This function returns the tick of the kernel.
+
+ 	 \return Ticks since the reset.
+ */
+TickType_t SIM_shim_get_tick(void);
+
+#endif /* FTM_SHIM_H_ */
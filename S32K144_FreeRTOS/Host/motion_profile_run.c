@@ -0,0 +1,181 @@
+/*!
+ 	 \file motion_profile_run.c
+
+ 	 \brief This is the host check of the motion profile. It runs random profiles
+ 	 	 	 (Limits, start and target, and a second target in the middle of some
+ 	 	 	 of them) and checks that every one moves towards its target without
+ 	 	 	 going back, keeps the acceleration and jerk limits, and ends exactly
+ 	 	 	 on the target.
+
+ 	 \note Build and run it with the host compiler:
+ 	 	 	 gcc -std=c99 -O2 -I../Sources motion_profile_run.c ../Sources/motion_profile.c -o motion_profile_run
+ 	 	 	 ./motion_profile_run [profiles] [seed]
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "motion_profile.h"
+
+/** Defines the default number of profiles*/
+#define DEFAULT_PROFILES					(20000)
+/** Defines the full scale of a speed in Q15 (Same as MC_SPEED_Q15_MAX)*/
+#define SPEED_Q15_MAX						(32767)
+/** Defines the lowest acceleration limit, as a power of 2*/
+#define ACCEL_MIN_BITS						(14)
+/** Defines the highest acceleration limit, as a power of 2*/
+#define ACCEL_MAX_BITS						(24)
+/** Defines the updates after the target for the profile to be settled*/
+#define SETTLE_UPDATES						(3)
+/** Defines the failures printed before the summary*/
+#define FAILURES_PRINTED					(10)
+
+/*********************************************************************************************/
+
+/** This function returns a random number between 0 and max*/
+static uint32_t motion_profile_run_random(uint32_t max)
+{
+	uint32_t value = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+
+	return value % (max + 1U);
+}
+
+/** This function returns a random speed in Q15*/
+static int16_t motion_profile_run_speed(void)
+{
+	return (int16_t)((int32_t)motion_profile_run_random(2U * SPEED_Q15_MAX) - SPEED_Q15_MAX);
+}
+
+/** This function returns the updates a profile may take to move between two speeds*/
+static uint32_t motion_profile_run_budget(const MOTION_PROFILE_config_t* config, int32_t from, int32_t to)
+{
+	int64_t distance = ((int64_t)((from > to) ? (from - to) : (to - from)) + 1) << MOTION_PROFILE_FRAC_BITS;
+	int32_t jerk = ((0 >= config->jerk_max) || (config->accel_max < config->jerk_max)) ? config->accel_max : config->jerk_max;
+
+	/** Cruise at the limit plus the ramps of the acceleration, twice over for the braking*/
+	return (uint32_t)((2 * distance / config->accel_max) + (4 * (config->accel_max / jerk)) + 16);
+}
+
+/** This function runs a profile to a target and checks it, it returns 1 if it fails*/
+static int motion_profile_run_leg(MOTION_PROFILE_t* profile, int16_t target, uint32_t updates, int check_monotonic)
+{
+	int16_t start = MOTION_PROFILE_update(profile);
+	int16_t previous = start;
+	int32_t previous_accel = profile->accel;
+	int32_t jerk = ((0 >= profile->config.jerk_max) || (profile->config.accel_max < profile->config.jerk_max)) ?
+				   profile->config.accel_max : profile->config.jerk_max;
+	int32_t step_max = (profile->config.accel_max >> MOTION_PROFILE_FRAC_BITS) + 1;
+	uint32_t counter;
+	uint32_t settled = 0;
+	int16_t speed;
+
+	MOTION_PROFILE_set_target(profile, target);
+
+	for(counter = 0 ; counter < updates ; counter ++)
+	{
+		speed = MOTION_PROFILE_update(profile);
+
+		if(check_monotonic && (((target >= start) && (speed < previous)) || ((target <= start) && (speed > previous))))
+		{
+			return 1;
+		}
+
+		if(((speed > previous) ? (speed - previous) : (previous - speed)) > step_max)
+		{
+			return 1;
+		}
+
+		if((profile->accel > profile->config.accel_max) || (profile->accel < -profile->config.accel_max))
+		{
+			return 1;
+		}
+
+		if(((profile->accel > previous_accel) ? (profile->accel - previous_accel) : (previous_accel - profile->accel)) > jerk)
+		{
+			return 1;
+		}
+
+		/** Settled: exactly on the target, without acceleration, for some updates*/
+		settled = ((((int32_t)target << MOTION_PROFILE_FRAC_BITS) == profile->speed) && (0 == profile->accel)) ? (settled + 1U) : 0U;
+		if(SETTLE_UPDATES <= settled)
+		{
+			return (speed == target) ? 0 : 1;
+		}
+
+		previous = speed;
+		previous_accel = profile->accel;
+	}
+
+	return 1;
+}
+
+/*********************************************************************************************/
+
+int main(int argc, char** argv)
+{
+	int profiles = (argc > 1) ? atoi(argv[1]) : DEFAULT_PROFILES;
+	unsigned seed = (argc > 2) ? (unsigned)strtoul(argv[2], NULL, 0) : 1U;
+	MOTION_PROFILE_config_t config;
+	MOTION_PROFILE_t profile;
+	int16_t start;
+	int16_t target;
+	int16_t second;
+	uint32_t half;
+	uint32_t counter;
+	int counter_profiles;
+	int failures = 0;
+	int changes = 0;
+
+	srand(seed);
+
+	for(counter_profiles = 0 ; counter_profiles < profiles ; counter_profiles ++)
+	{
+		/** Limits spread over the decades, a quarter of them without jerk limit (Trapezoid)*/
+		config.accel_max = (int32_t)(1U << (ACCEL_MIN_BITS + motion_profile_run_random(ACCEL_MAX_BITS - ACCEL_MIN_BITS)));
+		config.accel_max += (int32_t)motion_profile_run_random((uint32_t)config.accel_max - 1U);
+		config.jerk_max = (0U == motion_profile_run_random(3U)) ? 0 : (int32_t)(1U + motion_profile_run_random((uint32_t)config.accel_max - 1U));
+
+		start = motion_profile_run_speed();
+		target = motion_profile_run_speed();
+
+		MOTION_PROFILE_init(&profile, &config);
+		MOTION_PROFILE_reset(&profile, start);
+
+		/** A third of the profiles change the target in the middle*/
+		if(0U == motion_profile_run_random(2U))
+		{
+			second = motion_profile_run_speed();
+			half = motion_profile_run_budget(&config, start, target) / 4U;
+			MOTION_PROFILE_set_target(&profile, target);
+
+			for(counter = 0 ; counter < half ; counter ++)
+			{
+				MOTION_PROFILE_update(&profile);
+			}
+
+			changes ++;
+			target = second;
+			start = MOTION_PROFILE_update(&profile);
+		}
+
+		if(0 != motion_profile_run_leg(&profile, target, motion_profile_run_budget(&config, start, target) * 2U, (0 == profile.accel)))
+		{
+			if(FAILURES_PRINTED > failures)
+			{
+				printf("FAIL: accel %ld, jerk %ld, from %d to %d\n", (long)config.accel_max, (long)config.jerk_max, start, target);
+			}
+			failures ++;
+		}
+	}
+
+	printf("%d profiles (%d with a new target in the middle), seed %u\n", profiles, changes, seed);
+	printf("%d failures\n", failures);
+
+	return (0 == failures) ? 0 : 1;
+}
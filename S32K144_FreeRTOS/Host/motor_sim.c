@@ -0,0 +1,125 @@
+/*!
+ 	 \file motor_sim.c
+
+ 	 \brief This is the source file of the host model of the motor.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include <math.h>
+#include "motor_sim.h"
+
+/** Defines the supply of the datasheet, in V*/
+#define DATASHEET_SUPPLY_V					(12.0)
+/** Defines the stall current of the datasheet, in A*/
+#define DATASHEET_STALL_A					(5.5)
+/** Defines the free run current of the datasheet, in A*/
+#define DATASHEET_FREE_A					(0.2)
+/** Defines the free run speed of the output shaft of the datasheet, in RPM*/
+#define DATASHEET_FREE_RPM					(150.0)
+/** Defines the gear ratio of the datasheet*/
+#define DATASHEET_GEAR_RATIO				(70.0)
+/** Defines the counts of the encoder per turn of the motor*/
+#define DATASHEET_CPR						(64.0)
+
+/** Defines pi*/
+#define PI									(3.14159265358979323846)
+/** Defines the radians per second of 1 RPM*/
+#define RAD_S_PER_RPM						(2.0 * PI / 60.0)
+
+/** This function sets the default parameters*/
+void MOTOR_SIM_default_params(MOTOR_SIM_params_t* params)
+{
+	/** Speed of the motor shaft at free run*/
+	double free_speed = DATASHEET_FREE_RPM * DATASHEET_GEAR_RATIO * RAD_S_PER_RPM;
+	/** Friction torque at free run (Half viscous, half coulomb)*/
+	double free_torque;
+
+	params->supply_v = DATASHEET_SUPPLY_V;
+	params->resistance = DATASHEET_SUPPLY_V / DATASHEET_STALL_A;
+	params->inductance = 1.8e-3;
+	params->ke = (DATASHEET_SUPPLY_V - (DATASHEET_FREE_A * params->resistance)) / free_speed;
+
+	free_torque = params->ke * DATASHEET_FREE_A;
+	params->coulomb = free_torque / 2.0;
+	params->viscous = (free_torque / 2.0) / free_speed;
+
+	/** The rotor, the mechanical time constant is about 50 ms*/
+	params->inertia = 2.5e-6;
+	params->gear_ratio = DATASHEET_GEAR_RATIO;
+	params->gear_efficiency = 0.6;
+	params->encoder_cpr = DATASHEET_CPR;
+}
+
+/** This function initializes a motor*/
+void MOTOR_SIM_init(MOTOR_SIM_t* motor, const MOTOR_SIM_params_t* params)
+{
+	motor->params = *params;
+	motor->current = 0.0;
+	motor->speed = 0.0;
+	motor->angle = 0.0;
+	motor->load_torque = 0.0;
+}
+
+/** This function integrates the motor over a step*/
+void MOTOR_SIM_step(MOTOR_SIM_t* motor, double drive, double dt)
+{
+	const MOTOR_SIM_params_t* p = &motor->params;
+	/** Current at the end of the step if the speed did not change*/
+	double steady_current;
+	/** Torque of the motor and the load on the motor shaft*/
+	double torque;
+	/** Speed at the end of the step*/
+	double speed;
+
+	if(0.0 == drive)
+	{
+		/** Open bridge, the current decays through the diodes in much less than a step*/
+		motor->current = 0.0;
+	}
+
+	else
+	{
+		/** Exact solution of L di/dt = V - R i - Ke w, with w constant over the step*/
+		steady_current = ((drive * p->supply_v) - (p->ke * motor->speed)) / p->resistance;
+		motor->current = steady_current + ((motor->current - steady_current) * exp(-p->resistance * dt / p->inductance));
+	}
+
+	/** The load is reflected to the motor shaft through the gearbox*/
+	torque = (p->ke * motor->current) - (motor->load_torque / (p->gear_ratio * p->gear_efficiency));
+
+	/** Stopped and the torque does not overcome the static friction*/
+	if((0.0 == motor->speed) && (fabs(torque) <= p->coulomb))
+	{
+		return;
+	}
+
+	torque -= (p->viscous * motor->speed) + ((0.0 < motor->speed) ? p->coulomb : (0.0 > motor->speed) ? -p->coulomb : copysign(p->coulomb, torque));
+	speed = motor->speed + ((torque / p->inertia) * dt);
+
+	/** The friction stops the motor, it does not reverse it*/
+	if(((0.0 < motor->speed) && (0.0 > speed)) || ((0.0 > motor->speed) && (0.0 < speed)))
+	{
+		speed = 0.0;
+	}
+
+	motor->angle += (motor->speed + speed) * 0.5 * dt;
+	motor->speed = speed;
+}
+
+/** This function returns the speed of the output shaft*/
+double MOTOR_SIM_output_rpm(const MOTOR_SIM_t* motor)
+{
+	return motor->speed / (motor->params.gear_ratio * RAD_S_PER_RPM);
+}
+
+/** This function returns the position of the encoder*/
+double MOTOR_SIM_encoder_counts(const MOTOR_SIM_t* motor)
+{
+	return motor->angle * motor->params.encoder_cpr / (2.0 * PI);
+}
@@ -0,0 +1,103 @@
+/*!
+ 	 \file motor_sim.h
+
+ 	 \brief This is the header file of the host model of the 70:1 37Dx70L[mm] motor
+ 	 	 	 with its 64 CPR encoder. It integrates the electrical (armature) and
+ 	 	 	 mechanical (rotor, friction, gearbox and load) dynamics, and gives the
+ 	 	 	 position of the encoder on the motor shaft.
+
+ 	 \note The default parameters are derived from the free run (150 RPM, 0.2 A) and
+ 	 	 	 stall (5.5 A) points of the datasheet at 12 V, so they are approximate.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef MOTOR_SIM_H_
+#define MOTOR_SIM_H_
+
+/*!
+ 	 \brief Structure for the parameters of the motor.
+ */
+typedef struct
+{
+	double supply_v;		/*!< Supply of the H bridge, in V*/
+	double resistance;		/*!< Armature resistance, in ohm*/
+	double inductance;		/*!< Armature inductance, in H*/
+	double ke;				/*!< Back EMF (And torque) constant, in V*s/rad*/
+	double inertia;			/*!< Inertia on the motor shaft, in kg*m^2*/
+	double viscous;			/*!< Viscous friction on the motor shaft, in N*m*s/rad*/
+	double coulomb;			/*!< Coulomb friction on the motor shaft, in N*m*/
+	double gear_ratio;		/*!< Turns of the motor per turn of the output shaft*/
+	double gear_efficiency;	/*!< Efficiency of the gearbox*/
+	double encoder_cpr;		/*!< Counts of the encoder per turn of the motor (Four edges)*/
+}MOTOR_SIM_params_t;
+
+/*!
+ 	 \brief Structure for the state of the motor.
+ */
+typedef struct
+{
+	MOTOR_SIM_params_t params;	/*!< Parameters of the motor*/
+	double current;				/*!< Armature current, in A*/
+	double speed;				/*!< Speed of the motor shaft, in rad/s*/
+	double angle;				/*!< Angle of the motor shaft, in rad*/
+	double load_torque;			/*!< Load on the output shaft, in N*m (Positive opposes the forward direction)*/
+}MOTOR_SIM_t;
+
+/*!
+ 	 \brief This function sets the default parameters of the motor.
+
+ 	 \param[out] params Parameters to be set.
+
+ 	 \return void.
+ */
+void MOTOR_SIM_default_params(MOTOR_SIM_params_t* params);
+
+/*!
+ 	 \brief This function initializes a motor stopped and without load.
+
+ 	 \param[out] motor Motor to be initialized.
+ 	 \param[in] params Parameters of the motor.
+
+ 	 \return void.
+ */
+void MOTOR_SIM_init(MOTOR_SIM_t* motor, const MOTOR_SIM_params_t* params);
+
+/*!
+ 	 \brief This function integrates the motor over a step.
+
+ 	 \note The PWM is modeled by its average voltage, so the step must be much
+ 	 	 	 shorter than the electrical time constant (L/R is about 0.8 ms).
+
+ 	 \param[in,out] motor Motor to be integrated.
+ 	 \param[in] drive Fraction of the supply applied (Negative is reverse, 0 leaves the bridge open).
+ 	 \param[in] dt Step, in seconds.
+
+ 	 \return void.
+ */
+void MOTOR_SIM_step(MOTOR_SIM_t* motor, double drive, double dt);
+
+/*!
+ 	 \brief This function returns the speed of the output shaft.
+
+ 	 \param[in] motor Motor to be read.
+
+ 	 \return Speed in RPM (Negative is reverse).
+ */
+double MOTOR_SIM_output_rpm(const MOTOR_SIM_t* motor);
+
+/*!
+ 	 \brief This function returns the position of the encoder.
+
+ 	 \param[in] motor Motor to be read.
+
+ 	 \return Position in counts, with the fraction to the next count.
+ */
+double MOTOR_SIM_encoder_counts(const MOTOR_SIM_t* motor);
+
+#endif /* MOTOR_SIM_H_ */
@@ -0,0 +1,412 @@
+/*!
+ 	 \file motor_sim_run.c
+
+ 	 \brief This is a host simulation of the motor control in closed loop. The motor
+ 	 	 	 control, the speed measurement (input capture or quadrature decoder),
+ 	 	 	 and the control loop (Motion profile and speed PID) run unchanged over
+ 	 	 	 the FTM shim, and drive the model of the motor, the gearbox and the encoder.
+
+ 	 	 	 First the measurement is checked against the true speed over an open
+ 	 	 	 loop sweep, then random scenarios (target, direction, load step and
+ 	 	 	 motor parameters) are run in closed loop. The exit code is not zero if
+ 	 	 	 any check fails, so it can be run by the CI.
+
+ 	 \note Build and run it with the host compiler (MC_FEEDBACK_MODE=0 for the input capture):
+ 	 	 	 gcc -std=c99 -O2 -DHOST_SIM -DMC_FEEDBACK_MODE=1 -Isim_shim -I../Sources motor_sim_run.c
+ 	 	 	 	 motor_sim.c ftm_shim.c ../Sources/motor_control.c ../Sources/speed_meas.c
+ 	 	 	 	 ../Sources/quad_encoder.c ../Sources/speed_control.c ../Sources/speed_pid.c
+ 	 	 	 	 ../Sources/motion_profile.c -lm -o motor_sim_run
+ 	 	 	 ./motor_sim_run [scenarios] [seed]
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "motor_sim.h"
+#include "ftm_shim.h"
+#include "motor_control.h"
+#include "speed_control.h"
+#include "xcp.h"
+
+/** Defines the steps of the motor per tick (10 us)*/
+#define SUBSTEPS_PER_TICK					(100)
+/** Defines the duration of a tick, in seconds (The tick runs at 1667 Hz, FIX_PERIOD ticks per ms)*/
+#define TICK_S								(6.0 / 10002.5)
+/** Defines the default number of closed loop scenarios*/
+#define DEFAULT_SCENARIOS					(200)
+
+/** Defines the lowest speed of the sweep, in RPM*/
+#define SWEEP_MIN_RPM						(20)
+/** Defines the highest speed of the sweep, in RPM*/
+#define SWEEP_MAX_RPM						(150)
+/** Defines the increment of the sweep, in RPM*/
+#define SWEEP_STEP_RPM						(10)
+/** Defines the number of speeds of the sweep*/
+#define SWEEP_SPEEDS						(((SWEEP_MAX_RPM - SWEEP_MIN_RPM) / SWEEP_STEP_RPM) + 1)
+/** Defines the period of the reads of the sweep, as the CAN periodic message, in ticks*/
+#define SWEEP_READ_TICKS					(50)
+/** Defines the time to reach the steady state in the sweep, in ticks*/
+#define SWEEP_SETTLE_TICKS					(1500)
+/** Defines the reads checked at the end of every speed of the sweep*/
+#define SWEEP_READS							(10)
+/** Defines the allowed error of the measured RPM (The RPM is an integer)*/
+#define SWEEP_TOLERANCE_RPM					(1.5)
+
+/** Defines the duration of a scenario, in ticks*/
+#define SCENARIO_TICKS						(3000)
+/** Defines the tick of the load step*/
+#define LOAD_STEP_TICK						(1500)
+/** Defines the window at the end of each half where the steady state error is measured, in ticks*/
+#define STEADY_TICKS						(300)
+/** Defines the lowest target, in RPM*/
+#define TARGET_MIN_RPM						(20.0)
+/** Defines the highest target, in RPM*/
+#define TARGET_MAX_RPM						(100.0)
+/** Defines the highest load, as a fraction of the stall torque*/
+#define LOAD_MAX							(0.15)
+/** Defines the variation of the motor parameters*/
+#define PARAM_JITTER						(0.2)
+/** Defines the margin of the target to the speed at full drive with the load after the step*/
+#define TARGET_MARGIN						(0.85)
+/** Defines the radians per second of 1 RPM*/
+#define RAD_S_PER_RPM						(2.0 * 3.14159265358979323846 / 60.0)
+/** Defines the band of the settling time, as a fraction of the target*/
+#define SETTLE_BAND							(0.05)
+/** Defines the allowed steady state error, as a fraction of the target*/
+#define STEADY_TOLERANCE					(0.02)
+/** Defines the allowed steady state error on top of the fraction, in RPM*/
+#define STEADY_TOLERANCE_RPM				(0.5)
+
+/*!
+ 	 \brief Structure for the results of a closed loop scenario.
+ */
+typedef struct
+{
+	double steady_error;	/*!< Worst steady state error, in RPM*/
+	double settle_time;		/*!< Time to stay in the band after the start, in seconds*/
+	double overshoot;		/*!< Overshoot after the start, as a fraction of the target*/
+}scenario_result_t;
+
+/** Hardware of the motor, as main*/
+static const MC_config_t sim_mc_config =
+{
+	INST_FLEXTIMER1,
+	&flexTimer1_PwmConfig,
+	INST_FLEXTIMER2,
+	&flexTimer2_PwmConfig,
+	PWM_CHANNEL,
+	INST_FLEXTIMER3,
+	IC_CHANNEL,
+	false
+};
+/** Model of the motor*/
+static MOTOR_SIM_t sim_motor;
+/** Motor control of the simulation*/
+static MC_motor_t sim_mc;
+/** Control loop of the simulation*/
+static SPEED_CTRL_t sim_ctrl;
+
+/*!
+ 	 \brief This function returns a uniform random number.
+
+ 	 \param[in] low Lowest value.
+ 	 \param[in] high Highest value.
+
+ 	 \return Random number.
+ */
+static double sim_random(double low, double high)
+{
+	return low + ((high - low) * rand()) / RAND_MAX;
+}
+
+/*!
+ 	 \brief This function starts the motor and the FTMs as main does.
+
+ 	 \param[in] params Parameters of the motor.
+
+ 	 \return void.
+ */
+static void sim_start(const MOTOR_SIM_params_t* params)
+{
+	/** Stops the PWM of the last run, the motor control keeps its state*/
+	MC_set_drive(&sim_mc, 0);
+
+	SIM_shim_reset();
+	MOTOR_SIM_init(&sim_motor, params);
+
+	FTM_DRV_Init(INST_FLEXTIMER1, &flexTimer1_InitConfig, NULL);
+	FTM_DRV_Init(INST_FLEXTIMER2, &flexTimer2_InitConfig, NULL);
+	FTM_DRV_Init(INST_FLEXTIMER3, &flexTimer3_InitConfig, NULL);
+
+	MC_init(&sim_mc, &sim_mc_config);
+	SPEED_CTRL_init(&sim_ctrl, &sim_mc, XCP_EVENT_CONTROL_LOOP, NULL);
+}
+
+/*!
+ 	 \brief This function runs the motor and the encoder for a tick.
+
+ 	 \return void.
+ */
+static void sim_tick(void)
+{
+	int counter;
+
+	for(counter = 0 ; counter < SUBSTEPS_PER_TICK ; counter ++)
+	{
+		MOTOR_SIM_step(&sim_motor, SIM_shim_get_drive(), TICK_S / SUBSTEPS_PER_TICK);
+		SIM_shim_encoder(MOTOR_SIM_encoder_counts(&sim_motor), TICK_S / SUBSTEPS_PER_TICK);
+	}
+
+	SIM_shim_tick();
+}
+
+/*!
+ 	 \brief This function checks the measured speed against the true speed in open loop.
+
+ 	 \return Number of failed checks.
+ */
+static int sim_sweep(void)
+{
+	MOTOR_SIM_params_t params;
+	motor_speed_t command;
+	motor_speed_t measured;
+	/** Signed measured and true speeds*/
+	double measured_rpm;
+	double true_rpm;
+	double worst = 0;
+	int failures = 0;
+	int direction;
+	int rpm;
+	int tick;
+
+	MOTOR_SIM_default_params(&params);
+
+	/** The input capture cannot measure the direction, so only the quadrature decoder is swept in reverse*/
+	for(direction = 0 ; direction < (MC_FEEDBACK_MODE ? 2 : 1) ; direction ++)
+	{
+		for(rpm = SWEEP_MIN_RPM ; rpm <= SWEEP_MAX_RPM ; rpm += SWEEP_STEP_RPM)
+		{
+			sim_start(&params);
+			command.RPM = (uint8_t)rpm;
+			command.direction = direction ? motor_reverse : motor_forward;
+			MC_update_duty_cycle(&sim_mc, command);
+
+			for(tick = 1 ; tick <= SWEEP_SETTLE_TICKS + (SWEEP_READS * SWEEP_READ_TICKS) ; tick ++)
+			{
+				sim_tick();
+
+				if(0 != (tick % SWEEP_READ_TICKS))
+				{
+					continue;
+				}
+
+				MC_get_RPM(&sim_mc, &measured);
+
+				if(SWEEP_SETTLE_TICKS >= tick)
+				{
+					continue;
+				}
+
+				measured_rpm = (motor_reverse == measured.direction) ? -(double)measured.RPM : (double)measured.RPM;
+				true_rpm = MOTOR_SIM_output_rpm(&sim_motor);
+
+				if(fabs(measured_rpm - true_rpm) > worst)
+				{
+					worst = fabs(measured_rpm - true_rpm);
+				}
+
+				if(fabs(measured_rpm - true_rpm) > SWEEP_TOLERANCE_RPM)
+				{
+					printf("sweep %s %3d: measured %4.0f RPM, true %7.2f RPM\n",
+						   direction ? "reverse" : "forward", rpm, measured_rpm, true_rpm);
+					failures ++;
+				}
+			}
+		}
+	}
+
+	printf("sweep: worst error %.2f RPM, %d failures\n", worst, failures);
+
+	return failures;
+}
+
+/*!
+ 	 \brief This function runs a random closed loop scenario.
+
+ 	 \param[in] index Number of the scenario, for the report.
+ 	 \param[out] result Results of the scenario.
+
+ 	 \return Non zero if the scenario failed.
+ */
+static int sim_scenario(int index, scenario_result_t* result)
+{
+	MOTOR_SIM_params_t params;
+	motor_speed_t command;
+	/** Target and load of the scenario*/
+	double target_rpm;
+	double stall_torque;
+	double load;
+	/** Highest target for the load*/
+	double reachable_rpm;
+	/** Signed true speed*/
+	double true_rpm;
+	/** Speed in the direction of the target*/
+	double speed;
+	/** Sum of the speed at the end of each half*/
+	double sum = 0;
+	double error;
+	/** Last tick out of the settling band*/
+	int last_out = 0;
+	int failed = 0;
+	int tick;
+
+	MOTOR_SIM_default_params(&params);
+	params.resistance *= sim_random(1.0 - PARAM_JITTER, 1.0 + PARAM_JITTER);
+	params.ke *= sim_random(1.0 - PARAM_JITTER, 1.0 + PARAM_JITTER);
+	params.inertia *= sim_random(1.0 - PARAM_JITTER, 1.0 + PARAM_JITTER);
+	params.viscous *= sim_random(1.0 - PARAM_JITTER, 1.0 + PARAM_JITTER);
+	params.coulomb *= sim_random(1.0 - PARAM_JITTER, 1.0 + PARAM_JITTER);
+
+	/** Output stall torque, the load opposes the direction of the target*/
+	stall_torque = params.ke * (params.supply_v / params.resistance) * params.gear_ratio * params.gear_efficiency;
+	load = sim_random(0, LOAD_MAX) * stall_torque;
+
+	/** Motor speed at full drive with the load after the step (V = R i + Ke w, Ke i = load + friction)*/
+	reachable_rpm = (params.supply_v - (params.resistance *
+					 (((2.0 * load) / (params.gear_ratio * params.gear_efficiency)) + params.coulomb) / params.ke)) /
+					(params.ke + ((params.resistance * params.viscous) / params.ke));
+	reachable_rpm = TARGET_MARGIN * reachable_rpm / (params.gear_ratio * RAD_S_PER_RPM);
+
+	/** The target must be reachable, otherwise the drive saturates and the error is of the motor*/
+	target_rpm = floor(sim_random(TARGET_MIN_RPM, (TARGET_MAX_RPM < reachable_rpm) ? TARGET_MAX_RPM : reachable_rpm));
+	command.RPM = (uint8_t)target_rpm;
+	command.direction = (0.5 > sim_random(0, 1)) ? motor_reverse : motor_forward;
+
+	sim_start(&params);
+	sim_motor.load_torque = (motor_reverse == command.direction) ? -load : load;
+	SPEED_CTRL_set_target(&sim_ctrl, command);
+
+	result->steady_error = 0;
+	result->overshoot = 0;
+
+	for(tick = 1 ; tick <= SCENARIO_TICKS ; tick ++)
+	{
+		SPEED_CTRL_step(&sim_ctrl);
+		sim_tick();
+
+		true_rpm = MOTOR_SIM_output_rpm(&sim_motor);
+		speed = (motor_reverse == command.direction) ? -true_rpm : true_rpm;
+
+		if(LOAD_STEP_TICK == tick)
+		{
+			/** The load doubles*/
+			sim_motor.load_torque *= 2.0;
+		}
+
+		if(LOAD_STEP_TICK > tick)
+		{
+			if((speed - target_rpm) / target_rpm > result->overshoot)
+			{
+				result->overshoot = (speed - target_rpm) / target_rpm;
+			}
+
+			if(fabs(speed - target_rpm) > (SETTLE_BAND * target_rpm))
+			{
+				last_out = tick;
+			}
+		}
+
+		if((((LOAD_STEP_TICK - STEADY_TICKS) < tick) && (LOAD_STEP_TICK >= tick)) ||
+		   ((SCENARIO_TICKS - STEADY_TICKS) < tick))
+		{
+			sum += speed;
+		}
+
+		/** End of a half, the mean speed is compared to the target*/
+		if((LOAD_STEP_TICK == tick) || (SCENARIO_TICKS == tick))
+		{
+			error = fabs((sum / STEADY_TICKS) - target_rpm);
+			sum = 0;
+
+			if(error > result->steady_error)
+			{
+				result->steady_error = error;
+			}
+		}
+	}
+
+	result->settle_time = last_out * TICK_S;
+
+	if(result->steady_error > ((STEADY_TOLERANCE * target_rpm) + STEADY_TOLERANCE_RPM))
+	{
+		failed = 1;
+	}
+
+	if(failed)
+	{
+		printf("scenario %d failed: %s %3.0f RPM, load %.3f N*m, steady error %.2f RPM\n", index,
+			   (motor_reverse == command.direction) ? "reverse" : "forward", target_rpm, load, result->steady_error);
+	}
+
+	return failed;
+}
+
+int main(int argc, char* argv[])
+{
+	/** Closed loop scenarios and seed*/
+	int scenarios = (1 < argc) ? atoi(argv[1]) : DEFAULT_SCENARIOS;
+	unsigned int seed = (2 < argc) ? (unsigned int)atoi(argv[2]) : 1U;
+	scenario_result_t result;
+	/** Worst results of the scenarios*/
+	scenario_result_t worst = {0, 0, 0};
+	int failures;
+	int counter;
+	/** Processor time of the simulation*/
+	clock_t start = clock();
+	double cpu_s;
+	double sim_s;
+
+	printf("%s feedback, %d scenarios, seed %u\n", MC_FEEDBACK_MODE ? "quadrature" : "input capture", scenarios, seed);
+	srand(seed);
+
+	failures = sim_sweep();
+
+	for(counter = 0 ; counter < scenarios ; counter ++)
+	{
+		failures += sim_scenario(counter, &result);
+
+		if(result.steady_error > worst.steady_error)
+		{
+			worst.steady_error = result.steady_error;
+		}
+
+		if(result.settle_time > worst.settle_time)
+		{
+			worst.settle_time = result.settle_time;
+		}
+
+		if(result.overshoot > worst.overshoot)
+		{
+			worst.overshoot = result.overshoot;
+		}
+	}
+
+	cpu_s = (double)(clock() - start) / CLOCKS_PER_SEC;
+	sim_s = (scenarios * SCENARIO_TICKS * TICK_S) +
+			((MC_FEEDBACK_MODE ? 2 : 1) * SWEEP_SPEEDS * (SWEEP_SETTLE_TICKS + (SWEEP_READS * SWEEP_READ_TICKS)) * TICK_S);
+
+	printf("closed loop: worst steady error %.2f RPM, settle %.3f s, overshoot %.1f%%\n",
+		   worst.steady_error, worst.settle_time, worst.overshoot * 100.0);
+	printf("%d failures, %.0f s simulated in %.2f s (%.0fx real time)\n",
+		   failures, sim_s, cpu_s, sim_s / ((0.0 < cpu_s) ? cpu_s : 1e-9));
+
+	return (0 == failures) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,301 @@
+#!/usr/bin/env python3
+"""
+    \file pin_codegen.py
+
+    \brief Compiles the pin table of Processor Expert (g_pin_mux_InitConfigArr
+            of pin_mux.c) into the batches of pin_batch.h. The pins of a port
+            with the same configuration are grouped, so PIN_BATCH_init writes
+            up to 16 of them at once through GPCLR/GPCHR. The interrupt
+            configurations and the GPIO directions, which are not in the global
+            pin control registers, are listed apart.
+
+    \note Usage (From the project folder):
+            python3 Host/pin_codegen.py Generated_Code/pin_mux.c Sources/pin_batches
+            It writes Sources/pin_batches.h and Sources/pin_batches.c.
+
+    \author HEMI team
+            Arpio Fernandez, Leon               ie702086@iteso.mx
+            Barragan Alvarez, Daniel            ie702554@iteso.mx
+            Delsordo Bustillo, Jose Ricardo     ie702570@iteso.mx
+
+    \date   19/10/2026
+"""
+
+import os
+import re
+import sys
+
+# Pin table of the Processor Expert PinSettings component
+TABLE_RE = re.compile(r'g_pin_mux_InitConfigArr\s*\[[^\]]*\]\s*=\s*\{(.*?)\n\s*\};', re.S)
+# Pin of the table: { .field = value, ... }
+PIN_RE = re.compile(r'\{([^{}]*)\}', re.S)
+# Field of a pin: .field = value,
+FIELD_RE = re.compile(r'\.(\w+)\s*=\s*([^,\n]+?)\s*,')
+
+# Ports of the device
+PORTS = ['PORTA', 'PORTB', 'PORTC', 'PORTD', 'PORTE']
+# Pins of a half of a port (GPCLR and GPCHR)
+HALF_PINS = 16
+
+# PCR bits of the pull configurations
+PULL_BITS = {
+    'PORT_INTERNAL_PULL_NOT_ENABLED': [],
+    'PORT_INTERNAL_PULL_DOWN_ENABLED': ['PORT_PCR_PE_MASK'],
+    'PORT_INTERNAL_PULL_UP_ENABLED': ['PORT_PCR_PE_MASK', 'PORT_PCR_PS_MASK'],
+}
+# Muxes of the pins, the GPIO pins have a direction
+MUX_GPIO = 'PORT_MUX_AS_GPIO'
+MUX_DISABLED = 'PORT_PIN_DISABLED'
+# Interrupt configuration that needs no write after a reset
+INT_DISABLED = 'PORT_DMA_INT_DISABLED'
+# Directions of the GPIO pins
+DIRECTIONS = {
+    'GPIO_INPUT_DIRECTION': 'inputs',
+    'GPIO_OUTPUT_DIRECTION': 'outputs',
+}
+
+HEADER_TEMPLATE = """/*!
+ 	 \\file {base}.h
+
+ 	 \\brief This is the header file of the pin batches. It has the pins of {table}
+ 	 	 	 grouped by port and configuration, for PIN_BATCH_init.
+
+ 	 \\note Generated by Host/pin_codegen.py, do not modify it by hand.
+
+ 	 \\author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \\date 	19/10/2026
+ */
+
+#ifndef {guard}
+#define {guard}
+
+#include "pin_batch.h"
+
+/** Defines the number of pins of the table*/
+#define PIN_BATCHES_PINS					({pins})
+/** Defines the number of batches ({writes} writes to GPCLR/GPCHR)*/
+#define PIN_BATCHES_COUNT					({count})
+
+/** Configuration of the pins of the table*/
+extern const PIN_BATCH_config_t pin_batches_config;
+
+#endif /* {guard} */
+"""
+
+SOURCE_TEMPLATE = """/*!
+ 	 \\file {base}.c
+
+ 	 \\brief This is the source file of the pin batches. The pins of {table} are
+ 	 	 	 found in this source file, grouped by port and configuration.
+
+ 	 \\note Generated by Host/pin_codegen.py, do not modify it by hand.
+
+ 	 \\author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \\date 	19/10/2026
+ */
+
+#include "{base}.h"
+{body}"""
+
+
+class Pin(object):
+    """Pin of the table."""
+
+    def __init__(self, fields):
+        self.port = fields['base']
+        self.pin = int(fields['pinPortIdx'].rstrip('uU'))
+        self.pull = fields.get('pullConfig', 'PORT_INTERNAL_PULL_NOT_ENABLED')
+        self.filter = fields.get('passiveFilter', 'false') == 'true'
+        self.drive = fields.get('driveSelect', 'PORT_LOW_DRIVE_STRENGTH')
+        self.mux = fields.get('mux', MUX_DISABLED)
+        self.lock = fields.get('pinLock', 'false') == 'true'
+        self.interrupt = fields.get('intConfig', INT_DISABLED)
+        self.clear_flag = fields.get('clearIntFlag', 'false') == 'true'
+        self.gpio = fields.get('gpioBase')
+        self.direction = fields.get('direction')
+
+    def check(self):
+        if self.port not in PORTS:
+            raise ValueError('unknown port %s' % self.port)
+
+        if not 0 <= self.pin < 2 * HALF_PINS:
+            raise ValueError('pin %s%d out of range' % (self.port, self.pin))
+
+        if self.pull not in PULL_BITS:
+            raise ValueError('unknown pull %s of %s' % (self.pull, self.name()))
+
+        if (MUX_GPIO == self.mux) and (self.direction not in DIRECTIONS):
+            raise ValueError('GPIO %s without a direction' % self.name())
+
+    def name(self):
+        return 'PT%s%d' % (self.port[-1], self.pin)
+
+    def pcr(self):
+        """Bits 15:0 of the PCR, as a C expression."""
+        bits = []
+
+        if MUX_DISABLED != self.mux:
+            bits.append('PORT_PCR_MUX(%s)' % self.mux)
+
+        bits.extend(PULL_BITS[self.pull])
+
+        if self.filter:
+            bits.append('PORT_PCR_PFE_MASK')
+
+        if 'PORT_HIGH_DRIVE_STRENGTH' == self.drive:
+            bits.append('PORT_PCR_DSE_MASK')
+
+        if self.lock:
+            bits.append('PORT_PCR_LK_MASK')
+
+        return ' | '.join(bits) if bits else '0U'
+
+    def irq(self):
+        """Bits 31:16 of the PCR as a C expression, None if they stay as after a reset."""
+        bits = []
+
+        if INT_DISABLED != self.interrupt:
+            bits.append('PORT_PCR_IRQC(%s)' % self.interrupt)
+
+        if self.clear_flag:
+            bits.append('PORT_PCR_ISF_MASK')
+
+        return ' | '.join(bits) if bits else None
+
+
+def parse(path):
+    """Returns the pins of the table of pin_mux.c."""
+    with open(path) as source:
+        match = TABLE_RE.search(source.read())
+
+    if not match:
+        raise ValueError('g_pin_mux_InitConfigArr not found in %s' % path)
+
+    pins = []
+
+    for entry in PIN_RE.finditer(match.group(1)):
+        pins.append(Pin(dict(FIELD_RE.findall(entry.group(1) + ','))))
+        pins[-1].check()
+
+    return pins
+
+
+def batches(pins):
+    """Groups the pins by port and PCR, in the order of the ports and pins."""
+    groups = {}
+
+    for pin in pins:
+        groups.setdefault((pin.port, pin.pcr()), []).append(pin)
+
+    return sorted(groups.items(), key=lambda item: (PORTS.index(item[0][0]), min(pin.pin for pin in item[1])))
+
+
+def mask(pins, half):
+    """Pins of a half of the port, one bit per pin."""
+    bits = 0
+
+    for pin in pins:
+        if pin.pin // HALF_PINS == half:
+            bits |= 1 << (pin.pin % HALF_PINS)
+
+    return bits
+
+
+def source_body(pins, groups):
+    """Tables of the batches, interrupts and directions."""
+    lines = ['']
+    irqs = [pin for pin in pins if pin.irq()]
+    directions = {}
+
+    for pin in pins:
+        if MUX_GPIO == pin.mux:
+            entry = directions.setdefault(pin.gpio, {'port': pin.port, 'inputs': 0, 'outputs': 0})
+            entry[DIRECTIONS[pin.direction]] |= 1 << pin.pin
+
+    lines.append('/** Pins with the same configuration, per port*/')
+    lines.append('static const PIN_BATCH_t pin_batches[PIN_BATCHES_COUNT] =')
+    lines.append('{')
+
+    for index, ((port, pcr), batch) in enumerate(groups):
+        names = ', '.join(pin.name() for pin in sorted(batch, key=lambda pin: pin.pin))
+        lines.append('\t/* %s */' % names)
+        lines.append('\t{ %s, 0x%04XU, 0x%04XU, (uint16_t)(%s) }%s' % (
+            port, mask(batch, 0), mask(batch, 1), pcr, ',' if index < len(groups) - 1 else ''))
+
+    lines.append('};')
+
+    if irqs:
+        lines.append('')
+        lines.append('/** Pins with an interrupt configuration*/')
+        lines.append('static const PIN_BATCH_irq_t pin_batches_irqs[] =')
+        lines.append('{')
+
+        for index, pin in enumerate(irqs):
+            lines.append('\t{ %s, %dU, %s }%s\t/* %s */' % (
+                pin.port, pin.pin, pin.irq(), ',' if index < len(irqs) - 1 else '', pin.name()))
+
+        lines.append('};')
+
+    if directions:
+        lines.append('')
+        lines.append('/** Directions of the GPIO pins, per port*/')
+        lines.append('static const PIN_BATCH_direction_t pin_batches_directions[] =')
+        lines.append('{')
+        ordered = sorted(directions.items(), key=lambda item: PORTS.index(item[1]['port']))
+
+        for index, (gpio, entry) in enumerate(ordered):
+            lines.append('\t{ %s, 0x%08XUL, 0x%08XUL }%s' % (
+                gpio, entry['outputs'], entry['inputs'], ',' if index < len(ordered) - 1 else ''))
+
+        lines.append('};')
+
+    lines.append('')
+    lines.append('/** Configuration of the pins of the table*/')
+    lines.append('const PIN_BATCH_config_t pin_batches_config =')
+    lines.append('{')
+    lines.append('\tpin_batches,')
+    lines.append('\tPIN_BATCHES_COUNT,')
+    lines.append('\t%s,' % ('pin_batches_irqs' if irqs else 'NULL'))
+    lines.append('\t%s,' % ('sizeof(pin_batches_irqs) / sizeof(pin_batches_irqs[0])' if irqs else '0U'))
+    lines.append('\t%s,' % ('pin_batches_directions' if directions else 'NULL'))
+    lines.append('\t%s' % ('sizeof(pin_batches_directions) / sizeof(pin_batches_directions[0])' if directions else '0U'))
+    lines.append('};')
+    lines.append('')
+
+    return '\n'.join(lines)
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.stderr.write('usage: %s <pin_mux.c> <output base path>\n' % sys.argv[0])
+        return 1
+
+    table_path, output = sys.argv[1], sys.argv[2]
+    pins = parse(table_path)
+    groups = batches(pins)
+    base = os.path.basename(output)
+    table = os.path.basename(table_path)
+    writes = sum((mask(batch, 0) != 0) + (mask(batch, 1) != 0) for _, batch in groups)
+
+    with open(output + '.h', 'w') as header:
+        header.write(HEADER_TEMPLATE.format(base=base, table=table, guard=base.upper() + '_H_',
+                                            pins=len(pins), count=len(groups), writes=writes))
+
+    with open(output + '.c', 'w') as c_file:
+        c_file.write(SOURCE_TEMPLATE.format(base=base, table=table, body=source_body(pins, groups)))
+
+    sys.stdout.write('%d pins in %d batches (%d writes)\n' % (len(pins), len(groups), writes))
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,28 @@
+/*!
+ 	 \file FreeRTOS.h
+
+ 	 \brief This is the host simulation replacement of the FreeRTOS configuration. The
+ 	 	 	 tick is advanced by the simulation (SIM_shim_tick in ftm_shim.c).
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef FREERTOS_H_
+#define FREERTOS_H_
+
+#include <stdint.h>
+
+/** Defines the tick rate of the simulation (1 ms, as the target)*/
+#define configTICK_RATE_HZ							(1000)
+/** Defines the priority of the interrupts that use the kernel*/
+#define configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY	(1)
+
+/** Ticks of the kernel*/
+typedef uint32_t TickType_t;
+
+#endif /* FREERTOS_H_ */
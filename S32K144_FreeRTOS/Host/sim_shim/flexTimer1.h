@@ -0,0 +1,27 @@
+/*!
+ 	 \file flexTimer1.h
+
+ 	 \brief This is the host simulation replacement of the generated flexTimer1 component.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef flexTimer1_H
+#define flexTimer1_H
+
+#include "ftm_driver.h"
+
+/** Device instance number*/
+#define INST_FLEXTIMER1 0U
+
+/** Global configuration of flexTimer1*/
+extern ftm_user_config_t flexTimer1_InitConfig;
+/** PWM configuration of flexTimer1*/
+extern ftm_pwm_param_t flexTimer1_PwmConfig;
+
+#endif /* flexTimer1_H */
@@ -0,0 +1,27 @@
+/*!
+ 	 \file flexTimer2.h
+
+ 	 \brief This is the host simulation replacement of the generated flexTimer2 component.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef flexTimer2_H
+#define flexTimer2_H
+
+#include "ftm_driver.h"
+
+/** Device instance number*/
+#define INST_FLEXTIMER2 1U
+
+/** Global configuration of flexTimer2*/
+extern ftm_user_config_t flexTimer2_InitConfig;
+/** PWM configuration of flexTimer2 (Used by both motor timers)*/
+extern ftm_pwm_param_t flexTimer2_PwmConfig;
+
+#endif /* flexTimer2_H */
@@ -0,0 +1,25 @@
+/*!
+ 	 \file flexTimer3.h
+
+ 	 \brief This is the host simulation replacement of the generated flexTimer3 component.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef flexTimer3_H
+#define flexTimer3_H
+
+#include "ftm_driver.h"
+
+/** Device instance number*/
+#define INST_FLEXTIMER3 2U
+
+/** Global configuration of flexTimer3*/
+extern ftm_user_config_t flexTimer3_InitConfig;
+
+#endif /* flexTimer3_H */
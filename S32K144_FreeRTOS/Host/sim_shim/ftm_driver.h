@@ -0,0 +1,171 @@
+/*!
+ 	 \file ftm_driver.h
+
+ 	 \brief This is the host simulation replacement of the SDK FTM driver. It
+ 	 	 	 declares only the types and functions used by the motor control, the
+ 	 	 	 speed measurement and the quadrature encoder, with the same names and
+ 	 	 	 field order as the SDK. The behaviour is in ftm_shim.c.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef FTM_DRIVER_H_
+#define FTM_DRIVER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "status.h"
+
+/** Defines the number of FTM instances*/
+#define FTM_INSTANCE_COUNT					(4U)
+/** Defines the number of channels of an FTM*/
+#define FEATURE_FTM_CHANNEL_COUNT			(8U)
+/** Defines the duty cycle of 100% (Same as the SDK)*/
+#define FTM_MAX_DUTY_CYCLE					(0x8000U)
+
+/** There is no RAM code section on the host (s32_core_cm4.h)*/
+#define HOT_PATH_RAMSECTION
+
+/** Defines the number of channels of an FTM in the channel interrupts table*/
+#define FTM_IRQS_CH_COUNT					(8U)
+
+/*!
+ 	 \brief Interrupts of the FTMs, as the device header.
+ */
+typedef enum
+{
+	FTM0_Ch0_Ch1_IRQn = 99, FTM0_Ch2_Ch3_IRQn, FTM0_Ch4_Ch5_IRQn, FTM0_Ch6_Ch7_IRQn, FTM0_Fault_IRQn, FTM0_Ovf_Reload_IRQn,
+	FTM1_Ch0_Ch1_IRQn, FTM1_Ch2_Ch3_IRQn, FTM1_Ch4_Ch5_IRQn, FTM1_Ch6_Ch7_IRQn, FTM1_Fault_IRQn, FTM1_Ovf_Reload_IRQn,
+	FTM2_Ch0_Ch1_IRQn, FTM2_Ch2_Ch3_IRQn, FTM2_Ch4_Ch5_IRQn, FTM2_Ch6_Ch7_IRQn, FTM2_Fault_IRQn, FTM2_Ovf_Reload_IRQn,
+	FTM3_Ch0_Ch1_IRQn, FTM3_Ch2_Ch3_IRQn, FTM3_Ch4_Ch5_IRQn, FTM3_Ch6_Ch7_IRQn, FTM3_Fault_IRQn, FTM3_Ovf_Reload_IRQn
+}IRQn_Type;
+
+/** Defines the channel interrupts of the FTMs, as the device header*/
+#define FTM_IRQS							{ { FTM0_Ch0_Ch1_IRQn, FTM0_Ch0_Ch1_IRQn, FTM0_Ch2_Ch3_IRQn, FTM0_Ch2_Ch3_IRQn, FTM0_Ch4_Ch5_IRQn, FTM0_Ch4_Ch5_IRQn, FTM0_Ch6_Ch7_IRQn, FTM0_Ch6_Ch7_IRQn }, \
+											  { FTM1_Ch0_Ch1_IRQn, FTM1_Ch0_Ch1_IRQn, FTM1_Ch2_Ch3_IRQn, FTM1_Ch2_Ch3_IRQn, FTM1_Ch4_Ch5_IRQn, FTM1_Ch4_Ch5_IRQn, FTM1_Ch6_Ch7_IRQn, FTM1_Ch6_Ch7_IRQn }, \
+											  { FTM2_Ch0_Ch1_IRQn, FTM2_Ch0_Ch1_IRQn, FTM2_Ch2_Ch3_IRQn, FTM2_Ch2_Ch3_IRQn, FTM2_Ch4_Ch5_IRQn, FTM2_Ch4_Ch5_IRQn, FTM2_Ch6_Ch7_IRQn, FTM2_Ch6_Ch7_IRQn }, \
+											  { FTM3_Ch0_Ch1_IRQn, FTM3_Ch0_Ch1_IRQn, FTM3_Ch2_Ch3_IRQn, FTM3_Ch2_Ch3_IRQn, FTM3_Ch4_Ch5_IRQn, FTM3_Ch4_Ch5_IRQn, FTM3_Ch6_Ch7_IRQn, FTM3_Ch6_Ch7_IRQn } }
+/** Defines the overflow interrupts of the FTMs, as the device header*/
+#define FTM_Overflow_IRQS					{ FTM0_Ovf_Reload_IRQn, FTM1_Ovf_Reload_IRQn, FTM2_Ovf_Reload_IRQn, FTM3_Ovf_Reload_IRQn }
+
+/*!
+ 	 \brief Simulated registers of an FTM.
+ */
+typedef struct
+{
+	uint16_t MOD;							/*!< Modulo*/
+	uint16_t CnV[FEATURE_FTM_CHANNEL_COUNT];	/*!< Channel values*/
+	uint8_t PS;								/*!< Prescaler*/
+	uint8_t CLKS;							/*!< Clock source (Not simulated, the counters run at SIM_FTM_CLOCK_HZ)*/
+	bool TOF;								/*!< Timer overflow flag*/
+	bool TOIE;								/*!< Timer overflow interrupt enable*/
+}FTM_Type;
+
+typedef void (* ftm_channel_event_callback_t)(void * userData);
+
+typedef enum { FTM_PWM_UPDATE_IN_DUTY_CYCLE, FTM_PWM_UPDATE_IN_TICKS } ftm_pwm_update_option_t;
+typedef enum { FTM_SYSTEM_CLOCK, FTM_PWM_SYNC } ftm_reg_update_t;
+typedef enum { FTM_WAIT_LOADING_POINTS, FTM_UPDATE_NOW } ftm_pwm_sync_mode_t;
+typedef enum { FTM_EDGE_DETECT, FTM_SIGNAL_MEASUREMENT, FTM_NO_OPERATION } ftm_input_op_mode_t;
+typedef enum { FTM_NO_MEASUREMENT, FTM_RISING_EDGE_PERIOD_MEASUREMENT } ftm_signal_measurement_mode_t;
+typedef enum { FTM_NO_PIN_CONTROL, FTM_RISING_EDGE, FTM_FALLING_EDGE, FTM_BOTH_EDGES } ftm_edge_alignment_mode_t;
+typedef enum { FTM_QUAD_PHASE_ENCODE, FTM_QUAD_COUNT_AND_DIR } ftm_quad_decode_mode_t;
+typedef enum { FTM_QUAD_PHASE_NORMAL, FTM_QUAD_PHASE_INVERT } ftm_quad_phase_polarity_t;
+typedef uint8_t ftm_clock_ps_t;
+typedef enum { FTM_CLOCK_SOURCE_NONE, FTM_CLOCK_SOURCE_SYSTEMCLK, FTM_CLOCK_SOURCE_FIXEDCLK, FTM_CLOCK_SOURCE_EXTERNALCLK } ftm_clock_source_t;
+
+typedef struct
+{
+	bool softwareSync;
+	bool hardwareSync0;
+	bool hardwareSync1;
+	bool hardwareSync2;
+	bool maxLoadingPoint;
+	bool minLoadingPoint;
+	ftm_reg_update_t inverterSync;
+	ftm_reg_update_t outRegSync;
+	ftm_reg_update_t maskRegSync;
+	ftm_reg_update_t initCounterSync;
+	bool autoClearTrigger;
+	ftm_pwm_sync_mode_t syncPoint;
+}ftm_pwm_sync_t;
+
+typedef struct
+{
+	uint8_t ftmPrescaler;	/*!< Prescaler set by FTM_DRV_Init*/
+}ftm_user_config_t;
+
+typedef struct
+{
+	uint16_t uFrequencyHZ;	/*!< Frequency of the PWM*/
+}ftm_pwm_param_t;
+
+typedef struct
+{
+	uint8_t hwChannelId;
+	ftm_input_op_mode_t inputMode;
+	ftm_edge_alignment_mode_t edgeAlignement;
+	ftm_signal_measurement_mode_t measurementType;
+	uint16_t filterValue;
+	bool filterEn;
+	bool continuousModeEn;
+	void * channelsCallbacksParams;
+	ftm_channel_event_callback_t channelsCallbacks;
+}ftm_input_ch_param_t;
+
+typedef struct
+{
+	uint8_t nNumChannels;
+	uint16_t nMaxCountValue;
+	const ftm_input_ch_param_t * inputChConfig;
+}ftm_input_param_t;
+
+typedef struct
+{
+	bool phaseInputFilter;
+	uint8_t phaseFilterVal;
+	ftm_quad_phase_polarity_t phasePolarity;
+}ftm_phase_params_t;
+
+typedef struct
+{
+	ftm_quad_decode_mode_t mode;
+	uint16_t initialVal;
+	uint16_t maxVal;
+	ftm_phase_params_t phaseAConfig;
+	ftm_phase_params_t phaseBConfig;
+}ftm_quad_decode_config_t;
+
+/** Simulated FTM registers*/
+extern FTM_Type * const g_ftmBase[FTM_INSTANCE_COUNT];
+
+status_t FTM_DRV_Init(uint32_t instance, const ftm_user_config_t * info, void * state);
+status_t FTM_DRV_InitPwm(uint32_t instance, const ftm_pwm_param_t * param);
+status_t FTM_DRV_DeinitPwm(uint32_t instance);
+status_t FTM_DRV_UpdatePwmChannel(uint32_t instance, uint8_t channel, ftm_pwm_update_option_t typeOfUpdate,
+								  uint16_t firstEdge, uint16_t secondEdge, bool softwareTrigger);
+status_t FTM_DRV_SetSync(uint32_t instance, const ftm_pwm_sync_t * param);
+status_t FTM_DRV_InitInputCapture(uint32_t instance, const ftm_input_param_t * param);
+uint16_t FTM_DRV_GetInputCaptureMeasurement(uint32_t instance, uint8_t channel);
+uint32_t FTM_DRV_GetFrequency(uint32_t instance);
+status_t FTM_DRV_QuadDecodeStart(uint32_t instance, const ftm_quad_decode_config_t * config);
+
+uint16_t FTM_HAL_GetMod(const FTM_Type * ftmBase);
+void FTM_HAL_SetChnCountVal(FTM_Type * ftmBase, uint8_t channel, uint16_t value);
+void FTM_HAL_SetSoftwareTriggerCmd(FTM_Type * ftmBase, bool enable);
+uint16_t FTM_HAL_GetCounter(const FTM_Type * ftmBase);
+uint8_t FTM_HAL_GetClockPs(const FTM_Type * ftmBase);
+void FTM_HAL_SetClockPs(FTM_Type * ftmBase, ftm_clock_ps_t ps);
+ftm_clock_source_t FTM_HAL_GetClockSource(const FTM_Type * ftmBase);
+void FTM_HAL_SetClockSource(FTM_Type * ftmBase, ftm_clock_source_t clock);
+bool FTM_HAL_HasTimerOverflowed(const FTM_Type * ftmBase);
+void FTM_HAL_ClearTimerOverflow(FTM_Type * ftmBase);
+void FTM_HAL_SetTimerOverflowInt(FTM_Type * ftmBase, bool state);
+
+#endif /* FTM_DRIVER_H_ */
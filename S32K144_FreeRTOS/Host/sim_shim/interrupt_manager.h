@@ -0,0 +1,22 @@
+/*!
+ 	 \file interrupt_manager.h
+
+ 	 \brief This is the host simulation replacement of the SDK interrupt manager.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef INTERRUPT_MANAGER_H_
+#define INTERRUPT_MANAGER_H_
+
+#include "ftm_driver.h"
+
+void INT_SYS_EnableIRQ(IRQn_Type irqNumber);
+void INT_SYS_SetPriority(IRQn_Type irqNumber, uint8_t priority);
+
+#endif /* INTERRUPT_MANAGER_H_ */
@@ -0,0 +1,17 @@
+/*!
+ 	 \file pin_mux.h
+
+ 	 \brief This is the host simulation replacement of the generated pin settings (There are no pins).
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef PIN_MUX_H_
+#define PIN_MUX_H_
+
+#endif /* PIN_MUX_H_ */
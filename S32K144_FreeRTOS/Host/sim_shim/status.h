@@ -0,0 +1,28 @@
+/*!
+ 	 \file status.h
+
+ 	 \brief This is the host simulation replacement of the SDK status codes.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef STATUS_H_
+#define STATUS_H_
+
+/*!
+ 	 \brief Status of the SDK functions.
+ */
+typedef enum
+{
+	STATUS_SUCCESS,	/*!< Completed successfully*/
+	STATUS_ERROR,	/*!< Error occurred*/
+	STATUS_BUSY,	/*!< Resource is busy*/
+	STATUS_TIMEOUT	/*!< Operation timed out*/
+}status_t;
+
+#endif /* STATUS_H_ */
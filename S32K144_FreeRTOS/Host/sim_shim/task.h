@@ -0,0 +1,29 @@
+/*!
+ 	 \file task.h
+
+ 	 \brief This is the host simulation replacement of the FreeRTOS tasks. There is a
+ 	 	 	 single thread of execution, so the critical sections are empty.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef TASK_H_
+#define TASK_H_
+
+#include "FreeRTOS.h"
+
+/** The simulation has no preemption*/
+#define taskENTER_CRITICAL()
+/** The simulation has no preemption*/
+#define taskEXIT_CRITICAL()
+
+TickType_t xTaskGetTickCount(void);
+TickType_t xTaskGetTickCountFromISR(void);
+void vTaskDelayUntil(TickType_t* pxPreviousWakeTime, TickType_t xTimeIncrement);
+
+#endif /* TASK_H_ */
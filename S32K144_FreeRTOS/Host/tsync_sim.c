@@ -0,0 +1,244 @@
+/*!
+ 	 \file tsync_sim.c
+
+ 	 \brief This is a host simulation of the CAN time synchronization. A master and
+ 	 	 	 several slaves with drifting oscillators exchange SYNC and FUP frames on a
+ 	 	 	 loaded bus, and the error of every slave against the master is measured.
+
+ 	 \note Build and run it with the host compiler:
+ 	 	 	 gcc -std=c99 -I../Sources tsync_sim.c ../Sources/tsync_servo.c -lm -o tsync_sim
+ 	 	 	 ./tsync_sim
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "tsync_servo.h"
+
+/** Defines the number of nodes, the node 0 is the master*/
+#define NODES								(6)
+/** Defines the simulated time, in microseconds*/
+#define SIM_TIME_US							(120000000.0)
+/** Defines the time after which the error is measured, in microseconds*/
+#define SETTLE_TIME_US						(20000000.0)
+/** Defines the sync period, in microseconds*/
+#define SYNC_PERIOD_US						(100000.0)
+/** Defines the step of the error measurement, in microseconds*/
+#define SAMPLE_STEP_US						(997.0)
+/** Defines the bit time of the bus (500 kbit/s), it is the resolution of the timestamps*/
+#define BIT_TIME_US							(2.0)
+/** Defines the length of a frame with 8 bytes, in microseconds*/
+#define FRAME_TIME_US						(135.0 * BIT_TIME_US)
+/** Defines the maximum oscillator error, in parts per million*/
+#define MAX_DRIFT_PPM						(100.0)
+/** Defines the oscillator wander per sync period, in parts per million*/
+#define WANDER_PPM							(0.05)
+/** Defines the maximum initial offset, in microseconds*/
+#define MAX_OFFSET_US						(5000000.0)
+/** Defines the maximum delay to process a received frame, in microseconds*/
+#define RX_LATENCY_US						(2000.0)
+
+/*!
+ 	 \brief Structure for a simulated node.
+ */
+typedef struct
+{
+	double offset_us;		/*!< Local time when the true time was 0*/
+	double drift_ppm;		/*!< Oscillator error*/
+	double local_us;		/*!< Local time at the last update of the true time*/
+	TSYNC_servo_t servo;	/*!< Servo of the node (Unused in the master)*/
+}node_t;
+
+/** Nodes of the simulation*/
+static node_t node[NODES];
+/** True time of the last update*/
+static double node_true_us;
+
+/*!
+ 	 \brief This function returns a uniform random number.
+
+ 	 \param[in] low Lowest value.
+ 	 \param[in] high Highest value.
+
+ 	 \return Random number.
+ */
+static double sim_random(double low, double high)
+{
+	return low + ((high - low) * rand()) / RAND_MAX;
+}
+
+/*!
+ 	 \brief This function advances the local clocks of all the nodes to a true time.
+
+ 	 \param[in] true_us True time.
+
+ 	 \return void.
+ */
+static void sim_advance(double true_us)
+{
+	int counter;
+
+	for(counter = 0 ; counter < NODES ; counter ++)
+	{
+		node[counter].local_us += (true_us - node_true_us) * (1.0 + (node[counter].drift_ppm / 1e6));
+	}
+
+	node_true_us = true_us;
+}
+
+/*!
+ 	 \brief This function returns the local time of a node, quantized as the CAN timer.
+
+ 	 \param[in] index Node.
+
+ 	 \return Local time in microseconds.
+ */
+static int64_t sim_local(int index)
+{
+	return (int64_t)(floor(node[index].local_us / BIT_TIME_US) * BIT_TIME_US);
+}
+
+/*!
+ 	 \brief This function runs the simulation for a bus load.
+
+ 	 \param[in] load Bus load, from 0 to 1.
+
+ 	 \return void.
+ */
+static void sim_run(double load)
+{
+	/** Time of the next sync*/
+	double next_sync = SYNC_PERIOD_US;
+	/** Time of the next sample of the error*/
+	double next_sample = 0;
+	/** Time of the next event*/
+	double now;
+	/** Master time of the sync in flight and the local times when it was received*/
+	int64_t sync_master = 0;
+	int64_t sync_local[NODES];
+	/** Time when every slave processes the follow up*/
+	double fup_time[NODES];
+	/** Pending follow up flag*/
+	int fup_pending = 0;
+	/** Error statistics*/
+	double max_error = 0;
+	double sum_square = 0;
+	long samples = 0;
+	double error;
+	int counter;
+
+	srand(1);
+	node_true_us = 0;
+
+	for(counter = 0 ; counter < NODES ; counter ++)
+	{
+		node[counter].offset_us = sim_random(0, MAX_OFFSET_US);
+		node[counter].drift_ppm = sim_random(-MAX_DRIFT_PPM, MAX_DRIFT_PPM);
+		node[counter].local_us = node[counter].offset_us;
+		TSYNC_servo_init(&node[counter].servo);
+	}
+
+	while(node_true_us < SIM_TIME_US)
+	{
+		now = next_sample;
+
+		if(next_sync < now)
+		{
+			now = next_sync;
+		}
+
+		for(counter = 1 ; fup_pending && (counter < NODES) ; counter ++)
+		{
+			if(fup_time[counter] < now)
+			{
+				now = fup_time[counter];
+			}
+		}
+
+		sim_advance(now);
+
+		/** SYNC: waits for the bus, then every node timestamps the same start of frame*/
+		if(now == next_sync)
+		{
+			sim_advance(now + sim_random(0, (load / (1.0 - load + 0.01)) * FRAME_TIME_US));
+			sync_master = sim_local(0);
+
+			for(counter = 1 ; counter < NODES ; counter ++)
+			{
+				sync_local[counter] = sim_local(counter);
+			}
+
+			/** FUP: sent once the master reads its tx timestamp, delayed by the bus and the rx thread*/
+			for(counter = 1 ; counter < NODES ; counter ++)
+			{
+				fup_time[counter] = node_true_us + FRAME_TIME_US +
+									sim_random(0, (load / (1.0 - load + 0.01)) * FRAME_TIME_US) +
+									sim_random(0, RX_LATENCY_US);
+			}
+
+			fup_pending = 1;
+			next_sync += SYNC_PERIOD_US;
+
+			/** The oscillators wander slowly*/
+			for(counter = 0 ; counter < NODES ; counter ++)
+			{
+				node[counter].drift_ppm += sim_random(-WANDER_PPM, WANDER_PPM);
+			}
+		}
+
+		else if(now == next_sample)
+		{
+			for(counter = 1 ; (counter < NODES) && (SETTLE_TIME_US < now) ; counter ++)
+			{
+				error = (double)(TSYNC_servo_time(&node[counter].servo, sim_local(counter)) - sim_local(0));
+				sum_square += error * error;
+				samples ++;
+
+				if(fabs(error) > max_error)
+				{
+					max_error = fabs(error);
+				}
+			}
+
+			next_sample += SAMPLE_STEP_US;
+		}
+
+		else
+		{
+			for(counter = 1 ; counter < NODES ; counter ++)
+			{
+				if(fup_time[counter] == now)
+				{
+					TSYNC_servo_update(&node[counter].servo, sync_master, sync_local[counter]);
+					fup_time[counter] = SIM_TIME_US * 2;
+				}
+			}
+		}
+	}
+
+	printf("load %3.0f%%  rms error %6.2f us  max error %6.2f us\n", load * 100.0, sqrt(sum_square / samples), max_error);
+}
+
+int main(void)
+{
+	/** Bus loads to be simulated*/
+	const double load[] = {0.0, 0.3, 0.6, 0.9};
+	unsigned int counter;
+
+	printf("%d nodes, sync every %.0f ms, +-%.0f ppm oscillators, %.0f us timestamps\n",
+		   NODES, SYNC_PERIOD_US / 1000.0, MAX_DRIFT_PPM, BIT_TIME_US);
+
+	for(counter = 0 ; counter < (sizeof(load) / sizeof(load[0])) ; counter ++)
+	{
+		sim_run(load[counter]);
+	}
+
+	return 0;
+}
@@ -0,0 +1,323 @@
+/*!
+ 	 \file xcp_master.c
+
+ 	 \brief This is a stand-in XCP master. It runs the XCP slave of the firmware
+ 	 	 	 (xcp.c) against the simulated bus: it connects, uploads and downloads
+ 	 	 	 calibration values (Only in the RAM of the "firmware"), configures a DAQ
+ 	 	 	 list bound to an event, sends the queued frames as the sender thread
+ 	 	 	 does, and checks every DAQ frame against the values the event sampled.
+ 	 	 	 The exit code is not zero if any check fails, so it can be run by the CI.
+
+ 	 \note Build and run it with the host compiler. The slave keeps the addresses in
+ 	 	 	 32 bits, so the executable must not be position independent:
+ 	 	 	 gcc -std=c99 -O2 -no-pie -DXCP_HOST_BUS -I. -I../Sources xcp_master.c
+ 	 	 	 	 can_bus_sim.c ../Sources/xcp.c -o xcp_master
+ 	 	 	 ./xcp_master [events]
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "can_bus_sim.h"
+#include "xcp.h"
+
+/** Defines the default number of events of the DAQ test*/
+#define DEFAULT_EVENTS						(10000)
+/** Defines the prescaler of the DAQ list*/
+#define DAQ_PRESCALER						(2)
+/** Defines the number of ODTs of the DAQ list*/
+#define DAQ_ODTS							(2)
+/** Defines the highest address the slave can reach*/
+#define MAX_SLAVE_ADDRESS					(0xFFFFFFFFUL)
+
+/** Command codes and responses (ASAM MCD-1 XCP)*/
+#define CMD_CONNECT							(0xFF)
+#define CMD_DISCONNECT						(0xFE)
+#define CMD_GET_STATUS						(0xFD)
+#define CMD_SET_MTA							(0xF6)
+#define CMD_SHORT_UPLOAD					(0xF4)
+#define CMD_DOWNLOAD						(0xF0)
+#define CMD_WRITE_DAQ						(0xE1)
+#define CMD_SET_DAQ_PTR						(0xE2)
+#define CMD_SET_DAQ_LIST_MODE				(0xE0)
+#define CMD_START_STOP_DAQ_LIST				(0xDE)
+#define CMD_FREE_DAQ						(0xD6)
+#define CMD_ALLOC_DAQ						(0xD5)
+#define CMD_ALLOC_ODT						(0xD4)
+#define CMD_ALLOC_ODT_ENTRY					(0xD3)
+#define PID_RES								(0xFF)
+#define PID_ERR								(0xFE)
+#define ERR_ACCESS_DENIED					(0x24)
+#define ERR_DAQ_CONFIG						(0x2A)
+#define DAQ_LIST_STOP						(0x00)
+#define DAQ_LIST_START						(0x01)
+
+/** Defines the bit shifts for a byte*/
+#define BYTE_SHIFT							(8)
+/** Defines a mask to get a low byte*/
+#define LOW_BYTE_MASK						(0xFF)
+
+/*!
+ 	 \brief Variables measured by the DAQ list, as in the firmware. The speed and the
+ 	 	 	 current are contiguous, so the slave merges their entries.
+ */
+typedef struct
+{
+	uint16_t speed;		/*!< Measured speed*/
+	uint16_t current;	/*!< Measured current*/
+	uint32_t unused;	/*!< Not measured, it separates the position*/
+	int32_t position;	/*!< Measured position*/
+}master_signals_t;
+
+/*!
+ 	 \brief RAM of the "firmware", the only memory the slave can reach.
+ */
+typedef struct
+{
+	master_signals_t signals;	/*!< Measured variables*/
+	int16_t gain;				/*!< Calibration value*/
+}master_ram_t;
+
+/** RAM of the "firmware"*/
+static volatile master_ram_t master_ram = { { 0 }, 100 };
+/** Checks that failed*/
+static int master_failures = 0;
+
+/*********************************************************************************************/
+
+/** This function reports a failed check*/
+static void master_check(int condition, const char* what)
+{
+	if(!condition)
+	{
+		printf("FAIL: %s\n", what);
+		master_failures ++;
+	}
+}
+
+/** This function writes a little endian 32 bit value in a frame*/
+static void master_put_uint32(uint8_t* data, uint32_t value)
+{
+	data[0] = (uint8_t)(value & LOW_BYTE_MASK);
+	data[1] = (uint8_t)((value >> BYTE_SHIFT) & LOW_BYTE_MASK);
+	data[2] = (uint8_t)((value >> (2 * BYTE_SHIFT)) & LOW_BYTE_MASK);
+	data[3] = (uint8_t)((value >> (3 * BYTE_SHIFT)) & LOW_BYTE_MASK);
+}
+
+/** This function sends a command and reads its response, it returns whether there was one*/
+static int master_command(uint8_t b0, uint8_t b1, uint8_t b2, uint8_t b3, uint8_t b4, uint8_t b5,
+						  uint8_t b6, uint8_t b7, CAN_BUS_SIM_frame_t* response)
+{
+	uint8_t cmd[CAN_BUS_SIM_FRAME_SIZE] = { b0, b1, b2, b3, b4, b5, b6, b7 };
+
+	CAN_BUS_SIM_send(XCP_CRO_ID, cmd, CAN_BUS_SIM_FRAME_SIZE);
+
+	return CAN_BUS_SIM_receive(response);
+}
+
+/** This function sends a command with an address in the bytes 4 to 7, it returns whether there was a response*/
+static int master_address_command(uint8_t b0, uint8_t b1, uint8_t b2, const volatile void* address, CAN_BUS_SIM_frame_t* response)
+{
+	uint8_t cmd[CAN_BUS_SIM_FRAME_SIZE] = { b0, b1, b2 };
+
+	master_put_uint32(&cmd[4], (uint32_t)(uintptr_t)address);
+	CAN_BUS_SIM_send(XCP_CRO_ID, cmd, CAN_BUS_SIM_FRAME_SIZE);
+
+	return CAN_BUS_SIM_receive(response);
+}
+
+/** This function checks the positive response of a command*/
+static void master_expect_ok(int answered, const CAN_BUS_SIM_frame_t* response, const char* what)
+{
+	master_check(answered && (PID_RES == response->data[0]), what);
+}
+
+/*********************************************************************************************/
+
+/** This function tests the connection and the calibration*/
+static void master_calibration(void)
+{
+	CAN_BUS_SIM_frame_t response;
+	uint8_t cmd[CAN_BUS_SIM_FRAME_SIZE] = { CMD_DOWNLOAD, sizeof(int16_t) };
+	int16_t gain = -1234;
+
+	/** Only CONNECT is answered while disconnected*/
+	master_check(!master_command(CMD_GET_STATUS, 0, 0, 0, 0, 0, 0, 0, &response), "command answered while disconnected");
+
+	master_expect_ok(master_command(CMD_CONNECT, 0, 0, 0, 0, 0, 0, 0, &response), &response, "CONNECT");
+	master_check(CAN_BUS_SIM_FRAME_SIZE == response.data[3], "CONNECT MAX_CTO");
+
+	/** Upload of a measured variable*/
+	master_ram.signals.position = 0x12345678;
+	master_expect_ok(master_address_command(CMD_SHORT_UPLOAD, sizeof(int32_t), 0, &master_ram.signals.position, &response), &response, "SHORT_UPLOAD");
+	master_check((1 + sizeof(int32_t)) == response.DLC, "SHORT_UPLOAD DLC");
+	master_check(0 == memcmp(&response.data[1], (const void*)&master_ram.signals.position, sizeof(int32_t)), "SHORT_UPLOAD data");
+
+	/** Calibration of a value without halting the "firmware"*/
+	master_expect_ok(master_address_command(CMD_SET_MTA, 0, 0, &master_ram.gain, &response), &response, "SET_MTA");
+	memcpy(&cmd[2], &gain, sizeof(gain));
+	CAN_BUS_SIM_send(XCP_CRO_ID, cmd, CAN_BUS_SIM_FRAME_SIZE);
+	master_check(CAN_BUS_SIM_receive(&response) && (PID_RES == response.data[0]), "DOWNLOAD");
+	master_check(gain == master_ram.gain, "DOWNLOAD value");
+
+	/** The memory beyond the RAM of the "firmware" is refused*/
+	master_check(master_address_command(CMD_SHORT_UPLOAD, sizeof(int), 0, &master_failures, &response) &&
+				 (PID_ERR == response.data[0]) && (ERR_ACCESS_DENIED == response.data[1]), "SHORT_UPLOAD beyond the RAM refused");
+	master_check(master_address_command(CMD_SHORT_UPLOAD, 7, 0, &master_ram.gain, &response) &&
+				 (PID_ERR == response.data[0]) && (ERR_ACCESS_DENIED == response.data[1]), "SHORT_UPLOAD across the end of the RAM refused");
+	master_check(master_address_command(CMD_WRITE_DAQ, 0xFF, sizeof(int), &master_failures, &response) &&
+				 (PID_ERR == response.data[0]), "WRITE_DAQ beyond the RAM refused");
+
+	master_expect_ok(master_address_command(CMD_SET_MTA, 0, 0, &master_failures, &response), &response, "SET_MTA beyond the RAM");
+	CAN_BUS_SIM_send(XCP_CRO_ID, cmd, CAN_BUS_SIM_FRAME_SIZE);
+	master_check(CAN_BUS_SIM_receive(&response) && (PID_ERR == response.data[0]) && (ERR_ACCESS_DENIED == response.data[1]), "DOWNLOAD beyond the RAM refused");
+	master_check(0 == master_failures, "DOWNLOAD beyond the RAM written");
+}
+
+/** This function configures the DAQ list and checks its frames, it returns the frames received*/
+static unsigned long master_daq(unsigned long events)
+{
+	CAN_BUS_SIM_frame_t response;
+	unsigned long event;
+	unsigned long frames = 0;
+	unsigned long lists = 0;
+	uint32_t seed = 1;
+	uint8_t odt;
+	uint8_t expected[CAN_BUS_SIM_FRAME_SIZE];
+
+	/** One list, two ODTs: speed and current (Merged), position and gain*/
+	master_expect_ok(master_command(CMD_FREE_DAQ, 0, 0, 0, 0, 0, 0, 0, &response), &response, "FREE_DAQ");
+	master_expect_ok(master_command(CMD_ALLOC_DAQ, 0, 1, 0, 0, 0, 0, 0, &response), &response, "ALLOC_DAQ");
+	master_expect_ok(master_command(CMD_ALLOC_ODT, 0, 0, 0, DAQ_ODTS, 0, 0, 0, &response), &response, "ALLOC_ODT");
+	master_expect_ok(master_command(CMD_ALLOC_ODT_ENTRY, 0, 0, 0, 0, 2, 0, 0, &response), &response, "ALLOC_ODT_ENTRY 0");
+	master_expect_ok(master_command(CMD_ALLOC_ODT_ENTRY, 0, 0, 0, 1, 2, 0, 0, &response), &response, "ALLOC_ODT_ENTRY 1");
+
+	master_expect_ok(master_command(CMD_SET_DAQ_PTR, 0, 0, 0, 0, 0, 0, 0, &response), &response, "SET_DAQ_PTR 0");
+	master_expect_ok(master_address_command(CMD_WRITE_DAQ, 0xFF, sizeof(uint16_t), &master_ram.signals.speed, &response), &response, "WRITE_DAQ speed");
+	master_expect_ok(master_address_command(CMD_WRITE_DAQ, 0xFF, sizeof(uint16_t), &master_ram.signals.current, &response), &response, "WRITE_DAQ current");
+
+	master_expect_ok(master_command(CMD_SET_DAQ_PTR, 0, 0, 0, 1, 0, 0, 0, &response), &response, "SET_DAQ_PTR 1");
+	master_expect_ok(master_address_command(CMD_WRITE_DAQ, 0xFF, sizeof(int32_t), &master_ram.signals.position, &response), &response, "WRITE_DAQ position");
+
+	/** The ODT only has 3 bytes left, an entry of 4 bytes must be refused*/
+	master_check(master_address_command(CMD_WRITE_DAQ, 0xFF, sizeof(uint32_t), &master_ram.signals.unused, &response) &&
+				 (PID_ERR == response.data[0]) && (ERR_DAQ_CONFIG == response.data[1]), "WRITE_DAQ beyond the frame refused");
+
+	master_expect_ok(master_address_command(CMD_WRITE_DAQ, 0xFF, sizeof(int16_t), &master_ram.gain, &response), &response, "WRITE_DAQ gain");
+
+	master_expect_ok(master_command(CMD_SET_DAQ_LIST_MODE, 0, 0, 0, XCP_EVENT_SPEED_TASK, 0, DAQ_PRESCALER, 0, &response), &response, "SET_DAQ_LIST_MODE");
+	master_expect_ok(master_command(CMD_START_STOP_DAQ_LIST, DAQ_LIST_START, 0, 0, 0, 0, 0, 0, &response), &response, "START_STOP_DAQ_LIST");
+	master_check(0 == response.data[1], "first PID of the list");
+
+	for(event = 0 ; event < events ; event ++)
+	{
+		/** The "firmware" changes the values between the events*/
+		seed = (seed * 1103515245UL) + 12345UL;
+		master_ram.signals.speed = (uint16_t)(seed >> 16);
+		master_ram.signals.current = (uint16_t)seed;
+		master_ram.signals.position += (int32_t)(seed % 200U) - 100;
+		master_ram.gain = (int16_t)(seed >> 8);
+
+		/** Other events do not send the list*/
+		XCP_event(XCP_EVENT_CAN_RX);
+		master_check(!CAN_BUS_SIM_receive(&response), "frame sent by an event not bound");
+
+		/** The event only samples, the frames wait for the sender thread*/
+		XCP_event(XCP_EVENT_SPEED_TASK);
+		master_check(!CAN_BUS_SIM_receive(&response), "frame sent by the event");
+
+		if(0 != ((event + 1) % DAQ_PRESCALER))
+		{
+			master_check(0 == XCP_send_daq(), "frame sent before the prescaler");
+			continue;
+		}
+
+		master_check(DAQ_ODTS == XCP_send_daq(), "DAQ frames queued");
+
+		lists ++;
+
+		for(odt = 0 ; odt < DAQ_ODTS ; odt ++)
+		{
+			memset(expected, 0, sizeof(expected));
+			expected[0] = odt;
+
+			if(0 == odt)
+			{
+				memcpy(&expected[1], (const void*)&master_ram.signals.speed, sizeof(uint16_t));
+				memcpy(&expected[3], (const void*)&master_ram.signals.current, sizeof(uint16_t));
+			}
+
+			else
+			{
+				memcpy(&expected[1], (const void*)&master_ram.signals.position, sizeof(int32_t));
+				memcpy(&expected[5], (const void*)&master_ram.gain, sizeof(int16_t));
+			}
+
+			if(!CAN_BUS_SIM_receive(&response))
+			{
+				master_check(0, "DAQ frame missing");
+				break;
+			}
+
+			frames ++;
+			master_check(((0 == odt) ? 5 : 7) == response.DLC, "DAQ frame DLC");
+			master_check(0 == memcmp(response.data, expected, response.DLC), "DAQ frame data");
+		}
+	}
+
+	master_check((events / DAQ_PRESCALER) == lists, "DAQ lists sent");
+
+	/** A stopped list is not sent*/
+	master_expect_ok(master_command(CMD_START_STOP_DAQ_LIST, DAQ_LIST_STOP, 0, 0, 0, 0, 0, 0, &response), &response, "STOP DAQ list");
+
+	for(event = 0 ; event < DAQ_PRESCALER ; event ++)
+	{
+		XCP_event(XCP_EVENT_SPEED_TASK);
+	}
+
+	XCP_send_daq();
+
+	master_check(!CAN_BUS_SIM_receive(&response), "frame sent by a stopped list");
+
+	master_expect_ok(master_command(CMD_DISCONNECT, 0, 0, 0, 0, 0, 0, 0, &response), &response, "DISCONNECT");
+
+	return frames;
+}
+
+/*********************************************************************************************/
+
+int main(int argc, char** argv)
+{
+	unsigned long events = (1 < argc) ? strtoul(argv[1], NULL, 0) : DEFAULT_EVENTS;
+	unsigned long frames;
+	static CAN_Type can_sim;
+
+	/** The slave keeps the addresses in 32 bits*/
+	if(MAX_SLAVE_ADDRESS < (uintptr_t)&master_ram)
+	{
+		printf("The variables are beyond 4 GB, build with -no-pie\n");
+		return EXIT_FAILURE;
+	}
+
+	CAN_BUS_SIM_set_ram(&master_ram, sizeof(master_ram));
+	master_check(ID_func_vector_success == XCP_init(&can_sim, XCP_CRO_ID, XCP_DTO_ID), "XCP_init");
+
+	master_calibration();
+	frames = master_daq(events);
+
+	master_check(0 == CAN_BUS_SIM_get_overruns(), "frames lost by the bus");
+	master_check(0 == XCP_get_daq_overruns(), "DAQ lists dropped by the slave");
+
+	printf("DAQ: %lu events, %lu frames checked (%d bytes of 9 sampled per list in %d frames)\n",
+		   events, frames, 2 + 2 + 4 + 2, DAQ_ODTS);
+	printf("%d failures\n", master_failures);
+
+	return (0 == master_failures) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
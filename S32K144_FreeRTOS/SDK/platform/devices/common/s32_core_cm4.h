@@ -158,6 +158,17 @@ extern "C" {
     #define END_FUNCTION_DEFINITION_RAMSECTION
 #endif
 
+/** \brief  Places a hot path (An interrupt handler or the code it runs) in RAM, so
+ *          the flash builds run it without the flash wait states nor the code
+ *          cache misses. Define HOT_PATHS_IN_FLASH to leave the hot paths in
+ *          flash (e.g. to compare both layouts).
+ */
+#if defined ( __GNUC__ ) && !defined ( HOT_PATHS_IN_FLASH )
+    #define HOT_PATH_RAMSECTION                        __attribute__((section (".code_ram"), noinline, long_call))
+#else
+    #define HOT_PATH_RAMSECTION
+#endif
+
 #if defined (__ICCARM__)
     #define DISABLE_CHECK_RAMSECTION_FUNCTION_CALL     _Pragma("diag_suppress=Ta022")
     #define ENABLE_CHECK_RAMSECTION_FUNCTION_CALL      _Pragma("diag_default=Ta022")
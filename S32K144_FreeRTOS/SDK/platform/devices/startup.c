@@ -36,6 +36,11 @@
  * representing an address.
  *
  * @section [global]
+ * Violates MISRA 2012 Required Rule 11.3, A cast shall not be performed
+ * between a pointer to object type and a pointer to a different object type.
+ * The sections are copied and cleared by words once the pointers are aligned.
+ *
+ * @section [global]
  * Violates MISRA 2012 Required Rule 11.6, A cast shall not be performed
  * between pointer to void and an arithmetic type.
  * The cast is required to initialize a pointer with an unsigned int define,
@@ -62,6 +67,16 @@
     #pragma section = ".bss"
 #endif
 
+/* Mask of the address bits below a 32-bit word */
+#define INIT_WORD_MASK      (3U)
+
+/*******************************************************************************
+ * Private functions
+ ******************************************************************************/
+
+static void init_copy(uint8_t * dest, const uint8_t * src, const uint8_t * src_end);
+static void init_clear(uint8_t * dest, const uint8_t * dest_end);
+
 /*******************************************************************************
  * Code
  ******************************************************************************/
@@ -161,26 +176,126 @@ void init_data_bss(void)
     }
 
     /* Copy initialized data from ROM to RAM */
-    while (data_rom_end != data_rom)
+    init_copy(data_ram, data_rom, data_rom_end);
+
+    /* Copy functions from ROM to RAM */
+    init_copy(code_ram, code_rom, code_rom_end);
+
+    /* Clear the zero-initialized data section */
+    init_clear(bss_start, bss_end);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : init_copy
+ * Description   : Copy a section from ROM to RAM. When the source and the
+ * destination have the same alignment, the bytes up to a word boundary are
+ * copied one by one, then blocks of four words (LDM/STM), then single words,
+ * and the bytes left at the end. Otherwise the whole section is copied by bytes.
+ * From the Cortex-M4 timings, about 1 cycle per byte instead of 7.
+ *
+ *END**************************************************************************/
+static void init_copy(uint8_t * dest, const uint8_t * src, const uint8_t * src_end)
+{
+    uint32_t * dest_word;
+    const uint32_t * src_word;
+    uint32_t word0, word1, word2, word3;
+
+    if ((((uint32_t)dest ^ (uint32_t)src) & INIT_WORD_MASK) == 0U)
     {
-        *data_ram = *data_rom;
-        data_ram++;
-        data_rom++;
+        /* Unaligned head */
+        while ((src_end != src) && ((((uint32_t)src) & INIT_WORD_MASK) != 0U))
+        {
+            *dest = *src;
+            dest++;
+            src++;
+        }
+
+        dest_word = (uint32_t *)dest;
+        src_word = (const uint32_t *)src;
+
+        /* Blocks of four words, loaded together before they are stored */
+        while (((uint32_t)src_end - (uint32_t)src_word) >= (4U * sizeof(uint32_t)))
+        {
+            word0 = src_word[0];
+            word1 = src_word[1];
+            word2 = src_word[2];
+            word3 = src_word[3];
+            dest_word[0] = word0;
+            dest_word[1] = word1;
+            dest_word[2] = word2;
+            dest_word[3] = word3;
+            dest_word += 4U;
+            src_word += 4U;
+        }
+
+        /* Words left */
+        while (((uint32_t)src_end - (uint32_t)src_word) >= sizeof(uint32_t))
+        {
+            *dest_word = *src_word;
+            dest_word++;
+            src_word++;
+        }
+
+        dest = (uint8_t *)dest_word;
+        src = (const uint8_t *)src_word;
     }
 
-    /* Copy functions from ROM to RAM */
-    while (code_rom_end != code_rom)
+    /* Unaligned tail, or a section that can not be copied by words */
+    while (src_end != src)
     {
-        *code_ram = *code_rom;
-        code_ram++;
-        code_rom++;
+        *dest = *src;
+        dest++;
+        src++;
     }
+}
 
-    /* Clear the zero-initialized data section */
-    while(bss_end != bss_start)
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : init_clear
+ * Description   : Clear a section. The bytes up to a word boundary are cleared
+ * one by one, then blocks of four words (STM), then single words, and the bytes
+ * left at the end. From the Cortex-M4 timings, about 0.6 cycles per byte
+ * instead of 5.
+ *
+ *END**************************************************************************/
+static void init_clear(uint8_t * dest, const uint8_t * dest_end)
+{
+    uint32_t * dest_word;
+
+    /* Unaligned head */
+    while ((dest_end != dest) && ((((uint32_t)dest) & INIT_WORD_MASK) != 0U))
+    {
+        *dest = 0U;
+        dest++;
+    }
+
+    dest_word = (uint32_t *)dest;
+
+    /* Blocks of four words */
+    while (((uint32_t)dest_end - (uint32_t)dest_word) >= (4U * sizeof(uint32_t)))
+    {
+        dest_word[0] = 0U;
+        dest_word[1] = 0U;
+        dest_word[2] = 0U;
+        dest_word[3] = 0U;
+        dest_word += 4U;
+    }
+
+    /* Words left */
+    while (((uint32_t)dest_end - (uint32_t)dest_word) >= sizeof(uint32_t))
+    {
+        *dest_word = 0U;
+        dest_word++;
+    }
+
+    dest = (uint8_t *)dest_word;
+
+    /* Unaligned tail */
+    while (dest_end != dest)
     {
-        *bss_start = 0;
-        bss_start++;
+        *dest = 0U;
+        dest++;
     }
 }
 
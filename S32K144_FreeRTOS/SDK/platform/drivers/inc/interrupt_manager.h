@@ -70,6 +70,24 @@ typedef enum
 /*! @brief Interrupt handler type */
 typedef void (* isr_t)(void);
 
+#if defined(INT_SYS_PROFILING)
+
+/*!
+ * @brief Statistics of an interrupt, recorded by the profiling dispatcher.
+ *
+ * The cycles are core cycles (DWT cycle counter) spent in the handler itself,
+ * the cycles of the nested interrupts are not included.
+ */
+typedef struct
+{
+    uint32_t count;         /*!< Number of invocations */
+    uint32_t maxCycles;     /*!< Maximum cycles of an invocation */
+    uint64_t totalCycles;   /*!< Cumulative cycles of all the invocations */
+    uint8_t maxDepth;       /*!< Maximum nesting depth of an invocation (1: not nested) */
+} interrupt_manager_profile_t;
+
+#endif /* INT_SYS_PROFILING */
+
 /*******************************************************************************
  * Default interrupt handler - implemented in startup.s
  ******************************************************************************/
@@ -109,6 +127,39 @@ void INT_SYS_InstallHandler(IRQn_Type irqNumber,
                             const isr_t newHandler,
                             isr_t* const oldHandler);
 
+#if defined(INT_SYS_PROFILING)
+
+/*!
+ * @brief Profiles the handler currently in the vector table for a given IRQ number.
+ *
+ * The handlers installed with INT_SYS_InstallHandler are profiled already. This
+ * function wraps the handlers linked in the vector table at build time (e.g.
+ * SysTick_Handler or the FTM handlers). SVCall, PendSV and the fault exceptions
+ * are never wrapped, their handlers depend on the exception stack frame.
+ *
+ * @param irqNumber IRQ number
+ */
+void INT_SYS_ProfileIRQ(IRQn_Type irqNumber);
+
+/*!
+ * @brief Gets the statistics of an interrupt.
+ *
+ * The statistics are copied with the interrupts disabled, so they are
+ * consistent even if the interrupt is active.
+ *
+ * @param irqNumber IRQ number
+ * @param profile   Pointer to a location to store the statistics
+ */
+void INT_SYS_GetProfile(IRQn_Type irqNumber,
+                        interrupt_manager_profile_t * const profile);
+
+/*!
+ * @brief Clears the statistics of all the interrupts.
+ */
+void INT_SYS_ClearProfiles(void);
+
+#endif /* INT_SYS_PROFILING */
+
 /*!
  * @brief Enables an interrupt for a given IRQ number.
  *
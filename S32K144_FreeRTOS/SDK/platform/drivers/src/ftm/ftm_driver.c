@@ -87,43 +87,45 @@ static const clock_names_t g_ftmExtClockSel[FTM_INSTANCE_COUNT][2] = {{SIM_FTM0_
 /*******************************************************************************
  * Code
  ******************************************************************************/
+/* The channel interrupts run from RAM (HOT_PATH_RAMSECTION), they time stamp the
+ * input captures. */
 static void FTM_DRV_InputCaptureHandler(uint32_t instance,
-                                        uint8_t channelPair);
+                                        uint8_t channelPair) HOT_PATH_RAMSECTION;
 
 static void FTM_DRV_IrqHandler(uint32_t instance,
-                               uint8_t channelPair);
+                               uint8_t channelPair) HOT_PATH_RAMSECTION;
 
-void FTM0_Ch0_Ch1_IRQHandler(void);
+void FTM0_Ch0_Ch1_IRQHandler(void) HOT_PATH_RAMSECTION;
 
-void FTM0_Ch2_Ch3_IRQHandler(void);
+void FTM0_Ch2_Ch3_IRQHandler(void) HOT_PATH_RAMSECTION;
 
-void FTM0_Ch4_Ch5_IRQHandler(void);
+void FTM0_Ch4_Ch5_IRQHandler(void) HOT_PATH_RAMSECTION;
 
-void FTM0_Ch6_Ch7_IRQHandler(void);
+void FTM0_Ch6_Ch7_IRQHandler(void) HOT_PATH_RAMSECTION;
 
-void FTM1_Ch0_Ch1_IRQHandler(void);
+void FTM1_Ch0_Ch1_IRQHandler(void) HOT_PATH_RAMSECTION;
 
-void FTM1_Ch2_Ch3_IRQHandler(void);
+void FTM1_Ch2_Ch3_IRQHandler(void) HOT_PATH_RAMSECTION;
 
-void FTM1_Ch4_Ch5_IRQHandler(void);
+void FTM1_Ch4_Ch5_IRQHandler(void) HOT_PATH_RAMSECTION;
 
-void FTM1_Ch6_Ch7_IRQHandler(void);
+void FTM1_Ch6_Ch7_IRQHandler(void) HOT_PATH_RAMSECTION;
 
-void FTM2_Ch0_Ch1_IRQHandler(void);
+void FTM2_Ch0_Ch1_IRQHandler(void) HOT_PATH_RAMSECTION;
 
-void FTM2_Ch2_Ch3_IRQHandler(void);
+void FTM2_Ch2_Ch3_IRQHandler(void) HOT_PATH_RAMSECTION;
 
-void FTM2_Ch4_Ch5_IRQHandler(void);
+void FTM2_Ch4_Ch5_IRQHandler(void) HOT_PATH_RAMSECTION;
 
-void FTM2_Ch6_Ch7_IRQHandler(void);
+void FTM2_Ch6_Ch7_IRQHandler(void) HOT_PATH_RAMSECTION;
 
-void FTM3_Ch0_Ch1_IRQHandler(void);
+void FTM3_Ch0_Ch1_IRQHandler(void) HOT_PATH_RAMSECTION;
 
-void FTM3_Ch2_Ch3_IRQHandler(void);
+void FTM3_Ch2_Ch3_IRQHandler(void) HOT_PATH_RAMSECTION;
 
-void FTM3_Ch4_Ch5_IRQHandler(void);
+void FTM3_Ch4_Ch5_IRQHandler(void) HOT_PATH_RAMSECTION;
 
-void FTM3_Ch6_Ch7_IRQHandler(void);
+void FTM3_Ch6_Ch7_IRQHandler(void) HOT_PATH_RAMSECTION;
 
 /*FUNCTION**********************************************************************
  *
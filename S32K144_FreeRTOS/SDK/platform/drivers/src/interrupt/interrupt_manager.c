@@ -68,6 +68,42 @@ static int32_t g_interruptDisableCount = 0;
  */
 extern uint32_t __VECTOR_RAM[((uint32_t)(FEATURE_INTERRUPT_IRQ_MAX)) + 16U + 1U];
 
+#if defined(INT_SYS_PROFILING)
+
+/*!
+ * @brief Number of vectors of the vector table.
+ */
+#define INT_SYS_VECTOR_COUNT    (((uint32_t)(FEATURE_INTERRUPT_IRQ_MAX)) + 16U + 1U)
+
+/*!
+ * @brief DWT cycle counter, enabled from the reset by the application.
+ */
+#define INT_SYS_CYCLE_COUNTER   (*(volatile uint32_t *)0xE0001004U)
+
+/*!
+ * @brief Handlers called by the profiling dispatcher, by vector number.
+ */
+static isr_t s_profileHandlers[INT_SYS_VECTOR_COUNT];
+
+/*!
+ * @brief Statistics of the interrupts, by vector number.
+ */
+static interrupt_manager_profile_t s_profiles[INT_SYS_VECTOR_COUNT];
+
+/*!
+ * @brief Current nesting depth of the profiled interrupts.
+ */
+static uint8_t s_profileDepth = 0U;
+
+/*!
+ * @brief Cycles of the interrupts nested in the current one.
+ */
+static uint32_t s_profileNestedCycles = 0U;
+
+static void INT_SYS_ProfileDispatch(void) HOT_PATH_RAMSECTION;
+
+#endif /* INT_SYS_PROFILING */
+
 /*******************************************************************************
  * Code
  ******************************************************************************/
@@ -105,6 +141,14 @@ void INT_SYS_InstallHandler(IRQn_Type irqNumber,
     if (oldHandler != (isr_t *) 0)
     {
         *oldHandler = (isr_t)__VECTOR_RAM[((int32_t)irqNumber) + 16];
+
+#if defined(INT_SYS_PROFILING)
+        /* Return the wrapped handler, not the dispatcher */
+        if (*oldHandler == INT_SYS_ProfileDispatch)
+        {
+            *oldHandler = s_profileHandlers[((int32_t)irqNumber) + 16];
+        }
+#endif /* INT_SYS_PROFILING */
     }
 
 #if FEATURE_MSCM_HAS_INTERRUPT_ROUTER
@@ -119,10 +163,131 @@ void INT_SYS_InstallHandler(IRQn_Type irqNumber,
 
 #endif /* FEATURE_MSCM_HAS_INTERRUPT_ROUTER */
 
+#if defined(INT_SYS_PROFILING)
+
+    /* SVCall, PendSV and the faults are installed as they are */
+    if (((int32_t)irqNumber >= (int32_t)SysTick_IRQn) && (newHandler != (isr_t)0) && (newHandler != INT_SYS_ProfileDispatch))
+    {
+        /* The handler is set before the dispatcher can call it */
+        s_profileHandlers[((int32_t)irqNumber) + 16] = newHandler;
+        __VECTOR_RAM[((int32_t)irqNumber) + 16] = (uint32_t)INT_SYS_ProfileDispatch;
+        return;
+    }
+
+#endif /* INT_SYS_PROFILING */
+
     /* Set handler into vector table */
     __VECTOR_RAM[((int32_t)irqNumber) + 16] = (uint32_t)newHandler;
 }
 
+#if defined(INT_SYS_PROFILING)
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : INT_SYS_ProfileIRQ
+ * Description   : Profile the handler currently in the vector table
+ * This function installs again the handler linked in the vector table for
+ * the specified IRQ number, so it is wrapped by the profiling dispatcher.
+ *
+ *END**************************************************************************/
+void INT_SYS_ProfileIRQ(IRQn_Type irqNumber)
+{
+    /* A vector with the dispatcher already is left as it is */
+    INT_SYS_InstallHandler(irqNumber, (isr_t)__VECTOR_RAM[((int32_t)irqNumber) + 16], (isr_t *)0);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : INT_SYS_GetProfile
+ * Description   : Get the statistics of an interrupt
+ * This function copies the statistics of the specified IRQ number with the
+ * interrupts disabled.
+ *
+ *END**************************************************************************/
+void INT_SYS_GetProfile(IRQn_Type irqNumber,
+                        interrupt_manager_profile_t * const profile)
+{
+    /* Check IRQ number */
+    DEV_ASSERT(FEATURE_INTERRUPT_IRQ_MIN <= irqNumber);
+    DEV_ASSERT(irqNumber <= FEATURE_INTERRUPT_IRQ_MAX);
+    DEV_ASSERT(profile != (interrupt_manager_profile_t *)0);
+
+    INT_SYS_DisableIRQGlobal();
+    *profile = s_profiles[((int32_t)irqNumber) + 16];
+    INT_SYS_EnableIRQGlobal();
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : INT_SYS_ClearProfiles
+ * Description   : Clear the statistics of all the interrupts
+ *
+ *END**************************************************************************/
+void INT_SYS_ClearProfiles(void)
+{
+    uint32_t vector;
+
+    INT_SYS_DisableIRQGlobal();
+
+    for (vector = 0U; vector < INT_SYS_VECTOR_COUNT; vector++)
+    {
+        s_profiles[vector].count = 0U;
+        s_profiles[vector].maxCycles = 0U;
+        s_profiles[vector].totalCycles = 0U;
+        s_profiles[vector].maxDepth = 0U;
+    }
+
+    INT_SYS_EnableIRQGlobal();
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : INT_SYS_ProfileDispatch
+ * Description   : Profiling dispatcher, installed in the vector table
+ * This function finds the active vector, calls its handler and records
+ * its statistics. The cycles of the nested interrupts are subtracted, so
+ * each interrupt accounts only for its own cycles. An interrupt nested in
+ * the few instructions around the call of the handler is accounted to the
+ * wrapped one, never more than once.
+ *
+ *END**************************************************************************/
+static void INT_SYS_ProfileDispatch(void)
+{
+    uint32_t start = INT_SYS_CYCLE_COUNTER;
+    uint32_t vector = S32_SCB->ICSR & S32_SCB_ICSR_VECTACTIVE_MASK;
+    interrupt_manager_profile_t * profile = &s_profiles[vector];
+    uint32_t outerCycles = s_profileNestedCycles;
+    uint32_t nestedCycles;
+    uint32_t cycles;
+
+    s_profileNestedCycles = 0U;
+    s_profileDepth++;
+
+    if (s_profileDepth > profile->maxDepth)
+    {
+        profile->maxDepth = s_profileDepth;
+    }
+
+    s_profileHandlers[vector]();
+
+    /* The nested cycles are read first, they are always part of the cycles */
+    nestedCycles = s_profileNestedCycles;
+    cycles = INT_SYS_CYCLE_COUNTER - start;
+
+    s_profileDepth--;
+    s_profileNestedCycles = outerCycles + cycles;
+
+    profile->count++;
+    profile->totalCycles += (uint64_t)(cycles - nestedCycles);
+
+    if ((cycles - nestedCycles) > profile->maxCycles)
+    {
+        profile->maxCycles = cycles - nestedCycles;
+    }
+}
+
+#endif /* INT_SYS_PROFILING */
+
 /*FUNCTION**********************************************************************
  *
  * Function Name : INT_SYS_EnableIRQ
@@ -663,6 +663,10 @@ extern "C" {
 	#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )
 #endif
 
+#ifndef portHOT_PATH
+	#define portHOT_PATH
+#endif
+
 #ifndef configEXPECTED_IDLE_TIME_BEFORE_SLEEP
 	#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP 2
 #endif
@@ -162,8 +162,8 @@ void vPortSetupTimerInterrupt( void );
 /*
  * Exception handlers.
  */
-void xPortPendSVHandler( void ) __attribute__ (( naked ));
-void xPortSysTickHandler( void );
+void xPortPendSVHandler( void ) __attribute__ (( naked )) portHOT_PATH;
+void xPortSysTickHandler( void ) portHOT_PATH;
 void vPortSVCHandler( void ) __attribute__ (( naked ));
 
 /*
@@ -206,6 +206,13 @@ not necessary for to use this port.  They are defined so the common demo files
 	#define portFORCE_INLINE inline __attribute__(( always_inline))
 #endif
 
+/* The context switch and the tick run from RAM, so a flash build runs them
+without the flash wait states.  Define HOT_PATHS_IN_FLASH to leave them in
+flash. */
+#ifndef HOT_PATHS_IN_FLASH
+	#define portHOT_PATH __attribute__(( section( ".code_ram" ), noinline, long_call ))
+#endif
+
 /*-----------------------------------------------------------*/
 
 portFORCE_INLINE static void vPortRaiseBASEPRI( void )
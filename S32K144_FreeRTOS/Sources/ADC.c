@@ -5,6 +5,9 @@
 
 #include "ADC.h"
 
+#define ADC_VREFH_MV    5000            /* VREFH, in mV */
+#define ADC_FULL_SCALE  0xFFF           /* Highest 12-bit result (MODE=1) */
+
 uint16_t adcResult = 0;                 /* ADC conversion result */
 
 void ADC_init(void)  {
@@ -17,15 +20,27 @@ void ADC_init(void)  {
                                   /* AIEN=0: Interrupts are disabled */
   ADC0->CFG1 = 0x000000004;       /* ADICLK=0: Input clk=ALTCLK1=SOSCDIV2 */
                                   /* ADIV=0: Prescaler=1 */
-                                  /* MODE=1: 10-bit conversion */
+                                  /* MODE=1: 12-bit conversion */
   ADC0->CFG2 = 0x00000000C;       /* SMPLTS=12(default): sample time is 13 ADC clks */
   ADC0->SC2 = 0x00000000;         /* ADTRG=0: SW trigger */
                                   /* ACFE,ACFGT,ACREN=0: Compare func disabled */
                                   /* DMAEN=0: DMA disabled */
                                   /* REFSEL=0: Voltage reference pins= VREFH, VREEFL */
-  ADC0->SC3 = 0x00000000;         /* CAL=0: Do not start calibration sequence */
+  ADC0->CLPS = 0;                 /* Calibration starts from the reset values */
+  ADC0->CLP3 = 0;
+  ADC0->CLP2 = 0;
+  ADC0->CLP1 = 0;
+  ADC0->CLP0 = 0;
+  ADC0->CLPX = 0;
+  ADC0->CLP9 = 0;
+  ADC0->SC3 = 0x00000087;         /* CAL=1: Start calibration sequence */
+                                  /* AVGE=1,AVGS=3: 32 samples averaged */
+  while(ADC0->SC3 & ADC_SC3_CAL_MASK) {}  /* Wait for the calibration */
+  (void)ADC0->R[0];               /* Clear the COCO flag of the calibration */
+
+  ADC0->SC3 = 0x00000004;         /* CAL=0: Calibration done */
                                   /* ADCO=0: One conversion performed */
-                                  /* AVGE,AVGS=0: HW average function disabled */
+                                  /* AVGE=1,AVGS=0: 4 samples averaged */
 }
 
 void convertAdcChan(uint16_t adcChan) {   /* For SW trigger mode, SC1[0] is used */
@@ -40,6 +55,6 @@ uint8_t adc_complete(void)  {
 uint32_t read_adc_chx(void)  {
   uint16_t adc_result=0;
   adc_result=ADC0->R[0];      /* For SW trigger mode, R[0] is used */
-  return  (uint32_t) ((5000*adc_result)/0xFFF); /* Convert result to mv for 0-5V range */
+  return  (uint32_t) (((ADC_VREFH_MV*adc_result)+(ADC_FULL_SCALE/2))/ADC_FULL_SCALE); /* Convert result to mv for 0-5V range, rounded */
 }
 
@@ -0,0 +1,182 @@
+/*!
+ 	 \file adc_monitor.c
+
+ 	 \brief This is the source file of the threshold monitor of an analog input.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include "adc_monitor.h"
+#include <stdbool.h>
+#include "adc_scan.h"
+#include "S32K144.h"
+#include "interrupt_manager.h"
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+
+/** Defines the monitor as initialized*/
+#define IS_INIT								(1)
+/** Defines the monitor as not initialized*/
+#define NOT_INIT							(0)
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL							(0)
+
+/** Defines the ADC of the monitor*/
+#define ADC_MONITOR_INSTANCE				(1U)
+/** Defines the clock of the ADC (SIRCDIV2, as the scan)*/
+#define ADC_MONITOR_CLOCK_SOURCE			(2)
+/** Defines the 12 bit conversion mode*/
+#define ADC_MONITOR_MODE_12_BIT				(1)
+/** Defines the sample time, in ADC clocks minus 1 (The default)*/
+#define ADC_MONITOR_SAMPLE_TIME				(12)
+/** Defines the hardware average of the conversions (32 samples, the input is slow)*/
+#define ADC_MONITOR_HW_AVERAGE				(3)
+
+/*!
+ 	 \brief Structure for the monitor handler.
+ */
+typedef struct
+{
+	uint8_t init_val;										/*!< Defines whether the monitor has been initialized or not*/
+	uint16_t thresholds[ADC_MONITOR_THRESHOLDS_MAX];		/*!< Thresholds between the zones*/
+	uint8_t thresholds_count;								/*!< Number of thresholds*/
+	uint16_t hysteresis;									/*!< Conversions past a threshold to leave a zone*/
+	ADC_MONITOR_callback_t callback;						/*!< Callback of the zone changes*/
+	volatile uint8_t zone;									/*!< Current zone*/
+}adc_monitor_handler_t;
+
+/** Handler of the monitor*/
+static adc_monitor_handler_t adc_monitor_handler = { NOT_INIT };
+
+/*!
+ 	 \brief This function sets the compare window to a zone, widened by the hysteresis.
+ 	 	 	 The conversions inside the window do not complete.
+
+ 	 \param[in] zone Zone.
+
+ 	 \return void.
+ */
+static void adc_monitor_set_window(uint8_t zone);
+
+/** This function starts the monitor*/
+status_t ADC_MONITOR_init(const ADC_MONITOR_config_t* config)
+{
+	uint8_t threshold;
+
+	if((INIT_VAL == config->thresholds_count) || (ADC_MONITOR_THRESHOLDS_MAX < config->thresholds_count))
+	{
+		return STATUS_ERROR;
+	}
+
+	for(threshold = INIT_VAL ; threshold < config->thresholds_count ; threshold ++)
+	{
+		/** The zones must not be empty*/
+		if((INIT_VAL != threshold) && (config->thresholds[threshold] <= config->thresholds[threshold - 1]))
+		{
+			return STATUS_ERROR;
+		}
+
+		adc_monitor_handler.thresholds[threshold] = config->thresholds[threshold];
+	}
+
+	adc_monitor_handler.thresholds_count = config->thresholds_count;
+	adc_monitor_handler.hysteresis = config->hysteresis;
+	adc_monitor_handler.callback = config->callback;
+	adc_monitor_handler.zone = INIT_VAL;
+
+	/** Clocks the ADC from SIRCDIV2*/
+	PCC->PCCn[PCC_ADC1_INDEX] &= ~PCC_PCCn_CGC_MASK;
+	PCC->PCCn[PCC_ADC1_INDEX] = PCC_PCCn_PCS(ADC_MONITOR_CLOCK_SOURCE) | PCC_PCCn_CGC_MASK;
+
+	ADC1->SC1[0] = ADC_SC1_ADCH_MASK;
+	ADC1->CFG1 = ADC_CFG1_MODE(ADC_MONITOR_MODE_12_BIT);
+	ADC1->CFG2 = ADC_CFG2_SMPLTS(ADC_MONITOR_SAMPLE_TIME);
+
+	if(STATUS_SUCCESS != ADC_SCAN_calibrate(ADC_MONITOR_INSTANCE))
+	{
+		return STATUS_TIMEOUT;
+	}
+
+	/** Software trigger, without compare until the first zone is known*/
+	ADC1->SC2 = INIT_VAL;
+	ADC1->SC3 = ADC_SC3_ADCO_MASK | ADC_SC3_AVGE_MASK | ADC_SC3_AVGS(ADC_MONITOR_HW_AVERAGE);
+
+	/** The zone changes are published from the interrupt, which may use the kernel*/
+	INT_SYS_SetPriority(ADC1_IRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY);
+	INT_SYS_EnableIRQ(ADC1_IRQn);
+
+	/** Sets the handler as initialized*/
+	adc_monitor_handler.init_val = IS_INIT;
+
+	/** Writing the channel starts the continuous conversions*/
+	ADC1->SC1[0] = ADC_SC1_ADCH(config->channel) | ADC_SC1_AIEN_MASK;
+
+	return STATUS_SUCCESS;
+}
+
+/** This function gets the current zone*/
+uint8_t ADC_MONITOR_get_zone(void)
+{
+	return adc_monitor_handler.zone;
+}
+
+/** This function handles a conversion out of the zone*/
+void ADC1_IRQHandler(void)
+{
+	/** Reading the result clears the conversion complete flag*/
+	uint16_t result = (uint16_t)ADC1->R[0];
+	/** Zone of the conversion*/
+	uint8_t zone = INIT_VAL;
+	/** The first conversion completes without compare, the next ones only out of the zone*/
+	bool first = (INIT_VAL == (ADC1->SC2 & ADC_SC2_ACFE_MASK));
+
+	while((adc_monitor_handler.thresholds_count > zone) && (result >= adc_monitor_handler.thresholds[zone]))
+	{
+		zone ++;
+	}
+
+	adc_monitor_set_window(zone);
+
+	if(first || (zone != adc_monitor_handler.zone))
+	{
+		adc_monitor_handler.zone = zone;
+
+		if(NULL != adc_monitor_handler.callback)
+		{
+			adc_monitor_handler.callback(zone, result);
+		}
+	}
+}
+
+/** This function sets the compare window to a zone*/
+static void adc_monitor_set_window(uint8_t zone)
+{
+	/** Lowest conversion of the window*/
+	uint32_t low = INIT_VAL;
+	/** Highest conversion of the window*/
+	uint32_t high = ADC_MONITOR_RESULT_MAX;
+
+	if(INIT_VAL != zone)
+	{
+		low = adc_monitor_handler.thresholds[zone - 1];
+		low = (adc_monitor_handler.hysteresis < low) ? (low - adc_monitor_handler.hysteresis) : INIT_VAL;
+	}
+
+	if(adc_monitor_handler.thresholds_count > zone)
+	{
+		high = adc_monitor_handler.thresholds[zone] - 1U + adc_monitor_handler.hysteresis;
+		high = (ADC_MONITOR_RESULT_MAX < high) ? ADC_MONITOR_RESULT_MAX : high;
+	}
+
+	/** Compare true outside of CV1..CV2 (Range, not inclusive, with CV1 <= CV2)*/
+	ADC1->CV[0] = low;
+	ADC1->CV[1] = high;
+	ADC1->SC2 = ADC_SC2_ACFE_MASK | ADC_SC2_ACREN_MASK;
+}
@@ -0,0 +1,79 @@
+/*!
+ 	 \file adc_monitor.h
+
+ 	 \brief This is the header file of the threshold monitor of an analog input.
+ 	 	 	 ADC1 converts the input continuously, with the compare function set to
+ 	 	 	 the window of the current zone, so a conversion only completes (And
+ 	 	 	 interrupts) when the input leaves its zone. The interrupt moves the
+ 	 	 	 window to the new zone and calls the callback, so the CPU never polls
+ 	 	 	 the input.
+
+ 	 \note The compare function applies to every conversion of an ADC, and the scan
+ 	 	 	 of ADC0 (adc_scan.h) must complete all of them, so the monitor runs on ADC1.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef ADC_MONITOR_H_
+#define ADC_MONITOR_H_
+
+#include <stdint.h>
+#include "status.h"
+
+/** Defines the maximum number of thresholds (The zones are one more)*/
+#define ADC_MONITOR_THRESHOLDS_MAX			(4)
+/** Defines the reference of the conversions (VREFH), in mV*/
+#define ADC_MONITOR_VREF_MV					(5000UL)
+/** Defines the highest conversion (12 bits)*/
+#define ADC_MONITOR_RESULT_MAX				(0xFFFUL)
+/** Converts a voltage in mV to a conversion, for the thresholds*/
+#define ADC_MONITOR_MV(mv)					((uint16_t)((((mv) * ADC_MONITOR_RESULT_MAX) + (ADC_MONITOR_VREF_MV / 2)) / ADC_MONITOR_VREF_MV))
+
+/*!
+ 	 \brief Callback of a zone change. It runs in the ADC1 interrupt, so it must be
+ 	 	 	 short (e.g. set an event).
+
+ 	 \param[in] zone New zone (0 is below the first threshold).
+ 	 \param[in] result Conversion that left the previous zone (12 bits).
+ */
+typedef void (*ADC_MONITOR_callback_t)(uint8_t zone, uint16_t result);
+
+/*!
+ 	 \brief Structure for the configuration of the monitor.
+ */
+typedef struct
+{
+	uint8_t channel;					/*!< ADC1 channel of the input*/
+	const uint16_t* thresholds;			/*!< Thresholds between the zones, ascending (12 bits)*/
+	uint8_t thresholds_count;			/*!< Number of thresholds (Up to ADC_MONITOR_THRESHOLDS_MAX)*/
+	uint16_t hysteresis;				/*!< Conversions past a threshold to leave a zone*/
+	ADC_MONITOR_callback_t callback;	/*!< Callback of the zone changes*/
+}ADC_MONITOR_config_t;
+
+/*!
+ 	 \brief This function calibrates ADC1 and starts the continuous conversions of the
+ 	 	 	 input. The first conversion always completes, and gives the initial zone
+ 	 	 	 through the callback.
+
+ 	 \note The calibration waits for the ADC, so it is called before the scheduler starts.
+
+ 	 \param[in] config Configuration (The thresholds are copied).
+
+ 	 \return STATUS_ERROR if the thresholds are not valid, STATUS_TIMEOUT if the
+ 	 	 	 calibration did not finish.
+ */
+status_t ADC_MONITOR_init(const ADC_MONITOR_config_t* config);
+
+/*!
+ 	 \brief This function gets the current zone of the input.
+
+ 	 \return Zone (0 is below the first threshold).
+ */
+uint8_t ADC_MONITOR_get_zone(void);
+
+#endif /* ADC_MONITOR_H_ */
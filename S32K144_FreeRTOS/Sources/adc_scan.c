@@ -0,0 +1,419 @@
+/*!
+ 	 \file adc_scan.c
+
+ 	 \brief This is the source file of the ADC scan of the motor current and the
+ 	 	 	 potentiometer, triggered by the PWM through the TRGMUX and the PDB.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include "adc_scan.h"
+#include "cic_filter.h"
+#include "S32K144.h"
+#include "clock_manager.h"
+#include "interrupt_manager.h"
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/** Defines the ADC scan handler as initialized*/
+#define IS_INIT								(1)
+/** Defines the ADC scan handler as not initialized*/
+#define NOT_INIT							(0)
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL							(0)
+
+/** Defines the ADC of the scan*/
+#define ADC_SCAN_INSTANCE					(0U)
+/** Defines the clock of the ADC (SIRCDIV2, 8 MHz as the SOSCDIV2 of ADC_init, and it runs in VLPR)*/
+#define ADC_SCAN_CLOCK_SOURCE				(2)
+/** Defines the 12 bit conversion mode*/
+#define ADC_SCAN_MODE_12_BIT				(1)
+/** Defines the sample time, in ADC clocks minus 1 (The default)*/
+#define ADC_SCAN_SAMPLE_TIME				(12)
+/** Defines the hardware average of the conversions (4 samples)*/
+#define ADC_SCAN_HW_AVERAGE					(0)
+/** Defines the hardware average of the calibration (32 samples, as recommended)*/
+#define ADC_SCAN_CAL_AVERAGE				(3)
+/** Defines the maximum polls of the calibration (It takes a few thousand ADC clocks)*/
+#define ADC_SCAN_CAL_TIMEOUT				(100000U)
+
+/** Defines the PDB trigger input from the TRGMUX*/
+#define ADC_SCAN_PDB_TRIGGER_TRGMUX			(0)
+/** Defines the PDB trigger input of software*/
+#define ADC_SCAN_PDB_TRIGGER_SOFTWARE		(15)
+/** Defines the highest prescaler of the PDB (Divided by 128)*/
+#define ADC_SCAN_PDB_PS_MAX					(7)
+/** Defines the maximum value of the PDB counter*/
+#define ADC_SCAN_PDB_COUNTER_MAX			(0xFFFF)
+/** Defines the pre-triggers of the scan, one per input*/
+#define ADC_SCAN_PRETRIGGERS				((1U << adc_scan_inputs) - 1U)
+/** Defines the pre-trigger started by the delay, the rest start back to back on the previous conversion*/
+#define ADC_SCAN_FIRST_PRETRIGGER			(1U)
+
+/** Defines the TRGMUX source of the initialization trigger of FTM 0*/
+#define ADC_SCAN_TRGMUX_FTM0_INIT			(22U)
+/** Defines the distance between the sources of consecutive FTMs (Initialization and external triggers)*/
+#define ADC_SCAN_TRGMUX_FTM_STEP			(2U)
+/** Defines the number of FTMs with PWM that can trigger the scan*/
+#define ADC_SCAN_FTM_COUNT					(2U)
+
+/*!
+ 	 \brief Structure for the ADC scan handler.
+ */
+typedef struct
+{
+	uint8_t init_val;							/*!< Defines whether the handler has been initialized or not*/
+	uint16_t period;							/*!< PWM period, in PDB counts*/
+	uint8_t prescaler;							/*!< Prescaler of the PDB*/
+	uint32_t scan_rate;							/*!< Scans per second (PWM frequency)*/
+	uint32_t instance;							/*!< FTM of the triggers, or ADC_SCAN_FREE_RUN*/
+	uint16_t results[adc_scan_inputs];			/*!< Conversions of the last scan*/
+	volatile uint32_t scans;					/*!< Scans completed*/
+	CIC_FILTER_t filters[adc_scan_inputs];		/*!< Decimation filters*/
+	uint16_t filtered[adc_scan_inputs];			/*!< Last filtered results*/
+	volatile uint32_t outputs;					/*!< Filtered results completed*/
+	ADC_SCAN_callback_t filter_callback;		/*!< Callback of the filtered results*/
+	volatile uint32_t errors;					/*!< Triggers lost*/
+	ADC_SCAN_callback_t callback;				/*!< Callback of the completed scans*/
+}adc_scan_handler_t;
+
+/** Channels of the scan, in the order of adc_scan_input_t*/
+static const uint8_t adc_scan_channels[adc_scan_inputs] =
+{
+	ADC_SCAN_CURRENT_CHANNEL,
+	ADC_SCAN_POT_CHANNEL
+};
+
+/** Handler of the ADC scan*/
+static adc_scan_handler_t adc_scan_handler = { NOT_INIT };
+/** ADCs, by instance*/
+static ADC_Type* const adc_scan_bases[ADC_INSTANCE_COUNT] = ADC_BASE_PTRS;
+
+/*!
+ 	 \brief This function sets the period of the PDB to the scan rate, with the
+ 	 	 	 current bus clock.
+
+ 	 \return void.
+ */
+static void adc_scan_set_period(void);
+
+/*********************************************************************************************/
+
+/** This function starts the scan*/
+status_t ADC_SCAN_init(uint32_t pwm_frequency)
+{
+	uint8_t input;
+
+	adc_scan_handler.scan_rate = pwm_frequency;
+	adc_scan_set_period();
+	adc_scan_handler.scans = INIT_VAL;
+	adc_scan_handler.errors = INIT_VAL;
+	adc_scan_handler.callback = NULL;
+	adc_scan_handler.filter_callback = NULL;
+
+	/** Clocks the ADC from SIRCDIV2 and the PDB from the bus*/
+	PCC->PCCn[PCC_ADC0_INDEX] &= ~PCC_PCCn_CGC_MASK;
+	PCC->PCCn[PCC_ADC0_INDEX] = PCC_PCCn_PCS(ADC_SCAN_CLOCK_SOURCE) | PCC_PCCn_CGC_MASK;
+	PCC->PCCn[PCC_PDB0_INDEX] |= PCC_PCCn_CGC_MASK;
+
+	/** 12 bit conversions started by the PDB pre-triggers, once calibrated*/
+	ADC0->CFG1 = ADC_CFG1_MODE(ADC_SCAN_MODE_12_BIT);
+	ADC0->CFG2 = ADC_CFG2_SMPLTS(ADC_SCAN_SAMPLE_TIME);
+
+	if(STATUS_SUCCESS != ADC_SCAN_calibrate(ADC_SCAN_INSTANCE))
+	{
+		return STATUS_TIMEOUT;
+	}
+
+	ADC0->SC2 = ADC_SC2_ADTRG_MASK;
+	ADC0->SC3 = ADC_SC3_AVGE_MASK | ADC_SC3_AVGS(ADC_SCAN_HW_AVERAGE);
+
+	/** Each pre-trigger converts its input, only the last one interrupts*/
+	for(input = INIT_VAL ; input < adc_scan_inputs ; input ++)
+	{
+		ADC0->SC1[input] = ADC_SC1_ADCH(adc_scan_channels[input]) |
+						   ((adc_scan_inputs - 1 == input) ? ADC_SC1_AIEN_MASK : INIT_VAL);
+	}
+
+	/** The ADC is triggered by the PDB pre-triggers*/
+	SIM->ADCOPT &= ~(SIM_ADCOPT_ADC0TRGSEL_MASK | SIM_ADCOPT_ADC0SWPRETRG_MASK | SIM_ADCOPT_ADC0PRETRGSEL_MASK);
+
+	/** Both PWM FTMs give a trigger at the start of their period (Only the running one counts)*/
+	FTM0->EXTTRIG |= FTM_EXTTRIG_INITTRIGEN_MASK;
+	FTM1->EXTTRIG |= FTM_EXTTRIG_INITTRIGEN_MASK;
+
+	/** The results are published from the interrupt, which may use the kernel*/
+	INT_SYS_SetPriority(ADC0_IRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY);
+	INT_SYS_EnableIRQ(ADC0_IRQn);
+
+	/** Sets the handler as initialized*/
+	adc_scan_handler.init_val = IS_INIT;
+
+	ADC_SCAN_set_output_rate(ADC_SCAN_DEFAULT_OUTPUT_RATE);
+	ADC_SCAN_sync(ADC_SCAN_FREE_RUN);
+
+	return STATUS_SUCCESS;
+}
+
+/** This function syncs the scan to a PWM*/
+void ADC_SCAN_sync(uint32_t instance)
+{
+	/** Trigger of the PDB*/
+	uint32_t trigger = ADC_SCAN_PDB_TRIGGER_TRGMUX;
+	/** Continuous mode of the PDB*/
+	uint32_t continuous = INIT_VAL;
+
+	if(IS_INIT != adc_scan_handler.init_val)
+	{
+		return;
+	}
+
+	adc_scan_handler.instance = instance;
+
+	if(ADC_SCAN_FTM_COUNT > instance)
+	{
+		/** The initialization trigger of the FTM starts the PDB once per period*/
+		TRGMUX->TRGMUXn[TRGMUX_PDB0_INDEX] = TRGMUX_TRGMUXn_SEL0(ADC_SCAN_TRGMUX_FTM0_INIT + (instance * ADC_SCAN_TRGMUX_FTM_STEP));
+	}
+
+	else
+	{
+		/** Without PWM the PDB restarts itself every period*/
+		trigger = ADC_SCAN_PDB_TRIGGER_SOFTWARE;
+		continuous = PDB_SC_CONT_MASK;
+	}
+
+	/** The interrupt must not clear the errors while the PDB is set*/
+	taskENTER_CRITICAL();
+
+	/** Disabling the PDB stops and clears its counter, so no scan is started in between*/
+	PDB0->SC = INIT_VAL;
+	PDB0->MOD = PDB_MOD_MOD(adc_scan_handler.period - 1U);
+	/** The drive pulse is centered at the top of the center aligned counter, half a period after its start*/
+	PDB0->CH[0].DLY[0] = PDB_DLY_DLY(adc_scan_handler.period >> 1);
+	PDB0->CH[0].C1 = PDB_C1_EN(ADC_SCAN_PRETRIGGERS) | PDB_C1_TOS(ADC_SCAN_FIRST_PRETRIGGER) |
+					 PDB_C1_BB(ADC_SCAN_PRETRIGGERS & ~ADC_SCAN_FIRST_PRETRIGGER);
+	PDB0->CH[0].S = INIT_VAL;
+	PDB0->SC = PDB_SC_PDBEN_MASK | PDB_SC_TRGSEL(trigger) | PDB_SC_PRESCALER(adc_scan_handler.prescaler) | continuous;
+	PDB0->SC |= PDB_SC_LDOK_MASK;
+
+	if(ADC_SCAN_PDB_TRIGGER_SOFTWARE == trigger)
+	{
+		PDB0->SC |= PDB_SC_SWTRIG_MASK;
+	}
+
+	taskEXIT_CRITICAL();
+}
+
+/** This function sets the PDB to a new bus clock*/
+void ADC_SCAN_retime(void)
+{
+	if(IS_INIT != adc_scan_handler.init_val)
+	{
+		return;
+	}
+
+	adc_scan_set_period();
+	ADC_SCAN_sync(adc_scan_handler.instance);
+}
+
+/** This function sets the callback*/
+void ADC_SCAN_set_callback(ADC_SCAN_callback_t callback)
+{
+	adc_scan_handler.callback = callback;
+}
+
+/** This function gets the last scan*/
+uint32_t ADC_SCAN_get(uint16_t* results)
+{
+	/** Scans completed*/
+	uint32_t scans;
+	uint8_t input;
+
+	/** The interrupt must not change the results in between*/
+	taskENTER_CRITICAL();
+
+	for(input = INIT_VAL ; input < adc_scan_inputs ; input ++)
+	{
+		results[input] = adc_scan_handler.results[input];
+	}
+
+	scans = adc_scan_handler.scans;
+
+	taskEXIT_CRITICAL();
+
+	return scans;
+}
+
+/** This function sets the output rate of the filter*/
+uint32_t ADC_SCAN_set_output_rate(uint32_t rate)
+{
+	/** Highest decimation of the filter*/
+	uint8_t decimation_max = CIC_FILTER_get_max_decimation(ADC_SCAN_RESULT_BITS);
+	/** Decimation of the scan rate, as a power of 2*/
+	uint8_t decimation = INIT_VAL;
+	uint8_t input;
+
+	while((decimation_max > decimation) && (rate <= (adc_scan_handler.scan_rate >> (decimation + 1))))
+	{
+		decimation ++;
+	}
+
+	/** The interrupt must not filter while the filters restart*/
+	taskENTER_CRITICAL();
+
+	for(input = INIT_VAL ; input < adc_scan_inputs ; input ++)
+	{
+		CIC_FILTER_init(&adc_scan_handler.filters[input], ADC_SCAN_RESULT_BITS, decimation);
+	}
+
+	taskEXIT_CRITICAL();
+
+	return adc_scan_handler.scan_rate >> decimation;
+}
+
+/** This function sets the callback of the filtered results*/
+void ADC_SCAN_set_filter_callback(ADC_SCAN_callback_t callback)
+{
+	adc_scan_handler.filter_callback = callback;
+}
+
+/** This function gets the last filtered results*/
+uint32_t ADC_SCAN_get_filtered(uint16_t* results)
+{
+	/** Filtered results completed*/
+	uint32_t outputs;
+	uint8_t input;
+
+	/** The interrupt must not change the results in between*/
+	taskENTER_CRITICAL();
+
+	for(input = INIT_VAL ; input < adc_scan_inputs ; input ++)
+	{
+		results[input] = adc_scan_handler.filtered[input];
+	}
+
+	outputs = adc_scan_handler.outputs;
+
+	taskEXIT_CRITICAL();
+
+	return outputs;
+}
+
+/** This function gets the triggers lost*/
+uint32_t ADC_SCAN_get_errors(void)
+{
+	return adc_scan_handler.errors;
+}
+
+/** This function publishes a completed scan*/
+void ADC0_IRQHandler(void)
+{
+	/** Whether the filters gave new results (All of them decimate together)*/
+	bool filtered = false;
+	uint8_t input;
+
+	/** Reading the results clears the conversion complete flags*/
+	for(input = INIT_VAL ; input < adc_scan_inputs ; input ++)
+	{
+		adc_scan_handler.results[input] = (uint16_t)ADC0->R[input];
+	}
+
+	/** A trigger during the scan is lost and flagged by the PDB*/
+	if(PDB0->CH[0].S & PDB_S_ERR_MASK)
+	{
+		PDB0->CH[0].S &= ~PDB_S_ERR_MASK;
+		adc_scan_handler.errors ++;
+	}
+
+	adc_scan_handler.scans ++;
+
+	if(NULL != adc_scan_handler.callback)
+	{
+		adc_scan_handler.callback(adc_scan_handler.results);
+	}
+
+	for(input = INIT_VAL ; input < adc_scan_inputs ; input ++)
+	{
+		filtered = CIC_FILTER_update(&adc_scan_handler.filters[input], adc_scan_handler.results[input],
+									 &adc_scan_handler.filtered[input]);
+	}
+
+	if(filtered)
+	{
+		adc_scan_handler.outputs ++;
+
+		if(NULL != adc_scan_handler.filter_callback)
+		{
+			adc_scan_handler.filter_callback(adc_scan_handler.filtered);
+		}
+	}
+}
+
+/** This function calibrates an ADC*/
+status_t ADC_SCAN_calibrate(uint32_t instance)
+{
+	/** ADC to be calibrated*/
+	ADC_Type* base;
+	/** Polls left*/
+	uint32_t timeout = ADC_SCAN_CAL_TIMEOUT;
+
+	if(ADC_INSTANCE_COUNT <= instance)
+	{
+		return STATUS_ERROR;
+	}
+
+	base = adc_scan_bases[instance];
+
+	/** The calibration starts from the reset values, by software, with the highest average*/
+	base->CLPS = INIT_VAL;
+	base->CLP3 = INIT_VAL;
+	base->CLP2 = INIT_VAL;
+	base->CLP1 = INIT_VAL;
+	base->CLP0 = INIT_VAL;
+	base->CLPX = INIT_VAL;
+	base->CLP9 = INIT_VAL;
+	base->SC2 = INIT_VAL;
+	base->SC3 = ADC_SC3_CAL_MASK | ADC_SC3_AVGE_MASK | ADC_SC3_AVGS(ADC_SCAN_CAL_AVERAGE);
+
+	while((base->SC3 & ADC_SC3_CAL_MASK) && (INIT_VAL != timeout))
+	{
+		timeout --;
+	}
+
+	/** Reading the result clears the conversion complete flag of the calibration*/
+	(void)base->R[0];
+
+	return (INIT_VAL != timeout) ? STATUS_SUCCESS : STATUS_TIMEOUT;
+}
+
+/** This function sets the period of the PDB*/
+static void adc_scan_set_period(void)
+{
+	/** Clock of the PDB (Bus clock)*/
+	uint32_t bus_clock = INIT_VAL;
+	/** Period of the PWM in bus clocks*/
+	uint32_t period;
+
+	CLOCK_SYS_GetFreq(BUS_CLOCK, &bus_clock);
+	period = bus_clock / adc_scan_handler.scan_rate;
+
+	/** The smallest prescaler that fits the period in the PDB counter*/
+	adc_scan_handler.prescaler = INIT_VAL;
+
+	while((ADC_SCAN_PDB_COUNTER_MAX < (period >> adc_scan_handler.prescaler)) &&
+		  (ADC_SCAN_PDB_PS_MAX > adc_scan_handler.prescaler))
+	{
+		adc_scan_handler.prescaler ++;
+	}
+
+	adc_scan_handler.period = (uint16_t)(period >> adc_scan_handler.prescaler);
+}
@@ -0,0 +1,168 @@
+/*!
+ 	 \file adc_scan.h
+
+ 	 \brief This is the header file of the ADC scan of the motor current and the
+ 	 	 	 potentiometer. The FTM of the running PWM triggers the PDB through the
+ 	 	 	 TRGMUX at the start of every period, the PDB starts the conversions at
+ 	 	 	 the center of the drive pulse (One after the other), and the interrupt
+ 	 	 	 of the last conversion publishes the results. The CPU never starts nor
+ 	 	 	 waits for a conversion.
+ 	 	 	 Every conversion is the hardware average of 4 samples (Short next to the
+ 	 	 	 PWM period),
+ 	 	 	 and the scans also go through a CIC decimation filter (cic_filter.h),
+ 	 	 	 which gives 16 bit results at a lower, configurable output rate.
+
+ 	 \note The ADC is calibrated once by ADC_SCAN_init, before the scan starts.
+
+ 	 \note While the motor is stopped there is no PWM, so the PDB triggers itself
+ 	 	 	 at the same rate to keep the potentiometer updated.
+
+ 	 \note ADC_init (ADC.c) sets the software trigger, so it must not be called once
+ 	 	 	 the scan is running.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef ADC_SCAN_H_
+#define ADC_SCAN_H_
+
+#include <stdint.h>
+#include "status.h"
+
+/** Defines the ADC channel of the current sense of the H bridge*/
+#define ADC_SCAN_CURRENT_CHANNEL			(13)
+/** Defines the ADC channel to read the potentiometer*/
+#define ADC_SCAN_POT_CHANNEL				(12)
+/** Defines the sync of the scan to no PWM (The PDB triggers itself)*/
+#define ADC_SCAN_FREE_RUN					(0xFFFFFFFFU)
+/** Defines the bits of the conversions*/
+#define ADC_SCAN_RESULT_BITS				(12)
+/** Defines the bits of the filtered results*/
+#define ADC_SCAN_FILTERED_BITS				(16)
+/** Defines the initial output rate of the filter, in Hz*/
+#define ADC_SCAN_DEFAULT_OUTPUT_RATE		(125U)
+
+/*!
+ 	 \brief Enumerator to define the results of a scan, in the order of conversion.
+ */
+typedef enum
+{
+	adc_scan_current,	/*!< Current of the motor*/
+	adc_scan_pot,		/*!< Potentiometer*/
+	adc_scan_inputs		/*!< Number of inputs of the scan*/
+}adc_scan_input_t;
+
+/*!
+ 	 \brief Callback of a completed scan, or of a filtered result. It runs in the ADC
+ 	 	 	 interrupt (e.g. for a current limit), so it must be short.
+
+ 	 \param[in] results Conversions of the scan (12 bits) or filtered results (16 bits),
+ 	 	 	 indexed by adc_scan_input_t.
+ */
+typedef void (*ADC_SCAN_callback_t)(const uint16_t* results);
+
+/*!
+ 	 \brief This function calibrates and configures the ADC, configures the PDB and the
+ 	 	 	 TRGMUX, and starts the scan without PWM (ADC_SCAN_FREE_RUN), filtered at
+ 	 	 	 ADC_SCAN_DEFAULT_OUTPUT_RATE.
+
+ 	 \note The calibration waits for the ADC, so it is called before the scheduler starts.
+
+ 	 \param[in] pwm_frequency Frequency of the PWM, in Hz.
+
+ 	 \return STATUS_TIMEOUT if the calibration did not finish (The scan is not started).
+ */
+status_t ADC_SCAN_init(uint32_t pwm_frequency);
+
+/*!
+ 	 \brief This function runs the calibration of an ADC and waits for it. The ADC
+ 	 	 	 must be clocked, and it is left with the software trigger.
+
+ 	 \note ADC_SCAN_init calibrates ADC0, it is public for the other ADC (adc_monitor.h).
+
+ 	 \param[in] instance ADC to be calibrated.
+
+ 	 \return STATUS_ERROR if there is no such ADC, STATUS_TIMEOUT if it did not finish.
+ */
+status_t ADC_SCAN_calibrate(uint32_t instance);
+
+/*!
+ 	 \brief This function syncs the scan to the PWM of an FTM. It is called when the
+ 	 	 	 running PWM changes, since only the running FTM gives triggers.
+
+ 	 \param[in] instance FTM instance of the running PWM, or ADC_SCAN_FREE_RUN.
+
+ 	 \return void.
+ */
+void ADC_SCAN_sync(uint32_t instance);
+
+/*!
+ 	 \brief This function sets the period of the PDB again, after the bus clock
+ 	 	 	 changed (Clock policy). The scan stays synced to the same PWM.
+
+ 	 \return void.
+ */
+void ADC_SCAN_retime(void);
+
+/*!
+ 	 \brief This function sets the callback of the completed scans.
+
+ 	 \param[in] callback Callback (NULL to remove it).
+
+ 	 \return void.
+ */
+void ADC_SCAN_set_callback(ADC_SCAN_callback_t callback);
+
+/*!
+ 	 \brief This function gets the results of the last scan.
+
+ 	 \param[out] results Conversions of the scan (12 bits), indexed by adc_scan_input_t.
+
+ 	 \return Number of scans completed (To know whether the results are new).
+ */
+uint32_t ADC_SCAN_get(uint16_t* results);
+
+/*!
+ 	 \brief This function sets the output rate of the filter. The scan rate (The PWM
+ 	 	 	 frequency) is decimated by a power of 2, so the closest rate that is not
+ 	 	 	 lower is used, limited by the highest decimation of the filter. The
+ 	 	 	 filter restarts, so the next results take CIC_FILTER_ORDER outputs.
+
+ 	 \param[in] rate Output rate, in Hz.
+
+ 	 \return Output rate set, in Hz.
+ */
+uint32_t ADC_SCAN_set_output_rate(uint32_t rate);
+
+/*!
+ 	 \brief This function sets the callback of the filtered results.
+
+ 	 \param[in] callback Callback (NULL to remove it).
+
+ 	 \return void.
+ */
+void ADC_SCAN_set_filter_callback(ADC_SCAN_callback_t callback);
+
+/*!
+ 	 \brief This function gets the last filtered results.
+
+ 	 \param[out] results Filtered results (16 bits, full scale is VREFH), indexed by adc_scan_input_t.
+
+ 	 \return Number of filtered results (To know whether the results are new).
+ */
+uint32_t ADC_SCAN_get_filtered(uint16_t* results);
+
+/*!
+ 	 \brief This function gets the number of triggers lost because the previous scan
+ 	 	 	 was still converting (PDB sequence errors).
+
+ 	 \return Number of errors.
+ */
+uint32_t ADC_SCAN_get_errors(void);
+
+#endif /* ADC_SCAN_H_ */
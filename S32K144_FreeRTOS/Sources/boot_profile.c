@@ -0,0 +1,123 @@
+/*!
+ 	 \file boot_profile.c
+
+ 	 \brief This is the source file of the boot profiler.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include "boot_profile.h"
+#include "cycle_counter.h"
+#include "clock_manager.h"
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL							(0)
+/** Defines a bit to be shifted in masks*/
+#define BIT_TO_SHIFT						(1UL)
+/** Defines the Hz in a MHz*/
+#define HZ_PER_MHZ							(1000000UL)
+
+/*!
+ 	 \brief Structure for the profiler handler. It is in .bss, so it is zero from
+ 	 	 	 the .data/.bss init (The reset is the time 0).
+ */
+typedef struct
+{
+	uint32_t marked;							/*!< Phases marked, one bit per phase*/
+	uint32_t cycles[boot_profile_phases];		/*!< Cycles from the reset to the end of each phase*/
+	uint32_t us[boot_profile_phases];			/*!< Microseconds from the reset to the end of each phase*/
+	uint32_t last_cycles;						/*!< Cycles of the last mark*/
+	uint32_t last_us;							/*!< Microseconds of the last mark*/
+}boot_profile_handler_t;
+
+/** Handler of the profiler*/
+static boot_profile_handler_t boot_profile_handler;
+
+/** This function enables the cycle counter*/
+void BOOT_PROFILE_start(void)
+{
+	CYCLE_COUNTER_ENABLE();
+}
+
+/** This function marks the end of a phase*/
+void BOOT_PROFILE_mark(boot_profile_phase_t phase)
+{
+	/** Core clock of the phase*/
+	uint32_t core_clock = INIT_VAL;
+	/** Cycles of the mark*/
+	uint32_t cycles;
+	/** Interrupt mask to restore*/
+	UBaseType_t interrupts;
+
+	/** Most of the calls are after the phase was marked (e.g. every CAN frame)*/
+	if((boot_profile_phases <= phase) || (boot_profile_handler.marked & (BIT_TO_SHIFT << phase)))
+	{
+		return;
+	}
+
+	CLOCK_SYS_GetFreq(CORE_CLOCK, &core_clock);
+	core_clock /= HZ_PER_MHZ;
+
+	/** The marks from the interrupts must not come in between*/
+	interrupts = taskENTER_CRITICAL_FROM_ISR();
+
+	if(INIT_VAL == (boot_profile_handler.marked & (BIT_TO_SHIFT << phase)))
+	{
+		cycles = CYCLE_COUNTER_GET();
+
+		boot_profile_handler.cycles[phase] = cycles;
+		boot_profile_handler.us[phase] = boot_profile_handler.last_us;
+
+		if(INIT_VAL != core_clock)
+		{
+			boot_profile_handler.us[phase] += (cycles - boot_profile_handler.last_cycles) / core_clock;
+		}
+
+		boot_profile_handler.last_cycles = cycles;
+		boot_profile_handler.last_us = boot_profile_handler.us[phase];
+		boot_profile_handler.marked |= (BIT_TO_SHIFT << phase);
+	}
+
+	taskEXIT_CRITICAL_FROM_ISR(interrupts);
+}
+
+/** This function gets the cycles of a phase*/
+uint32_t BOOT_PROFILE_get_cycles(boot_profile_phase_t phase)
+{
+	if(boot_profile_reset == phase)
+	{
+		return INIT_VAL;
+	}
+
+	if((boot_profile_phases <= phase) || (INIT_VAL == (boot_profile_handler.marked & (BIT_TO_SHIFT << phase))))
+	{
+		return BOOT_PROFILE_NOT_REACHED;
+	}
+
+	return boot_profile_handler.cycles[phase];
+}
+
+/** This function gets the time of a phase*/
+uint32_t BOOT_PROFILE_get_us(boot_profile_phase_t phase)
+{
+	if(boot_profile_reset == phase)
+	{
+		return INIT_VAL;
+	}
+
+	if((boot_profile_phases <= phase) || (INIT_VAL == (boot_profile_handler.marked & (BIT_TO_SHIFT << phase))))
+	{
+		return BOOT_PROFILE_NOT_REACHED;
+	}
+
+	return boot_profile_handler.us[phase];
+}
@@ -0,0 +1,88 @@
+/*!
+ 	 \file boot_profile.h
+
+ 	 \brief This is the header file of the boot profiler. The cycle counter is
+ 	 	 	 enabled by the reset handler (BOOT_PROFILE_start), and every init phase
+ 	 	 	 marks the time it finished, from the reset to the first CAN frame. The
+ 	 	 	 times are read with a debugger (boot_profile_handler) or with the getters.
+
+ 	 \note The core clock changes during the boot (FIRC, then SPLL), so each phase
+ 	 	 	 is converted to microseconds with the core clock at its mark. A phase
+ 	 	 	 that changes the clock is converted with the new one.
+
+ 	 \note Each phase is marked once, the later marks of the same phase are ignored.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef BOOT_PROFILE_H_
+#define BOOT_PROFILE_H_
+
+#include <stdint.h>
+
+/** Defines the time of a phase not reached yet*/
+#define BOOT_PROFILE_NOT_REACHED			(0xFFFFFFFFUL)
+
+/*!
+ 	 \brief Phases of the boot, in the order they finish.
+ */
+typedef enum
+{
+	boot_profile_reset,			/*!< Reset handler, the counter starts (Always 0)*/
+	boot_profile_main,			/*!< Start of main (SystemInit and the .data/.bss init)*/
+	boot_profile_clocks,		/*!< Clock manager (SOSC and SPLL locked, core on the SPLL)*/
+	boot_profile_pins,			/*!< Pins*/
+	boot_profile_can_start,		/*!< SBC configuration queued and FlexCAN enabled (rtos_can_start)*/
+	boot_profile_motor,			/*!< FTMs and motor*/
+	boot_profile_adc_scan,		/*!< ADC0 calibrated and scan started*/
+	boot_profile_services,		/*!< ISO-TP, control loop, XCP, bootloader and time sync*/
+	boot_profile_can,			/*!< FlexCAN out of freeze mode and SBC timer (rtos_can_init)*/
+	boot_profile_zone,			/*!< ADC1 calibrated and monitor started (rtos_zone_init)*/
+	boot_profile_threads,		/*!< Bus statistics and threads, the scheduler starts*/
+	boot_profile_sbc,			/*!< SBC configuration transfer finished*/
+	boot_profile_first_frame,	/*!< First CAN frame transmitted*/
+	boot_profile_phases			/*!< Number of phases*/
+}boot_profile_phase_t;
+
+/*!
+ 	 \brief This function enables the cycle counter. It is called by the reset
+ 	 	 	 handler, before SystemInit and the .data/.bss init, so it must not
+ 	 	 	 use any variable.
+
+ 	 \return void.
+ */
+void BOOT_PROFILE_start(void);
+
+/*!
+ 	 \brief This function marks the end of a phase. It may be called from an interrupt.
+
+ 	 \param[in] phase Phase finished.
+
+ 	 \return void.
+ */
+void BOOT_PROFILE_mark(boot_profile_phase_t phase);
+
+/*!
+ 	 \brief This function gets the cycles from the reset to the end of a phase.
+
+ 	 \param[in] phase Phase.
+
+ 	 \return Cycles, BOOT_PROFILE_NOT_REACHED if the phase has not finished.
+ */
+uint32_t BOOT_PROFILE_get_cycles(boot_profile_phase_t phase);
+
+/*!
+ 	 \brief This function gets the time from the reset to the end of a phase.
+
+ 	 \param[in] phase Phase.
+
+ 	 \return Time in microseconds, BOOT_PROFILE_NOT_REACHED if the phase has not finished.
+ */
+uint32_t BOOT_PROFILE_get_us(boot_profile_phase_t phase);
+
+#endif /* BOOT_PROFILE_H_ */
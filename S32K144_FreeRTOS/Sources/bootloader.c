@@ -0,0 +1,695 @@
+/*!
+ 	 \file bootloader.c
+
+ 	 \brief This is the source file of the CAN bootloader. The request handling
+ 	 	 	 and the double buffered programming of the image are found in this
+ 	 	 	 source file.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include "bootloader.h"
+#include "tick_period.h"
+#include "clock_policy.h"
+
+/** Defines the bootloader handler as initialized*/
+#define IS_INIT								(1)
+/** Defines the bootloader handler as not initialized*/
+#define NOT_INIT							(0)
+/** Defines a flag as set*/
+#define FLAG_SET							(1)
+/** Defines a flag as cleared*/
+#define FLAG_CLEAR							(0)
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL							(0)
+
+/** Defines the number of rx buffers (One is received while the other is programmed)*/
+#define BL_BUFFERS							(2)
+/** Defines the position of the command in a request*/
+#define CMD_POS								(0)
+/** Defines the position of the address in a request*/
+#define ADDRESS_POS							(1)
+/** Defines the position of the size in a start request*/
+#define SIZE_POS							(5)
+/** Defines the position of the CRC in an end request*/
+#define CRC_POS								(1)
+/** Defines the position of the data in a data request*/
+#define DATA_POS							(5)
+/** Defines the size of a start request*/
+#define START_SIZE							(9)
+/** Defines the size of an end request*/
+#define END_SIZE							(5)
+/** Defines the size of the header of a data request*/
+#define DATA_HEADER_SIZE					(5)
+/** Defines the size of the rx buffers*/
+#define BL_BUFFER_SIZE						(DATA_HEADER_SIZE + BL_BLOCK_DATA_SIZE)
+/** Defines the size of an answer*/
+#define RESPONSE_SIZE						(2)
+/** Defines the position of the status in an answer*/
+#define RESPONSE_STATUS_POS					(1)
+
+/** Defines the number of blocks that can wait to be executed*/
+#define BL_QUEUE_LENGTH						(BL_BUFFERS)
+
+/** Defines the initial value and the final XOR of the CRC*/
+#define CRC_INIT							(0xFFFFFFFFU)
+/** Defines the reflected polynomial of the CRC*/
+#define CRC_POLYNOMIAL						(0xEDB88320U)
+/** Defines the bits of a byte*/
+#define BITS_IN_BYTE						(8)
+/** Defines the bit shifts for a byte*/
+#define BYTE_SHIFT							(8)
+
+/** Defines the key to write AIRCR*/
+#define AIRCR_KEY							(0x5FA)
+
+/** Defines the position of the initial stack pointer in the vector table*/
+#define VECTOR_SP_POS						(0)
+/** Defines the position of the reset handler in the vector table*/
+#define VECTOR_RESET_POS					(1)
+/** Defines the Thumb bit of a function address*/
+#define THUMB_BIT							(1U)
+/** Defines the value to clear all the bits of a register*/
+#define ALL_BITS							(0xFFFFFFFFU)
+/** Defines the time the answer of a jump request has to be sent, in ms*/
+#define BL_JUMP_DELAY						(10)
+/** Defines the period the flash is polled if its interruption is lost, in ms (Longer than an erase)*/
+#define BL_FLASH_POLL_PERIOD				(20)
+
+/*********************************************************************************************/
+
+/*!
+ 	 \brief Structure for a request waiting to be executed.
+ */
+typedef struct
+{
+	uint8_t* data;			/*!< Buffer where the request was received*/
+	uint16_t length;		/*!< Length of the request*/
+}bl_request_t;
+
+/*!
+ 	 \brief Structure for the bootloader handler.
+ */
+typedef struct
+{
+	uint8_t init_val;				/*!< Defines whether the handler has been initialized or not*/
+	QueueHandle_t queue;			/*!< Requests received and not executed yet*/
+	SemaphoreHandle_t sem_flash;	/*!< Binary semaphore given when a flash operation ends*/
+	const flash_if_t* flash;		/*!< Flash where the image is programmed*/
+	uint8_t started;				/*!< Set when a start request was executed*/
+	uint32_t image_address;			/*!< First address of the image*/
+	uint32_t image_size;			/*!< Size of the image*/
+	BL_status_t error;				/*!< First programming error since the start request*/
+	uint8_t held;					/*!< Set while the RUN level of the clock policy is held*/
+}bl_handler_t;
+
+/*********************************************************************************************/
+
+/*!
+ 	 \brief This function is the rx callback of the bootloader session. It queues the
+ 	 	 	 request, the buffer is not touched again until the request is executed.
+
+ 	 \param[in] session Session that received the message.
+ 	 \param[in] data Buffer where the message was received.
+ 	 \param[in] length Length of the message.
+ 	 \param[in] status Result of the reception.
+
+ 	 \return void.
+ */
+static void bl_rx_callback(uint8_t session, uint8_t* data, uint16_t length, ISOTP_status_t status);
+
+/*!
+ 	 \brief This function sends the answer of a request.
+
+ 	 \param[in] command Command of the request.
+ 	 \param[in] status Result of the request.
+
+ 	 \return void.
+ */
+static void bl_send_response(uint8_t command, BL_status_t status);
+
+/*!
+ 	 \brief This function reads a big endian 32 bits field.
+
+ 	 \param[in] data Start of the field.
+
+ 	 \return Value of the field.
+ */
+static uint32_t bl_get_u32(const uint8_t* data);
+
+/*!
+ 	 \brief This function checks that a range is inside the application region.
+
+ 	 \param[in] address First address of the range.
+ 	 \param[in] size Size of the range.
+
+ 	 \return FLAG_SET if the range is valid.
+ */
+static uint8_t bl_range_is_valid(uint32_t address, uint32_t size);
+
+/*!
+ 	 \brief This function is the done callback of the flash, it wakes up the thread.
+
+ 	 \return void.
+ */
+static void bl_flash_done(void);
+
+/*!
+ 	 \brief This function waits until the flash ends its last operation, the thread
+ 	 	 	 is blocked so the other threads run meanwhile.
+
+ 	 \return Result of the operation.
+ */
+static flash_status_t bl_flash_wait(void);
+
+/*!
+ 	 \brief This function executes a start request, erasing the sectors of the image.
+
+ 	 \param[in] request Request to be executed.
+
+ 	 \return Result of the request.
+ */
+static BL_status_t bl_start(bl_request_t request);
+
+/*!
+ 	 \brief This function programs the data of a block.
+
+ 	 \param[in] address Address of the block.
+ 	 \param[in] data Data of the block.
+ 	 \param[in] size Size of the data.
+
+ 	 \return Result of the programming.
+ */
+static BL_status_t bl_program(uint32_t address, const uint8_t* data, uint32_t size);
+
+/*!
+ 	 \brief This function executes an end request, checking the CRC of the image.
+
+ 	 \param[in] request Request to be executed.
+
+ 	 \return Result of the request.
+ */
+static BL_status_t bl_end(bl_request_t request);
+
+/*!
+ 	 \brief This function releases the RUN level of the clock policy, if it is held.
+
+ 	 \return void.
+ */
+static void bl_release(void);
+
+/*!
+ 	 \brief This function checks the vector table of the application region: the
+ 	 	 	 stack pointer must be in the SRAM and the reset handler must be a Thumb
+ 	 	 	 address inside the region (An erased region fails both).
+
+ 	 \return FLAG_SET if the vector table is valid.
+ */
+static uint8_t bl_application_is_valid(void);
+
+/*!
+ 	 \brief This function loads the stack pointer of the application in MSP, makes
+ 	 	 	 the thread mode use it with privileges, and branches to the reset handler.
+
+ 	 \note It is naked, the stack of the caller is not used once MSP changes.
+
+ 	 \param[in] sp Initial stack pointer of the application.
+ 	 \param[in] pc Reset handler of the application.
+
+ 	 \return void.
+ */
+static void bl_hand_off(uint32_t sp, uint32_t pc) __attribute__((naked, noreturn));
+
+/*********************************************************************************************/
+
+/** Bootloader handler*/
+static bl_handler_t bl_handler = { INIT_VAL };
+/** Rx buffers, one receives the next block while the other is programmed*/
+static uint8_t bl_buffer[BL_BUFFERS][BL_BUFFER_SIZE];
+/** Buffer for the answers*/
+static uint8_t bl_response[RESPONSE_SIZE];
+
+/*********************************************************************************************/
+
+/** This function initializes the bootloader*/
+ISOTP_status_t BL_init(CAN_Type* base, const flash_if_t* flash)
+{
+	/** Configuration of the bootloader session*/
+	ISOTP_session_config_t config;
+
+	bl_handler.queue = xQueueCreate(BL_QUEUE_LENGTH, sizeof(bl_request_t));
+	bl_handler.sem_flash = xSemaphoreCreateBinary();
+	bl_handler.flash = flash;
+	bl_handler.flash->set_done_callback(bl_flash_done);
+	bl_handler.started = FLAG_CLEAR;
+	bl_handler.error = bl_ok;
+	bl_handler.held = FLAG_CLEAR;
+
+	/** A block of consecutive frames fits in the Rx FIFO, so the tester sends it back to back*/
+	config.base = base;
+	config.tx_ID = BL_TX_ID;
+	config.rx_ID = BL_RX_ID;
+	config.block_size = ISOTP_BS_DEFAULT;
+	config.st_min = ISOTP_STMIN_DEFAULT;
+	config.rx_buffer = bl_buffer[INIT_VAL];
+	config.rx_buffer_size = BL_BUFFER_SIZE;
+	config.rx_callback = bl_rx_callback;
+	config.tx_callback = NULL;
+
+	/** Sets the handler as initialized*/
+	bl_handler.init_val = IS_INIT;
+
+	return ISOTP_open_session(BL_ISOTP_SESSION, config);
+}
+
+/** This thread executes the requests*/
+void BL_thread(void* args)
+{
+	/** Request to be executed*/
+	bl_request_t request;
+	/** Result of the request*/
+	BL_status_t status;
+	/** Size of the data of a block*/
+	uint32_t size;
+	/** Address of a block*/
+	uint32_t address;
+
+	for(;;)
+	{
+		xQueueReceive(bl_handler.queue, &request, portMAX_DELAY);
+
+		switch(request.data[CMD_POS])
+		{
+			case BL_CMD_START:
+				status = bl_start(request);
+				bl_send_response(BL_CMD_START, status);
+			break;
+
+			case BL_CMD_DATA:
+				size = request.length - DATA_HEADER_SIZE;
+				address = bl_get_u32(&request.data[ADDRESS_POS]);
+
+				/** The next block is received in the other buffer while this one is programmed*/
+				if(isotp_success != ISOTP_set_rx_buffer(BL_ISOTP_SESSION,
+						(request.data == bl_buffer[INIT_VAL]) ? bl_buffer[1] : bl_buffer[INIT_VAL], BL_BUFFER_SIZE))
+				{
+					status = bl_transfer_error;
+				}
+
+				else if(FLAG_SET != bl_handler.started)
+				{
+					status = bl_sequence_error;
+				}
+
+				else if((DATA_HEADER_SIZE >= request.length) || (INIT_VAL != (size % bl_handler.flash->phrase_size)))
+				{
+					status = bl_invalid_length;
+				}
+
+				else if(FLAG_SET != bl_range_is_valid(address, size))
+				{
+					status = bl_out_of_range;
+				}
+
+				/** Reports a previous programming error, otherwise the block is accepted*/
+				else
+				{
+					status = bl_handler.error;
+				}
+
+				bl_send_response(BL_CMD_DATA, status);
+
+				if(bl_ok == status)
+				{
+					bl_handler.error = bl_program(address, &request.data[DATA_POS], size);
+				}
+
+				/** The next block would overwrite this one, the image is not programmed and must be started again*/
+				else if(bl_transfer_error == status)
+				{
+					bl_handler.started = FLAG_CLEAR;
+					bl_release();
+				}
+			break;
+
+			case BL_CMD_END:
+				status = bl_end(request);
+				bl_send_response(BL_CMD_END, status);
+			break;
+
+			case BL_CMD_RESET:
+				bl_send_response(BL_CMD_RESET, bl_ok);
+				S32_SCB->AIRCR = S32_SCB_AIRCR_VECTKEY(AIRCR_KEY) | S32_SCB_AIRCR_SYSRESETREQ_MASK;
+				for(;;);
+			break;
+
+			case BL_CMD_JUMP:
+				if(FLAG_SET == bl_handler.started)
+				{
+					status = bl_sequence_error;
+				}
+
+				else if(FLAG_SET != bl_application_is_valid())
+				{
+					status = bl_no_application;
+				}
+
+				else
+				{
+					status = bl_ok;
+				}
+
+				bl_send_response(BL_CMD_JUMP, status);
+
+				if(bl_ok == status)
+				{
+					/** The answer is sent before the jump, the application starts from the RUN level*/
+					vTaskDelay(BL_JUMP_DELAY * FIX_PERIOD);
+					CLOCK_POLICY_hold();
+					BL_jump_to_application();
+				}
+			break;
+
+			default:
+				bl_send_response(request.data[CMD_POS], bl_unknown_command);
+			break;
+		}
+	}
+}
+
+/** This function starts the application*/
+BL_status_t BL_jump_to_application(void)
+{
+	/** Vector table of the application*/
+	const uint32_t* vectors = (const uint32_t*)BL_APP_START_ADDRESS;
+	/** Counter for the NVIC registers*/
+	uint8_t counter;
+
+	if(FLAG_SET != bl_application_is_valid())
+	{
+		return bl_no_application;
+	}
+
+	/** No interrupt nor tick of this firmware can run once the application starts*/
+	INT_SYS_DisableIRQGlobal();
+	S32_SysTick->CSR = INIT_VAL;
+
+	for(counter = INIT_VAL ; counter < S32_NVIC_ICER_COUNT ; counter ++)
+	{
+		S32_NVIC->ICER[counter] = ALL_BITS;
+		S32_NVIC->ICPR[counter] = ALL_BITS;
+	}
+
+	/** The vector table of the application is used from here*/
+	S32_SCB->VTOR = BL_APP_START_ADDRESS;
+#if defined(__arm__)
+	__asm volatile ("dsb\n\tisb" ::: "memory");
+#endif
+
+	bl_hand_off(vectors[VECTOR_SP_POS], vectors[VECTOR_RESET_POS]);
+
+	return bl_ok;
+}
+
+/** This function calculates the CRC-32 of a region*/
+uint32_t BL_crc32(const uint8_t* data, uint32_t length)
+{
+	/** CRC being calculated*/
+	uint32_t crc = CRC_INIT;
+	/** Counter for the bits*/
+	uint8_t bit;
+
+	while(length --)
+	{
+		crc ^= *data ++;
+
+		for(bit = INIT_VAL ; bit < BITS_IN_BYTE ; bit ++)
+		{
+			crc = (crc >> 1) ^ (CRC_POLYNOMIAL & (uint32_t)(-(int32_t)(crc & 1U)));
+		}
+	}
+
+	return crc ^ CRC_INIT;
+}
+
+/** This function queues the requests received*/
+static void bl_rx_callback(uint8_t session, uint8_t* data, uint16_t length, ISOTP_status_t status)
+{
+	/** Request to be queued*/
+	bl_request_t request;
+
+	/** Failed receptions are dropped, the sender times out waiting for the answer*/
+	if((isotp_success == status) && (IS_INIT == bl_handler.init_val))
+	{
+		request.data = data;
+		request.length = length;
+		xQueueSend(bl_handler.queue, &request, 0);
+	}
+}
+
+/** This function sends an answer*/
+static void bl_send_response(uint8_t command, BL_status_t status)
+{
+	bl_response[CMD_POS] = command | BL_RESPONSE_MASK;
+	bl_response[RESPONSE_STATUS_POS] = (uint8_t)status;
+
+	ISOTP_send(BL_ISOTP_SESSION, bl_response, RESPONSE_SIZE);
+}
+
+/** This function reads a big endian field*/
+static uint32_t bl_get_u32(const uint8_t* data)
+{
+	/** Value of the field*/
+	uint32_t value = INIT_VAL;
+	/** Counter for the bytes*/
+	uint8_t counter;
+
+	for(counter = INIT_VAL ; counter < sizeof(uint32_t) ; counter ++)
+	{
+		value = (value << BYTE_SHIFT) | data[counter];
+	}
+
+	return value;
+}
+
+/** This function checks a range*/
+static uint8_t bl_range_is_valid(uint32_t address, uint32_t size)
+{
+	/** Sets the return value as not valid*/
+	uint8_t retval = FLAG_CLEAR;
+
+	if((BL_APP_START_ADDRESS <= address) && (BL_APP_END_ADDRESS >= address) &&
+	   ((BL_APP_END_ADDRESS - address) >= size))
+	{
+		retval = FLAG_SET;
+	}
+
+	return retval;
+}
+
+/** This function wakes up the thread once the flash operation ends*/
+static void bl_flash_done(void)
+{
+	/** Whether a higher priority thread was woken up*/
+	BaseType_t woken = pdFALSE;
+
+	xSemaphoreGiveFromISR(bl_handler.sem_flash, &woken);
+	portYIELD_FROM_ISR(woken);
+}
+
+/** This function waits for the flash*/
+static flash_status_t bl_flash_wait(void)
+{
+	/** Result of the operation*/
+	flash_status_t status;
+
+	while(flash_busy == (status = bl_handler.flash->poll()))
+	{
+		/** The done callback gives the semaphore, the timeout only covers a lost interruption*/
+		xSemaphoreTake(bl_handler.sem_flash, BL_FLASH_POLL_PERIOD * FIX_PERIOD);
+	}
+
+	return status;
+}
+
+/** This function executes a start request*/
+static BL_status_t bl_start(bl_request_t request)
+{
+	/** Sets the return value as successful*/
+	BL_status_t retval = bl_ok;
+	/** Address of the sector being erased*/
+	uint32_t sector;
+	/** First address of the image*/
+	uint32_t address;
+	/** Size of the image*/
+	uint32_t size;
+	/** Result of the flash operation*/
+	flash_status_t status;
+
+	bl_handler.started = FLAG_CLEAR;
+
+	if(START_SIZE != request.length)
+	{
+		return bl_invalid_length;
+	}
+
+	address = bl_get_u32(&request.data[ADDRESS_POS]);
+	size = bl_get_u32(&request.data[SIZE_POS]);
+
+	if((INIT_VAL != (address % bl_handler.flash->sector_size)) || (FLAG_SET != bl_range_is_valid(address, size)))
+	{
+		return bl_out_of_range;
+	}
+
+	/** The flash is not erased nor programmed in HSRUN or VLPR, the level is held until the end request*/
+	if(FLAG_SET != bl_handler.held)
+	{
+		CLOCK_POLICY_hold();
+		bl_handler.held = FLAG_SET;
+	}
+
+	/** The whole image is erased here, so the data blocks only program phrases*/
+	for(sector = address ; (sector < (address + size)) && (bl_ok == retval) ; sector += bl_handler.flash->sector_size)
+	{
+		status = bl_handler.flash->erase_sector(sector);
+
+		if(flash_busy == status)
+		{
+			status = bl_flash_wait();
+		}
+
+		if(flash_success != status)
+		{
+			retval = bl_erase_error;
+		}
+	}
+
+	if(bl_ok == retval)
+	{
+		bl_handler.image_address = address;
+		bl_handler.image_size = size;
+		bl_handler.error = bl_ok;
+		bl_handler.started = FLAG_SET;
+	}
+
+	else
+	{
+		bl_release();
+	}
+
+	return retval;
+}
+
+/** This function programs a block*/
+static BL_status_t bl_program(uint32_t address, const uint8_t* data, uint32_t size)
+{
+	/** Offset of the phrase being programmed*/
+	uint32_t offset;
+	/** Result of the flash operation*/
+	flash_status_t status;
+
+	for(offset = INIT_VAL ; offset < size ; offset += bl_handler.flash->phrase_size)
+	{
+		status = bl_handler.flash->program_phrase(address + offset, &data[offset]);
+
+		if(flash_busy == status)
+		{
+			status = bl_flash_wait();
+		}
+
+		if(flash_success != status)
+		{
+			return bl_program_error;
+		}
+	}
+
+	return bl_ok;
+}
+
+/** This function executes an end request*/
+static BL_status_t bl_end(bl_request_t request)
+{
+	/** Sets the return value as successful*/
+	BL_status_t retval = bl_ok;
+
+	if(END_SIZE != request.length)
+	{
+		retval = bl_invalid_length;
+	}
+
+	else if(FLAG_SET != bl_handler.started)
+	{
+		retval = bl_sequence_error;
+	}
+
+	/** The blocks are programmed before the next request is taken, so the image is complete*/
+	else if(bl_ok != bl_handler.error)
+	{
+		retval = bl_handler.error;
+	}
+
+	else if(bl_get_u32(&request.data[CRC_POS]) !=
+			BL_crc32(bl_handler.flash->read(bl_handler.image_address), bl_handler.image_size))
+	{
+		retval = bl_crc_error;
+	}
+
+	bl_handler.started = FLAG_CLEAR;
+	bl_release();
+
+	return retval;
+}
+
+/** This function releases the RUN level*/
+static void bl_release(void)
+{
+	if(FLAG_SET == bl_handler.held)
+	{
+		CLOCK_POLICY_release();
+		bl_handler.held = FLAG_CLEAR;
+	}
+}
+
+/** This function checks the vector table of the application*/
+static uint8_t bl_application_is_valid(void)
+{
+	/** Vector table of the application*/
+	const uint32_t* vectors = (const uint32_t*)BL_APP_START_ADDRESS;
+	/** Initial stack pointer of the application*/
+	uint32_t sp = vectors[VECTOR_SP_POS];
+	/** Reset handler of the application*/
+	uint32_t pc = vectors[VECTOR_RESET_POS];
+	/** Sets the return value as not valid*/
+	uint8_t retval = FLAG_CLEAR;
+
+	if((BL_SRAM_START_ADDRESS < sp) && (BL_SRAM_END_ADDRESS >= sp) && (THUMB_BIT & pc) &&
+	   (BL_APP_START_ADDRESS <= (pc & ~THUMB_BIT)) && (BL_APP_END_ADDRESS > (pc & ~THUMB_BIT)))
+	{
+		retval = FLAG_SET;
+	}
+
+	return retval;
+}
+
+/** This function hands the MCU off to the application*/
+static void bl_hand_off(uint32_t sp, uint32_t pc)
+{
+	/** MSP = sp, CONTROL = 0 (MSP, privileged, no FP context), BASEPRI = 0, PC = pc (Only on the Cortex-M4, not on the host harness)*/
+#if defined(__arm__)
+	__asm volatile
+	(
+		"msr msp, r0		\n"
+		"movs r2, #0		\n"
+		"msr control, r2	\n"
+		"msr basepri, r2	\n"
+		"isb				\n"
+		"bx r1				\n"
+	);
+#endif
+}
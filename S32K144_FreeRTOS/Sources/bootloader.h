@@ -0,0 +1,130 @@
+/*!
+ 	 \file bootloader.h
+
+ 	 \brief This is the header file of the CAN bootloader. It receives an image
+ 	 	 	 over an ISO-TP session and programs it in the application region of a
+ 	 	 	 flash, while the next block is being received in a second buffer.
+
+ 	 \note Protocol (Every request is an ISO-TP message, big endian fields):
+ 	 	 	 - BL_CMD_START [cmd, address(4), size(4)]: erases the region of the image.
+ 	 	 	 - BL_CMD_DATA [cmd, address(4), data(n)]: programs a block, n multiple of the phrase.
+ 	 	 	 - BL_CMD_END [cmd, crc32(4)]: waits for the last block and checks the CRC of the image.
+ 	 	 	 - BL_CMD_RESET [cmd]: resets the MCU.
+ 	 	 	 - BL_CMD_JUMP [cmd]: starts the application programmed in the region.
+ 	 	 	 Every request is answered with [cmd | BL_RESPONSE_MASK, status]. The answer of a
+ 	 	 	 data block is sent as soon as the block is taken, so the sender can stream the
+ 	 	 	 next block while this one is programmed. Programming errors are sticky and
+ 	 	 	 reported on the next answer.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef BOOTLOADER_H_
+#define BOOTLOADER_H_
+
+#include "isotp.h"
+#include "flash_if.h"
+
+/** Defines the ISO-TP session used by the bootloader*/
+#define BL_ISOTP_SESSION					(1)
+/** Defines the ID used to transmit the answers*/
+#define BL_TX_ID							(0x7E9)
+/** Defines the ID used to receive the requests*/
+#define BL_RX_ID							(0x7E1)
+
+/** Defines the first address of the application region (Reserved as m_app in S32K144_64_flash.ld)*/
+#define BL_APP_START_ADDRESS				(0x00040000U)
+/** Defines the address after the application region*/
+#define BL_APP_END_ADDRESS					(0x00080000U)
+/** Defines the first address of the SRAM, where the stack of the application must be*/
+#define BL_SRAM_START_ADDRESS				(0x1FFF8000U)
+/** Defines the address after the SRAM*/
+#define BL_SRAM_END_ADDRESS					(0x20007000U)
+
+/** Defines the maximum data of a single block*/
+#define BL_BLOCK_DATA_SIZE					(2048U)
+
+/** Defines the start request*/
+#define BL_CMD_START						(0x31)
+/** Defines the data request*/
+#define BL_CMD_DATA							(0x36)
+/** Defines the end request*/
+#define BL_CMD_END							(0x37)
+/** Defines the reset request*/
+#define BL_CMD_RESET						(0x11)
+/** Defines the request to start the application*/
+#define BL_CMD_JUMP							(0x32)
+/** Defines the mask added to the command in the answers*/
+#define BL_RESPONSE_MASK					(0x40)
+
+/*!
+ 	 \brief Enumerator to define the status sent in the answers.
+ */
+typedef enum
+{
+	bl_ok,					/*!< Request executed*/
+	bl_unknown_command,		/*!< The command is not supported*/
+	bl_invalid_length,		/*!< The length of the request is wrong*/
+	bl_out_of_range,		/*!< The address is outside of the application region*/
+	bl_sequence_error,		/*!< A data or end request was received without a start*/
+	bl_erase_error,			/*!< The flash failed to erase a sector*/
+	bl_program_error,		/*!< The flash failed to program a phrase*/
+	bl_crc_error,			/*!< The CRC of the image does not match*/
+	bl_no_application,		/*!< The vector table of the application region is not valid*/
+	bl_transfer_error		/*!< The next block could not be received in the other buffer, the image must be started again*/
+}BL_status_t;
+
+/*!
+ 	 \brief This function initializes the bootloader and opens its ISO-TP session.
+
+ 	 \note Call it after ISOTP_init and before creating BL_thread.
+
+ 	 \param[in] base CAN used by the bootloader.
+ 	 \param[in] flash Flash where the image is programmed.
+
+ 	 \return Whether the ISO-TP session was opened or the reason why it was not.
+ */
+ISOTP_status_t BL_init(CAN_Type* base, const flash_if_t* flash);
+
+/*!
+ 	 \brief This thread executes the requests and programs the blocks.
+
+ 	 \note Give it a lower priority than the RX thread, the blocks are received while
+ 	 	 	 this thread programs the flash.
+
+ 	 \param[in] args Thread arguments. Set to NULL.
+
+ 	 \return void.
+ */
+void BL_thread(void* args);
+
+/*!
+ 	 \brief This function starts the application programmed in the region. The
+ 	 	 	 interrupts and the SysTick are stopped, VTOR is moved to the vector table
+ 	 	 	 of the application, and its stack pointer and reset handler are loaded.
+
+ 	 \note The peripherals keep their configuration, the start-up of the application
+ 	 	 	 initializes them again. It can be called from a thread or before the
+ 	 	 	 scheduler starts.
+
+ 	 \return bl_no_application if the region has no valid vector table, otherwise it
+ 	 	 	 does not return.
+ */
+BL_status_t BL_jump_to_application(void);
+
+/*!
+ 	 \brief This function calculates the CRC-32 (IEEE 802.3) of a memory region.
+
+ 	 \param[in] data Start of the region.
+ 	 \param[in] length Size of the region.
+
+ 	 \return CRC of the region.
+ */
+uint32_t BL_crc32(const uint8_t* data, uint32_t length);
+
+#endif /* BOOTLOADER_H_ */
@@ -14,6 +14,7 @@
  */
 
 #include "can_driver.h"
+#include "device_registers.h"
 
 /** Defines the initial value for the variables*/
 #define INIT_VAL				(0)
@@ -25,14 +26,11 @@
 /** Defines the length of a buffer*/
 #define MSG_BUF_SIZE			(4)
 
-/** Defines the RX mask to enable the buffer*/
-#define ENABLE_RX_BUFF			(0x04000000)
-
 /** Defines the value to accept all IDs*/
 #define NOT_CHECK_ANY_ID		(0x00000000)
 
-/** Defines the bits to clear the interruption flag of the Rx MB*/
-#define CLEAR_MB_0				(0x00000001)
+/** Defines the bits to clear the interruption flag of the Tx MB*/
+#define CLEAR_TX_MB				(0x00000100)
 /** Defines the mask for the standard ID*/
 #define STD_ID_MASK				(0x000007FF)
 /** Defines the shifts for the standard ID*/
@@ -41,25 +39,25 @@
 /** Defines the transmit code*/
 #define TX_BUFF_TRANSMITT		(0x0C400000)
 
-/** Defines the mask for the MB code*/
-#define CAN_CODE_MASK			(0x07000000)
-/** Defines the shift for the MB code*/
-#define CAN_CODE_SHIFT			(24)
-
 /** Defines the mask for the time stamp*/
 #define CAN_TIMESTAMP_MASK		(0x0000FFFF)
-/** Defines the bits to clear the interruption flag of the Tx MB*/
-#define CLEAR_MB_4				(0x00000010)
+/** Defines the bits to pop the output of the Rx FIFO (Frames available flag)*/
+#define CLEAR_RX_FIFO			(0x00000020)
+/** Defines the overflow flag of the Rx FIFO*/
+#define RX_FIFO_OVERFLOW		(0x00000080)
+
+/** Defines the mask of the segments of the speed*/
+#define CAN_SEGMENTS_MASK		(CAN_CTRL1_RJW_MASK | CAN_CTRL1_PSEG1_MASK | CAN_CTRL1_PSEG2_MASK | CAN_CTRL1_PROPSEG_MASK)
 
 /** Defines the mask for the LSB*/
 #define BIT_MASK				(1)
 /** Defines the bits to clear al MB interruption flags*/
 #define CLEAR_ALL_FLAGS			(0xFFFFFFFF)
 
-/** Defines the Rx MB offset in RAM array*/
-#define RX_BUFF_OFFSET			(0x04)
-/** Defines the Tx MB offset in RAM array*/
-#define TX_BUFF_OFFSET			(0x00)
+/** Defines the Rx FIFO output offset in RAM array (MB0, the FIFO and its ID filters take MB0 to MB7)*/
+#define RX_BUFF_OFFSET			(0x00)
+/** Defines the Tx MB offset in RAM array (The first MB after the Rx FIFO)*/
+#define TX_BUFF_OFFSET			(0x08)
 /** Defines the code and DLC position in the MB array*/
 #define CODE_AND_DLC_POS		(0x00)
 /** Defines the ID position in the MB array*/
@@ -71,11 +69,15 @@
 
 /** Defines the divisor to convert from DLC to the msg size*/
 #define DLC_TO_MSG_SIZE_DIV		(0x04)
-/** Defines the shifts for the Rx MB interruption flag*/
-#define RX_MB_FLAG_SHIFT		(0x04)
+/** Defines the shifts for the frames available flag of the Rx FIFO*/
+#define RX_MB_FLAG_SHIFT		(0x05)
+/** Defines the shifts for the Tx MB interruption flag*/
+#define TX_MB_FLAG_SHIFT		(0x08)
 
 /** Disable CAN FS*/
 #define CAN_FD_DISABLE			(0x0003001F)
+/** Defines the MCR out of freeze mode: CAN FD disabled and the Rx FIFO enabled*/
+#define CAN_MCR_RUN				(CAN_FD_DISABLE | CAN_MCR_RFEN_MASK)
 /** Offset to calculate the msg_size from DLC*/
 #define MESSAGE_SIZE_OFF		(0x03)
 /** Delay for the Tx*/
@@ -83,8 +85,8 @@
 
 /** Mask to get the MSB of the Rx message*/
 #define CAN_RX_MSG_MSB_MASK		(0xFF000000)
-/** Mask to enable the interruption of the Rx message buffer*/
-#define CAN_SET_RX_BUFF_ISR		(0x10)
+/** Mask to enable the interruption of the frames available in the Rx FIFO*/
+#define CAN_SET_RX_BUFF_ISR		(0x20)
 
 /** Size of the variable to concatenate the message received*/
 #define TEMP_VAR_SIZE			(2)
@@ -106,87 +108,214 @@
 /** Maximum DLC that can be sent*/
 #define MAX_DLC					(8)
 
-/** Variable to store the code of the Rx MB*/
-static uint32_t RxCODE;
+/** Polls of a mode acknowledge before it times out (A frame of 135 bits at 50 Kbps in HSRUN)*/
+#define CAN_ACK_TIMEOUT			(100000U)
+
 /** Variable to store the ID of the Rx MB*/
 static uint32_t RxID;
 /** Variable to store the DLC of the Rx MB*/
 static uint32_t RxLENGTH;
 
 /** This function initializes the CAN*/
-void CAN_Init(can_init_config_t can_init)
+status_t CAN_Init(can_init_config_t can_init)
 {
 	/** Counter to clean the RAM*/
 	uint8_t counter;
+	/** Polls left*/
+	uint32_t timeout = CAN_ACK_TIMEOUT;
+
+	/** The module may be enabled already (CAN_enable), entering freeze mode meanwhile*/
+	if((can_init.base->MCR & CAN_MCR_MDIS_MASK) || (INIT_VAL == (can_init.base->MCR & CAN_MCR_FRZ_MASK)))
+	{
+		CAN_enable(can_init.base);
+	}
 
+	/** Waits for the module to enter freeze mode, to manage the CTRL and other registers*/
+	while((!(can_init.base->MCR & CAN_MCR_FRZACK_MASK)) && (INIT_VAL != timeout))
+	{
+		timeout --;
+	}
+
+	if(INIT_VAL == timeout)
+	{
+		return STATUS_TIMEOUT;
+	}
+
+	/** Configures the speed, and other parameters*/
+	can_init.base->CTRL1 = can_init.speed;
+
+	/** Initializes the MB RAM in 0*/
+	for(counter = INIT_VAL ; MAX_MSG_BUFFERS > counter ; counter ++)
+	{
+		can_init.base->RAMn[counter] = INIT_VAL;
+
+		/** Sets the ID masks to not check the ID*/
+		if(MAX_FILTER_BUFFERS > counter)
+		{
+			can_init.base->RXIMR[counter] = NOT_CHECK_ANY_ID;
+		}
+	}
+
+	/** Sets the global ID masks to not check any ID*/
+	can_init.base->RXMGMASK = NOT_CHECK_ANY_ID;
+	can_init.base->RXFGMASK = NOT_CHECK_ANY_ID;
+
+	/** CAN FD not used, the Rx FIFO queues the frames (Its ID filters are cleared with the RAM, and not checked)*/
+	can_init.base->MCR = CAN_MCR_RUN;
+
+	/** Waits for the module to exit freeze mode and to be ready*/
+	timeout = CAN_ACK_TIMEOUT;
+
+	while((can_init.base->MCR & (CAN_MCR_FRZACK_MASK | CAN_MCR_NOTRDY_MASK)) && (INIT_VAL != timeout))
+	{
+		timeout --;
+	}
+
+	return (INIT_VAL != timeout) ? STATUS_SUCCESS : STATUS_TIMEOUT;
+}
+
+/** This function enables the module*/
+void CAN_enable(CAN_Type* base)
+{
 	/** For CAN0*/
-	if(CAN0 == can_init.base)
+	if(CAN0 == base)
 	{
 		/** Enables the peripheral clock*/
 		PCC->PCCn[PCC_FlexCAN0_INDEX] |= PCC_PCCn_CGC_MASK;
 	}
 
 	/** For CAN1*/
-	else if(CAN1 == can_init.base)
+	else if(CAN1 == base)
 	{
 		/** Enables the peripheral clock*/
 		PCC->PCCn[PCC_FlexCAN1_INDEX] |= PCC_PCCn_CGC_MASK;
 	}
 
 	/** For CAN2*/
-	else if(CAN2 == can_init.base)
+	else if(CAN2 == base)
 	{
 		PCC->PCCn[PCC_FlexCAN2_INDEX] |= PCC_PCCn_CGC_MASK;
 	}
 
 	/** Disables the module*/
-	can_init.base->MCR |= CAN_MCR_MDIS_MASK;
+	base->MCR |= CAN_MCR_MDIS_MASK;
 	/** Sets the clock source to the oscillator clock*/
-	can_init.base->CTRL1 &= (~CAN_CTRL1_CLKSRC_MASK);
-	/** Enables the module*/
-	can_init.base->MCR &= (~CAN_MCR_MDIS_MASK);
+	base->CTRL1 &= (~CAN_CTRL1_CLKSRC_MASK);
+	/** Enables the module in freeze mode, the acknowledge is waited by CAN_Init*/
+	base->MCR |= CAN_MCR_FRZ_MASK | CAN_MCR_HALT_MASK;
+	base->MCR &= (~CAN_MCR_MDIS_MASK);
+}
 
-	/** Waits for the module to enter freeze mode, to manage the CTRL and other registers*/
-	while(!((can_init.base->MCR & CAN_MCR_FRZACK_MASK) >> CAN_MCR_FRZACK_SHIFT));
+/** This function enters the freeze mode*/
+status_t CAN_freeze(CAN_Type* base)
+{
+	/** Polls left*/
+	uint32_t timeout = CAN_ACK_TIMEOUT;
 
-	/** Configures the speed, and other parameters*/
-	can_init.base->CTRL1 = can_init.speed;
+	/** Not enabled yet*/
+	if(base->MCR & CAN_MCR_MDIS_MASK)
+	{
+		return STATUS_UNSUPPORTED;
+	}
 
-	/** Initializes the MB RAM in 0*/
-	for(counter = INIT_VAL ; MAX_MSG_BUFFERS > counter ; counter ++)
+	base->MCR |= CAN_MCR_FRZ_MASK | CAN_MCR_HALT_MASK;
+
+	/** The frame on the bus ends before the acknowledge*/
+	while((!(base->MCR & CAN_MCR_FRZACK_MASK)) && (INIT_VAL != timeout))
 	{
-		can_init.base->RAMn[counter] = INIT_VAL;
+		timeout --;
+	}
 
-		/** Sets the ID masks to not check the ID*/
-		if(MAX_FILTER_BUFFERS > counter)
+	return (INIT_VAL != timeout) ? STATUS_SUCCESS : STATUS_TIMEOUT;
+}
+
+/** This function changes the clock of the protocol engine*/
+status_t CAN_set_clock(CAN_Type* base, CAN_clock_t clock)
+{
+	/** Polls left*/
+	uint32_t timeout = CAN_ACK_TIMEOUT;
+
+	/** The clock source is only written with the module disabled*/
+	base->MCR |= CAN_MCR_FRZ_MASK | CAN_MCR_HALT_MASK | CAN_MCR_MDIS_MASK;
+
+	while((!(base->MCR & CAN_MCR_LPMACK_MASK)) && (INIT_VAL != timeout))
+	{
+		timeout --;
+	}
+
+	if(INIT_VAL == timeout)
+	{
+		return STATUS_TIMEOUT;
+	}
+
+	if(can_clock_bus == clock)
+	{
+		base->CTRL1 |= CAN_CTRL1_CLKSRC_MASK;
+	}
+
+	else
+	{
+		base->CTRL1 &= (~CAN_CTRL1_CLKSRC_MASK);
+	}
+
+	return STATUS_SUCCESS;
+}
+
+/** This function enables the module again after a clock change*/
+status_t CAN_resume(CAN_Type* base)
+{
+	/** Speed with the segments of the clock*/
+	uint32_t ctrl1;
+	/** Polls left*/
+	uint32_t timeout = CAN_ACK_TIMEOUT;
+
+	/** Enabled again in freeze mode, where the segments are written (Only frozen if the transition failed)*/
+	if(base->MCR & CAN_MCR_MDIS_MASK)
+	{
+		base->MCR &= (~CAN_MCR_MDIS_MASK);
+
+		while((!(base->MCR & CAN_MCR_FRZACK_MASK)) && (INIT_VAL != timeout))
 		{
-			can_init.base->RXIMR[counter] = NOT_CHECK_ANY_ID;
+			timeout --;
+		}
+
+		if(INIT_VAL == timeout)
+		{
+			return STATUS_TIMEOUT;
 		}
 	}
 
-	/** Sets the global ID mask to not check any ID*/
-	can_init.base->RXMGMASK = NOT_CHECK_ANY_ID;
+	/** The prescaler of the speed is kept, the bus clock takes the segments of 8 time quanta*/
+	ctrl1 = base->CTRL1 & (~CAN_SEGMENTS_MASK);
+	ctrl1 |= (ctrl1 & CAN_CTRL1_CLKSRC_MASK) ? CAN_CTRL1_SEGMENTS_8TQ : CAN_CTRL1_SEGMENTS_16TQ;
+	base->CTRL1 = ctrl1;
 
-	/** Enables the MB 4 for reception*/
-	can_init.base->RAMn[(RX_BUFF_OFFSET * MSG_BUF_SIZE) + CODE_AND_DLC_POS] = ENABLE_RX_BUFF;
+	/** Leaves the freeze mode*/
+	base->MCR &= (~(CAN_MCR_FRZ_MASK | CAN_MCR_HALT_MASK));
+	timeout = CAN_ACK_TIMEOUT;
 
-	/** CAN FD not used*/
-	can_init.base->MCR = CAN_FD_DISABLE;
+	while((base->MCR & CAN_MCR_FRZACK_MASK) && (INIT_VAL != timeout))
+	{
+		timeout --;
+	}
 
-	/** Waits for the module to exit freeze mode*/
-	while ((can_init.base->MCR && CAN_MCR_FRZACK_MASK) >> CAN_MCR_FRZACK_SHIFT);
-	/** Waits for the module to be ready*/
-	while ((can_init.base->MCR && CAN_MCR_NOTRDY_MASK) >> CAN_MCR_NOTRDY_SHIFT);
+	return (INIT_VAL != timeout) ? STATUS_SUCCESS : STATUS_TIMEOUT;
 }
 
 /** This function enables the interruption for the Rx message buffer*/
 void CAN_enable_rx_interruption(CAN_Type* base)
 {
-	base->IMASK1 = CAN_SET_RX_BUFF_ISR;
+	base->IMASK1 |= CAN_SET_RX_BUFF_ISR;
 }
 
-/** This function sends a message via CAN*/
-void CAN_send_message(can_message_tx_config_t can_message_tx)
+/** This function disables the interruption for the Rx message buffer*/
+void CAN_disable_rx_interruption(CAN_Type* base)
+{
+	base->IMASK1 &= ~CAN_SET_RX_BUFF_ISR;
+}
+
+/** This function sends a message via CAN (The copy to the MB runs from RAM in the flash builds)*/
+HOT_PATH_RAMSECTION void CAN_send_message(can_message_tx_config_t can_message_tx)
 {
 	/** Counter to set the message to the MB*/
 	uint16_t counter = INIT_VAL;
@@ -201,8 +330,8 @@ void CAN_send_message(can_message_tx_config_t can_message_tx)
 		can_message_tx.DLC = MAX_DLC;
 	}
 
-	/** Clears CAN 0 MB 0 interruption flag*/
-	can_message_tx.base->IFLAG1 = CLEAR_MB_0;
+	/** Clears the Tx MB interruption flag*/
+	can_message_tx.base->IFLAG1 = CLEAR_TX_MB;
 
 	/** Sets the message in the CAN tx buffer*/
 	for(counter = INIT_VAL ; counter < can_message_tx.DLC ; counter ++)
@@ -234,44 +363,52 @@ void CAN_send_message(can_message_tx_config_t can_message_tx)
 	can_message_tx.base->RAMn[(TX_BUFF_OFFSET * MSG_BUF_SIZE) + CODE_AND_DLC_POS] = (can_message_tx.DLC << CAN_WMBn_CS_DLC_SHIFT) | TX_BUFF_TRANSMITT;
 
 	while(!CAN_get_tx_status(CAN0));
-	can_message_tx.base->IFLAG1 = CLEAR_MB_0;
+	can_message_tx.base->IFLAG1 = CLEAR_TX_MB;
 }
 
-/** This function receives a message from CAN*/
-void CAN_receive_message(can_message_rx_config_t *can_message_rx)
+/** This function receives a message from CAN (The copy from the MB runs from RAM in the flash builds)*/
+HOT_PATH_RAMSECTION void CAN_receive_message(can_message_rx_config_t *can_message_rx)
 {
 	/** Counter to get the message*/
 	uint8_t counter = INIT_VAL;
+	/** Code and DLC word of the Rx FIFO output*/
+	uint32_t code_and_dlc = (*can_message_rx).base->RAMn[(RX_BUFF_OFFSET * MSG_BUF_SIZE) + CODE_AND_DLC_POS];
+	/** Data words of the Rx FIFO output*/
+	uint32_t data[DATA_SIZE];
 
-	/** Gets the rx code*/
-	RxCODE = ((*can_message_rx).base->RAMn[(RX_BUFF_OFFSET * MSG_BUF_SIZE) + CODE_AND_DLC_POS] & CAN_CODE_MASK) >> CAN_CODE_SHIFT;
 	/** Gets ID*/
 	RxID = ((*can_message_rx).base->RAMn[(RX_BUFF_OFFSET * MSG_BUF_SIZE) + ID_POS] & CAN_WMBn_ID_ID_MASK) >> STD_ID_SHIFT;
 	/** Gets the DLC*/
-	RxLENGTH = ((*can_message_rx).base->RAMn[(RX_BUFF_OFFSET * MSG_BUF_SIZE) + CODE_AND_DLC_POS] & CAN_WMBn_CS_DLC_MASK);
-	RxLENGTH  >>= CAN_WMBn_CS_DLC_SHIFT;
+	RxLENGTH = (code_and_dlc & CAN_WMBn_CS_DLC_MASK) >> CAN_WMBn_CS_DLC_SHIFT;
+	/** Gets the time stamp*/
+	(*can_message_rx).timestamp = (uint16_t)(code_and_dlc & CAN_TIMESTAMP_MASK);
+
+	/** The FIFO output is only read, the data is shifted in a copy*/
+	data[LOW_BYTE_TEMP] = (*can_message_rx).base->RAMn[(RX_BUFF_OFFSET * MSG_BUF_SIZE) + MSG_POS];
+	data[HIGH_BYTE_TEMP] = (*can_message_rx).base->RAMn[(RX_BUFF_OFFSET * MSG_BUF_SIZE) + ARRAY_OFFSET_1 + MSG_POS];
+
+	if(MAX_DLC < RxLENGTH)
+	{
+		RxLENGTH = MAX_DLC;
+	}
 
 	/** Gets each of the bytes*/
 	for(counter = INIT_VAL ; counter < RxLENGTH ; counter ++)
 	{
-		/** Gets the highest byte of the MB and sets it to msg*/
-		((*can_message_rx).msg[counter]) = (uint8_t)((((*can_message_rx).base->RAMn[(RX_BUFF_OFFSET * MSG_BUF_SIZE) +
-													(counter / BYTE_COUNT_4) + MSG_POS]) & CAN_RX_MSG_MSB_MASK) >> MSB_TO_LSB_SHIFT);
+		/** Gets the highest byte of the word and sets it to msg*/
+		((*can_message_rx).msg[counter]) = (uint8_t)((data[counter / BYTE_COUNT_4] & CAN_RX_MSG_MSB_MASK) >> MSB_TO_LSB_SHIFT);
 
 		/** Shifts the remaining message to the left*/
-		(*can_message_rx).base->RAMn[(RX_BUFF_OFFSET * MSG_BUF_SIZE) + (counter / BYTE_COUNT_4) + MSG_POS] <<= BYTE_SHIFT;
+		data[counter / BYTE_COUNT_4] <<= BYTE_SHIFT;
 	}
 
-	/** Clears the reception flag*/
-	(*can_message_rx).base->IFLAG1 = CLEAR_MB_4;
+	/** Pops the frame, the next one of the FIFO is moved to the output*/
+	(*can_message_rx).base->IFLAG1 = CLEAR_RX_FIFO;
 
 	/** Returns the data*/
 	((*can_message_rx).ID) = (uint16_t)RxID;
 	/** Sets the DLC*/
 	((*can_message_rx).DLC) = (uint8_t)(RxLENGTH);
-
-	/** Sets the MB ready for another message*/
-	(*can_message_rx).base->RAMn[(RX_BUFF_OFFSET * MSG_BUF_SIZE) + CODE_AND_DLC_POS] |= ENABLE_RX_BUFF;
 }
 
 /** Gets the flag of the RX buffer*/
@@ -280,10 +417,36 @@ CAN_rx_status_t CAN_get_rx_status(CAN_Type* base)
 	return ((CAN_rx_status_t)((base->IFLAG1 >> RX_MB_FLAG_SHIFT) & BIT_MASK));
 }
 
+/** This function clears the overflow flag of the Rx FIFO*/
+uint8_t CAN_clear_rx_overflow(CAN_Type* base)
+{
+	if(INIT_VAL == (base->IFLAG1 & RX_FIFO_OVERFLOW))
+	{
+		return INIT_VAL;
+	}
+
+	/** Only the overflow flag is written, the frames are not popped*/
+	base->IFLAG1 = RX_FIFO_OVERFLOW;
+
+	return BIT_MASK;
+}
+
 /** Gets the flag of the RX buffer*/
 CAN_tx_status_t CAN_get_tx_status(CAN_Type* base)
 {
-	return((CAN_tx_status_t)(base->IFLAG1 & BIT_MASK));
+	return((CAN_tx_status_t)((base->IFLAG1 >> TX_MB_FLAG_SHIFT) & BIT_MASK));
+}
+
+/** Gets the time stamp of the TX buffer*/
+uint16_t CAN_get_tx_timestamp(CAN_Type* base)
+{
+	return ((uint16_t)(base->RAMn[(TX_BUFF_OFFSET * MSG_BUF_SIZE) + CODE_AND_DLC_POS] & CAN_TIMESTAMP_MASK));
+}
+
+/** Gets the free running timer*/
+uint16_t CAN_get_timer(CAN_Type* base)
+{
+	return ((uint16_t)(base->TIMER & CAN_TIMESTAMP_MASK));
 }
 
 /** This function clears the RX and TX buffer flags*/
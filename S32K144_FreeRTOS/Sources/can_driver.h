@@ -17,6 +17,7 @@
 #define CAN_DRIVER_H_
 
 #include "S32K144.h"
+#include "status.h"
 
 /** Defines the speed of 500 Kbps*/
 #define CAN_CTRL1_SPEED_500KBPS			(0x00DB0006)
@@ -27,6 +28,23 @@
 /** Defines the speed of 50 Kbps*/
 #define CAN_CTRL1_SPEED_50KBPS			(0x09DB0006)
 
+/** Defines the frames queued by the Rx FIFO (Read one at a time with CAN_receive_message)*/
+#define CAN_RX_FIFO_DEPTH				(6U)
+
+/** Defines the segments of the speeds, 16 time quanta per bit (8 MHz oscillator clock)*/
+#define CAN_CTRL1_SEGMENTS_16TQ			(0x00DB0006)
+/** Defines the segments of 8 time quanta per bit, same sample point (4 MHz bus clock of VLPR)*/
+#define CAN_CTRL1_SEGMENTS_8TQ			(0x00490002)
+
+/*!
+ 	 \brief Enumerator to define the clock of the protocol engine.
+ */
+typedef enum
+{
+	can_clock_oscillator,	/*!< Oscillator clock (SOSCDIV2, 8 MHz)*/
+	can_clock_bus			/*!< Bus clock (Half the oscillator clock, only in VLPR)*/
+}CAN_clock_t;
+
 /*!
  	 \brief Enumerator to define whether the rx buffer has interrupted
  	 	 	 or not.
@@ -76,6 +94,7 @@ typedef struct
 	uint16_t ID;	/*!< ID received*/
 	uint8_t msg[8];	/*!< Message received*/
 	uint8_t DLC;	/*!< DLC received*/
+	uint16_t timestamp;	/*!< Value of the free running timer when the message was received*/
 }can_message_rx_config_t;
 
 /*!
@@ -83,12 +102,63 @@ typedef struct
 
  	 \param[in] can_init Configuration for the CAN driver.
 
+ 	 \return STATUS_SUCCESS, or STATUS_TIMEOUT if the module did not enter or leave
+ 	 	 	 the freeze mode.
+ */
+status_t CAN_Init(can_init_config_t can_init);
+
+/*!
+ 	 \brief This function enables the clock of the CAN module, and enables the module
+ 	 	 	 in freeze mode without waiting for it. CAN_Init waits for the freeze
+ 	 	 	 acknowledge, so the init in between overlaps it.
+
+ 	 \param[in] base CAN to be enabled.
+
  	 \return void.
  */
-void CAN_Init(can_init_config_t can_init);
+void CAN_enable(CAN_Type* base);
+
+/*!
+ 	 \brief This function enters the freeze mode, once the frame on the bus ends.
+ 	 	 	 It is called before the clock of the module changes (CAN_set_clock
+ 	 	 	 and CAN_resume follow).
+
+ 	 \param[in] base CAN to be frozen.
+
+ 	 \return STATUS_SUCCESS, STATUS_TIMEOUT if the freeze was not acknowledged, or
+ 	 	 	 STATUS_UNSUPPORTED if the module is not enabled yet (Nothing is changed).
+ */
+status_t CAN_freeze(CAN_Type* base);
 
 /*!
- 	 \brief This function enables the interruption for the Rx MB.
+ 	 \brief This function disables the module and selects the clock of its protocol
+ 	 	 	 engine. The module stays disabled until CAN_resume, so the clock can
+ 	 	 	 stop meanwhile (e.g. the SOSC in a transition to VLPR).
+
+ 	 \note The bus clock must be half the oscillator clock (4 MHz, VLPR of clock_policy.h).
+
+ 	 \param[in] base CAN whose clock is changed (Frozen with CAN_freeze).
+ 	 \param[in] clock Clock of the protocol engine.
+
+ 	 \return STATUS_SUCCESS, or STATUS_TIMEOUT if the module did not stop.
+ */
+status_t CAN_set_clock(CAN_Type* base, CAN_clock_t clock);
+
+/*!
+ 	 \brief This function enables the module again after CAN_set_clock (Or after
+ 	 	 	 CAN_freeze alone), and leaves the freeze mode. The prescaler of the speed
+ 	 	 	 is kept, the bus clock takes the segments of 8 time quanta, so the bit
+ 	 	 	 rate does not change.
+
+ 	 \param[in] base CAN to be resumed.
+
+ 	 \return STATUS_SUCCESS, or STATUS_TIMEOUT if a mode was not acknowledged.
+ */
+status_t CAN_resume(CAN_Type* base);
+
+/*!
+ 	 \brief This function enables the interruption for the Rx FIFO, it interrupts
+ 	 	 	 while frames are available. The other interruptions are kept.
 
  	 \param[in] base CAN whose interruption will be enabled.
 
@@ -96,6 +166,16 @@ void CAN_Init(can_init_config_t can_init);
  */
 void CAN_enable_rx_interruption(CAN_Type* base);
 
+/*!
+ 	 \brief This function disables the interruption for the Rx FIFO. The Rx flag is still
+ 	 	 	 set while frames are available (CAN_get_rx_status).
+
+ 	 \param[in] base CAN whose interruption will be disabled.
+
+ 	 \return void.
+ */
+void CAN_disable_rx_interruption(CAN_Type* base);
+
 /*!
  	 \brief This function sends a message via CAN using the standard ID.
 
@@ -108,10 +188,10 @@ void CAN_enable_rx_interruption(CAN_Type* base);
 void CAN_send_message(can_message_tx_config_t can_message_tx);
 
 /*!
- 	 \brief This function reads a message received via CAN.
+ 	 \brief This function reads the oldest message of the Rx FIFO.
 
  	 \note First make sure the CAN has received a message using the function CAN_get_rx_status().
- 	 \note This function erases the interruption flag of the Rx buffer.
+ 	 \note This function pops the message, the flag stays set while the FIFO holds more.
 
 	 \param[out] can_message_rx Message structure with the data received.
 
@@ -120,7 +200,7 @@ void CAN_send_message(can_message_tx_config_t can_message_tx);
 void CAN_receive_message(can_message_rx_config_t *can_message_rx);
 
 /*!
- 	 \brief This function gets the status of the Rx message buffer.
+ 	 \brief This function gets the status of the Rx FIFO.
 
  	 \param[in] base CAN module from which the Rx status will be checked.
 
@@ -128,6 +208,16 @@ void CAN_receive_message(can_message_rx_config_t *can_message_rx);
  */
 CAN_rx_status_t CAN_get_rx_status(CAN_Type* base);
 
+/*!
+ 	 \brief This function clears the overflow flag of the Rx FIFO. The flag is set when a
+ 	 	 	 frame is received with the FIFO full (The frame is lost).
+
+ 	 \param[in] base CAN module whose flag will be cleared.
+
+ 	 \return 1 if the FIFO overflowed since the last call, otherwise 0.
+ */
+uint8_t CAN_clear_rx_overflow(CAN_Type* base);
+
 /*!
  	 \brief This function gets the status of the Tx message buffer.
 
@@ -138,9 +228,32 @@ CAN_rx_status_t CAN_get_rx_status(CAN_Type* base);
 CAN_tx_status_t CAN_get_tx_status(CAN_Type* base);
 
 
+/*!
+ 	 \brief This function gets the time stamp of the last message sent.
+
+ 	 \note The time stamp is captured by the hardware on the same bit of the frame as in
+ 	 	 	 the receivers, so both sides timestamp the same instant.
+
+ 	 \param[in] base CAN module from which the time stamp will be read.
+
+ 	 \return Value of the free running timer when the message was sent (1 tick per bit time).
+ */
+uint16_t CAN_get_tx_timestamp(CAN_Type* base);
+
+/*!
+ 	 \brief This function gets the value of the free running timer.
+
+ 	 \param[in] base CAN module from which the timer will be read.
+
+ 	 \return Value of the free running timer (1 tick per bit time).
+ */
+uint16_t CAN_get_timer(CAN_Type* base);
+
 /*!
  	 \brief This function erases the Tx and Rx buffer flags.
 
+ 	 \note The frames available flag pops one frame of the Rx FIFO.
+
  	 \param[in] base CAN module whose flags will be erased.
 
  	 \return void.
@@ -0,0 +1,92 @@
+/*!
+ 	 \file can_signals.c
+
+ 	 \brief This is the source file of the CAN signals. The pack and unpack
+ 	 	 	 functions of the messages of motor.dbc are found in this source file.
+
+ 	 \note Generated by Host/dbc_codegen.py, do not modify it by hand.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include "can_signals.h"
+
+/** This function packs the SPEED_TX message*/
+void CAN_SIG_pack_speed_tx(uint8_t* data, const can_sig_speed_tx_t* msg)
+{
+	/** Raw value of direction*/
+	uint32_t raw_direction;
+	/** Raw value of RPM*/
+	uint32_t raw_RPM;
+
+	/** direction: saturates to [0, 1] and converts to raw*/
+	raw_direction = (uint32_t)((msg->direction > 1) ? 1 : msg->direction);
+
+	/** RPM: saturates to [0, 255] and converts to raw*/
+	raw_RPM = (uint32_t)msg->RPM;
+
+	/** Writes every byte once, the unused bits are 0*/
+	data[0] = (uint8_t)(raw_direction);
+	data[1] = (uint8_t)(raw_RPM);
+}
+
+/** This function unpacks the SPEED_TX message*/
+void CAN_SIG_unpack_speed_tx(const uint8_t* data, can_sig_speed_tx_t* msg)
+{
+	/** Raw value of direction*/
+	uint32_t raw_direction;
+	/** Raw value of RPM*/
+	uint32_t raw_RPM;
+
+	/** direction: gathers the raw bits, then converts and saturates to [0, 1]*/
+	raw_direction = (uint32_t)data[0];
+	msg->direction = (uint8_t)raw_direction;
+	msg->direction = (msg->direction > 1) ? 1 : msg->direction;
+
+	/** RPM: gathers the raw bits, then converts and saturates to [0, 255]*/
+	raw_RPM = (uint32_t)data[1];
+	msg->RPM = (uint8_t)raw_RPM;
+}
+
+/** This function packs the SPEED_RX message*/
+void CAN_SIG_pack_speed_rx(uint8_t* data, const can_sig_speed_rx_t* msg)
+{
+	/** Raw value of direction*/
+	uint32_t raw_direction;
+	/** Raw value of RPM*/
+	uint32_t raw_RPM;
+
+	/** direction: saturates to [0, 1] and converts to raw*/
+	raw_direction = (uint32_t)((msg->direction > 1) ? 1 : msg->direction);
+
+	/** RPM: saturates to [0, 150] and converts to raw*/
+	raw_RPM = (uint32_t)((msg->RPM > 150) ? 150 : msg->RPM);
+
+	/** Writes every byte once, the unused bits are 0*/
+	data[0] = (uint8_t)(raw_direction);
+	data[1] = (uint8_t)(raw_RPM);
+}
+
+/** This function unpacks the SPEED_RX message*/
+void CAN_SIG_unpack_speed_rx(const uint8_t* data, can_sig_speed_rx_t* msg)
+{
+	/** Raw value of direction*/
+	uint32_t raw_direction;
+	/** Raw value of RPM*/
+	uint32_t raw_RPM;
+
+	/** direction: gathers the raw bits, then converts and saturates to [0, 1]*/
+	raw_direction = (uint32_t)data[0];
+	msg->direction = (uint8_t)raw_direction;
+	msg->direction = (msg->direction > 1) ? 1 : msg->direction;
+
+	/** RPM: gathers the raw bits, then converts and saturates to [0, 150]*/
+	raw_RPM = (uint32_t)data[1];
+	msg->RPM = (uint8_t)raw_RPM;
+	msg->RPM = (msg->RPM > 150) ? 150 : msg->RPM;
+}
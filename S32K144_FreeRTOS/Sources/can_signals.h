@@ -0,0 +1,90 @@
+/*!
+ 	 \file can_signals.h
+
+ 	 \brief This is the header file of the CAN signals. It has the pack and unpack
+ 	 	 	 functions of the messages of motor.dbc.
+
+ 	 \note Generated by Host/dbc_codegen.py, do not modify it by hand.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef CAN_SIGNALS_H_
+#define CAN_SIGNALS_H_
+
+#include <stdint.h>
+
+/** Defines the ID of the SPEED_TX message*/
+#define CAN_SIG_SPEED_TX_ID			(0x011)
+/** Defines the DLC of the SPEED_TX message*/
+#define CAN_SIG_SPEED_TX_DLC		(2)
+
+/*!
+ 	 \brief Signals of the SPEED_TX message (Speed measured by the motor node).
+ */
+typedef struct
+{
+	uint8_t direction;	/*!< Bits 0 to 7, Intel*/
+	uint8_t RPM;	/*!< Bits 8 to 15, Intel [rpm]*/
+}can_sig_speed_tx_t;
+
+/*!
+ 	 \brief This function packs the SPEED_TX message, saturating every signal to its range.
+
+ 	 \param[out] data Payload of 2 bytes.
+ 	 \param[in] msg Signals to be packed.
+
+ 	 \return void.
+ */
+void CAN_SIG_pack_speed_tx(uint8_t* data, const can_sig_speed_tx_t* msg);
+
+/*!
+ 	 \brief This function unpacks the SPEED_TX message, saturating every signal to its range.
+
+ 	 \param[in] data Payload of 2 bytes.
+ 	 \param[out] msg Signals unpacked.
+
+ 	 \return void.
+ */
+void CAN_SIG_unpack_speed_tx(const uint8_t* data, can_sig_speed_tx_t* msg);
+
+/** Defines the ID of the SPEED_RX message*/
+#define CAN_SIG_SPEED_RX_ID			(0x010)
+/** Defines the DLC of the SPEED_RX message*/
+#define CAN_SIG_SPEED_RX_DLC		(2)
+
+/*!
+ 	 \brief Signals of the SPEED_RX message (Speed requested to the motor node).
+ */
+typedef struct
+{
+	uint8_t direction;	/*!< Bits 0 to 7, Intel*/
+	uint8_t RPM;	/*!< Bits 8 to 15, Intel [rpm]*/
+}can_sig_speed_rx_t;
+
+/*!
+ 	 \brief This function packs the SPEED_RX message, saturating every signal to its range.
+
+ 	 \param[out] data Payload of 2 bytes.
+ 	 \param[in] msg Signals to be packed.
+
+ 	 \return void.
+ */
+void CAN_SIG_pack_speed_rx(uint8_t* data, const can_sig_speed_rx_t* msg);
+
+/*!
+ 	 \brief This function unpacks the SPEED_RX message, saturating every signal to its range.
+
+ 	 \param[in] data Payload of 2 bytes.
+ 	 \param[out] msg Signals unpacked.
+
+ 	 \return void.
+ */
+void CAN_SIG_unpack_speed_rx(const uint8_t* data, can_sig_speed_rx_t* msg);
+
+#endif /* CAN_SIGNALS_H_ */
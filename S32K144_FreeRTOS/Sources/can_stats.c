@@ -0,0 +1,592 @@
+/*!
+ 	 \file can_stats.c
+
+ 	 \brief This is the source file of the CAN statistics. The frame accounting,
+ 	 	 	 the load windows and the broadcast are found in this source file.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include "can_stats.h"
+#include "tick_period.h"
+#include "rtos_driver.h"
+
+/** Defines the statistics handler as initialized*/
+#define IS_INIT								(1)
+/** Defines the statistics handler as not initialized*/
+#define NOT_INIT							(0)
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL							(0)
+
+
+/** Defines the bits of a standard data frame without data that can be stuffed (SOF to CRC)*/
+#define FRAME_STUFFED_BITS					(34)
+/** Defines the bits of a standard data frame that are never stuffed (CRC delimiter to IFS)*/
+#define FRAME_FIXED_BITS					(13)
+/** Defines the bits of a data byte*/
+#define BITS_IN_BYTE						(8)
+/** Defines the maximum DLC of a frame*/
+#define MAX_DLC								(8)
+/** Defines the bits after which a stuff bit can be inserted (Worst case, after the first one every 4 bits)*/
+#define STUFF_BIT_PERIOD					(4)
+
+/** Defines the scale of the filtered intervals*/
+#define EMA_SCALE_SHIFT						(4)
+/** Defines the weight of a new interval in the filters (1/8)*/
+#define EMA_WEIGHT_SHIFT					(3)
+/** Defines the longest interval accounted in the filters, in ticks*/
+#define MAX_FILTER_INTERVAL					(0x07FFFFFFU)
+
+/** Defines the value of the load of a full window*/
+#define PERMILLE							(1000U)
+/** Defines the microseconds in a second*/
+#define US_PER_S							(1000000U)
+/** Defines the milliseconds in a second*/
+#define MS_PER_S							(1000U)
+
+/** Defines the bit shifts for a byte*/
+#define BYTE_SHIFT							(8)
+/** Defines a mask to get a byte*/
+#define BYTE_MASK							(0xFF)
+/** Defines the size of the broadcast frame*/
+#define BROADCAST_SIZE						(8)
+/** Defines the position of the load in the broadcast frame*/
+#define LOAD_POS							(0)
+/** Defines the position of the peak load in the broadcast frame*/
+#define PEAK_POS							(2)
+/** Defines the position of the frames per second in the broadcast frame*/
+#define RATE_POS							(4)
+/** Defines the position of the busiest ID in the broadcast frame*/
+#define BUSIEST_POS							(6)
+/** Defines the offset of the low byte of a field*/
+#define LOW_BYTE_OFFSET						(1)
+
+/*********************************************************************************************/
+
+/*!
+ 	 \brief Structure for the statistics of a tracked ID.
+ */
+typedef struct
+{
+	uint16_t ID;				/*!< ID of the entry*/
+	uint32_t frames;			/*!< Frames since the statistics were initialized*/
+	uint32_t window_frames;		/*!< Frames in the current window*/
+	uint32_t window_bits;		/*!< Bits in the current window*/
+	uint32_t frames_per_s;		/*!< Frames per second in the last window*/
+	uint64_t last_stamp;		/*!< Time of the last frame, in ticks*/
+	uint32_t mean_interval;		/*!< Filtered interval, in ticks scaled by EMA_SCALE_SHIFT*/
+	uint32_t jitter;			/*!< Filtered deviation, in ticks scaled by EMA_SCALE_SHIFT*/
+	uint32_t min_interval;		/*!< Shortest interval, in ticks*/
+	uint32_t max_interval;		/*!< Longest interval, in ticks*/
+}can_stats_entry_t;
+
+/*!
+ 	 \brief Structure for the statistics handler.
+ */
+typedef struct
+{
+	uint8_t init_val;			/*!< Defines whether the handler has been initialized or not*/
+	CAN_Type* base;				/*!< CAN whose traffic is measured*/
+	uint32_t bit_rate;			/*!< Bit rate of the bus (Ticks per second)*/
+	uint64_t ticks;				/*!< Timer extended to 64 bits*/
+	uint16_t last_timer;		/*!< Value of the timer on the last extension*/
+	uint64_t window_start;		/*!< Time when the current window started*/
+	uint32_t window_bits;		/*!< Bits in the current window*/
+	uint32_t window_frames;		/*!< Frames in the current window*/
+	uint8_t entries;			/*!< Number of tracked IDs*/
+	uint8_t last_entry;			/*!< Last entry hit, consecutive frames of an ID skip the search*/
+	uint32_t broadcast_windows;	/*!< Windows between broadcasts (0 = disabled)*/
+	can_stats_bus_t bus;		/*!< Statistics of the bus*/
+}can_stats_handler_t;
+
+/*********************************************************************************************/
+
+/*!
+ 	 \brief This function extends a time stamp of the timer to 64 bits.
+
+ 	 \note Call it inside a critical section.
+
+ 	 \param[in] timestamp Time stamp or value of the timer.
+
+ 	 \return Extended time, in ticks.
+ */
+static uint64_t can_stats_extend(uint16_t timestamp);
+
+/*!
+ 	 \brief This function finds the entry of an ID, and adds it if there is space.
+
+ 	 \param[in] ID ID to be found.
+
+ 	 \return Pointer to the entry, NULL if the table is full.
+ */
+static can_stats_entry_t* can_stats_find(uint16_t ID);
+
+/*!
+ 	 \brief This function converts ticks to microseconds.
+
+ 	 \param[in] ticks Ticks to be converted.
+
+ 	 \return Microseconds.
+ */
+static uint32_t can_stats_ticks_to_us(uint64_t ticks);
+
+/*!
+ 	 \brief This function closes the current window. The counters are copied and
+ 	 	 	 cleared inside a critical section, and divided after it.
+
+ 	 \return void.
+ */
+static void can_stats_close_window(void);
+
+/*!
+ 	 \brief This function copies the statistics of an entry.
+
+ 	 \param[in] entry Entry to be copied.
+ 	 \param[out] stats Statistics of the ID.
+
+ 	 \return void.
+ */
+static void can_stats_copy(const can_stats_entry_t* entry, can_stats_ID_t* stats);
+
+/*!
+ 	 \brief This function sends the broadcast of the bus statistics.
+
+ 	 \return void.
+ */
+static void can_stats_broadcast(void);
+
+/*********************************************************************************************/
+
+/** Statistics handler*/
+static can_stats_handler_t can_stats_handler = { INIT_VAL };
+/** Statistics of the tracked IDs*/
+static can_stats_entry_t can_stats_entry[CAN_STATS_MAX_IDS];
+
+/*********************************************************************************************/
+
+/** This function initializes the statistics*/
+void CAN_STATS_init(CAN_Type* base, uint32_t bit_rate)
+{
+	can_stats_handler.base = base;
+	can_stats_handler.bit_rate = bit_rate;
+	can_stats_handler.ticks = INIT_VAL;
+	can_stats_handler.last_timer = CAN_get_timer(base);
+	can_stats_handler.window_start = INIT_VAL;
+	can_stats_handler.window_bits = INIT_VAL;
+	can_stats_handler.window_frames = INIT_VAL;
+	can_stats_handler.entries = INIT_VAL;
+	can_stats_handler.last_entry = INIT_VAL;
+	can_stats_handler.broadcast_windows = INIT_VAL;
+
+	/** Sets the handler as initialized*/
+	can_stats_handler.init_val = IS_INIT;
+}
+
+/** This function accounts a frame*/
+void CAN_STATS_record(uint16_t ID, uint8_t DLC, uint16_t timestamp)
+{
+	/** Bits of the frame, with the worst case of stuff bits*/
+	uint32_t bits;
+	/** Time of the frame*/
+	uint64_t now;
+	/** Time since the previous frame of the ID*/
+	uint32_t interval;
+	/** Deviation of the interval from the mean*/
+	int32_t deviation;
+	/** Entry of the ID*/
+	can_stats_entry_t* entry;
+
+	if(IS_INIT != can_stats_handler.init_val)
+	{
+		return;
+	}
+
+	if(MAX_DLC < DLC)
+	{
+		DLC = MAX_DLC;
+	}
+
+	bits = FRAME_STUFFED_BITS + FRAME_FIXED_BITS + (BITS_IN_BYTE * DLC) +
+		   ((FRAME_STUFFED_BITS + (BITS_IN_BYTE * DLC) - 1) / STUFF_BIT_PERIOD);
+
+	taskENTER_CRITICAL();
+
+	now = can_stats_extend(timestamp);
+	can_stats_handler.window_bits += bits;
+	can_stats_handler.window_frames ++;
+	can_stats_handler.bus.total_frames ++;
+
+	entry = can_stats_find(ID);
+
+	if(NULL == entry)
+	{
+		can_stats_handler.bus.untracked_frames ++;
+	}
+
+	else
+	{
+		/** The intervals start with the second frame*/
+		if(INIT_VAL != entry->frames)
+		{
+			interval = (uint32_t)(now - entry->last_stamp);
+
+			if(interval < entry->min_interval)
+			{
+				entry->min_interval = interval;
+			}
+
+			if(interval > entry->max_interval)
+			{
+				entry->max_interval = interval;
+			}
+
+			if(MAX_FILTER_INTERVAL < interval)
+			{
+				interval = MAX_FILTER_INTERVAL;
+			}
+
+			/** The first interval initializes the mean, the next ones are filtered*/
+			if(INIT_VAL == entry->mean_interval)
+			{
+				entry->mean_interval = interval << EMA_SCALE_SHIFT;
+			}
+
+			deviation = (int32_t)(interval << EMA_SCALE_SHIFT) - (int32_t)entry->mean_interval;
+			entry->mean_interval = (uint32_t)((int32_t)entry->mean_interval + (deviation >> EMA_WEIGHT_SHIFT));
+
+			if(INIT_VAL > deviation)
+			{
+				deviation = -deviation;
+			}
+
+			entry->jitter = (uint32_t)((int32_t)entry->jitter + ((deviation - (int32_t)entry->jitter) >> EMA_WEIGHT_SHIFT));
+		}
+
+		entry->last_stamp = now;
+		entry->frames ++;
+		entry->window_frames ++;
+		entry->window_bits += bits;
+	}
+
+	taskEXIT_CRITICAL();
+}
+
+/** This thread closes the windows*/
+void CAN_STATS_thread(void* args)
+{
+	/** Variable to count the ticks passed since the delay*/
+	TickType_t xLastWakeTime = xTaskGetTickCount();
+	/** Windows since the last broadcast*/
+	uint32_t windows = INIT_VAL;
+
+	for(;;)
+	{
+		/** The window is shorter than a wrap of the timer, so it also keeps the extension valid*/
+		vTaskDelayUntil(&xLastWakeTime, (CAN_STATS_WINDOW * FIX_PERIOD));
+
+		can_stats_close_window();
+
+		windows ++;
+
+		if((INIT_VAL != can_stats_handler.broadcast_windows) && (can_stats_handler.broadcast_windows <= windows))
+		{
+			can_stats_broadcast();
+			windows = INIT_VAL;
+		}
+	}
+}
+
+/** This function sets the broadcast period*/
+void CAN_STATS_set_broadcast(uint32_t period)
+{
+	can_stats_handler.broadcast_windows = period / CAN_STATS_WINDOW;
+}
+
+/** This function gets the statistics of the bus*/
+void CAN_STATS_get_bus(can_stats_bus_t* bus)
+{
+	taskENTER_CRITICAL();
+	*bus = can_stats_handler.bus;
+	bus->tracked_IDs = can_stats_handler.entries;
+	taskEXIT_CRITICAL();
+}
+
+/** This function gets the statistics of an ID*/
+CAN_stats_status_t CAN_STATS_get_ID(uint16_t ID, can_stats_ID_t* stats)
+{
+	/** Sets the return value as not found*/
+	CAN_stats_status_t retval = can_stats_not_found;
+	/** Counter for the entries*/
+	uint8_t counter;
+	/** Copy of the entry, converted out of the critical section*/
+	can_stats_entry_t entry;
+
+	taskENTER_CRITICAL();
+
+	for(counter = INIT_VAL ; counter < can_stats_handler.entries ; counter ++)
+	{
+		if(ID == can_stats_entry[counter].ID)
+		{
+			entry = can_stats_entry[counter];
+			retval = can_stats_success;
+			break;
+		}
+	}
+
+	taskEXIT_CRITICAL();
+
+	if(can_stats_success == retval)
+	{
+		can_stats_copy(&entry, stats);
+	}
+
+	return retval;
+}
+
+/** This function gets the statistics of an index*/
+CAN_stats_status_t CAN_STATS_get_index(uint8_t index, can_stats_ID_t* stats)
+{
+	/** Sets the return value as not found*/
+	CAN_stats_status_t retval = can_stats_not_found;
+	/** Copy of the entry, converted out of the critical section*/
+	can_stats_entry_t entry;
+
+	taskENTER_CRITICAL();
+
+	if(index < can_stats_handler.entries)
+	{
+		entry = can_stats_entry[index];
+		retval = can_stats_success;
+	}
+
+	taskEXIT_CRITICAL();
+
+	if(can_stats_success == retval)
+	{
+		can_stats_copy(&entry, stats);
+	}
+
+	return retval;
+}
+
+/** This function clears the peak load*/
+void CAN_STATS_reset_peak(void)
+{
+	taskENTER_CRITICAL();
+	can_stats_handler.bus.peak_load_permille = INIT_VAL;
+	can_stats_handler.bus.peak_time_ms = INIT_VAL;
+	taskEXIT_CRITICAL();
+}
+
+/** This function extends a time stamp*/
+static uint64_t can_stats_extend(uint16_t timestamp)
+{
+	/** Value of the timer*/
+	uint16_t timer = CAN_get_timer(can_stats_handler.base);
+
+	/** Accumulates the ticks since the last extension (The subtraction wraps with the timer)*/
+	can_stats_handler.ticks += (uint16_t)(timer - can_stats_handler.last_timer);
+	can_stats_handler.last_timer = timer;
+
+	/** The time stamp is in the past of the current value of the timer*/
+	return can_stats_handler.ticks - (uint16_t)(timer - timestamp);
+}
+
+/** This function finds the entry of an ID*/
+static can_stats_entry_t* can_stats_find(uint16_t ID)
+{
+	/** Entry found*/
+	can_stats_entry_t* entry = NULL;
+	/** Counter for the entries*/
+	uint8_t counter;
+
+	/** Consecutive frames of the same ID are the common case*/
+	if((can_stats_handler.last_entry < can_stats_handler.entries) &&
+	   (ID == can_stats_entry[can_stats_handler.last_entry].ID))
+	{
+		return &can_stats_entry[can_stats_handler.last_entry];
+	}
+
+	for(counter = INIT_VAL ; counter < can_stats_handler.entries ; counter ++)
+	{
+		if(ID == can_stats_entry[counter].ID)
+		{
+			entry = &can_stats_entry[counter];
+			break;
+		}
+	}
+
+	/** Adds the ID if it is new and there is space*/
+	if((NULL == entry) && (CAN_STATS_MAX_IDS > can_stats_handler.entries))
+	{
+		entry = &can_stats_entry[can_stats_handler.entries];
+		entry->ID = ID;
+		entry->frames = INIT_VAL;
+		entry->window_frames = INIT_VAL;
+		entry->window_bits = INIT_VAL;
+		entry->frames_per_s = INIT_VAL;
+		entry->mean_interval = INIT_VAL;
+		entry->jitter = INIT_VAL;
+		entry->min_interval = UINT32_MAX;
+		entry->max_interval = INIT_VAL;
+		counter = can_stats_handler.entries;
+		can_stats_handler.entries ++;
+	}
+
+	if(NULL != entry)
+	{
+		can_stats_handler.last_entry = counter;
+	}
+
+	return entry;
+}
+
+/** This function converts ticks to microseconds*/
+static uint32_t can_stats_ticks_to_us(uint64_t ticks)
+{
+	return (uint32_t)((ticks * US_PER_S) / can_stats_handler.bit_rate);
+}
+
+/** This function closes the window*/
+static void can_stats_close_window(void)
+{
+	/** Time of the end of the window*/
+	uint64_t now;
+	/** Start of the window*/
+	uint64_t window_start;
+	/** Duration of the window, in ticks (1 tick per bit)*/
+	uint64_t elapsed;
+	/** Bits of the window*/
+	uint32_t window_bits;
+	/** Frames of the window*/
+	uint32_t window_frames;
+	/** Frames of the window of every entry*/
+	uint32_t entry_frames[CAN_STATS_MAX_IDS];
+	/** Entries of the window*/
+	uint8_t entries;
+	/** Bits of the busiest ID*/
+	uint32_t busiest_bits = INIT_VAL;
+	/** Busiest ID of the window*/
+	uint16_t busiest_ID = INIT_VAL;
+	/** Load of the window*/
+	uint16_t load_permille;
+	/** Frames per second of the window*/
+	uint32_t frames_per_s;
+	/** Time of the start of the window, in ms*/
+	uint32_t start_ms;
+	/** Counter for the entries*/
+	uint8_t counter;
+
+	/** Only the copies and the clears are done with the interrupts masked*/
+	taskENTER_CRITICAL();
+
+	now = can_stats_extend(CAN_get_timer(can_stats_handler.base));
+	window_start = can_stats_handler.window_start;
+	elapsed = now - window_start;
+
+	if(INIT_VAL == elapsed)
+	{
+		taskEXIT_CRITICAL();
+		return;
+	}
+
+	window_bits = can_stats_handler.window_bits;
+	window_frames = can_stats_handler.window_frames;
+	entries = can_stats_handler.entries;
+
+	for(counter = INIT_VAL ; counter < entries ; counter ++)
+	{
+		entry_frames[counter] = can_stats_entry[counter].window_frames;
+
+		if(can_stats_entry[counter].window_bits > busiest_bits)
+		{
+			busiest_bits = can_stats_entry[counter].window_bits;
+			busiest_ID = can_stats_entry[counter].ID;
+		}
+
+		can_stats_entry[counter].window_frames = INIT_VAL;
+		can_stats_entry[counter].window_bits = INIT_VAL;
+	}
+
+	can_stats_handler.window_bits = INIT_VAL;
+	can_stats_handler.window_frames = INIT_VAL;
+	can_stats_handler.window_start = now;
+
+	taskEXIT_CRITICAL();
+
+	/** A bit on the bus takes a tick, so the load does not depend on the bit rate*/
+	load_permille = (uint16_t)(((uint64_t)window_bits * PERMILLE) / elapsed);
+	frames_per_s = (uint32_t)(((uint64_t)window_frames * can_stats_handler.bit_rate) / elapsed);
+	start_ms = (uint32_t)((window_start * MS_PER_S) / can_stats_handler.bit_rate);
+
+	/** The rate of an entry is a single word, it is written without the critical section*/
+	for(counter = INIT_VAL ; counter < entries ; counter ++)
+	{
+		can_stats_entry[counter].frames_per_s = (uint32_t)(((uint64_t)entry_frames[counter] * can_stats_handler.bit_rate) / elapsed);
+	}
+
+	taskENTER_CRITICAL();
+
+	can_stats_handler.bus.load_permille = load_permille;
+	can_stats_handler.bus.frames_per_s = frames_per_s;
+
+	if(INIT_VAL != busiest_bits)
+	{
+		can_stats_handler.bus.busiest_ID = busiest_ID;
+	}
+
+	if(load_permille > can_stats_handler.bus.peak_load_permille)
+	{
+		can_stats_handler.bus.peak_load_permille = load_permille;
+		can_stats_handler.bus.peak_time_ms = start_ms;
+	}
+
+	taskEXIT_CRITICAL();
+}
+
+/** This function copies the statistics of an entry*/
+static void can_stats_copy(const can_stats_entry_t* entry, can_stats_ID_t* stats)
+{
+	stats->ID = entry->ID;
+	stats->frames = entry->frames;
+	stats->frames_per_s = entry->frames_per_s;
+	stats->mean_interval_us = can_stats_ticks_to_us(entry->mean_interval >> EMA_SCALE_SHIFT);
+	stats->jitter_us = can_stats_ticks_to_us(entry->jitter >> EMA_SCALE_SHIFT);
+	stats->min_interval_us = (UINT32_MAX == entry->min_interval) ? INIT_VAL : can_stats_ticks_to_us(entry->min_interval);
+	stats->max_interval_us = can_stats_ticks_to_us(entry->max_interval);
+}
+
+/** This function sends the broadcast*/
+static void can_stats_broadcast(void)
+{
+	/** Frame to be sent*/
+	uint8_t frame[BROADCAST_SIZE];
+	/** Message structure*/
+	can_message_tx_config_t tx_msg;
+	/** Statistics of the bus*/
+	can_stats_bus_t bus;
+
+	CAN_STATS_get_bus(&bus);
+
+	frame[LOAD_POS] = (uint8_t)(bus.load_permille >> BYTE_SHIFT);
+	frame[LOAD_POS + LOW_BYTE_OFFSET] = (uint8_t)(bus.load_permille & BYTE_MASK);
+	frame[PEAK_POS] = (uint8_t)(bus.peak_load_permille >> BYTE_SHIFT);
+	frame[PEAK_POS + LOW_BYTE_OFFSET] = (uint8_t)(bus.peak_load_permille & BYTE_MASK);
+	frame[RATE_POS] = (uint8_t)((bus.frames_per_s >> BYTE_SHIFT) & BYTE_MASK);
+	frame[RATE_POS + LOW_BYTE_OFFSET] = (uint8_t)(bus.frames_per_s & BYTE_MASK);
+	frame[BUSIEST_POS] = (uint8_t)(bus.busiest_ID >> BYTE_SHIFT);
+	frame[BUSIEST_POS + LOW_BYTE_OFFSET] = (uint8_t)(bus.busiest_ID & BYTE_MASK);
+
+	tx_msg.base = can_stats_handler.base;
+	tx_msg.ID = CAN_STATS_TX_ID;
+	tx_msg.msg = frame;
+	tx_msg.DLC = BROADCAST_SIZE;
+
+	rtos_can_transmit(tx_msg);
+}
@@ -0,0 +1,151 @@
+/*!
+ 	 \file can_stats.h
+
+ 	 \brief This is the header file of the CAN statistics. It is fed by the rx and
+ 	 	 	 tx functions of the RTOS CAN driver, and computes the bus load, the peak
+ 	 	 	 load window and the rate and inter-arrival jitter of every ID.
+
+ 	 \note The frame length is estimated with the worst case of stuff bits, so the
+ 	 	 	 bus load is an upper bound. The times are measured with the time stamps of
+ 	 	 	 the message buffers (1 tick per bit time).
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef CAN_STATS_H_
+#define CAN_STATS_H_
+
+#include "S32K144.h"
+
+/** Defines the number of IDs that are tracked (The rest only count for the bus load)*/
+#define CAN_STATS_MAX_IDS					(32)
+/** Defines the length of a load window, in milliseconds*/
+#define CAN_STATS_WINDOW					(100)
+/** Defines the ID of the periodic broadcast*/
+#define CAN_STATS_TX_ID						(0x7A0)
+
+/*!
+ 	 \brief Enumerator to define the status of a statistics query.
+ */
+typedef enum
+{
+	can_stats_success,		/*!< The statistics were copied*/
+	can_stats_not_found		/*!< The ID or the index is not tracked*/
+}CAN_stats_status_t;
+
+/*!
+ 	 \brief Statistics of the bus.
+ */
+typedef struct
+{
+	uint16_t load_permille;			/*!< Bus load of the last window*/
+	uint16_t peak_load_permille;	/*!< Highest bus load of a window since the last reset*/
+	uint32_t peak_time_ms;			/*!< Time of the peak window, since the statistics were initialized*/
+	uint32_t frames_per_s;			/*!< Frames per second in the last window*/
+	uint32_t total_frames;			/*!< Frames since the statistics were initialized*/
+	uint16_t busiest_ID;			/*!< ID with most bits in the last window*/
+	uint8_t tracked_IDs;			/*!< Number of IDs being tracked*/
+	uint32_t untracked_frames;		/*!< Frames whose ID did not fit in the table*/
+}can_stats_bus_t;
+
+/*!
+ 	 \brief Statistics of an ID.
+ */
+typedef struct
+{
+	uint16_t ID;					/*!< ID of the statistics*/
+	uint32_t frames;				/*!< Frames since the statistics were initialized*/
+	uint32_t frames_per_s;			/*!< Frames per second in the last window*/
+	uint32_t mean_interval_us;		/*!< Filtered time between frames*/
+	uint32_t jitter_us;				/*!< Filtered deviation of the time between frames*/
+	uint32_t min_interval_us;		/*!< Shortest time between frames*/
+	uint32_t max_interval_us;		/*!< Longest time between frames*/
+}can_stats_ID_t;
+
+/*!
+ 	 \brief This function initializes the statistics.
+
+ 	 \param[in] base CAN whose traffic is measured.
+ 	 \param[in] bit_rate Bit rate of the bus, in bits per second.
+
+ 	 \return void.
+ */
+void CAN_STATS_init(CAN_Type* base, uint32_t bit_rate);
+
+/*!
+ 	 \brief This function accounts a frame sent or received.
+
+ 	 \note It is called by the RTOS CAN driver, and it only accumulates counters, the
+ 	 	 	 windows are closed by CAN_STATS_thread.
+
+ 	 \param[in] ID ID of the frame.
+ 	 \param[in] DLC DLC of the frame.
+ 	 \param[in] timestamp Time stamp of the message buffer.
+
+ 	 \return void.
+ */
+void CAN_STATS_record(uint16_t ID, uint8_t DLC, uint16_t timestamp);
+
+/*!
+ 	 \brief This thread closes the load windows and sends the periodic broadcast.
+
+ 	 \param[in] args Thread arguments. Set to NULL.
+
+ 	 \return void.
+ */
+void CAN_STATS_thread(void* args);
+
+/*!
+ 	 \brief This function sets the period of the broadcast of the bus statistics.
+
+ 	 \note Broadcast frame (ID CAN_STATS_TX_ID): [load (2), peak load (2),
+ 	 	 	 frames per second (2), busiest ID (2)], big endian.
+
+ 	 \param[in] period Period in milliseconds, rounded to windows. 0 disables the broadcast.
+
+ 	 \return void.
+ */
+void CAN_STATS_set_broadcast(uint32_t period);
+
+/*!
+ 	 \brief This function gets the statistics of the bus.
+
+ 	 \param[out] bus Statistics of the bus.
+
+ 	 \return void.
+ */
+void CAN_STATS_get_bus(can_stats_bus_t* bus);
+
+/*!
+ 	 \brief This function gets the statistics of an ID.
+
+ 	 \param[in] ID ID to be queried.
+ 	 \param[out] stats Statistics of the ID.
+
+ 	 \return Whether the ID is tracked.
+ */
+CAN_stats_status_t CAN_STATS_get_ID(uint16_t ID, can_stats_ID_t* stats);
+
+/*!
+ 	 \brief This function gets the statistics of a tracked ID by its index, to list all of them.
+
+ 	 \param[in] index Index from 0 to tracked_IDs - 1.
+ 	 \param[out] stats Statistics of the ID.
+
+ 	 \return Whether the index is valid.
+ */
+CAN_stats_status_t CAN_STATS_get_index(uint8_t index, can_stats_ID_t* stats);
+
+/*!
+ 	 \brief This function clears the peak load.
+
+ 	 \return void.
+ */
+void CAN_STATS_reset_peak(void);
+
+#endif /* CAN_STATS_H_ */
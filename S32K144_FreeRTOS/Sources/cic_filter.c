@@ -0,0 +1,102 @@
+/*!
+ 	 \file cic_filter.c
+
+ 	 \brief This is the source file of the fixed point CIC decimation filter.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include "cic_filter.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL							(0)
+/** Defines the maximum value of the output*/
+#define CIC_FILTER_OUTPUT_MAX				((1UL << CIC_FILTER_OUTPUT_BITS) - 1UL)
+
+/** This function initializes a filter*/
+void CIC_FILTER_init(CIC_FILTER_t* filter, uint8_t input_bits, uint8_t decimation_log2)
+{
+	/** Highest decimation for the input*/
+	uint8_t decimation_max = CIC_FILTER_get_max_decimation(input_bits);
+	uint8_t stage;
+
+	filter->input_bits = input_bits;
+	filter->decimation_log2 = (decimation_max < decimation_log2) ? decimation_max : decimation_log2;
+	filter->phase = INIT_VAL;
+	filter->settling = CIC_FILTER_ORDER;
+
+	for(stage = INIT_VAL ; stage < CIC_FILTER_ORDER ; stage ++)
+	{
+		filter->integrators[stage] = INIT_VAL;
+		filter->combs[stage] = INIT_VAL;
+	}
+}
+
+/** This function gets the highest decimation*/
+uint8_t CIC_FILTER_get_max_decimation(uint8_t input_bits)
+{
+	return (CIC_FILTER_STATE_BITS <= input_bits) ? INIT_VAL :
+		   (uint8_t)((CIC_FILTER_STATE_BITS - input_bits) / CIC_FILTER_ORDER);
+}
+
+/** This function filters an input sample*/
+bool CIC_FILTER_update(CIC_FILTER_t* filter, uint16_t sample, uint16_t* output)
+{
+	/** Value through the stages*/
+	uint32_t value = sample;
+	/** Input of a comb*/
+	uint32_t comb_input;
+	/** Bits of the output before the scaling*/
+	uint8_t bits;
+	uint8_t stage;
+
+	for(stage = INIT_VAL ; stage < CIC_FILTER_ORDER ; stage ++)
+	{
+		filter->integrators[stage] += value;
+		value = filter->integrators[stage];
+	}
+
+	filter->phase ++;
+
+	if((1U << filter->decimation_log2) > filter->phase)
+	{
+		return false;
+	}
+
+	filter->phase = INIT_VAL;
+
+	for(stage = INIT_VAL ; stage < CIC_FILTER_ORDER ; stage ++)
+	{
+		comb_input = value;
+		value -= filter->combs[stage];
+		filter->combs[stage] = comb_input;
+	}
+
+	if(INIT_VAL != filter->settling)
+	{
+		filter->settling --;
+		return false;
+	}
+
+	/** The gain is the decimation to the order, the output is scaled to its bits with rounding*/
+	bits = filter->input_bits + (CIC_FILTER_ORDER * filter->decimation_log2);
+
+	if(CIC_FILTER_OUTPUT_BITS < bits)
+	{
+		value = (value >> (bits - CIC_FILTER_OUTPUT_BITS)) + ((value >> (bits - CIC_FILTER_OUTPUT_BITS - 1)) & 1U);
+	}
+
+	else
+	{
+		value <<= (CIC_FILTER_OUTPUT_BITS - bits);
+	}
+
+	*output = (uint16_t)((CIC_FILTER_OUTPUT_MAX < value) ? CIC_FILTER_OUTPUT_MAX : value);
+
+	return true;
+}
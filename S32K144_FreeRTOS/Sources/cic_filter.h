@@ -0,0 +1,83 @@
+/*!
+ 	 \file cic_filter.h
+
+ 	 \brief This is the header file of the fixed point CIC decimation filter.
+ 	 	 	 It integrates every input sample and, once every decimation, takes the
+ 	 	 	 differences of the integrators (Cascaded Integrator Comb). The output
+ 	 	 	 is the average of the last inputs with a sinc^N response, so it has
+ 	 	 	 more effective bits than the input and rejects the noise above the
+ 	 	 	 output rate.
+
+ 	 \note The integrators wrap around on purpose: while the output fits in 32 bits
+ 	 	 	 (Input bits + CIC_FILTER_ORDER * log2 of the decimation), the combs remove
+ 	 	 	 the overflow. There are no multiplications nor divisions.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef CIC_FILTER_H_
+#define CIC_FILTER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Defines the stages of integrators and combs*/
+#define CIC_FILTER_ORDER					(3)
+/** Defines the bits of the output, full scale of the input is full scale of the output*/
+#define CIC_FILTER_OUTPUT_BITS				(16)
+/** Defines the bits of the state*/
+#define CIC_FILTER_STATE_BITS				(32)
+
+/*!
+ 	 \brief Structure for the filter.
+ */
+typedef struct
+{
+	uint8_t input_bits;							/*!< Bits of the input samples*/
+	uint8_t decimation_log2;					/*!< Inputs per output, as a power of 2*/
+	uint8_t phase;								/*!< Inputs since the last output*/
+	uint8_t settling;							/*!< Outputs left until the combs are filled*/
+	uint32_t integrators[CIC_FILTER_ORDER];		/*!< Integrators, at the input rate*/
+	uint32_t combs[CIC_FILTER_ORDER];			/*!< Last input of each comb, at the output rate*/
+}CIC_FILTER_t;
+
+/*!
+ 	 \brief This function initializes a filter and clears its state.
+
+ 	 \param[out] filter Filter to be initialized.
+ 	 \param[in] input_bits Bits of the input samples (e.g. 12 for the ADC).
+ 	 \param[in] decimation_log2 Inputs per output, as a power of 2. It is limited so
+ 	 	 	 the output fits in CIC_FILTER_STATE_BITS.
+
+ 	 \return void.
+ */
+void CIC_FILTER_init(CIC_FILTER_t* filter, uint8_t input_bits, uint8_t decimation_log2);
+
+/*!
+ 	 \brief This function gets the highest decimation of a filter for an input size.
+
+ 	 \param[in] input_bits Bits of the input samples.
+
+ 	 \return Highest decimation, as a power of 2.
+ */
+uint8_t CIC_FILTER_get_max_decimation(uint8_t input_bits);
+
+/*!
+ 	 \brief This function filters an input sample, and gives an output once every
+ 	 	 	 decimation. The first CIC_FILTER_ORDER outputs are dropped, since the
+ 	 	 	 combs are not filled yet.
+
+ 	 \param[in,out] filter Filter.
+ 	 \param[in] sample Input sample.
+ 	 \param[out] output Output, of CIC_FILTER_OUTPUT_BITS (Only written when there is one).
+
+ 	 \return true if there is a new output.
+ */
+bool CIC_FILTER_update(CIC_FILTER_t* filter, uint16_t sample, uint16_t* output);
+
+#endif /* CIC_FILTER_H_ */
@@ -0,0 +1,856 @@
+/*!
+ 	 \file clock_policy.c
+
+ 	 \brief This is the source file of the clock policy. The configurations of the
+ 	 	 	 levels, the callbacks of the transitions, the load measurement and the
+ 	 	 	 policy thread are found in this source file.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include "clock_policy.h"
+#include "tick_period.h"
+#include "clockMan1.h"
+#include "smc_hal.h"
+#include "can_driver.h"
+#include "adc_scan.h"
+#include "motor_control.h"
+#include "cycle_counter.h"
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/** Defines the policy handler as initialized*/
+#define IS_INIT								(1)
+/** Defines the policy handler as not initialized*/
+#define NOT_INIT							(0)
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL							(0)
+/** Defines a flag as set*/
+#define FLAG_SET							(1)
+/** Defines a flag as cleared*/
+#define FLAG_CLEAR							(0)
+
+
+/** Defines the load of a full window*/
+#define PERCENT								(100U)
+/** Defines the initial value of the shortest idle iteration*/
+#define IDLE_MIN_INIT						(0xFFFFFFFFU)
+
+/** Defines the cycles of a tick of the port (configCPU_CLOCK_HZ)*/
+#define TICK_CYCLES							(configCPU_CLOCK_HZ / configTICK_RATE_HZ)
+/** Defines the core clock of TICK_CYCLES, the RUN level (FIX_PERIOD is tuned to it)*/
+#define TICK_CORE_CLOCK						(80000000ULL)
+
+/** Defines the number of callbacks of the transitions*/
+#define CLOCK_POLICY_CALLBACKS				(5U)
+
+/*!
+ 	 \brief Structure for the policy handler.
+ */
+typedef struct
+{
+	uint8_t init_val;					/*!< Defines whether the handler has been initialized or not*/
+	clock_policy_level_t level;			/*!< Current level*/
+	SemaphoreHandle_t mutex;			/*!< Mutex of the transitions (Thread and holds)*/
+	uint32_t holds;						/*!< Holds of the RUN level*/
+	uint32_t low_windows;				/*!< Consecutive windows that allow the lower level*/
+	uint32_t load;						/*!< Load of the last window, in percent*/
+	uint32_t errors;					/*!< Transitions that failed*/
+	uint8_t can_stopped;				/*!< The CAN was frozen before a transition and is not running again*/
+	uint32_t window_start;				/*!< Cycles at the start of the window*/
+	uint32_t idle_last;					/*!< Cycles of the last idle iteration*/
+	uint32_t idle_count;				/*!< Idle iterations of the window*/
+	uint32_t idle_min;					/*!< Shortest idle iteration of the window, in cycles*/
+}clock_policy_handler_t;
+
+/*********************************************************************************************/
+
+/*!
+ 	 \brief This function is the callback of the power mode. Before a transition it
+ 	 	 	 returns to RUN, where the clocks of every level are set, and after it
+ 	 	 	 enters the power mode of the new level.
+
+ 	 \param[in] notify Notification of the clock manager.
+ 	 \param[in] data Not used.
+
+ 	 \return The status of the power mode change.
+ */
+static status_t clock_policy_power_callback(clock_notify_struct_t* notify, void* data);
+
+/*!
+ 	 \brief This function is the callback of the SysTick. It sets the reload for the new
+ 	 	 	 core clock, so the tick period (And FIX_PERIOD) does not change.
+
+ 	 \param[in] notify Notification of the clock manager.
+ 	 \param[in] data Not used.
+
+ 	 \return STATUS_SUCCESS.
+ */
+static status_t clock_policy_tick_callback(clock_notify_struct_t* notify, void* data);
+
+/*!
+ 	 \brief This function is the callback of the FlexCAN. Before a transition the module
+ 	 	 	 is frozen and disabled, and its protocol engine is switched to the clock
+ 	 	 	 of the new level (The bus in VLPR, where the SOSC is off). It runs again
+ 	 	 	 after the transition, or with the clock of the current level if the
+ 	 	 	 transition failed.
+
+ 	 \note A CAN that does not run again after a transition counts as an error of the
+ 	 	 	 policy, and it is tried again after the next transition.
+
+ 	 \param[in] notify Notification of the clock manager.
+ 	 \param[in] data CAN to be re-timed.
+
+ 	 \return STATUS_TIMEOUT if the module did not stop before the transition, otherwise STATUS_SUCCESS.
+ */
+static status_t clock_policy_can_callback(clock_notify_struct_t* notify, void* data);
+
+/*!
+ 	 \brief This function is the callback of the ADC scan. The PDB is clocked from the
+ 	 	 	 bus, so its period is set again.
+
+ 	 \param[in] notify Notification of the clock manager.
+ 	 \param[in] data Not used.
+
+ 	 \return STATUS_SUCCESS.
+ */
+static status_t clock_policy_scan_callback(clock_notify_struct_t* notify, void* data);
+
+/*!
+ 	 \brief This function is the callback of the motor. The FTMs are clocked from
+ 	 	 	 SIRCDIV1 (8 MHz), above a quarter of the system clock of VLPR (4 MHz),
+ 	 	 	 so they run from the system clock in VLPR.
+
+ 	 \param[in] notify Notification of the clock manager.
+ 	 \param[in] data Motor to be re-timed.
+
+ 	 \return STATUS_SUCCESS.
+ */
+static status_t clock_policy_motor_callback(clock_notify_struct_t* notify, void* data);
+
+/*!
+ 	 \brief This function sets the power mode of a level.
+
+ 	 \param[in] level Level of the power mode.
+
+ 	 \return The status of the SMC.
+ */
+static status_t clock_policy_set_mode(clock_policy_level_t level);
+
+/*!
+ 	 \brief This function changes the level, one level at a time. The mutex must be taken.
+
+ 	 \param[in] level Level to be set.
+
+ 	 \return The status of the clock manager.
+ */
+static status_t clock_policy_set_level(clock_policy_level_t level);
+
+/*!
+ 	 \brief This function closes the window and starts the next one.
+
+ 	 \return Load of the window, in percent.
+ */
+static uint32_t clock_policy_close_window(void);
+
+/*!
+ 	 \brief This function decides the level for the load of a window.
+
+ 	 \param[in] load Load of the window, in percent.
+
+ 	 \return Level to be set.
+ */
+static clock_policy_level_t clock_policy_decide(uint32_t load);
+
+/*********************************************************************************************/
+
+/** Handler of the policy*/
+static clock_policy_handler_t clock_policy_handler = { NOT_INIT };
+
+/** Power modes of the levels*/
+static const power_manager_modes_t clock_policy_modes[clock_policy_levels] =
+{
+	POWER_MANAGER_VLPR,
+	POWER_MANAGER_RUN,
+	POWER_MANAGER_HSRUN
+};
+
+/** Status of the power modes of the levels*/
+static const power_mode_stat_t clock_policy_stats[clock_policy_levels] =
+{
+	STAT_VLPR,
+	STAT_RUN,
+	STAT_HSRUN
+};
+
+/** Core clocks of the levels, in MHz*/
+static const uint32_t clock_policy_core_mhz[clock_policy_levels] =
+{
+	4U,
+	80U,
+	112U
+};
+
+/** HSRUN level: SPLL of 112 MHz (8 MHz x 28 / 2). Its RUN clocks (Core 56 MHz) are used
+ * while it is entered and left, the peripheral clocks are not changed*/
+static const clock_manager_user_config_t clock_policy_hsrun_config =
+{
+	.scgConfig =
+	{
+		.sircConfig =
+		{
+			.initialize       = true,
+			.enableInStop     = false,
+			.enableInLowPower = true,
+			.locked           = false,
+			.range            = SCG_SIRC_RANGE_HIGH,
+			.div1             = SCG_ASYNC_CLOCK_DIV_BY_1,
+			.div2             = SCG_ASYNC_CLOCK_DIV_BY_1,
+		},
+		.fircConfig =
+		{
+			.initialize       = true,
+			.regulator        = true,
+			.locked           = false,
+			.range            = SCG_FIRC_RANGE_48M,
+			.div1             = SCG_ASYNC_CLOCK_DIV_BY_1,
+			.div2             = SCG_ASYNC_CLOCK_DIV_BY_1,
+		},
+		.rtcConfig =
+		{
+			.initialize       = true,
+			.rtcClkInFreq     = 0U,
+		},
+		.soscConfig =
+		{
+			.initialize       = true,
+			.freq             = 8000000U,
+			.monitorMode      = SCG_SOSC_MONITOR_DISABLE,
+			.locked           = false,
+			.extRef           = SCG_SOSC_REF_OSC,
+			.gain             = SCG_SOSC_GAIN_LOW,
+			.range            = SCG_SOSC_RANGE_MID,
+			.div1             = SCG_ASYNC_CLOCK_DIV_BY_1,
+			.div2             = SCG_ASYNC_CLOCK_DIV_BY_1,
+		},
+		.spllConfig =
+		{
+			.initialize       = true,
+			.monitorMode      = SCG_SPLL_MONITOR_DISABLE,
+			.locked           = false,
+			.prediv           = 0U,
+			.mult             = 12U,								/*!< x28*/
+			.src              = 0U,
+			.div1             = SCG_ASYNC_CLOCK_DIV_BY_2,
+			.div2             = SCG_ASYNC_CLOCK_DIV_BY_4,			/*!< LPSPI 28 MHz*/
+		},
+		.clockOutConfig =
+		{
+			.initialize       = true,
+			.source           = SCG_CLOCKOUT_SRC_FIRC,
+		},
+		.clockModeConfig =
+		{
+			.initialize       = true,
+			.rccrConfig =
+			{
+				.src          = SCG_SYSTEM_CLOCK_SRC_SYS_PLL,
+				.divCore      = SCG_SYSTEM_CLOCK_DIV_BY_2,
+				.divBus       = SCG_SYSTEM_CLOCK_DIV_BY_2,
+				.divSlow      = SCG_SYSTEM_CLOCK_DIV_BY_4,
+			},
+			.vccrConfig =
+			{
+				.src          = SCG_SYSTEM_CLOCK_SRC_SIRC,
+				.divCore      = SCG_SYSTEM_CLOCK_DIV_BY_2,
+				.divBus       = SCG_SYSTEM_CLOCK_DIV_BY_1,
+				.divSlow      = SCG_SYSTEM_CLOCK_DIV_BY_4,
+			},
+			.hccrConfig =
+			{
+				.src          = SCG_SYSTEM_CLOCK_SRC_SYS_PLL,
+				.divCore      = SCG_SYSTEM_CLOCK_DIV_BY_1,
+				.divBus       = SCG_SYSTEM_CLOCK_DIV_BY_2,
+				.divSlow      = SCG_SYSTEM_CLOCK_DIV_BY_4,
+			},
+		},
+	},
+	.pccConfig =
+	{
+		.peripheralClocks = NULL,
+		.count = 0U,
+	},
+};
+
+/** VLPR level: only SIRC, the SOSC, the SPLL and the FIRC are off. The RUN clocks are
+ * the VLPR ones, so entering and leaving VLPR changes no clock*/
+static const clock_manager_user_config_t clock_policy_vlpr_config =
+{
+	.scgConfig =
+	{
+		.sircConfig =
+		{
+			.initialize       = true,
+			.enableInStop     = false,
+			.enableInLowPower = true,
+			.locked           = false,
+			.range            = SCG_SIRC_RANGE_HIGH,
+			.div1             = SCG_ASYNC_CLOCK_DIV_BY_1,
+			.div2             = SCG_ASYNC_CLOCK_DIV_BY_1,
+		},
+		.fircConfig =
+		{
+			.initialize       = false,
+		},
+		.rtcConfig =
+		{
+			.initialize       = true,
+			.rtcClkInFreq     = 0U,
+		},
+		.soscConfig =
+		{
+			.initialize       = false,
+		},
+		.spllConfig =
+		{
+			.initialize       = false,
+		},
+		.clockOutConfig =
+		{
+			.initialize       = false,
+		},
+		.clockModeConfig =
+		{
+			.initialize       = true,
+			.rccrConfig =
+			{
+				.src          = SCG_SYSTEM_CLOCK_SRC_SIRC,
+				.divCore      = SCG_SYSTEM_CLOCK_DIV_BY_2,
+				.divBus       = SCG_SYSTEM_CLOCK_DIV_BY_1,
+				.divSlow      = SCG_SYSTEM_CLOCK_DIV_BY_4,
+			},
+			.vccrConfig =
+			{
+				.src          = SCG_SYSTEM_CLOCK_SRC_SIRC,
+				.divCore      = SCG_SYSTEM_CLOCK_DIV_BY_2,
+				.divBus       = SCG_SYSTEM_CLOCK_DIV_BY_1,
+				.divSlow      = SCG_SYSTEM_CLOCK_DIV_BY_4,
+			},
+			.hccrConfig =
+			{
+				.src          = SCG_SYSTEM_CLOCK_SRC_SIRC,
+				.divCore      = SCG_SYSTEM_CLOCK_DIV_BY_2,
+				.divBus       = SCG_SYSTEM_CLOCK_DIV_BY_1,
+				.divSlow      = SCG_SYSTEM_CLOCK_DIV_BY_4,
+			},
+		},
+	},
+	.pccConfig =
+	{
+		.peripheralClocks = NULL,
+		.count = 0U,
+	},
+};
+
+/** RUN level after the start-up: the configuration of Processor Expert without the
+ * peripheral clocks, which are gated off while they are set*/
+static clock_manager_user_config_t clock_policy_run_config;
+
+/** Configurations of the clock manager, indexed by clock_policy_level_t (RUN is the one of
+ * Processor Expert until the start-up ends)*/
+static clock_manager_user_config_t const* clock_policy_configs[clock_policy_levels] =
+{
+	&clock_policy_vlpr_config,
+	&clockMan1_InitConfig0,
+	&clock_policy_hsrun_config
+};
+
+/** Callback of the power mode*/
+static clock_manager_callback_user_config_t clock_policy_power = { clock_policy_power_callback, CLOCK_MANAGER_CALLBACK_BEFORE_AFTER, NULL };
+/** Callback of the SysTick*/
+static clock_manager_callback_user_config_t clock_policy_tick = { clock_policy_tick_callback, CLOCK_MANAGER_CALLBACK_AFTER, NULL };
+/** Callback of the FlexCAN (The CAN is set by CLOCK_POLICY_init)*/
+static clock_manager_callback_user_config_t clock_policy_can = { clock_policy_can_callback, CLOCK_MANAGER_CALLBACK_BEFORE_AFTER, NULL };
+/** Callback of the ADC scan*/
+static clock_manager_callback_user_config_t clock_policy_scan = { clock_policy_scan_callback, CLOCK_MANAGER_CALLBACK_AFTER, NULL };
+/** Callback of the motor (The motor is set by CLOCK_POLICY_set_motor)*/
+static clock_manager_callback_user_config_t clock_policy_motor = { clock_policy_motor_callback, CLOCK_MANAGER_CALLBACK_AFTER, NULL };
+
+/** Callbacks, the power mode goes first. The clock manager reads one entry past the
+ * last one to recover from a failed configuration, so the table ends with NULL*/
+static clock_manager_callback_user_config_t* clock_policy_callbacks[CLOCK_POLICY_CALLBACKS + 1U] =
+{
+	&clock_policy_power,
+	&clock_policy_tick,
+	&clock_policy_can,
+	&clock_policy_scan,
+	&clock_policy_motor,
+	NULL
+};
+
+/*********************************************************************************************/
+
+/** This function initializes the clock manager with the levels*/
+status_t CLOCK_POLICY_init(CAN_Type* can)
+{
+	/** HSRUN and VLPR are allowed*/
+	smc_power_mode_protection_config_t protection;
+	/** Status of the clock manager*/
+	status_t status;
+
+	protection.vlpProt = true;
+	protection.hsrunProt = true;
+	SMC_HAL_SetProtectionMode(SMC, &protection);
+
+	clock_policy_can.callbackData = can;
+
+	clock_policy_handler.level = clock_policy_run;
+	clock_policy_handler.holds = INIT_VAL;
+	clock_policy_handler.low_windows = INIT_VAL;
+	clock_policy_handler.load = INIT_VAL;
+	clock_policy_handler.errors = INIT_VAL;
+	clock_policy_handler.can_stopped = FLAG_CLEAR;
+	clock_policy_handler.idle_min = IDLE_MIN_INIT;
+	clock_policy_handler.mutex = xSemaphoreCreateMutex();
+
+	status = CLOCK_SYS_Init(clock_policy_configs, clock_policy_levels, clock_policy_callbacks, CLOCK_POLICY_CALLBACKS);
+
+	if(STATUS_SUCCESS == status)
+	{
+		status = CLOCK_SYS_UpdateConfiguration(clock_policy_run, CLOCK_MANAGER_POLICY_AGREEMENT);
+	}
+
+	/** The next transitions to RUN do not set the peripheral clocks again*/
+	clock_policy_run_config = clockMan1_InitConfig0;
+	clock_policy_run_config.pccConfig.peripheralClocks = NULL;
+	clock_policy_run_config.pccConfig.count = INIT_VAL;
+	clock_policy_configs[clock_policy_run] = &clock_policy_run_config;
+
+	/** Sets the handler as initialized, the first level was set before the CAN was clocked*/
+	clock_policy_handler.init_val = IS_INIT;
+
+	return status;
+}
+
+/** This function sets the motor re-timed on the transitions*/
+void CLOCK_POLICY_set_motor(MC_motor_t* motor)
+{
+	clock_policy_motor.callbackData = motor;
+}
+
+/** This thread measures the load and changes the level*/
+void CLOCK_POLICY_thread(void* args)
+{
+	/** Variable to count the ticks passed since the delay*/
+	TickType_t xLastWakeTime = xTaskGetTickCount();
+	/** Level for the load of the window*/
+	clock_policy_level_t level;
+
+	clock_policy_close_window();
+
+	for(;;)
+	{
+		vTaskDelayUntil(&xLastWakeTime, (CLOCK_POLICY_WINDOW * FIX_PERIOD));
+
+		xSemaphoreTake(clock_policy_handler.mutex, portMAX_DELAY);
+
+		clock_policy_handler.load = clock_policy_close_window();
+		level = clock_policy_decide(clock_policy_handler.load);
+
+		if(clock_policy_handler.level != level)
+		{
+			clock_policy_set_level(level);
+
+			/** The transition is not load of the next window*/
+			clock_policy_close_window();
+		}
+
+		xSemaphoreGive(clock_policy_handler.mutex);
+	}
+}
+
+/** This function sets and holds the RUN level*/
+status_t CLOCK_POLICY_hold(void)
+{
+	/** Status of the transition*/
+	status_t status;
+
+	if(IS_INIT != clock_policy_handler.init_val)
+	{
+		return STATUS_ERROR;
+	}
+
+	xSemaphoreTake(clock_policy_handler.mutex, portMAX_DELAY);
+
+	clock_policy_handler.holds ++;
+	status = clock_policy_set_level(clock_policy_run);
+
+	xSemaphoreGive(clock_policy_handler.mutex);
+
+	return status;
+}
+
+/** This function releases a hold of the RUN level*/
+void CLOCK_POLICY_release(void)
+{
+	if(IS_INIT != clock_policy_handler.init_val)
+	{
+		return;
+	}
+
+	xSemaphoreTake(clock_policy_handler.mutex, portMAX_DELAY);
+
+	if(INIT_VAL != clock_policy_handler.holds)
+	{
+		clock_policy_handler.holds --;
+	}
+
+	xSemaphoreGive(clock_policy_handler.mutex);
+}
+
+/** This function gets the current level*/
+clock_policy_level_t CLOCK_POLICY_get_level(void)
+{
+	return clock_policy_handler.level;
+}
+
+/** This function gets the load of the last window*/
+uint32_t CLOCK_POLICY_get_load(void)
+{
+	return clock_policy_handler.load;
+}
+
+/** This function gets the transitions that failed*/
+uint32_t CLOCK_POLICY_get_errors(void)
+{
+	return clock_policy_handler.errors;
+}
+
+/** Idle hook of the kernel (configUSE_IDLE_HOOK), it counts the idle iterations*/
+void vApplicationIdleHook(void)
+{
+	/** Cycles of the iteration*/
+	uint32_t now;
+
+	/** The thread closes the window in between*/
+	taskENTER_CRITICAL();
+
+	now = CYCLE_COUNTER_GET();
+
+	/** The iterations with a task or an interrupt in between are longer*/
+	if((now - clock_policy_handler.idle_last) < clock_policy_handler.idle_min)
+	{
+		clock_policy_handler.idle_min = now - clock_policy_handler.idle_last;
+	}
+
+	clock_policy_handler.idle_last = now;
+	clock_policy_handler.idle_count ++;
+
+	taskEXIT_CRITICAL();
+}
+
+/*********************************************************************************************/
+
+/** This function is the callback of the power mode*/
+static status_t clock_policy_power_callback(clock_notify_struct_t* notify, void* data)
+{
+	/** Status of the power mode change*/
+	status_t status;
+
+	switch(notify->notifyType)
+	{
+		case CLOCK_MANAGER_NOTIFY_BEFORE:
+			status = clock_policy_set_mode(clock_policy_run);
+		break;
+
+		case CLOCK_MANAGER_NOTIFY_AFTER:
+			status = clock_policy_set_mode((clock_policy_level_t)notify->targetClockConfigIndex);
+		break;
+
+		/** Back to the power mode of the current level*/
+		default:
+			status = clock_policy_set_mode(clock_policy_handler.level);
+		break;
+	}
+
+	return status;
+}
+
+/** This function is the callback of the SysTick*/
+static status_t clock_policy_tick_callback(clock_notify_struct_t* notify, void* data)
+{
+	/** Core clock of the new level*/
+	uint32_t core_clock = INIT_VAL;
+
+	/** The kernel sets the SysTick once the scheduler starts*/
+	if(INIT_VAL == (S32_SysTick->CSR & S32_SysTick_CSR_ENABLE_MASK))
+	{
+		return STATUS_SUCCESS;
+	}
+
+	CLOCK_SYS_GetFreq(CORE_CLOCK, &core_clock);
+
+	S32_SysTick->RVR = (uint32_t)((TICK_CYCLES * (uint64_t)core_clock) / TICK_CORE_CLOCK) - 1U;
+	S32_SysTick->CVR = INIT_VAL;
+
+	return STATUS_SUCCESS;
+}
+
+/** This function is the callback of the FlexCAN*/
+static status_t clock_policy_can_callback(clock_notify_struct_t* notify, void* data)
+{
+	/** CAN to be re-timed*/
+	CAN_Type* base = (CAN_Type*)data;
+	/** Level of the clock*/
+	clock_policy_level_t level = clock_policy_handler.level;
+	/** Status of the CAN*/
+	status_t status = STATUS_SUCCESS;
+
+	if((NULL == base) || (IS_INIT != clock_policy_handler.init_val))
+	{
+		return STATUS_SUCCESS;
+	}
+
+	if(CLOCK_MANAGER_NOTIFY_BEFORE == notify->notifyType)
+	{
+		/** Not enabled yet (CAN_Init sets the oscillator clock)*/
+		status = CAN_freeze(base);
+
+		if(STATUS_UNSUPPORTED == status)
+		{
+			return STATUS_SUCCESS;
+		}
+
+		/** The clock source is switched while the clocks of the current level still run*/
+		clock_policy_handler.can_stopped = FLAG_SET;
+
+		if(STATUS_SUCCESS == status)
+		{
+			level = (clock_policy_level_t)notify->targetClockConfigIndex;
+			status = CAN_set_clock(base, (clock_policy_vlpr == level) ? can_clock_bus : can_clock_oscillator);
+		}
+
+		return status;
+	}
+
+	if(FLAG_SET != clock_policy_handler.can_stopped)
+	{
+		return STATUS_SUCCESS;
+	}
+
+	/** A failed transition keeps the current level, with its clock*/
+	if(CLOCK_MANAGER_NOTIFY_RECOVER == notify->notifyType)
+	{
+		status = CAN_set_clock(base, (clock_policy_vlpr == level) ? can_clock_bus : can_clock_oscillator);
+	}
+
+	if(STATUS_SUCCESS == status)
+	{
+		status = CAN_resume(base);
+	}
+
+	if(STATUS_SUCCESS == status)
+	{
+		clock_policy_handler.can_stopped = FLAG_CLEAR;
+	}
+
+	/** The clocks changed already, the other callbacks still run*/
+	else
+	{
+		clock_policy_handler.errors ++;
+	}
+
+	return STATUS_SUCCESS;
+}
+
+/** This function is the callback of the ADC scan*/
+static status_t clock_policy_scan_callback(clock_notify_struct_t* notify, void* data)
+{
+	ADC_SCAN_retime();
+
+	return STATUS_SUCCESS;
+}
+
+/** This function is the callback of the motor*/
+static status_t clock_policy_motor_callback(clock_notify_struct_t* notify, void* data)
+{
+	/** Motor to be re-timed*/
+	MC_motor_t* motor = (MC_motor_t*)data;
+	/** PCC clocks of the FTMs, by instance*/
+	static const clock_names_t ftm_clocks[FTM_INSTANCE_COUNT] = { PCC_FTM0_CLOCK, PCC_FTM1_CLOCK, PCC_FTM2_CLOCK, PCC_FTM3_CLOCK };
+	/** Level of the clock, the current one if the transition failed*/
+	clock_policy_level_t level = clock_policy_handler.level;
+	/** Clock of the encoder FTM*/
+	uint32_t clock_hz = INIT_VAL;
+
+	if(NULL == motor)
+	{
+		return STATUS_SUCCESS;
+	}
+
+	if(CLOCK_MANAGER_NOTIFY_AFTER == notify->notifyType)
+	{
+		level = (clock_policy_level_t)notify->targetClockConfigIndex;
+	}
+
+	if(clock_policy_vlpr == level)
+	{
+		CLOCK_SYS_GetFreq(CORE_CLOCK, &clock_hz);
+		MC_set_clock(motor, mc_clock_system, clock_hz);
+	}
+
+	else
+	{
+		CLOCK_SYS_GetFreq(ftm_clocks[motor->config.encoder_instance], &clock_hz);
+		MC_set_clock(motor, mc_clock_sirc, clock_hz);
+	}
+
+	return STATUS_SUCCESS;
+}
+
+/** This function sets the power mode of a level*/
+static status_t clock_policy_set_mode(clock_policy_level_t level)
+{
+	/** Power mode of the level*/
+	smc_power_mode_config_t mode;
+	/** Status of the SMC*/
+	status_t status;
+
+	if(clock_policy_stats[level] == SMC_HAL_GetPowerModeStatus(SMC))
+	{
+		return STATUS_SUCCESS;
+	}
+
+	mode.powerModeName = clock_policy_modes[level];
+	mode.stopOption = false;
+	mode.stopOptionValue = SMC_STOP1;
+
+	/** The biasing is needed in the very low power modes*/
+	if(clock_policy_vlpr == level)
+	{
+		PMC->REGSC |= PMC_REGSC_BIASEN_MASK;
+	}
+
+	status = SMC_HAL_SetPowerMode(SMC, &mode);
+
+	if(STAT_VLPR != SMC_HAL_GetPowerModeStatus(SMC))
+	{
+		PMC->REGSC &= (uint8_t)(~PMC_REGSC_BIASEN_MASK);
+	}
+
+	return status;
+}
+
+/** This function changes the level*/
+static status_t clock_policy_set_level(clock_policy_level_t level)
+{
+	/** Status of the clock manager*/
+	status_t status = STATUS_SUCCESS;
+	/** Next level of the steps*/
+	clock_policy_level_t next;
+
+	while((STATUS_SUCCESS == status) && (clock_policy_handler.level != level))
+	{
+		next = (level > clock_policy_handler.level) ? (clock_policy_handler.level + 1) : (clock_policy_handler.level - 1);
+
+		status = CLOCK_SYS_UpdateConfiguration((uint8_t)next, CLOCK_MANAGER_POLICY_AGREEMENT);
+
+		if(STATUS_SUCCESS == status)
+		{
+			clock_policy_handler.level = next;
+		}
+
+		else
+		{
+			clock_policy_handler.errors ++;
+		}
+	}
+
+	return status;
+}
+
+/** This function closes the window*/
+static uint32_t clock_policy_close_window(void)
+{
+	/** Cycles of the window*/
+	uint32_t window;
+	/** Idle cycles of the window*/
+	uint32_t idle;
+
+	taskENTER_CRITICAL();
+
+	window = CYCLE_COUNTER_GET() - clock_policy_handler.window_start;
+	idle = clock_policy_handler.idle_count * clock_policy_handler.idle_min;
+
+	if(INIT_VAL == clock_policy_handler.idle_count)
+	{
+		idle = INIT_VAL;
+	}
+
+	clock_policy_handler.window_start += window;
+	clock_policy_handler.idle_count = INIT_VAL;
+	clock_policy_handler.idle_min = IDLE_MIN_INIT;
+
+	taskEXIT_CRITICAL();
+
+	window /= PERCENT;
+
+	if((INIT_VAL == window) || (idle >= (window * PERCENT)))
+	{
+		return INIT_VAL;
+	}
+
+	return PERCENT - (idle / window);
+}
+
+/** This function decides the level for a load*/
+static clock_policy_level_t clock_policy_decide(uint32_t load)
+{
+	/** Current level*/
+	clock_policy_level_t level = clock_policy_handler.level;
+
+	/** Only RUN while it is held*/
+	if(INIT_VAL != clock_policy_handler.holds)
+	{
+		clock_policy_handler.low_windows = INIT_VAL;
+
+		return clock_policy_run;
+	}
+
+	if((CLOCK_POLICY_UP_LOAD <= load) && (clock_policy_hsrun > level))
+	{
+		clock_policy_handler.low_windows = INIT_VAL;
+
+		return level + 1;
+	}
+
+	/** The load of the lower level grows with the ratio of the core clocks*/
+	if((clock_policy_vlpr < level) &&
+	   (CLOCK_POLICY_DOWN_LOAD > ((load * clock_policy_core_mhz[level]) / clock_policy_core_mhz[level - 1])))
+	{
+		clock_policy_handler.low_windows ++;
+
+		if(CLOCK_POLICY_DOWN_WINDOWS <= clock_policy_handler.low_windows)
+		{
+			clock_policy_handler.low_windows = INIT_VAL;
+
+			return level - 1;
+		}
+	}
+
+	else
+	{
+		clock_policy_handler.low_windows = INIT_VAL;
+	}
+
+	return level;
+}
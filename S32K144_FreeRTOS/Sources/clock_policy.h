@@ -0,0 +1,136 @@
+/*!
+ 	 \file clock_policy.h
+
+ 	 \brief This is the header file of the clock policy. It scales the clocks with
+ 	 	 	 the CPU load: HSRUN (112 MHz) under the bursts of the control loop or
+ 	 	 	 the bus, RUN (80 MHz) by default, and VLPR (4 MHz) when the system is
+ 	 	 	 idle. The levels are the configurations of the clock manager, and its
+ 	 	 	 callbacks change the power mode and re-time the SysTick, the FlexCAN,
+ 	 	 	 the PDB of the ADC scan and the FTMs of the motor on every transition.
+
+ 	 \note The load is the time out of the idle task, measured by the idle hook: it
+ 	 	 	 counts the iterations of the idle loop, and one iteration costs the
+ 	 	 	 shortest time between two of them. The interrupts count as load.
+
+ 	 \note A level is left up when the load reaches CLOCK_POLICY_UP_LOAD, and down when
+ 	 	 	 the load projected on the lower level stays under CLOCK_POLICY_DOWN_LOAD
+ 	 	 	 for CLOCK_POLICY_DOWN_WINDOWS windows. The levels change one at a time.
+
+ 	 \note The FTMs are clocked from SIRCDIV1 (8 MHz), which must be below a quarter of
+ 	 	 	 the system clock, so in VLPR (4 MHz) they run from the system clock with
+ 	 	 	 the prescaler halved. The ADCs are clocked from SIRCDIV2, so the PWM and
+ 	 	 	 the conversions do not change between levels. The LPSPI is clocked from
+ 	 	 	 SPLLDIV2, which is off in VLPR (The transfers wait for the next level).
+
+ 	 \note The flash is not erased nor programmed in HSRUN or VLPR, CLOCK_POLICY_hold
+ 	 	 	 keeps the RUN level meanwhile.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef CLOCK_POLICY_H_
+#define CLOCK_POLICY_H_
+
+#include <stdint.h>
+#include "S32K144.h"
+#include "status.h"
+#include "motor_control.h"
+
+/** Defines the length of a load window, in milliseconds*/
+#define CLOCK_POLICY_WINDOW					(100)
+/** Defines the load that raises the level, in percent*/
+#define CLOCK_POLICY_UP_LOAD				(80U)
+/** Defines the load projected on the lower level that lowers the level, in percent*/
+#define CLOCK_POLICY_DOWN_LOAD				(50U)
+/** Defines the windows under CLOCK_POLICY_DOWN_LOAD that lower the level*/
+#define CLOCK_POLICY_DOWN_WINDOWS			(10U)
+
+/*!
+ 	 \brief Enumerator to define the levels of the clocks. They are also the indexes
+ 	 	 	 of the configurations of the clock manager.
+ */
+typedef enum
+{
+	clock_policy_vlpr,		/*!< VLPR, SIRC: core 4 MHz, bus 4 MHz, flash 1 MHz*/
+	clock_policy_run,		/*!< RUN, SPLL: core 80 MHz, bus 40 MHz, flash 20 MHz (clockMan1)*/
+	clock_policy_hsrun,		/*!< HSRUN, SPLL: core 112 MHz, bus 56 MHz, flash 28 MHz*/
+	clock_policy_levels		/*!< Number of levels*/
+}clock_policy_level_t;
+
+/*!
+ 	 \brief This function initializes the clock manager with the levels and their
+ 	 	 	 callbacks, and sets the RUN level. It replaces CLOCK_SYS_Init.
+
+ 	 \note The power modes are allowed here, the protection register is written
+ 	 	 	 once after a reset.
+
+ 	 \param[in] can CAN re-timed on the transitions.
+
+ 	 \return The status of the clock manager.
+ */
+status_t CLOCK_POLICY_init(CAN_Type* can);
+
+/*!
+ 	 \brief This function sets the motor whose FTMs are re-timed on the transitions.
+
+ 	 \note The motor must be initialized, MC_init clocks its FTMs from SIRCDIV1 (The
+ 	 	 	 RUN level).
+
+ 	 \param[in] motor Motor.
+
+ 	 \return void.
+ */
+void CLOCK_POLICY_set_motor(MC_motor_t* motor);
+
+/*!
+ 	 \brief This thread measures the load and changes the level. It has the highest
+ 	 	 	 priority, so it runs even when the load is 100%.
+
+ 	 \param[in] args Thread arguments. Set to NULL.
+
+ 	 \return void.
+ */
+void CLOCK_POLICY_thread(void* args);
+
+/*!
+ 	 \brief This function sets the RUN level and keeps it until CLOCK_POLICY_release
+ 	 	 	 is called (e.g. while the flash is programmed). The holds are counted.
+
+ 	 \return The status of the transition, STATUS_SUCCESS if it was in RUN already.
+ */
+status_t CLOCK_POLICY_hold(void);
+
+/*!
+ 	 \brief This function releases a hold of the RUN level.
+
+ 	 \return void.
+ */
+void CLOCK_POLICY_release(void);
+
+/*!
+ 	 \brief This function gets the current level.
+
+ 	 \return Level of the clocks.
+ */
+clock_policy_level_t CLOCK_POLICY_get_level(void);
+
+/*!
+ 	 \brief This function gets the load of the last window.
+
+ 	 \return Load, in percent.
+ */
+uint32_t CLOCK_POLICY_get_load(void);
+
+/*!
+ 	 \brief This function gets the number of transitions that failed (The level did not change).
+
+ 	 \return Number of errors.
+ */
+uint32_t CLOCK_POLICY_get_errors(void);
+
+#endif /* CLOCK_POLICY_H_ */
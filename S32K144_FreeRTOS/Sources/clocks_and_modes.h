@@ -1,13 +0,0 @@
-#ifndef CLOCKS_AND_MODES_H_
-#define CLOCKS_AND_MODES_H_
-
-/*********************** NOTE ***************************/
-/** This module is taken from the driver example FlexCAN*/
-/********************************************************/
-
-void SOSC_init_8MHz (void);
-void SPLL_init_160MHz (void);
-void NormalRUNmode_80MHz (void);
-
-#endif /* CLOCKS_AND_MODES_H_ */
-
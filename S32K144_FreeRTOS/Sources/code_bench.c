@@ -0,0 +1,196 @@
+/*!
+ 	 \file code_bench.c
+
+ 	 \brief This is the source file of the code placement benchmark. The runs of
+ 	 	 	 each target and mode are found in this source file.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include "code_bench.h"
+#include "code_cache.h"
+#include "cycle_counter.h"
+#include "interrupt_manager.h"
+#include "rtos_driver.h"
+#include "speed_pid.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL							(0)
+/** Defines a flag as set*/
+#define FLAG_SET							(1)
+/** Defines a flag as cleared*/
+#define FLAG_CLEAR							(0)
+
+/** Defines the interrupt of the benchmark*/
+#define CODE_BENCH_IRQ						(SWI_IRQn)
+/** Defines the priority of the interrupt (Highest, the kernel masks the others until the scheduler starts)*/
+#define CODE_BENCH_PRIORITY					(0U)
+/** Defines the initial value of the minimums*/
+#define CODE_BENCH_MIN_INIT					(0xFFFFFFFFUL)
+
+/** Defines the proportional gain of the PID of the benchmark (0.5 in Q15)*/
+#define CODE_BENCH_PID_KP					(16384)
+/** Defines the integral gain of the PID of the benchmark (0.01 in Q15)*/
+#define CODE_BENCH_PID_KI					(328)
+/** Defines the derivative gain of the PID of the benchmark (0.1 in Q15)*/
+#define CODE_BENCH_PID_KD					(3277)
+/** Defines the setpoint of the PID of the benchmark (0.25 in Q15)*/
+#define CODE_BENCH_PID_SETPOINT				(8192)
+
+/*!
+ 	 \brief Structure for the benchmark handler.
+ */
+typedef struct
+{
+	can_message_rx_config_t rx_message;								/*!< Frame read by CAN_receive_message*/
+	SPEED_PID_t pid;												/*!< PID updated by SPEED_PID_update*/
+	CODE_BENCH_result_t results[code_bench_targets][code_bench_modes];	/*!< Results of each target and mode*/
+}code_bench_handler_t;
+
+/*********************************************************************************************/
+
+/*!
+ 	 \brief This function runs a target once.
+
+ 	 \param[in] target Function to be measured.
+ 	 \param[in] run Number of the run, it changes the measurement of the PID.
+
+ 	 \return Cycles of the target.
+ */
+static uint32_t code_bench_measure(code_bench_target_t target, uint32_t run);
+
+/*********************************************************************************************/
+
+/** Handler of the benchmark*/
+static code_bench_handler_t code_bench_handler;
+
+/*********************************************************************************************/
+
+/** This function runs the benchmark*/
+void CODE_BENCH_run(void)
+{
+	/** State of the code cache to be restored*/
+	uint8_t cache = CODE_CACHE_is_enabled();
+	/** Handler of the interrupt to be restored*/
+	isr_t previous = NULL;
+	/** Gains and limits of the PID*/
+	const SPEED_PID_config_t pid_config =
+	{
+		CODE_BENCH_PID_KP,
+		CODE_BENCH_PID_KI,
+		CODE_BENCH_PID_KD,
+		-SPEED_PID_Q15_MAX,
+		SPEED_PID_Q15_MAX
+	};
+	/** Results of the target and mode*/
+	CODE_BENCH_result_t* result;
+	/** Mode of the code cache*/
+	uint32_t mode;
+	/** Function measured*/
+	uint32_t target;
+	/** Counter for the runs*/
+	uint32_t run;
+	/** Cycles of a run*/
+	uint32_t cycles;
+
+	/** The real interruption of the Rx FIFO is pended on the SWI*/
+	INT_SYS_InstallHandler(CODE_BENCH_IRQ, CAN_RX_Interrupt, &previous);
+	INT_SYS_SetPriority(CODE_BENCH_IRQ, CODE_BENCH_PRIORITY);
+	INT_SYS_EnableIRQ(CODE_BENCH_IRQ);
+
+	code_bench_handler.rx_message.base = CAN0;
+	SPEED_PID_init(&code_bench_handler.pid, &pid_config);
+
+	for(mode = INIT_VAL ; mode < code_bench_modes ; mode ++)
+	{
+		for(target = INIT_VAL ; target < code_bench_targets ; target ++)
+		{
+			result = &code_bench_handler.results[target][mode];
+			result->cycles_min = CODE_BENCH_MIN_INIT;
+			result->cycles_max = INIT_VAL;
+
+			/** Both invalidate the cache, the first run of every target has the misses*/
+			if(code_bench_cache_on == mode)
+			{
+				CODE_CACHE_enable();
+			}
+
+			else
+			{
+				CODE_CACHE_disable();
+			}
+
+			for(run = INIT_VAL ; run < CODE_BENCH_RUNS ; run ++)
+			{
+				cycles = code_bench_measure((code_bench_target_t)target, run);
+
+				if(cycles < result->cycles_min)
+				{
+					result->cycles_min = cycles;
+				}
+
+				if(cycles > result->cycles_max)
+				{
+					result->cycles_max = cycles;
+				}
+			}
+		}
+	}
+
+	INT_SYS_DisableIRQ(CODE_BENCH_IRQ);
+	INT_SYS_InstallHandler(CODE_BENCH_IRQ, previous, NULL);
+
+	if(FLAG_SET == cache)
+	{
+		CODE_CACHE_enable();
+	}
+
+	else
+	{
+		CODE_CACHE_disable();
+	}
+}
+
+/** This function gets the results of a target and mode*/
+const CODE_BENCH_result_t* CODE_BENCH_get_result(code_bench_target_t target, code_bench_mode_t mode)
+{
+	if((code_bench_targets <= target) || (code_bench_modes <= mode))
+	{
+		return NULL;
+	}
+
+	return &code_bench_handler.results[target][mode];
+}
+
+/*********************************************************************************************/
+
+/** This function runs a target once*/
+static uint32_t code_bench_measure(code_bench_target_t target, uint32_t run)
+{
+	/** Cycles when the target started*/
+	uint32_t start = CYCLE_COUNTER_GET();
+
+	switch(target)
+	{
+		case code_bench_can_rx_isr:
+			/** The interrupt is taken before the pending bit reads back cleared, and it returns before the thread goes on*/
+			INT_SYS_SetPending(CODE_BENCH_IRQ);
+			while(INT_SYS_GetPending(CODE_BENCH_IRQ));
+		break;
+
+		case code_bench_can_receive:
+			CAN_receive_message(&code_bench_handler.rx_message);
+		break;
+
+		default:
+			SPEED_PID_update(&code_bench_handler.pid, CODE_BENCH_PID_SETPOINT, (int16_t)(run << 8), INIT_VAL);
+		break;
+	}
+
+	return CYCLE_COUNTER_GET() - start;
+}
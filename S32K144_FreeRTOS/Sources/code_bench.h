@@ -0,0 +1,92 @@
+/*!
+ 	 \file code_bench.h
+
+ 	 \brief This is the header file of the code placement benchmark. It measures
+ 	 	 	 the cycles of the real hot paths and of a control function, with the
+ 	 	 	 code cache disabled and enabled. The results are read with a debugger
+ 	 	 	 (code_bench_handler) or with CODE_BENCH_get_result.
+
+ 	 \note The targets are CAN_RX_Interrupt and CAN_receive_message (The RX path,
+ 	 	 	 HOT_PATH_RAMSECTION), and SPEED_PID_update (The control loop), which
+ 	 	 	 always runs from flash. So a single build compares code in RAM and in
+ 	 	 	 flash. Building the flash configuration with HOT_PATHS_IN_FLASH defined
+ 	 	 	 leaves the hot paths in flash too, and their results show the cost of
+ 	 	 	 the placement.
+
+ 	 \note The interrupt is pended on the software interrupt (SWI), it is measured
+ 	 	 	 from the pend to its return (Latency, handler and exit). The functions
+ 	 	 	 are measured around the call. The first run after the cache is
+ 	 	 	 invalidated gives the maximum (Misses), the next ones the minimum.
+
+ 	 \note The benchmark only runs at the start-up of the builds with CODE_BENCH_ENABLE
+ 	 	 	 defined, it switches the code cache and delays the boot. CAN_receive_message
+ 	 	 	 pops the Rx FIFO of CAN0, a frame received before the scheduler starts is
+ 	 	 	 lost in those builds.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef CODE_BENCH_H_
+#define CODE_BENCH_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/** Defines the runs of each target and mode*/
+#define CODE_BENCH_RUNS						(32U)
+
+/*!
+ 	 \brief Modes of the code cache of the benchmark.
+ */
+typedef enum
+{
+	code_bench_cache_off,		/*!< Code cache disabled*/
+	code_bench_cache_on,		/*!< Code cache enabled (Invalidated before the first run)*/
+	code_bench_modes			/*!< Number of modes*/
+}code_bench_mode_t;
+
+/*!
+ 	 \brief Functions measured by the benchmark.
+ */
+typedef enum
+{
+	code_bench_can_rx_isr,		/*!< CAN_RX_Interrupt, pended on the SWI*/
+	code_bench_can_receive,		/*!< CAN_receive_message on CAN0*/
+	code_bench_speed_pid,		/*!< SPEED_PID_update (In flash in every build)*/
+	code_bench_targets			/*!< Number of targets*/
+}code_bench_target_t;
+
+/*!
+ 	 \brief Structure for the results of a target and mode, in core cycles.
+ */
+typedef struct
+{
+	uint32_t cycles_min;		/*!< Minimum cycles of the target*/
+	uint32_t cycles_max;		/*!< Maximum cycles of the target*/
+}CODE_BENCH_result_t;
+
+/*!
+ 	 \brief This function runs the benchmark. It must be called before the scheduler
+ 	 	 	 starts, with the clocks set and the CAN initialized (rtos_can_init). The
+ 	 	 	 state of the code cache is restored.
+
+ 	 \return void.
+ */
+void CODE_BENCH_run(void);
+
+/*!
+ 	 \brief This function gets the results of a target and mode.
+
+ 	 \param[in] target Function measured.
+ 	 \param[in] mode Mode of the code cache.
+
+ 	 \return Results of the target and mode, NULL if they are not valid.
+ */
+const CODE_BENCH_result_t* CODE_BENCH_get_result(code_bench_target_t target, code_bench_mode_t mode);
+
+#endif /* CODE_BENCH_H_ */
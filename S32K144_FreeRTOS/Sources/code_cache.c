@@ -0,0 +1,114 @@
+/*!
+ 	 \file code_cache.c
+
+ 	 \brief This is the source file of the code cache. The commands of the LMEM
+ 	 	 	 cache are found in this source file.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include "code_cache.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL							(0)
+/** Defines a flag as set*/
+#define FLAG_SET							(1)
+/** Defines a flag as cleared*/
+#define FLAG_CLEAR							(0)
+
+/** Defines the command of a line to invalidate it*/
+#define CODE_CACHE_LINE_INVALIDATE			(1U)
+/** Defines the mask of the address of a line*/
+#define CODE_CACHE_LINE_MASK				(~(CODE_CACHE_LINE_SIZE - 1U))
+
+/*********************************************************************************************/
+
+/*!
+ 	 \brief This function runs a command of the whole cache and waits until it ends.
+
+ 	 \param[in] command Bits of the command (INVW0, INVW1), ENCACHE is kept.
+
+ 	 \return void.
+ */
+static void code_cache_command(uint32_t command);
+
+/*********************************************************************************************/
+
+/** This function enables the cache*/
+void CODE_CACHE_enable(void)
+{
+	code_cache_command(LMEM_PCCCR_INVW0_MASK | LMEM_PCCCR_INVW1_MASK);
+
+	LMEM->PCCCR |= LMEM_PCCCR_ENCACHE_MASK;
+}
+
+/** This function disables the cache*/
+void CODE_CACHE_disable(void)
+{
+	LMEM->PCCCR &= ~LMEM_PCCCR_ENCACHE_MASK;
+
+	/** The flash is write-through, so there is nothing to push*/
+	code_cache_command(LMEM_PCCCR_INVW0_MASK | LMEM_PCCCR_INVW1_MASK);
+}
+
+/** This function gets whether the cache is enabled*/
+uint8_t CODE_CACHE_is_enabled(void)
+{
+	if(LMEM->PCCCR & LMEM_PCCCR_ENCACHE_MASK)
+	{
+		return FLAG_SET;
+	}
+
+	return FLAG_CLEAR;
+}
+
+/** This function invalidates the cache*/
+void CODE_CACHE_invalidate(void)
+{
+	code_cache_command(LMEM_PCCCR_INVW0_MASK | LMEM_PCCCR_INVW1_MASK);
+}
+
+/** This function invalidates the lines of a range*/
+void CODE_CACHE_invalidate_range(uint32_t address, uint32_t size)
+{
+	/** Address of the line being invalidated*/
+	uint32_t line;
+
+	if((INIT_VAL == size) || (FLAG_SET != CODE_CACHE_is_enabled()))
+	{
+		return;
+	}
+
+	/** A line command per line would take longer than filling the cache again*/
+	if(CODE_CACHE_SIZE <= size)
+	{
+		CODE_CACHE_invalidate();
+
+		return;
+	}
+
+	/** The lines are searched by their physical address*/
+	LMEM->PCCLCR = LMEM_PCCLCR_LADSEL_MASK | LMEM_PCCLCR_LCMD(CODE_CACHE_LINE_INVALIDATE);
+
+	for(line = address & CODE_CACHE_LINE_MASK ; line < (address + size) ; line += CODE_CACHE_LINE_SIZE)
+	{
+		LMEM->PCCSAR = (line & LMEM_PCCSAR_PHYADDR_MASK) | LMEM_PCCSAR_LGO_MASK;
+
+		while(LMEM->PCCSAR & LMEM_PCCSAR_LGO_MASK);
+	}
+}
+
+/*********************************************************************************************/
+
+/** This function runs a command of the cache*/
+static void code_cache_command(uint32_t command)
+{
+	LMEM->PCCCR = (LMEM->PCCCR & LMEM_PCCCR_ENCACHE_MASK) | command | LMEM_PCCCR_GO_MASK;
+
+	while(LMEM->PCCCR & LMEM_PCCCR_GO_MASK);
+}
@@ -0,0 +1,72 @@
+/*!
+ 	 \file code_cache.h
+
+ 	 \brief This is the header file of the code cache. It manages the LMEM cache of
+ 	 	 	 the code bus (4 KB, 2 ways, lines of 16 bytes), which caches the
+ 	 	 	 program flash. The flash builds enable it at start-up, and the flash
+ 	 	 	 driver invalidates the lines of the erased and programmed addresses.
+
+ 	 \note The SRAM_L is not cached, so the code of the RAM builds and the hot paths
+ 	 	 	 (HOT_PATH_RAMSECTION) do not depend on the cache.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef CODE_CACHE_H_
+#define CODE_CACHE_H_
+
+#include <stdint.h>
+#include "S32K144.h"
+
+/** Defines the size of the cache, in bytes*/
+#define CODE_CACHE_SIZE						(4096U)
+/** Defines the size of a line of the cache, in bytes*/
+#define CODE_CACHE_LINE_SIZE				(16U)
+
+/*!
+ 	 \brief This function invalidates the whole cache and enables it.
+
+ 	 \return void.
+ */
+void CODE_CACHE_enable(void);
+
+/*!
+ 	 \brief This function disables the cache and invalidates it, the flash is read
+ 	 	 	 with its wait states.
+
+ 	 \return void.
+ */
+void CODE_CACHE_disable(void);
+
+/*!
+ 	 \brief This function gets whether the cache is enabled.
+
+ 	 \return 1 if the cache is enabled, 0 otherwise.
+ */
+uint8_t CODE_CACHE_is_enabled(void);
+
+/*!
+ 	 \brief This function invalidates the whole cache.
+
+ 	 \return void.
+ */
+void CODE_CACHE_invalidate(void);
+
+/*!
+ 	 \brief This function invalidates the lines of an address range (e.g. after the
+ 	 	 	 flash is erased or programmed). A range as big as the cache
+ 	 	 	 invalidates the whole cache.
+
+ 	 \param[in] address First address of the range.
+ 	 \param[in] size Size of the range, in bytes.
+
+ 	 \return void.
+ */
+void CODE_CACHE_invalidate_range(uint32_t address, uint32_t size);
+
+#endif /* CODE_CACHE_H_ */
@@ -0,0 +1,50 @@
+/*!
+ 	 \file cycle_counter.h
+
+ 	 \brief This is the header file of the cycle counter. It uses the DWT cycle
+ 	 	 	 counter of the Cortex-M4 to measure the core cycles of a code section.
+
+ 	 \note The counter is enabled from the reset by the boot profiler (BOOT_PROFILE_start),
+ 	 	 	 do not enable it again, it would clear the boot times. A measurement is
+ 	 	 	 CYCLE_COUNTER_GET() - start, the subtraction is right even if the counter wraps.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef CYCLE_COUNTER_H_
+#define CYCLE_COUNTER_H_
+
+#include <stdint.h>
+
+#ifdef HOST_SIM
+/** There is no DWT on the host simulation, the cycles read 0*/
+#define CYCLE_COUNTER_ENABLE()				do { } while(0)
+/** Gets the cycles since the counter was enabled*/
+#define CYCLE_COUNTER_GET()					(0U)
+#else
+/** Defines the Debug Exception and Monitor Control Register*/
+#define CYCLE_COUNTER_DEMCR					(*(volatile uint32_t*)0xE000EDFCU)
+/** Defines the DWT control register*/
+#define CYCLE_COUNTER_DWT_CTRL				(*(volatile uint32_t*)0xE0001000U)
+/** Defines the DWT cycle count register*/
+#define CYCLE_COUNTER_DWT_CYCCNT			(*(volatile uint32_t*)0xE0001004U)
+/** Defines the trace enable bit of DEMCR*/
+#define CYCLE_COUNTER_DEMCR_TRCENA			(0x01000000U)
+/** Defines the cycle counter enable bit of the DWT control*/
+#define CYCLE_COUNTER_DWT_CYCCNTENA			(0x00000001U)
+
+/** Enables the cycle counter*/
+#define CYCLE_COUNTER_ENABLE()				do { CYCLE_COUNTER_DEMCR |= CYCLE_COUNTER_DEMCR_TRCENA; \
+												 CYCLE_COUNTER_DWT_CYCCNT = 0U; \
+												 CYCLE_COUNTER_DWT_CTRL |= CYCLE_COUNTER_DWT_CYCCNTENA; } while(0)
+
+/** Gets the cycles since the counter was enabled*/
+#define CYCLE_COUNTER_GET()					(CYCLE_COUNTER_DWT_CYCCNT)
+#endif
+
+#endif /* CYCLE_COUNTER_H_ */
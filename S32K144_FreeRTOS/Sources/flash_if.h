@@ -0,0 +1,55 @@
+/*!
+ 	 \file flash_if.h
+
+ 	 \brief This is the header file of the flash interface. It defines the
+ 	 	 	 operations that the bootloader needs from a flash, so the FTFC driver
+ 	 	 	 and a RAM-backed simulation can be used interchangeably.
+
+ 	 \note The operations are split in start and poll, so the caller can do other
+ 	 	 	 work (e.g. receive the next block) while the flash is busy. The flash
+ 	 	 	 calls the done callback when a busy operation ends, so the caller can
+ 	 	 	 block instead of polling.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef FLASH_IF_H_
+#define FLASH_IF_H_
+
+#include <stdint.h>
+
+/*!
+ 	 \brief Enumerator to define the status of a flash operation.
+ */
+typedef enum
+{
+	flash_success,			/*!< Operation finished successfully*/
+	flash_busy,				/*!< An operation is still in progress*/
+	flash_address_error,	/*!< The address is not aligned or is out of range*/
+	flash_access_error,		/*!< The flash rejected the command*/
+	flash_protection_error,	/*!< The address is protected*/
+	flash_verify_error		/*!< The flash contents do not match the data written*/
+}flash_status_t;
+
+/*!
+ 	 \brief Operations and geometry of a flash.
+ */
+typedef struct
+{
+	uint32_t base_address;	/*!< First address of the flash*/
+	uint32_t size;			/*!< Size of the flash in bytes*/
+	uint32_t sector_size;	/*!< Size of the smallest erasable unit*/
+	uint32_t phrase_size;	/*!< Size of the smallest programmable unit*/
+	flash_status_t (*erase_sector)(uint32_t address);					/*!< Starts the erase of the sector on the address*/
+	flash_status_t (*program_phrase)(uint32_t address, const uint8_t* data);	/*!< Starts the programming of a phrase*/
+	flash_status_t (*poll)(void);										/*!< Returns flash_busy until the last operation ends*/
+	const uint8_t* (*read)(uint32_t address);							/*!< Returns a pointer to read the flash on the address*/
+	void (*set_done_callback)(void (*callback)(void));					/*!< Sets the function called (From an interrupt) when a busy operation ends*/
+}flash_if_t;
+
+#endif /* FLASH_IF_H_ */
@@ -0,0 +1,354 @@
+/*!
+ 	 \file ftfc_flash.c
+
+ 	 \brief This is the source file of the FTFC flash driver. The erase and
+ 	 	 	 program commands of the program flash are found in this source file.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include <stddef.h>
+#include "ftfc_flash.h"
+#include "FreeRTOS.h"
+#include "interrupt_manager.h"
+#include "code_cache.h"
+
+/** Defines the command to program a phrase*/
+#define FTFC_CMD_PROGRAM_PHRASE				(0x07U)
+/** Defines the command to erase a sector*/
+#define FTFC_CMD_ERASE_SECTOR				(0x09U)
+
+/** Defines the FCCOB of the command*/
+#define FCCOB_CMD							(0)
+/** Defines the FCCOB of the bits 23 to 16 of the address*/
+#define FCCOB_ADDR_HIGH						(1)
+/** Defines the FCCOB of the bits 15 to 8 of the address*/
+#define FCCOB_ADDR_MID						(2)
+/** Defines the FCCOB of the bits 7 to 0 of the address*/
+#define FCCOB_ADDR_LOW						(3)
+/** Defines the FCCOB of the first data byte*/
+#define FCCOB_DATA							(4)
+
+/** Defines the bit shifts for the high byte of the address*/
+#define ADDR_HIGH_SHIFT						(16)
+/** Defines the bit shifts for the middle byte of the address*/
+#define ADDR_MID_SHIFT						(8)
+/** Defines a mask to get a byte*/
+#define BYTE_MASK							(0xFFU)
+
+/** Defines the priority of the command complete interruption (The callback may use the kernel)*/
+#define FTFC_INTERRUPT_PRIO					(configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY)
+
+/** Defines the error flags of FSTAT, they are cleared writing 1*/
+#define FSTAT_ERROR_MASK					(FTFC_FSTAT_RDCOLERR_MASK | FTFC_FSTAT_ACCERR_MASK | FTFC_FSTAT_FPVIOL_MASK)
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL							(0)
+/** Defines a flag as set*/
+#define FLAG_SET							(1)
+/** Defines a flag as cleared*/
+#define FLAG_CLEAR							(0)
+
+/** Maps the FCCOB number to the register array (Registers are big endian in groups of 4)*/
+#define FTFC_FCCOB(n)						(FTFC->FCCOB[((n) & ~3U) + (3U - ((n) & 3U))])
+
+/*********************************************************************************************/
+
+/*!
+ 	 \brief This function launches the loaded command (Or resumes a suspended erase),
+ 	 	 	 and waits until it ends if requested.
+
+ 	 \note It runs from RAM, the program flash cannot be read until CCIF is set. While
+ 	 	 	 it waits, a pending interruption suspends an erase (ERSSUSP), so the
+ 	 	 	 interruption is served as soon as the flash can be read again.
+
+ 	 \param[in] wait FLAG_SET to return once the command ended or was suspended.
+ 	 \param[in] suspend FLAG_SET if the command is an erase that can be suspended.
+
+ 	 \return The value of FSTAT.
+ */
+static uint8_t ftfc_launch_command(uint8_t wait, uint8_t suspend) __attribute__((section(".code_ram"), noinline, long_call));
+
+/*!
+ 	 \brief This function loads the address of a command and launches it. If the code
+ 	 	 	 runs from the program flash it waits in RAM until the command ends (The
+ 	 	 	 erases are suspended to serve the interruptions), otherwise it returns
+ 	 	 	 flash_busy and the command complete interruption calls the done callback.
+
+ 	 \param[in] command Command to be launched.
+ 	 \param[in] address Address of the command.
+ 	 \param[in] data Phrase to be programmed, NULL if the command has no data.
+ 	 \param[in] size Size of the flash written by the command.
+
+ 	 \return Result of the command, or flash_busy.
+ */
+static flash_status_t ftfc_execute(uint8_t command, uint32_t address, const uint8_t* data, uint32_t size);
+
+/*!
+ 	 \brief This function ends a command: it invalidates the code cache lines of its
+ 	 	 	 range and decodes its errors.
+
+ 	 \param[in] fstat Value of FSTAT once the command ended.
+
+ 	 \return Result of the command.
+ */
+static flash_status_t ftfc_finish(uint8_t fstat);
+
+/*!
+ 	 \brief This function starts the erase of a sector.
+
+ 	 \param[in] address Address of the sector.
+
+ 	 \return Result of the erase.
+ */
+static flash_status_t ftfc_erase_sector(uint32_t address);
+
+/*!
+ 	 \brief This function programs a phrase.
+
+ 	 \param[in] address Address of the phrase.
+ 	 \param[in] data Phrase to be programmed.
+
+ 	 \return Result of the programming.
+ */
+static flash_status_t ftfc_program_phrase(uint32_t address, const uint8_t* data);
+
+/*!
+ 	 \brief This function returns the result of the last command, flash_busy while
+ 	 	 	 it runs.
+
+ 	 \return Result of the last command.
+ */
+static flash_status_t ftfc_poll(void);
+
+/*!
+ 	 \brief This function returns a pointer to read the program flash.
+
+ 	 \param[in] address Address to be read.
+
+ 	 \return Pointer to the address.
+ */
+static const uint8_t* ftfc_read(uint32_t address);
+
+/*!
+ 	 \brief This function sets the function called by the command complete interruption,
+ 	 	 	 and enables the interruption.
+
+ 	 \param[in] callback Function called when a command launched from RAM ends.
+
+ 	 \return void.
+ */
+static void ftfc_set_done_callback(void (*callback)(void));
+
+/*********************************************************************************************/
+
+/** Result of the last command*/
+static flash_status_t ftfc_last_status = flash_success;
+/** First address written by the last command*/
+static uint32_t ftfc_last_address = INIT_VAL;
+/** Size of the flash written by the last command*/
+static uint32_t ftfc_last_size = INIT_VAL;
+/** Function called when a command ends*/
+static void (*ftfc_done_callback)(void) = NULL;
+
+/** Flash interface of the program flash*/
+static const flash_if_t ftfc_flash_if =
+{
+	FTFC_PFLASH_BASE,
+	FTFC_PFLASH_SIZE,
+	FTFC_SECTOR_SIZE,
+	FTFC_PHRASE_SIZE,
+	ftfc_erase_sector,
+	ftfc_program_phrase,
+	ftfc_poll,
+	ftfc_read,
+	ftfc_set_done_callback
+};
+
+/*********************************************************************************************/
+
+/** This function returns the flash interface*/
+const flash_if_t* FTFC_get_flash_if(void)
+{
+	return &ftfc_flash_if;
+}
+
+/** Interruption of the command complete, it only runs when the commands are launched from RAM*/
+void FTFC_IRQHandler(void)
+{
+	/** CCIF stays set until the next command, the interruption is enabled again when it is launched*/
+	FTFC->FCNFG &= ~FTFC_FCNFG_CCIE_MASK;
+
+	if(NULL != ftfc_done_callback)
+	{
+		ftfc_done_callback();
+	}
+}
+
+/** This function launches the command, the wait is in RAM*/
+static uint8_t ftfc_launch_command(uint8_t wait, uint8_t suspend)
+{
+	/** Launches the command*/
+	FTFC->FSTAT = FTFC_FSTAT_CCIF_MASK;
+
+	/** Waits until the command ends (The FTFC clears ERSSUSP if the erase ends before it is suspended)*/
+	while((FLAG_SET == wait) && (INIT_VAL == (FTFC->FSTAT & FTFC_FSTAT_CCIF_MASK)))
+	{
+		if((FLAG_SET == suspend) && (S32_SCB->ICSR & S32_SCB_ICSR_VECTPENDING_MASK))
+		{
+			FTFC->FCNFG |= FTFC_FCNFG_ERSSUSP_MASK;
+		}
+	}
+
+	return FTFC->FSTAT;
+}
+
+/** This function loads and executes a command*/
+static flash_status_t ftfc_execute(uint8_t command, uint32_t address, const uint8_t* data, uint32_t size)
+{
+	/** Status of the command*/
+	uint8_t fstat;
+	/** Counter to load the data*/
+	uint8_t counter;
+
+	/** A command is still running, it must be polled until it ends*/
+	if(INIT_VAL == (FTFC->FSTAT & FTFC_FSTAT_CCIF_MASK))
+	{
+		return flash_access_error;
+	}
+
+	ftfc_last_address = address;
+	ftfc_last_size = size;
+
+	/** Clears the errors of the previous command*/
+	FTFC->FSTAT = FSTAT_ERROR_MASK;
+
+	/** Loads the command and the address*/
+	FTFC_FCCOB(FCCOB_CMD) = command;
+	FTFC_FCCOB(FCCOB_ADDR_HIGH) = (uint8_t)((address >> ADDR_HIGH_SHIFT) & BYTE_MASK);
+	FTFC_FCCOB(FCCOB_ADDR_MID) = (uint8_t)((address >> ADDR_MID_SHIFT) & BYTE_MASK);
+	FTFC_FCCOB(FCCOB_ADDR_LOW) = (uint8_t)(address & BYTE_MASK);
+
+	for(counter = INIT_VAL ; (NULL != data) && (counter < FTFC_PHRASE_SIZE) ; counter ++)
+	{
+		FTFC_FCCOB(FCCOB_DATA + counter) = data[counter];
+	}
+
+	/** The code runs from SRAM (RAM builds), it keeps running while the flash is busy*/
+	if(FTFC_PFLASH_SIZE <= ((uint32_t)&ftfc_execute - FTFC_PFLASH_BASE))
+	{
+		ftfc_last_status = flash_busy;
+		ftfc_launch_command(FLAG_CLEAR, FLAG_CLEAR);
+
+		/** The interruption is enabled once CCIF is cleared, it calls the done callback*/
+		if(NULL != ftfc_done_callback)
+		{
+			FTFC->FCNFG |= FTFC_FCNFG_CCIE_MASK;
+		}
+
+		return ftfc_last_status;
+	}
+
+	/** The code runs from the program flash (A single block, it cannot be read while it is written), the wait is in RAM*/
+	INT_SYS_DisableIRQGlobal();
+	fstat = ftfc_launch_command(FLAG_SET, (FTFC_CMD_ERASE_SECTOR == command) ? FLAG_SET : FLAG_CLEAR);
+
+	/** The erase was suspended: the pending interruptions run while the flash can be read, then it resumes*/
+	while(FTFC->FCNFG & FTFC_FCNFG_ERSSUSP_MASK)
+	{
+		INT_SYS_EnableIRQGlobal();
+		INT_SYS_DisableIRQGlobal();
+
+		FTFC->FCNFG &= ~FTFC_FCNFG_ERSSUSP_MASK;
+		fstat = ftfc_launch_command(FLAG_SET, FLAG_SET);
+	}
+
+	INT_SYS_EnableIRQGlobal();
+
+	return ftfc_finish(fstat);
+}
+
+/** This function ends a command*/
+static flash_status_t ftfc_finish(uint8_t fstat)
+{
+	/** The cache may have the old contents of the range, even if the command failed*/
+	CODE_CACHE_invalidate_range(ftfc_last_address, ftfc_last_size);
+
+	if(fstat & FTFC_FSTAT_FPVIOL_MASK)
+	{
+		ftfc_last_status = flash_protection_error;
+	}
+
+	else if(fstat & (FTFC_FSTAT_ACCERR_MASK | FTFC_FSTAT_RDCOLERR_MASK))
+	{
+		ftfc_last_status = flash_access_error;
+	}
+
+	else if(fstat & FTFC_FSTAT_MGSTAT0_MASK)
+	{
+		ftfc_last_status = flash_verify_error;
+	}
+
+	else
+	{
+		ftfc_last_status = flash_success;
+	}
+
+	return ftfc_last_status;
+}
+
+/** This function erases a sector*/
+static flash_status_t ftfc_erase_sector(uint32_t address)
+{
+	if((INIT_VAL != (address % FTFC_SECTOR_SIZE)) || ((FTFC_PFLASH_BASE + FTFC_PFLASH_SIZE) <= address))
+	{
+		return flash_address_error;
+	}
+
+	return ftfc_execute(FTFC_CMD_ERASE_SECTOR, address, NULL, FTFC_SECTOR_SIZE);
+}
+
+/** This function programs a phrase*/
+static flash_status_t ftfc_program_phrase(uint32_t address, const uint8_t* data)
+{
+	if((INIT_VAL != (address % FTFC_PHRASE_SIZE)) || ((FTFC_PFLASH_BASE + FTFC_PFLASH_SIZE) <= address))
+	{
+		return flash_address_error;
+	}
+
+	return ftfc_execute(FTFC_CMD_PROGRAM_PHRASE, address, data, FTFC_PHRASE_SIZE);
+}
+
+/** This function returns the result of the last command*/
+static flash_status_t ftfc_poll(void)
+{
+	/** Status of the flash*/
+	uint8_t fstat = FTFC->FSTAT;
+
+	if((flash_busy == ftfc_last_status) && (fstat & FTFC_FSTAT_CCIF_MASK))
+	{
+		ftfc_finish(fstat);
+	}
+
+	return ftfc_last_status;
+}
+
+/** This function returns a pointer to the flash*/
+static const uint8_t* ftfc_read(uint32_t address)
+{
+	return (const uint8_t*)address;
+}
+
+/** This function sets the done callback*/
+static void ftfc_set_done_callback(void (*callback)(void))
+{
+	ftfc_done_callback = callback;
+
+	INT_SYS_SetPriority(FTFC_IRQn, FTFC_INTERRUPT_PRIO);
+	INT_SYS_EnableIRQ(FTFC_IRQn);
+}
@@ -0,0 +1,43 @@
+/*!
+ 	 \file ftfc_flash.h
+
+ 	 \brief This is the header file of the FTFC flash driver. It implements the
+ 	 	 	 flash interface for the program flash of the S32K144.
+
+ 	 \note The program flash is a single block, so it cannot be read while a command
+ 	 	 	 runs. When the code runs from the program flash (Flash builds), the command
+ 	 	 	 launch waits in RAM with the interrupts disabled, the CAN controller keeps
+ 	 	 	 receiving into its message buffers meanwhile. When the code runs from
+ 	 	 	 SRAM (RAM builds), the commands return flash_busy and the poll ends them.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef FTFC_FLASH_H_
+#define FTFC_FLASH_H_
+
+#include "S32K144.h"
+#include "flash_if.h"
+
+/** Defines the first address of the program flash*/
+#define FTFC_PFLASH_BASE					(0x00000000U)
+/** Defines the size of the program flash*/
+#define FTFC_PFLASH_SIZE					(0x00080000U)
+/** Defines the size of a program flash sector*/
+#define FTFC_SECTOR_SIZE					(4096U)
+/** Defines the size of a program flash phrase*/
+#define FTFC_PHRASE_SIZE					(8U)
+
+/*!
+ 	 \brief This function returns the flash interface of the program flash.
+
+ 	 \return Pointer to the flash interface.
+ */
+const flash_if_t* FTFC_get_flash_if(void);
+
+#endif /* FTFC_FLASH_H_ */
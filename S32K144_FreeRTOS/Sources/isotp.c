@@ -0,0 +1,860 @@
+/*!
+ 	 \file isotp.c
+
+ 	 \brief This is the source file of the ISO-TP (ISO 15765-2) transport layer.
+ 	 	 	 All the segmentation, reassembly and flow control functions are found
+ 	 	 	 in this source file.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include "isotp.h"
+#include "tick_period.h"
+
+/** Defines the ISO-TP handler as initialized*/
+#define IS_INIT								(1)
+/** Defines the ISO-TP handler as not initialized*/
+#define NOT_INIT							(0)
+/** Defines the session as open*/
+#define SESSION_OPEN						(1)
+/** Defines the session as closed*/
+#define SESSION_CLOSED						(0)
+/** Defines a flag as set*/
+#define FLAG_SET							(1)
+/** Defines a flag as cleared*/
+#define FLAG_CLEAR							(0)
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL							(0)
+
+
+/** Defines the size of a CAN frame*/
+#define CAN_FRAME_SIZE						(8)
+/** Defines the byte used to pad the unused bytes of a frame*/
+#define PADDING_BYTE						(0xCC)
+
+/** Defines the position of the PCI byte in a frame*/
+#define PCI_POS								(0)
+/** Defines the mask of the PCI type*/
+#define PCI_TYPE_MASK						(0xF0)
+/** Defines the mask of the low nibble of the PCI*/
+#define PCI_NIBBLE_MASK						(0x0F)
+/** Defines the PCI of a single frame*/
+#define PCI_SINGLE_FRAME					(0x00)
+/** Defines the PCI of a first frame*/
+#define PCI_FIRST_FRAME						(0x10)
+/** Defines the PCI of a consecutive frame*/
+#define PCI_CONSECUTIVE_FRAME				(0x20)
+/** Defines the PCI of a flow control frame*/
+#define PCI_FLOW_CONTROL					(0x30)
+
+/** Defines the maximum payload of a single frame*/
+#define SF_MAX_DATA							(7)
+/** Defines the payload of a first frame*/
+#define FF_DATA								(6)
+/** Defines the maximum payload of a consecutive frame*/
+#define CF_MAX_DATA							(7)
+/** Defines the position of the low byte of the length in a first frame*/
+#define FF_LENGTH_LOW_POS					(1)
+/** Defines the position of the data in a first frame*/
+#define FF_DATA_POS							(2)
+/** Defines the position of the data in single and consecutive frames*/
+#define DATA_POS							(1)
+/** Defines the position of the block size in a flow control*/
+#define FC_BS_POS							(1)
+/** Defines the position of STmin in a flow control*/
+#define FC_STMIN_POS						(2)
+/** Defines the size of a flow control frame*/
+#define FC_SIZE								(3)
+
+/** Defines the flow status continue to send*/
+#define FS_CONTINUE_TO_SEND					(0x00)
+/** Defines the flow status wait*/
+#define FS_WAIT								(0x01)
+/** Defines the flow status overflow*/
+#define FS_OVERFLOW							(0x02)
+
+/** Defines the first sequence number of the consecutive frames*/
+#define FIRST_SEQUENCE_NUMBER				(1)
+/** Defines the mask of the sequence number*/
+#define SEQUENCE_NUMBER_MASK				(0x0F)
+
+/** Defines the biggest STmin in milliseconds*/
+#define STMIN_MAX_MS						(0x7F)
+/** Defines the lowest STmin in the range of 100 to 900 us*/
+#define STMIN_US_LOW						(0xF1)
+/** Defines the highest STmin in the range of 100 to 900 us*/
+#define STMIN_US_HIGH						(0xF9)
+/** Defines the ticks used for STmin values under 1 ms*/
+#define STMIN_US_TICKS						(1)
+
+/** Defines the bit shifts for a byte*/
+#define BYTE_SHIFT							(8)
+/** Defines a mask to get a low byte*/
+#define LOW_BYTE_MASK						(0x00FF)
+
+/** Defines the timeout, in milliseconds, to receive a flow control (N_Bs)*/
+#define N_BS_TIMEOUT						(1000U)
+/** Defines the timeout, in milliseconds, to receive a consecutive frame (N_Cr)*/
+#define N_CR_TIMEOUT						(1000U)
+
+/** Defines the half of the tick range, used to compare ticks with overflow*/
+#define TICK_HALF_RANGE						(portMAX_DELAY / 2)
+
+/*********************************************************************************************/
+
+/*!
+ 	 \brief Enumerator to define the states of the transmission of a session.
+ */
+typedef enum
+{
+	tx_idle,			/*!< Nothing is being sent*/
+	tx_wait_fc,			/*!< Waiting for a flow control*/
+	tx_sending_cf		/*!< Sending consecutive frames*/
+}isotp_tx_state_t;
+
+/*!
+ 	 \brief Enumerator to define the states of the reception of a session.
+ */
+typedef enum
+{
+	rx_idle,			/*!< Nothing is being received*/
+	rx_receiving_cf		/*!< Receiving consecutive frames*/
+}isotp_rx_state_t;
+
+/*!
+ 	 \brief Structure to define an ISO-TP session.
+ */
+typedef struct
+{
+	uint8_t is_open;				/*!< Whether the session is open or not*/
+	ISOTP_session_config_t config;	/*!< Configuration of the session*/
+
+	isotp_tx_state_t tx_state;		/*!< State of the transmission*/
+	const uint8_t* tx_data;			/*!< Caller's buffer being sent*/
+	uint16_t tx_length;				/*!< Length of the message being sent*/
+	uint16_t tx_offset;				/*!< Bytes already sent*/
+	uint8_t tx_sn;					/*!< Next sequence number to be sent*/
+	uint8_t tx_bs;					/*!< Block size received in the last flow control*/
+	uint8_t tx_bs_count;			/*!< Consecutive frames sent in the current block*/
+	TickType_t tx_st_min;			/*!< Ticks to wait between consecutive frames*/
+	TickType_t tx_next_tick;		/*!< Tick when the next consecutive frame can be sent*/
+	TickType_t tx_deadline;			/*!< Tick when the flow control wait times out*/
+
+	isotp_rx_state_t rx_state;		/*!< State of the reception*/
+	uint16_t rx_length;				/*!< Length of the message being received*/
+	uint16_t rx_offset;				/*!< Bytes already received*/
+	uint8_t rx_sn;					/*!< Next sequence number expected*/
+	uint8_t rx_bs_count;			/*!< Consecutive frames received in the current block*/
+	TickType_t rx_deadline;			/*!< Tick when the consecutive frame wait times out*/
+}isotp_session_t;
+
+/*!
+ 	 \brief Structure for the ISO-TP handler.
+ */
+typedef struct
+{
+	uint8_t init_val;				/*!< Defines whether the handler has been initialized or not*/
+	SemaphoreHandle_t sem_work;		/*!< Binary semaphore to wake up the ISO-TP thread*/
+	SemaphoreHandle_t mutex;		/*!< Mutex to protect the sessions*/
+}isotp_handler_t;
+
+/*********************************************************************************************/
+
+/** ISO-TP handler*/
+static isotp_handler_t isotp_handler = { INIT_VAL };
+/** ISO-TP sessions*/
+static isotp_session_t isotp_session[ISOTP_MAX_SESSIONS];
+
+/*********************************************************************************************/
+
+/** This function returns whether a tick has been reached, considering the tick overflow*/
+static uint8_t isotp_tick_reached(TickType_t now, TickType_t target)
+{
+	return ((TickType_t)(now - target) < TICK_HALF_RANGE) ? FLAG_SET : FLAG_CLEAR;
+}
+
+/** This function converts the STmin received in a flow control into ticks*/
+static TickType_t isotp_st_min_to_ticks(uint8_t st_min)
+{
+	/** Variable for the ticks, reserved values are taken as the maximum STmin*/
+	TickType_t ticks = (TickType_t)(STMIN_MAX_MS * FIX_PERIOD);
+
+	/** STmin in milliseconds*/
+	if(STMIN_MAX_MS >= st_min)
+	{
+		ticks = (TickType_t)(st_min * FIX_PERIOD);
+	}
+
+	/** STmin in hundreds of microseconds, the tick is the smallest delay possible*/
+	else if((STMIN_US_LOW <= st_min) && (STMIN_US_HIGH >= st_min))
+	{
+		ticks = STMIN_US_TICKS;
+	}
+
+	return ticks;
+}
+
+/** This function sends a frame of a session padded to 8 bytes*/
+static void isotp_send_frame(isotp_session_t* session, uint8_t* frame)
+{
+	/** Variable to transmit the frame*/
+	can_message_tx_config_t tx_frame;
+
+	tx_frame.base = session->config.base;
+	tx_frame.ID = session->config.tx_ID;
+	tx_frame.msg = frame;
+	tx_frame.DLC = CAN_FRAME_SIZE;
+
+	/** Sends the frame protecting the CAN with a mutex*/
+	rtos_can_transmit(tx_frame);
+}
+
+/** This function sends a flow control with the block size and STmin of the session*/
+static void isotp_send_flow_control(isotp_session_t* session, uint8_t flow_status)
+{
+	/** Flow control frame*/
+	uint8_t frame[CAN_FRAME_SIZE] = {PADDING_BYTE, PADDING_BYTE, PADDING_BYTE, PADDING_BYTE,
+									 PADDING_BYTE, PADDING_BYTE, PADDING_BYTE, PADDING_BYTE};
+
+	frame[PCI_POS] = PCI_FLOW_CONTROL | flow_status;
+	frame[FC_BS_POS] = session->config.block_size;
+	frame[FC_STMIN_POS] = session->config.st_min;
+
+	isotp_send_frame(session, frame);
+}
+
+/** This function sends the next consecutive frame of a session, and returns whether the message was completed*/
+static uint8_t isotp_send_consecutive_frame(isotp_session_t* session)
+{
+	/** Consecutive frame*/
+	uint8_t frame[CAN_FRAME_SIZE] = {PADDING_BYTE, PADDING_BYTE, PADDING_BYTE, PADDING_BYTE,
+									 PADDING_BYTE, PADDING_BYTE, PADDING_BYTE, PADDING_BYTE};
+	/** Bytes to be sent in this frame*/
+	uint16_t data_size = session->tx_length - session->tx_offset;
+	/** Counter to copy the data*/
+	uint8_t counter = INIT_VAL;
+
+	if(CF_MAX_DATA < data_size)
+	{
+		data_size = CF_MAX_DATA;
+	}
+
+	frame[PCI_POS] = PCI_CONSECUTIVE_FRAME | session->tx_sn;
+
+	/** Reads the data straight from the caller's buffer*/
+	for(counter = INIT_VAL ; counter < data_size ; counter ++)
+	{
+		frame[DATA_POS + counter] = session->tx_data[session->tx_offset + counter];
+	}
+
+	isotp_send_frame(session, frame);
+
+	session->tx_offset += data_size;
+	session->tx_sn = (session->tx_sn + FIRST_SEQUENCE_NUMBER) & SEQUENCE_NUMBER_MASK;
+
+	return (session->tx_offset >= session->tx_length) ? FLAG_SET : FLAG_CLEAR;
+}
+
+/** This function returns the number of the open session that receives an ID*/
+static uint8_t isotp_find_session(uint16_t rx_ID)
+{
+	/** Counter for the sessions, set to an invalid session if the ID is not found*/
+	uint8_t counter = INIT_VAL;
+
+	for(counter = INIT_VAL ; counter < ISOTP_MAX_SESSIONS ; counter ++)
+	{
+		if((SESSION_OPEN == isotp_session[counter].is_open) && (rx_ID == isotp_session[counter].config.rx_ID))
+		{
+			break;
+		}
+	}
+
+	return counter;
+}
+
+/*********************************************************************************************/
+
+/** This function initializes the ISO-TP layer*/
+void ISOTP_init(void)
+{
+	/** Counter for the sessions*/
+	uint8_t counter = INIT_VAL;
+
+	for(counter = INIT_VAL ; counter < ISOTP_MAX_SESSIONS ; counter ++)
+	{
+		isotp_session[counter].is_open = SESSION_CLOSED;
+		isotp_session[counter].tx_state = tx_idle;
+		isotp_session[counter].rx_state = rx_idle;
+	}
+
+	/** Creates the semaphore and the mutex*/
+	isotp_handler.sem_work = xSemaphoreCreateBinary();
+	isotp_handler.mutex = xSemaphoreCreateMutex();
+
+	/** Sets the handler as initialized*/
+	isotp_handler.init_val = IS_INIT;
+}
+
+/** This function opens an ISO-TP session*/
+ISOTP_status_t ISOTP_open_session(uint8_t session, ISOTP_session_config_t config)
+{
+	/** Sets the return value as successful*/
+	ISOTP_status_t retval = isotp_success;
+	/** Variable to add the rx ID to the ID function vector*/
+	ID_function_t ID_func;
+
+	if(ISOTP_MAX_SESSIONS <= session)
+	{
+		retval = isotp_invalid_session;
+	}
+
+	else if(SESSION_OPEN == isotp_session[session].is_open)
+	{
+		retval = isotp_session_open;
+	}
+
+	else
+	{
+		/** The rx ID is routed to the ISO-TP callback by the RX thread*/
+		ID_func.ID = config.rx_ID;
+		ID_func.ID_func = ISOTP_rx_callback;
+
+		if(ID_func_vector_success != rtos_add_ID_function(ID_func))
+		{
+			retval = isotp_ID_error;
+		}
+
+		else
+		{
+			xSemaphoreTake(isotp_handler.mutex, portMAX_DELAY);
+			isotp_session[session].config = config;
+			isotp_session[session].tx_state = tx_idle;
+			isotp_session[session].rx_state = rx_idle;
+			isotp_session[session].is_open = SESSION_OPEN;
+			xSemaphoreGive(isotp_handler.mutex);
+		}
+	}
+
+	return retval;
+}
+
+/** This function closes an ISO-TP session*/
+ISOTP_status_t ISOTP_close_session(uint8_t session)
+{
+	/** Sets the return value as successful*/
+	ISOTP_status_t retval = isotp_success;
+	/** Variable to remove the rx ID from the ID function vector*/
+	ID_function_t ID_func;
+
+	if(ISOTP_MAX_SESSIONS <= session)
+	{
+		retval = isotp_invalid_session;
+	}
+
+	else if(SESSION_OPEN != isotp_session[session].is_open)
+	{
+		retval = isotp_session_not_open;
+	}
+
+	else
+	{
+		xSemaphoreTake(isotp_handler.mutex, portMAX_DELAY);
+		isotp_session[session].is_open = SESSION_CLOSED;
+		isotp_session[session].tx_state = tx_idle;
+		isotp_session[session].rx_state = rx_idle;
+		xSemaphoreGive(isotp_handler.mutex);
+
+		ID_func.ID = isotp_session[session].config.rx_ID;
+		ID_func.ID_func = ISOTP_rx_callback;
+		rtos_remove_ID_function(ID_func);
+	}
+
+	return retval;
+}
+
+/** This function starts the transmission of a message*/
+ISOTP_status_t ISOTP_send(uint8_t session, const uint8_t* data, uint16_t length)
+{
+	/** Sets the return value as successful*/
+	ISOTP_status_t retval = isotp_success;
+	/** Variable for the single or first frame*/
+	uint8_t frame[CAN_FRAME_SIZE] = {PADDING_BYTE, PADDING_BYTE, PADDING_BYTE, PADDING_BYTE,
+									 PADDING_BYTE, PADDING_BYTE, PADDING_BYTE, PADDING_BYTE};
+	/** Counter to copy the data*/
+	uint8_t counter = INIT_VAL;
+	/** Flag to call the tx callback once the mutex is released*/
+	uint8_t notify_tx = FLAG_CLEAR;
+	/** Pointer to the session*/
+	isotp_session_t* current;
+
+	if(ISOTP_MAX_SESSIONS <= session)
+	{
+		return isotp_invalid_session;
+	}
+
+	current = &isotp_session[session];
+
+	if((INIT_VAL == length) || (ISOTP_MAX_MSG_SIZE < length))
+	{
+		return isotp_invalid_length;
+	}
+
+	xSemaphoreTake(isotp_handler.mutex, portMAX_DELAY);
+
+	if(SESSION_OPEN != current->is_open)
+	{
+		retval = isotp_session_not_open;
+	}
+
+	else if(tx_idle != current->tx_state)
+	{
+		retval = isotp_busy;
+	}
+
+	/** The message fits in a single frame*/
+	else if(SF_MAX_DATA >= length)
+	{
+		frame[PCI_POS] = PCI_SINGLE_FRAME | (uint8_t)length;
+
+		for(counter = INIT_VAL ; counter < length ; counter ++)
+		{
+			frame[DATA_POS + counter] = data[counter];
+		}
+
+		isotp_send_frame(current, frame);
+		notify_tx = FLAG_SET;
+	}
+
+	/** The message is segmented, the first frame is sent and the flow control is awaited*/
+	else
+	{
+		frame[PCI_POS] = PCI_FIRST_FRAME | (uint8_t)(length >> BYTE_SHIFT);
+		frame[FF_LENGTH_LOW_POS] = (uint8_t)(length & LOW_BYTE_MASK);
+
+		for(counter = INIT_VAL ; counter < FF_DATA ; counter ++)
+		{
+			frame[FF_DATA_POS + counter] = data[counter];
+		}
+
+		current->tx_data = data;
+		current->tx_length = length;
+		current->tx_offset = FF_DATA;
+		current->tx_sn = FIRST_SEQUENCE_NUMBER;
+		current->tx_deadline = xTaskGetTickCount() + (TickType_t)(N_BS_TIMEOUT * FIX_PERIOD);
+		current->tx_state = tx_wait_fc;
+
+		isotp_send_frame(current, frame);
+	}
+
+	xSemaphoreGive(isotp_handler.mutex);
+
+	if((FLAG_SET == notify_tx) && (NULL != current->config.tx_callback))
+	{
+		current->config.tx_callback(session, isotp_success);
+	}
+
+	/** Wakes up the thread to supervise the flow control timeout*/
+	if(isotp_success == retval)
+	{
+		xSemaphoreGive(isotp_handler.sem_work);
+	}
+
+	return retval;
+}
+
+/** This function sets the rx buffer of a session*/
+ISOTP_status_t ISOTP_set_rx_buffer(uint8_t session, uint8_t* buffer, uint16_t size)
+{
+	/** Sets the return value as successful*/
+	ISOTP_status_t retval = isotp_success;
+
+	if(ISOTP_MAX_SESSIONS <= session)
+	{
+		retval = isotp_invalid_session;
+	}
+
+	else
+	{
+		xSemaphoreTake(isotp_handler.mutex, portMAX_DELAY);
+
+		/** The buffer cannot be changed in the middle of a message*/
+		if(rx_idle != isotp_session[session].rx_state)
+		{
+			retval = isotp_busy;
+		}
+
+		else
+		{
+			isotp_session[session].config.rx_buffer = buffer;
+			isotp_session[session].config.rx_buffer_size = size;
+		}
+
+		xSemaphoreGive(isotp_handler.mutex);
+	}
+
+	return retval;
+}
+
+/** This function sets the block size and STmin of a session*/
+ISOTP_status_t ISOTP_set_flow_control(uint8_t session, uint8_t block_size, uint8_t st_min)
+{
+	/** Sets the return value as successful*/
+	ISOTP_status_t retval = isotp_success;
+
+	if(ISOTP_MAX_SESSIONS <= session)
+	{
+		retval = isotp_invalid_session;
+	}
+
+	else
+	{
+		xSemaphoreTake(isotp_handler.mutex, portMAX_DELAY);
+		isotp_session[session].config.block_size = block_size;
+		isotp_session[session].config.st_min = st_min;
+		xSemaphoreGive(isotp_handler.mutex);
+	}
+
+	return retval;
+}
+
+/** This function handles the frames received for the ISO-TP sessions*/
+void ISOTP_rx_callback(can_message_rx_config_t can_message_rx)
+{
+	/** Session that receives the ID*/
+	uint8_t session = isotp_find_session(can_message_rx.ID);
+	/** Pointer to the session*/
+	isotp_session_t* current;
+	/** Bytes of data in the frame*/
+	uint16_t data_size = INIT_VAL;
+	/** Counter to copy the data*/
+	uint8_t counter = INIT_VAL;
+	/** Flags to call the callbacks once the mutex is released*/
+	uint8_t notify_rx = FLAG_CLEAR;
+	uint8_t notify_tx = FLAG_CLEAR;
+	/** Status reported to the callbacks*/
+	ISOTP_status_t rx_status = isotp_success;
+	ISOTP_status_t tx_status = isotp_success;
+	/** Length reported to the rx callback*/
+	uint16_t rx_length = INIT_VAL;
+
+	/** The ID does not belong to any session, or the frame is empty*/
+	if((ISOTP_MAX_SESSIONS <= session) || (INIT_VAL == can_message_rx.DLC))
+	{
+		return;
+	}
+
+	current = &isotp_session[session];
+
+	xSemaphoreTake(isotp_handler.mutex, portMAX_DELAY);
+
+	switch(can_message_rx.msg[PCI_POS] & PCI_TYPE_MASK)
+	{
+		/** The whole message comes in this frame*/
+		case PCI_SINGLE_FRAME:
+			rx_length = can_message_rx.msg[PCI_POS] & PCI_NIBBLE_MASK;
+
+			/** Invalid lengths are ignored*/
+			if((INIT_VAL == rx_length) || (rx_length > (can_message_rx.DLC - DATA_POS)))
+			{
+				break;
+			}
+
+			/** A new message aborts the one being received*/
+			current->rx_state = rx_idle;
+			notify_rx = FLAG_SET;
+
+			if((NULL == current->config.rx_buffer) || (current->config.rx_buffer_size < rx_length))
+			{
+				rx_status = isotp_buffer_overflow;
+			}
+
+			else
+			{
+				for(counter = INIT_VAL ; counter < rx_length ; counter ++)
+				{
+					current->config.rx_buffer[counter] = can_message_rx.msg[DATA_POS + counter];
+				}
+			}
+		break;
+
+		/** First frame of a segmented message*/
+		case PCI_FIRST_FRAME:
+			rx_length = ((uint16_t)(can_message_rx.msg[PCI_POS] & PCI_NIBBLE_MASK) << BYTE_SHIFT) |
+						can_message_rx.msg[FF_LENGTH_LOW_POS];
+
+			/** Segmented messages are longer than a single frame*/
+			if((SF_MAX_DATA >= rx_length) || (CAN_FRAME_SIZE > can_message_rx.DLC))
+			{
+				break;
+			}
+
+			current->rx_state = rx_idle;
+
+			/** The other node is told that the message does not fit*/
+			if((NULL == current->config.rx_buffer) || (current->config.rx_buffer_size < rx_length))
+			{
+				isotp_send_flow_control(current, FS_OVERFLOW);
+				rx_status = isotp_buffer_overflow;
+				notify_rx = FLAG_SET;
+			}
+
+			else
+			{
+				for(counter = INIT_VAL ; counter < FF_DATA ; counter ++)
+				{
+					current->config.rx_buffer[counter] = can_message_rx.msg[FF_DATA_POS + counter];
+				}
+
+				current->rx_length = rx_length;
+				current->rx_offset = FF_DATA;
+				current->rx_sn = FIRST_SEQUENCE_NUMBER;
+				current->rx_bs_count = INIT_VAL;
+				current->rx_deadline = xTaskGetTickCount() + (TickType_t)(N_CR_TIMEOUT * FIX_PERIOD);
+				current->rx_state = rx_receiving_cf;
+
+				isotp_send_flow_control(current, FS_CONTINUE_TO_SEND);
+			}
+		break;
+
+		/** Next part of the message being received*/
+		case PCI_CONSECUTIVE_FRAME:
+			if(rx_receiving_cf != current->rx_state)
+			{
+				break;
+			}
+
+			if((can_message_rx.msg[PCI_POS] & SEQUENCE_NUMBER_MASK) != current->rx_sn)
+			{
+				current->rx_state = rx_idle;
+				rx_status = isotp_wrong_sequence;
+				rx_length = current->rx_offset;
+				notify_rx = FLAG_SET;
+				break;
+			}
+
+			data_size = current->rx_length - current->rx_offset;
+
+			if(CF_MAX_DATA < data_size)
+			{
+				data_size = CF_MAX_DATA;
+			}
+
+			/** Only the last consecutive frame can be shorter, otherwise the offset would lose sync*/
+			if(data_size > (can_message_rx.DLC - DATA_POS))
+			{
+				current->rx_state = rx_idle;
+				rx_status = isotp_invalid_frame;
+				rx_length = current->rx_offset;
+				notify_rx = FLAG_SET;
+				break;
+			}
+
+			/** Writes the data straight into the caller's buffer*/
+			for(counter = INIT_VAL ; counter < data_size ; counter ++)
+			{
+				current->config.rx_buffer[current->rx_offset + counter] = can_message_rx.msg[DATA_POS + counter];
+			}
+
+			current->rx_offset += data_size;
+			current->rx_sn = (current->rx_sn + FIRST_SEQUENCE_NUMBER) & SEQUENCE_NUMBER_MASK;
+			current->rx_deadline = xTaskGetTickCount() + (TickType_t)(N_CR_TIMEOUT * FIX_PERIOD);
+
+			/** The message is complete*/
+			if(current->rx_offset >= current->rx_length)
+			{
+				current->rx_state = rx_idle;
+				rx_length = current->rx_length;
+				notify_rx = FLAG_SET;
+			}
+
+			/** The block is complete, the other node waits for a new flow control*/
+			else if(ISOTP_BS_UNLIMITED != current->config.block_size)
+			{
+				current->rx_bs_count ++;
+
+				if(current->config.block_size <= current->rx_bs_count)
+				{
+					current->rx_bs_count = INIT_VAL;
+					isotp_send_flow_control(current, FS_CONTINUE_TO_SEND);
+				}
+			}
+		break;
+
+		/** Flow control of the message being sent*/
+		case PCI_FLOW_CONTROL:
+			if((tx_wait_fc != current->tx_state) || (FC_SIZE > can_message_rx.DLC))
+			{
+				break;
+			}
+
+			switch(can_message_rx.msg[PCI_POS] & PCI_NIBBLE_MASK)
+			{
+				case FS_CONTINUE_TO_SEND:
+					current->tx_bs = can_message_rx.msg[FC_BS_POS];
+					current->tx_bs_count = INIT_VAL;
+					current->tx_st_min = isotp_st_min_to_ticks(can_message_rx.msg[FC_STMIN_POS]);
+					current->tx_next_tick = xTaskGetTickCount();
+					current->tx_state = tx_sending_cf;
+				break;
+
+				case FS_WAIT:
+					current->tx_deadline = xTaskGetTickCount() + (TickType_t)(N_BS_TIMEOUT * FIX_PERIOD);
+				break;
+
+				/** Overflow or invalid flow status*/
+				default:
+					current->tx_state = tx_idle;
+					tx_status = isotp_aborted;
+					notify_tx = FLAG_SET;
+				break;
+			}
+		break;
+
+		/** Unknown PCI*/
+		default:
+		break;
+	}
+
+	xSemaphoreGive(isotp_handler.mutex);
+
+	if((FLAG_SET == notify_rx) && (NULL != current->config.rx_callback))
+	{
+		current->config.rx_callback(session, current->config.rx_buffer, rx_length, rx_status);
+	}
+
+	if((FLAG_SET == notify_tx) && (NULL != current->config.tx_callback))
+	{
+		current->config.tx_callback(session, tx_status);
+	}
+
+	/** Wakes up the thread to send the consecutive frames or to supervise the timeouts*/
+	xSemaphoreGive(isotp_handler.sem_work);
+}
+
+/** This thread sends the consecutive frames and checks the timeouts of all the sessions*/
+void ISOTP_thread(void* args)
+{
+	/** Ticks to wait until the next consecutive frame or timeout*/
+	TickType_t wait_ticks = portMAX_DELAY;
+	/** Variable for the current tick count*/
+	TickType_t now;
+	/** Ticks remaining for an event of a session*/
+	TickType_t remaining;
+	/** Counter for the sessions*/
+	uint8_t session = INIT_VAL;
+	/** Whether any frame was sent in the last round*/
+	uint8_t frame_sent = FLAG_CLEAR;
+	/** Flags to call the callbacks once the mutex is released*/
+	uint8_t notify_rx = FLAG_CLEAR;
+	uint8_t notify_tx = FLAG_CLEAR;
+	/** Status reported to the tx callback*/
+	ISOTP_status_t tx_status = isotp_success;
+	/** Pointer to the session*/
+	isotp_session_t* current;
+
+	/** If the ISO-TP handler has been initialized*/
+	if(IS_INIT == isotp_handler.init_val)
+	{
+		/** Infinite cycle*/
+		for(;;)
+		{
+			/** Waits for a frame or for the next event of the sessions*/
+			xSemaphoreTake(isotp_handler.sem_work, wait_ticks);
+
+			/** Serves the sessions in round robin while any of them can send a frame right away*/
+			do
+			{
+				frame_sent = FLAG_CLEAR;
+				wait_ticks = portMAX_DELAY;
+
+				for(session = INIT_VAL ; session < ISOTP_MAX_SESSIONS ; session ++)
+				{
+					current = &isotp_session[session];
+					notify_rx = FLAG_CLEAR;
+					notify_tx = FLAG_CLEAR;
+
+					/** The mutex is taken per session so the RX thread can handle flow controls in between*/
+					xSemaphoreTake(isotp_handler.mutex, portMAX_DELAY);
+					now = xTaskGetTickCount();
+
+					/** The consecutive frame did not arrive in time*/
+					if((rx_receiving_cf == current->rx_state) && isotp_tick_reached(now, current->rx_deadline))
+					{
+						current->rx_state = rx_idle;
+						notify_rx = FLAG_SET;
+					}
+
+					/** The flow control did not arrive in time*/
+					if((tx_wait_fc == current->tx_state) && isotp_tick_reached(now, current->tx_deadline))
+					{
+						current->tx_state = tx_idle;
+						tx_status = isotp_timeout;
+						notify_tx = FLAG_SET;
+					}
+
+					/** STmin has passed since the last consecutive frame*/
+					if((tx_sending_cf == current->tx_state) && isotp_tick_reached(now, current->tx_next_tick))
+					{
+						frame_sent = FLAG_SET;
+
+						if(isotp_send_consecutive_frame(current))
+						{
+							current->tx_state = tx_idle;
+							tx_status = isotp_success;
+							notify_tx = FLAG_SET;
+						}
+
+						/** The block is complete, waits for the next flow control*/
+						else if((ISOTP_BS_UNLIMITED != current->tx_bs) && (current->tx_bs <= ++ current->tx_bs_count))
+						{
+							current->tx_deadline = now + (TickType_t)(N_BS_TIMEOUT * FIX_PERIOD);
+							current->tx_state = tx_wait_fc;
+						}
+
+						else
+						{
+							current->tx_next_tick = now + current->tx_st_min;
+						}
+					}
+
+					/** Computes the time until the next event of the session*/
+					if(rx_receiving_cf == current->rx_state)
+					{
+						remaining = current->rx_deadline - now;
+						wait_ticks = (remaining < wait_ticks) ? remaining : wait_ticks;
+					}
+
+					if(tx_wait_fc == current->tx_state)
+					{
+						remaining = current->tx_deadline - now;
+						wait_ticks = (remaining < wait_ticks) ? remaining : wait_ticks;
+					}
+
+					else if(tx_sending_cf == current->tx_state)
+					{
+						remaining = isotp_tick_reached(now, current->tx_next_tick) ? INIT_VAL : (current->tx_next_tick - now);
+						wait_ticks = (remaining < wait_ticks) ? remaining : wait_ticks;
+					}
+
+					xSemaphoreGive(isotp_handler.mutex);
+
+					if((FLAG_SET == notify_rx) && (NULL != current->config.rx_callback))
+					{
+						current->config.rx_callback(session, current->config.rx_buffer, current->rx_offset, isotp_timeout);
+					}
+
+					if((FLAG_SET == notify_tx) && (NULL != current->config.tx_callback))
+					{
+						current->config.tx_callback(session, tx_status);
+					}
+				}
+			}while(FLAG_SET == frame_sent);
+		}
+	}
+}
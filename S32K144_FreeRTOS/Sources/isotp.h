@@ -0,0 +1,165 @@
+/*!
+ 	 \file isotp.h
+
+ 	 \brief This is the header file of the ISO-TP (ISO 15765-2) transport layer.
+ 	 	 	 It segments payloads of up to 4095 bytes into CAN frames on top of
+ 	 	 	 rtos_can_transmit and the ID function vector of the RTOS CAN driver.
+
+ 	 \note Data is streamed straight from the caller's tx buffer and straight into
+ 	 	 	 the caller's rx buffer, the layer does not keep intermediate copies.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef ISOTP_H_
+#define ISOTP_H_
+
+#include "rtos_driver.h"
+
+/** Defines the number of sessions that can be open at the same time*/
+#define ISOTP_MAX_SESSIONS					(4)
+/** Defines the maximum payload of a single ISO-TP message*/
+#define ISOTP_MAX_MSG_SIZE					(4095)
+
+/** Defines a block size of 0 (The sender never waits for another flow control)*/
+#define ISOTP_BS_UNLIMITED					(0x00)
+/** Defines a STmin of 0 (Consecutive frames are sent back to back)*/
+#define ISOTP_STMIN_NONE					(0x00)
+/** Defines the default block size: a block fits in the Rx FIFO, so it is queued even if the RX thread is late*/
+#define ISOTP_BS_DEFAULT					(CAN_RX_FIFO_DEPTH)
+/** Defines the default STmin: the block size already bounds the frames in flight, so they are sent back to back*/
+#define ISOTP_STMIN_DEFAULT					(ISOTP_STMIN_NONE)
+
+/*!
+ 	 \brief Enumerator to define the status of an ISO-TP operation.
+ */
+typedef enum
+{
+	isotp_success,			/*!< Operation successful*/
+	isotp_busy,				/*!< The session is already transmitting or receiving*/
+	isotp_invalid_session,	/*!< The session number is out of range*/
+	isotp_session_not_open,	/*!< The session has not been opened*/
+	isotp_session_open,		/*!< The session is already open*/
+	isotp_ID_error,			/*!< The rx ID could not be added to the ID function vector*/
+	isotp_invalid_length,	/*!< The length is 0 or higher than ISOTP_MAX_MSG_SIZE*/
+	isotp_buffer_overflow,	/*!< The message does not fit in the rx buffer*/
+	isotp_wrong_sequence,	/*!< A consecutive frame was received out of sequence*/
+	isotp_timeout,			/*!< The other node stopped answering (N_Bs or N_Cr)*/
+	isotp_aborted,			/*!< The other node reported an overflow in its flow control*/
+	isotp_invalid_frame		/*!< A consecutive frame that is not the last one is shorter than 8 bytes*/
+}ISOTP_status_t;
+
+/*!
+ 	 \brief Configuration of an ISO-TP session.
+ */
+typedef struct
+{
+	CAN_Type* base;			/*!< CAN used by the session*/
+	uint16_t tx_ID;			/*!< ID used to transmit the frames of the session*/
+	uint16_t rx_ID;			/*!< ID used by the other node to transmit to this session*/
+	uint8_t block_size;		/*!< Block size sent in the flow control (0 = unlimited, ISOTP_BS_DEFAULT recommended)*/
+	uint8_t st_min;			/*!< STmin sent in the flow control (ISO 15765-2 encoding, ISOTP_STMIN_DEFAULT recommended)*/
+	uint8_t* rx_buffer;		/*!< Buffer where the received payloads are written*/
+	uint16_t rx_buffer_size;/*!< Size of the rx buffer*/
+	void (*rx_callback)(uint8_t session, uint8_t* data, uint16_t length, ISOTP_status_t status);	/*!< Called when a reception ends*/
+	void (*tx_callback)(uint8_t session, ISOTP_status_t status);									/*!< Called when a transmission ends*/
+}ISOTP_session_config_t;
+
+/*!
+ 	 \brief This function initializes the semaphore and the mutex of the ISO-TP layer.
+
+ 	 \note Call it before opening any session and before creating ISOTP_thread.
+
+ 	 \return void.
+ */
+void ISOTP_init(void);
+
+/*!
+ 	 \brief This function opens a session, and adds its rx ID to the ID function vector.
+
+ 	 \param[in] session Number of the session, from 0 to ISOTP_MAX_SESSIONS - 1.
+ 	 \param[in] config Configuration of the session.
+
+ 	 \return Whether the session was opened or the reason why it was not.
+ */
+ISOTP_status_t ISOTP_open_session(uint8_t session, ISOTP_session_config_t config);
+
+/*!
+ 	 \brief This function closes a session and removes its rx ID from the ID function vector.
+
+ 	 \note Any transmission or reception in progress is dropped without calling the callbacks.
+
+ 	 \param[in] session Number of the session to be closed.
+
+ 	 \return Whether the session was closed or the reason why it was not.
+ */
+ISOTP_status_t ISOTP_close_session(uint8_t session);
+
+/*!
+ 	 \brief This function starts the transmission of a message.
+
+ 	 \note The data is read straight from the buffer while the message is being sent,
+ 	 	 	 so it must not be modified until the tx callback is called.
+
+ 	 \param[in] session Session from which the message will be sent.
+ 	 \param[in] data Payload to be sent.
+ 	 \param[in] length Size of the payload, from 1 to ISOTP_MAX_MSG_SIZE.
+
+ 	 \return Whether the transmission started or the reason why it did not.
+ */
+ISOTP_status_t ISOTP_send(uint8_t session, const uint8_t* data, uint16_t length);
+
+/*!
+ 	 \brief This function sets the buffer where the next messages of a session will be received.
+
+ 	 \note Use it from the rx callback to swap buffers (e.g. double buffering), the
+ 	 	 	 new buffer is used starting on the next first frame.
+
+ 	 \param[in] session Session whose rx buffer will be changed.
+ 	 \param[in] buffer New rx buffer.
+ 	 \param[in] size Size of the new rx buffer.
+
+ 	 \return Whether the buffer was changed or the reason why it was not.
+ */
+ISOTP_status_t ISOTP_set_rx_buffer(uint8_t session, uint8_t* buffer, uint16_t size);
+
+/*!
+ 	 \brief This function changes the block size and STmin sent in the flow control of a session.
+
+ 	 \param[in] session Session to be tuned.
+ 	 \param[in] block_size Consecutive frames between flow controls (0 = unlimited).
+ 	 \param[in] st_min Minimum separation time between consecutive frames (ISO 15765-2 encoding).
+
+ 	 \return Whether the values were changed or the reason why they were not.
+ */
+ISOTP_status_t ISOTP_set_flow_control(uint8_t session, uint8_t block_size, uint8_t st_min);
+
+/*!
+ 	 \brief This function is the callback added to the ID function vector for the rx IDs
+ 	 	 	 of the open sessions. It handles single, first, consecutive and flow control frames.
+
+ 	 \param[in] can_message_rx Message received.
+
+ 	 \return void.
+ */
+void ISOTP_rx_callback(can_message_rx_config_t can_message_rx);
+
+/*!
+ 	 \brief This thread sends the consecutive frames of all the sessions, respecting
+ 	 	 	 the block size and STmin of the other node, and checks the timeouts.
+
+ 	 \note Sessions are served in round robin, one consecutive frame each, so several
+ 	 	 	 transfers can run at the same time.
+
+ 	 \param[in] args Thread arguments. Set to NULL.
+
+ 	 \return void.
+ */
+void ISOTP_thread(void* args);
+
+#endif /* ISOTP_H_ */
@@ -59,8 +59,21 @@
 #include "S32K144.h"
 
 #include "transceiver.h"
-#include "clocks_and_modes.h"
 #include "rtos_driver.h"
+#include "isotp.h"
+#include "xcp.h"
+#include "bootloader.h"
+#include "ftfc_flash.h"
+#include "tsync.h"
+#include "can_stats.h"
+#include "boot_profile.h"
+#include "pin_batches.h"
+#include "speed_control.h"
+#include "adc_scan.h"
+#include "can_signals.h"
+#include "clock_policy.h"
+#include "code_cache.h"
+#include "code_bench.h"
 #include "task.h"
 
 volatile int exit_code = 0;
@@ -71,6 +84,10 @@ volatile int exit_code = 0;
 
 /** ID for the SW3 message*/
 #define SW3_MSG_ID				(0x30)
+/** ID for the analog zone message*/
+#define ZONE_MSG_ID				(0x31)
+/** ADC1 channel of the analog zones (ADC1_SE2, PTD2)*/
+#define ZONE_ADC_CHANNEL		(2)
 /** ID for the periodic tx message*/
 #define PERIODIC_MSG_ID			(0x40)
 /** ID for the RX callback*/
@@ -82,12 +99,81 @@ volatile int exit_code = 0;
 #define SPEED_THREAD_PRIO		(4)
 /** TX thread priority*/
 #define TX_THREAD_PRIO			(5)
+/** ISO-TP thread priority*/
+#define ISOTP_THREAD_PRIO		(2)
+/** Bootloader thread priority (Lowest, the blocks are received while it programs)*/
+#define BL_THREAD_PRIO			(1)
+/** Time sync thread priority*/
+#define TSYNC_THREAD_PRIO		(2)
+/** CAN statistics thread priority*/
+#define CAN_STATS_THREAD_PRIO	(2)
+/** Speed control thread priority (Highest, so the period has no jitter)*/
+#define SPEED_CTRL_THREAD_PRIO	(6)
+/** XCP sender thread priority (Lowest, the events only queue the DAQ frames)*/
+#define XCP_THREAD_PRIO			(1)
+/** Clock policy thread priority (Highest, so the load is measured even when the CPU is saturated)*/
+#define CLOCK_POLICY_THREAD_PRIO	(7)
 
 /** Period for the TX thread*/
 #define TX_THREAD_PERIOD		(1000)
-/** Period for the ADC thread*/
-#define SPEED_THREAD_PERIOD		(250)
+/** Period for the ADC thread (The tx policy decides which samples are sent)*/
+#define SPEED_THREAD_PERIOD		(50)
 
+/** ISO-TP session used for the multi-frame messages*/
+#define ISOTP_SESSION			(0)
+/** ID used to transmit the ISO-TP messages*/
+#define ISOTP_TX_ID				(0x7E8)
+/** ID used to receive the ISO-TP messages*/
+#define ISOTP_RX_ID				(0x7E0)
+/** Size of the buffer for the ISO-TP messages*/
+#define ISOTP_RX_BUFFER_SIZE	(1024)
+
+/** Bit rate of the bus*/
+#define CAN_BIT_RATE			(500000U)
+
+/** Role of this node in the time synchronization (Only one node of the bus is the master)*/
+#define TSYNC_NODE_ROLE			(tsync_slave)
+
+/** Buffer where the ISO-TP messages are received*/
+static uint8_t isotp_rx_buffer[ISOTP_RX_BUFFER_SIZE];
+
+/** Hardware of the motor (Another motor needs its own FTMs, and the current scan follows only one)*/
+static const MC_config_t motor_config =
+{
+	INST_FLEXTIMER1,		/* Forward PWM, FTM 0 */
+	&flexTimer1_PwmConfig,
+	INST_FLEXTIMER2,		/* Reverse PWM, FTM 1 */
+	&flexTimer2_PwmConfig,
+	PWM_CHANNEL,
+	INST_FLEXTIMER3,		/* Encoder, FTM 2 */
+	IC_CHANNEL,				/* Phase A on PTC5 */
+	true					/* Current scan */
+};
+/** Motor*/
+static MC_motor_t motor;
+/** Control loop of the motor*/
+static SPEED_CTRL_t motor_ctrl;
+/** Name of the thread or step that stopped the boot (Read it with the debugger)*/
+static const char* volatile boot_failure = NULL;
+
+
+/** This function stops the boot, the motor stays stopped and no thread runs*/
+static void boot_halt(const char* failure)
+{
+	boot_failure = failure;
+	INT_SYS_DisableIRQGlobal();
+
+	for(;;);
+}
+
+/** This function creates a thread, the boot stops if the heap cannot hold it (configTOTAL_HEAP_SIZE)*/
+static void create_thread(const char* name, void (*thread)(void* pvParameters), void* arg, int priority)
+{
+	if(NULL == sys_thread_new(name, thread, arg, configMINIMAL_STACK_SIZE, priority))
+	{
+		boot_halt(name);
+	}
+}
 
 /** Test callback function*/
 void test_function(can_message_rx_config_t can_message_rx)
@@ -123,6 +209,10 @@ int main(void)
 	can_message_tx_config_t tx_msg_init;
 	/** Periodic message structure*/
 	static can_message_tx_config_t periodic_msg;
+	/** ISO-TP session configuration*/
+	ISOTP_session_config_t isotp_config;
+	/** CAN identity of the motor*/
+	rtos_motor_t motor_can;
 
 	/* Variables used to store PWM duty cycle */
 	ftm_state_t ftmStateStruct_ftm0;
@@ -134,6 +224,12 @@ int main(void)
 #endif
 	/*** End of Processor Expert internal initialization.                    ***/
 
+	/** The boot profiler runs from the reset (BOOT_PROFILE_start)*/
+	BOOT_PROFILE_mark(boot_profile_main);
+
+	/** The flash is read through the code cache, the flash driver invalidates what it erases and programs*/
+	CODE_CACHE_enable();
+
 	/*********************** NOTE *******************************************/
 	/** This module is taken from the driver example ftm_signale_measurement*/
 	/************************************************************************/
@@ -141,13 +237,19 @@ int main(void)
 	/* Initialize and configure clocks
 	 *  -   see clock manager component for details
 	 */
-	CLOCK_SYS_Init(g_clockManConfigsArr, CLOCK_MANAGER_CONFIG_CNT,
-			g_clockManCallbacksArr, CLOCK_MANAGER_CALLBACK_CNT);
-	CLOCK_SYS_UpdateConfiguration(0U, CLOCK_MANAGER_POLICY_AGREEMENT);
+	/** The clock manager has the levels of the clock policy, it starts in RUN (clockMan1_InitConfig0)*/
+	CLOCK_POLICY_init(CAN0);
+	BOOT_PROFILE_mark(boot_profile_clocks);
 	/* Initialize pins
 	 *  -   See PinSettings component for more info
+	 *  -   The pins of the component are written in batches (Host/pin_codegen.py)
 	 */
-	PINS_DRV_Init(NUM_OF_CONFIGURED_PINS, g_pin_mux_InitConfigArr);
+	PIN_BATCH_init(&pin_batches_config);
+	BOOT_PROFILE_mark(boot_profile_pins);
+
+	/** Starts the SBC configuration and the FlexCAN freeze mode, they get ready during the init below*/
+	rtos_can_start(CAN0);
+	BOOT_PROFILE_mark(boot_profile_can_start);
 
 	/* Initialize FTM PWM channel 0 PTD15
 	 *  -   See ftm component for more info
@@ -157,16 +259,26 @@ int main(void)
 	FTM_DRV_Init(INST_FLEXTIMER3, &flexTimer3_InitConfig, &ftmStateStruct_ftm2);
 
 	/* Initialize FTM PWM channel */
-	FTM_DRV_InitPwm(INST_FLEXTIMER1, &flexTimer2_PwmConfig);
-	FTM_DRV_InitPwm(INST_FLEXTIMER2, &flexTimer2_PwmConfig);
+	FTM_DRV_InitPwm(motor_config.forward_instance, motor_config.forward_pwm);
+	FTM_DRV_InitPwm(motor_config.reverse_instance, motor_config.reverse_pwm);
 
-	/* Setup input capture for FTM 2 channel 0  - PTC5 */
-	FTM_DRV_InitInputCapture(INST_FLEXTIMER3, &flexTimer3_InputCaptureConfig);
+	/** Starts the motor stopped, with the feedback of its encoder (Quadrature decoder or input capture)*/
+	MC_init(&motor, &motor_config);
+	/** The FTMs of the motor run from the system clock in VLPR*/
+	CLOCK_POLICY_set_motor(&motor);
 
-	FTM_DRV_UpdatePwmChannel(INST_FLEXTIMER1, PWM_CHANNEL, FTM_PWM_UPDATE_IN_DUTY_CYCLE, DUTY_CYCLE_INV, PWM_EDGE, true);
-	FTM_DRV_UpdatePwmChannel(INST_FLEXTIMER2, PWM_CHANNEL, FTM_PWM_UPDATE_IN_DUTY_CYCLE, DUTY_CYCLE_INV, PWM_EDGE, true);
+	FTM_DRV_UpdatePwmChannel(motor_config.forward_instance, motor_config.pwm_channel, FTM_PWM_UPDATE_IN_DUTY_CYCLE, DUTY_CYCLE_INV, PWM_EDGE, true);
+	FTM_DRV_UpdatePwmChannel(motor_config.reverse_instance, motor_config.pwm_channel, FTM_PWM_UPDATE_IN_DUTY_CYCLE, DUTY_CYCLE_INV, PWM_EDGE, true);
 
 	/** To here *******************************************************************************/
+	BOOT_PROFILE_mark(boot_profile_motor);
+
+	/** Starts the scan of the current and the potentiometer, triggered by the PWM (The boot stops if the ADC does not calibrate)*/
+	if(STATUS_SUCCESS != ADC_SCAN_init(flexTimer2_PwmConfig.uFrequencyHZ))
+	{
+		boot_halt("ADC_SCAN");
+	}
+	BOOT_PROFILE_mark(boot_profile_adc_scan);
 
 	/** Sets the base and the speed for CAN*/
 	can_init.base = CAN0;
@@ -195,35 +307,111 @@ int main(void)
 	/** Adds the RX ID and function*/
 	rtos_add_ID_function(test_ID_func);
 
+	/** Sets the ISO-TP session (A block of consecutive frames fits in the Rx FIFO)*/
+	isotp_config.base = CAN0;
+	isotp_config.tx_ID = ISOTP_TX_ID;
+	isotp_config.rx_ID = ISOTP_RX_ID;
+	isotp_config.block_size = ISOTP_BS_DEFAULT;
+	isotp_config.st_min = ISOTP_STMIN_DEFAULT;
+	isotp_config.rx_buffer = isotp_rx_buffer;
+	isotp_config.rx_buffer_size = sizeof(isotp_rx_buffer);
+	isotp_config.rx_callback = NULL;
+	isotp_config.tx_callback = NULL;
+
+	/** Initializes the ISO-TP layer and opens its session*/
+	ISOTP_init();
+	ISOTP_open_session(ISOTP_SESSION, isotp_config);
+
+	/** Initializes the control loop of the motor with the default gains*/
+	SPEED_CTRL_init(&motor_ctrl, &motor, XCP_EVENT_CONTROL_LOOP, NULL);
+
+	/** Sets the CAN identity of the motor*/
+	motor_can.rx_ID = CAN_SIG_SPEED_RX_ID;
+	motor_can.tx_ID = CAN_SIG_SPEED_TX_ID;
+	motor_can.motor = &motor;
+	motor_can.control = &motor_ctrl;
+	rtos_add_motor(motor_can);
+
+	/** Initializes the XCP slave (Measurement and calibration)*/
+	XCP_init(CAN0, XCP_CRO_ID, XCP_DTO_ID);
+
+	/** Initializes the bootloader on the program flash*/
+	BL_init(CAN0, FTFC_get_flash_if());
+
+	/** Initializes the time synchronization*/
+	TSYNC_init(CAN0, TSYNC_NODE_ROLE, TSYNC_BIT_TIME_500KBPS_NS);
+	BOOT_PROFILE_mark(boot_profile_services);
+
 	/** Sets the periods for tx and speed threads*/
 	set_tx_thread_period(TX_THREAD_PERIOD);
 	set_speed_tx_thread_period(SPEED_THREAD_PERIOD);
 
-	/** Initializes the rtos can*/
-	rtos_can_init(can_init);
+	/** Initializes the rtos can (The boot stops if the FlexCAN does not leave the freeze mode)*/
+	if(STATUS_SUCCESS != rtos_can_init(can_init))
+	{
+		boot_halt("CAN");
+	}
+	BOOT_PROFILE_mark(boot_profile_can);
 
+	/** Starts the monitor of the analog zones (Only the zone changes wake the tx thread)*/
+	rtos_zone_init(ZONE_MSG_ID, ZONE_ADC_CHANNEL);
+	BOOT_PROFILE_mark(boot_profile_zone);
+
+	/** Initializes the bus statistics once the CAN timer runs (Call CAN_STATS_set_broadcast to publish them)*/
+	CAN_STATS_init(CAN0, CAN_BIT_RATE);
+
+	/** The 10 threads take 9 KB of the heap, the idle and timer threads with the queues and semaphores 2.4 KB more*/
 	/** Creates the TX thread by interrupt*/
-	sys_thread_new("TX_interrupt_thread", rtos_can_tx_thread_EG, NULL, configMINIMAL_STACK_SIZE, TX_THREAD_PRIO);
+	create_thread("TX_interrupt_thread", rtos_can_tx_thread_EG, NULL, TX_THREAD_PRIO);
+
+	/** Creates the ISO-TP thread*/
+	create_thread("ISOTP", ISOTP_thread, NULL, ISOTP_THREAD_PRIO);
+
+	/** Creates the bootloader thread*/
+	create_thread("BL", BL_thread, NULL, BL_THREAD_PRIO);
+
+	/** Creates the XCP sender thread*/
+	create_thread("XCP", XCP_thread, NULL, XCP_THREAD_PRIO);
+
+	/** Creates the time sync thread*/
+	create_thread("TSYNC", TSYNC_thread, NULL, TSYNC_THREAD_PRIO);
+
+	/** Creates the CAN statistics thread*/
+	create_thread("CAN_STATS", CAN_STATS_thread, NULL, CAN_STATS_THREAD_PRIO);
+
+	/** Creates the speed control thread (In open loop it runs the motion profile)*/
+	create_thread("SPEED_CTRL", SPEED_CTRL_thread, &motor_ctrl, SPEED_CTRL_THREAD_PRIO);
+
+	/** Creates the clock policy thread*/
+	create_thread("CLOCK", CLOCK_POLICY_thread, NULL, CLOCK_POLICY_THREAD_PRIO);
 
 	/*******************************************************************************************************************/
-	/** NOTE: To test both the periodic RX and the RX by interrupt, please the value of RX_MODE, found in rtos_driver.h*/
+	/** NOTE: The RX thread starts in RX_MODE (rtos_driver.h), set_rx_mode switches between the modes at runtime*/
 	/*******************************************************************************************************************/
-#if(!RX_MODE)
-	/** Creates the RX thread by interrupt*/
-	sys_thread_new("RX", rtos_can_rx_thread_interruption, NULL, configMINIMAL_STACK_SIZE, RX_THREAD_PRIO);
-#endif
-#if(RX_MODE)
-	/** Creates the RX periodic thread*/
-	sys_thread_new("RX", rtos_can_rx_thread_periodic, NULL, configMINIMAL_STACK_SIZE, RX_THREAD_PRIO);
-#endif
+	/** Creates the RX thread (Interruption, periodic or adaptive)*/
+	create_thread("RX", rtos_can_rx_thread, NULL, RX_THREAD_PRIO);
 
 	/** Creates the ADC thread*/
-	sys_thread_new("Speed", rtos_speed_read_thread, NULL, configMINIMAL_STACK_SIZE, SPEED_THREAD_PRIO);
+	create_thread("Speed", rtos_speed_read_thread, NULL, SPEED_THREAD_PRIO);
+
+	BOOT_PROFILE_mark(boot_profile_threads);
+
+#ifdef CODE_BENCH_ENABLE
+	/** Measures the hot paths and the control loop with the code cache disabled and enabled (code_bench.h)*/
+	CODE_BENCH_run();
+#endif
+
+#ifdef INT_SYS_PROFILING
+	/** The kernel tick is linked in the vector table, it is wrapped to be profiled (INT_SYS_GetProfile)*/
+	INT_SYS_ProfileIRQ(SysTick_IRQn);
+	INT_SYS_ClearProfiles();
+#endif
 
 	/* Start the tasks and timer running. */
 	vTaskStartScheduler();
 
-	for(;;);
+	/** The scheduler only returns when the heap cannot hold the idle and timer threads*/
+	boot_halt("scheduler");
 
     /* Variables used to store PWM frequency,
      * input capture measurement value
@@ -0,0 +1,146 @@
+/*!
+ 	 \file motion_profile.c
+
+ 	 \brief This is the source file of the fixed point motion profile of the speed.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include "motion_profile.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL							(0)
+/** Defines the half of the fractional bits, to round*/
+#define FRAC_HALF							(1 << (MOTION_PROFILE_FRAC_BITS - 1))
+
+/*!
+ 	 \brief This function returns the speed still gained while an acceleration is
+ 	 	 	 taken to 0, reducing it by the jerk on every update.
+
+ 	 \param[in] accel Acceleration.
+ 	 \param[in] jerk Jerk limit (Not 0).
+
+ 	 \return Speed gained, with the sign of the acceleration.
+ */
+static int64_t motion_profile_brake(int32_t accel, int32_t jerk);
+
+/*!
+ 	 \brief This function limits an acceleration.
+
+ 	 \param[in] accel Acceleration to be limited.
+ 	 \param[in] max Limit of both directions.
+
+ 	 \return The limited acceleration.
+ */
+static inline int32_t motion_profile_clamp(int64_t accel, int32_t max);
+
+/** This function initializes a profile*/
+void MOTION_PROFILE_init(MOTION_PROFILE_t* profile, const MOTION_PROFILE_config_t* config)
+{
+	profile->config = *config;
+	MOTION_PROFILE_reset(profile, INIT_VAL);
+}
+
+/** This function restarts a profile*/
+void MOTION_PROFILE_reset(MOTION_PROFILE_t* profile, int16_t speed)
+{
+	profile->target = speed;
+	profile->speed = (int32_t)speed * (1 << MOTION_PROFILE_FRAC_BITS);
+	profile->accel = INIT_VAL;
+}
+
+/** This function sets the target of a profile*/
+void MOTION_PROFILE_set_target(MOTION_PROFILE_t* profile, int16_t target)
+{
+	profile->target = target;
+}
+
+/** This function executes one step of the profile*/
+int16_t MOTION_PROFILE_update(MOTION_PROFILE_t* profile)
+{
+	/** Limits of this step*/
+	int32_t accel_max = profile->config.accel_max;
+	int32_t jerk = profile->config.jerk_max;
+	/** Speed left to the target*/
+	int64_t error = ((int64_t)profile->target * (1 << MOTION_PROFILE_FRAC_BITS)) - profile->speed;
+	/** Direction of the target (1 or -1)*/
+	int32_t direction = (INIT_VAL > error) ? -1 : 1;
+	/** Acceleration with one more jerk towards the target*/
+	int32_t accel_up;
+
+	/** Without limits the speed is the target*/
+	if(INIT_VAL >= accel_max)
+	{
+		MOTION_PROFILE_reset(profile, profile->target);
+		return profile->target;
+	}
+
+	/** Without jerk limit the acceleration changes at once (Trapezoid)*/
+	if((INIT_VAL >= jerk) || (accel_max < jerk))
+	{
+		jerk = accel_max;
+	}
+
+	/** The target is reached in this step, and the acceleration can stop on the next*/
+	if((jerk >= (direction * error)) && (jerk >= ((error > profile->accel) ? (error - profile->accel) : (profile->accel - error))))
+	{
+		profile->accel = (int32_t)error;
+	}
+
+	else
+	{
+		accel_up = motion_profile_clamp((int64_t)profile->accel + (direction * jerk), accel_max);
+
+		/** Accelerates while the target can still be reached by braking after this step*/
+		if(INIT_VAL <= (direction * (error - accel_up - motion_profile_brake(accel_up, jerk))))
+		{
+			profile->accel = accel_up;
+		}
+
+		/** Keeps the acceleration while it can still brake, or brakes*/
+		else if(INIT_VAL > (direction * (error - profile->accel - motion_profile_brake(profile->accel, jerk))))
+		{
+			profile->accel = motion_profile_clamp((int64_t)profile->accel - (direction * jerk), accel_max);
+		}
+	}
+
+	profile->speed += profile->accel;
+
+	/** Rounds to Q15, symmetric for both directions*/
+	return (int16_t)((INIT_VAL > profile->speed) ? -((FRAC_HALF - profile->speed) >> MOTION_PROFILE_FRAC_BITS) :
+												   ((profile->speed + FRAC_HALF) >> MOTION_PROFILE_FRAC_BITS));
+}
+
+/** This function returns the speed gained while braking*/
+static int64_t motion_profile_brake(int32_t accel, int32_t jerk)
+{
+	/** Magnitude of the acceleration*/
+	uint32_t magnitude = (INIT_VAL > accel) ? (0U - (uint32_t)accel) : (uint32_t)accel;
+	/** Updates until the acceleration is less than a jerk (32 bit division, the hardware divider)*/
+	uint32_t updates = magnitude / (uint32_t)jerk;
+	/** Sum of magnitude - jerk, magnitude - 2 jerk ... for every update*/
+	int64_t gained = ((int64_t)updates * magnitude) - (int64_t)(((uint64_t)jerk * updates * (updates + 1U)) >> 1);
+
+	return (INIT_VAL > accel) ? -gained : gained;
+}
+
+/** This function limits an acceleration*/
+static inline int32_t motion_profile_clamp(int64_t accel, int32_t max)
+{
+	if(max < accel)
+	{
+		accel = max;
+	}
+
+	else if(-max > accel)
+	{
+		accel = -max;
+	}
+
+	return (int32_t)accel;
+}
@@ -0,0 +1,90 @@
+/*!
+ 	 \file motion_profile.h
+
+ 	 \brief This is the header file of the fixed point motion profile of the speed.
+ 	 	 	 It moves a setpoint towards a target with limited acceleration and
+ 	 	 	 jerk (S curve), or only limited acceleration (Trapezoid) if the jerk
+ 	 	 	 limit is 0. It runs one step per update of the control loop, and the
+ 	 	 	 target can change at any time, even in the middle of a profile.
+
+ 	 \note Every update costs the same (One 32 bit division), the deceleration is
+ 	 	 	 decided from the speed still gained while the acceleration goes to 0.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef MOTION_PROFILE_H_
+#define MOTION_PROFILE_H_
+
+#include <stdint.h>
+
+/** Defines the fractional bits of the speed and its limits (On top of Q15)*/
+#define MOTION_PROFILE_FRAC_BITS			(16)
+
+/*!
+ 	 \brief Structure for the limits of the profile. Both are per update, in Q15
+ 	 	 	 with MOTION_PROFILE_FRAC_BITS more fractional bits.
+ */
+typedef struct
+{
+	int32_t accel_max;	/*!< Maximum change of the speed per update (0 disables the profile)*/
+	int32_t jerk_max;	/*!< Maximum change of the acceleration per update (0 for a trapezoid)*/
+}MOTION_PROFILE_config_t;
+
+/*!
+ 	 \brief Structure for the profile.
+ */
+typedef struct
+{
+	MOTION_PROFILE_config_t config;	/*!< Limits*/
+	int16_t target;					/*!< Target speed, in Q15*/
+	int32_t speed;					/*!< Speed of the profile, in Q15 with fractional bits*/
+	int32_t accel;					/*!< Acceleration of the profile, per update*/
+}MOTION_PROFILE_t;
+
+/*!
+ 	 \brief This function initializes a profile stopped.
+
+ 	 \param[out] profile Profile to be initialized.
+ 	 \param[in] config Limits.
+
+ 	 \return void.
+ */
+void MOTION_PROFILE_init(MOTION_PROFILE_t* profile, const MOTION_PROFILE_config_t* config);
+
+/*!
+ 	 \brief This function restarts a profile from a speed, without acceleration, and
+ 	 	 	 sets it as the target.
+
+ 	 \param[in,out] profile Profile to be restarted.
+ 	 \param[in] speed Speed, in Q15.
+
+ 	 \return void.
+ */
+void MOTION_PROFILE_reset(MOTION_PROFILE_t* profile, int16_t speed);
+
+/*!
+ 	 \brief This function sets the target of a profile, the next updates move to it.
+
+ 	 \param[in,out] profile Profile.
+ 	 \param[in] target Target speed, in Q15.
+
+ 	 \return void.
+ */
+void MOTION_PROFILE_set_target(MOTION_PROFILE_t* profile, int16_t target);
+
+/*!
+ 	 \brief This function executes one step of the profile.
+
+ 	 \param[in,out] profile Profile to be updated.
+
+ 	 \return Speed of the profile, in Q15.
+ */
+int16_t MOTION_PROFILE_update(MOTION_PROFILE_t* profile);
+
+#endif /* MOTION_PROFILE_H_ */
@@ -17,6 +17,13 @@
 #include "flexTimer2.h"
 #include "flexTimer3.h"
 #include "pin_mux.h"
+#include "cycle_counter.h"
+#include "adc_scan.h"
+
+/** Defines the motor as initialized*/
+#define IS_INIT						(1)
+/** Defines the motor as not initialized*/
+#define NOT_INIT					(0)
 
 /** Defines the initial value for the variables*/
 #define INIT_VAL					(0x00)
@@ -25,25 +32,122 @@
 #define MAX_RPM						(150)
 /** Defines the minimum allowed RPM*/
 #define MIN_RPM						(13)
-/** Defines the maximum frequency given by the encoder*/
-#define MAX_FREQ					(2600)
+/** Defines the counts of the encoder per revolution of the motor (Both edges of both phases)*/
+#define ENCODER_CPR					(64)
+/** Defines the gear ratio between the motor and the output shaft*/
+#define GEAR_RATIO					(70)
+/** Defines the seconds in a minute*/
+#define SECONDS_PER_MINUTE			(60)
+/** Defines the counts per second of the decoder at the maximum RPM*/
+#define MAX_COUNTS_PER_SECOND		((MAX_RPM * GEAR_RATIO * ENCODER_CPR) / SECONDS_PER_MINUTE)
 
-/** RPM divider for the frequency*/
-#define RPM_DIVIDER					(2)
+/** Defines the shifts to scale the modulo by a duty cycle (0x8000 is 100%)*/
+#define DUTY_CYCLE_SHIFT			(15)
+/** Defines the prescaler steps between SIRCDIV1 (8 MHz) and the system clock of VLPR (4 MHz)*/
+#define SYSTEM_CLOCK_PS_SHIFT		(1)
 
-/** Variable to store the current motor speed*/
-static volatile motor_speed_t current_speed = {INIT_VAL, motor_forward};
-/** Variable to store the clock frequency*/
-static uint32_t frequency = INIT_VAL;
+/*!
+ 	 \brief This function writes the duty cycle of a running PWM. The new CnV is loaded
+ 	 	 	 at the next maximum of the counter, so the period in progress is not cut.
 
-/** This function updates the PWM ducy cycle according to the speed given*/
-void MC_update_duty_cycle(motor_speed_t new_speed)
+ 	 \param[in] instance FTM instance of the PWM.
+ 	 \param[in] channel Channel of the PWM.
+ 	 \param[in] duty_cycle Duty cycle (0x8000 is 100%).
+
+ 	 \return void.
+ */
+static void mc_write_duty_cycle(uint32_t instance, uint8_t channel, uint16_t duty_cycle);
+
+/*!
+ 	 \brief This function stops the PWM of one direction and starts the one of the other.
+
+ 	 \param[in] motor Motor.
+ 	 \param[in] stop_instance FTM instance of the PWM to be stopped.
+ 	 \param[in] start_instance FTM instance of the PWM to be started.
+ 	 \param[in] start_pwm PWM configuration of the FTM to be started.
+ 	 \param[in] duty_cycle Duty cycle (0x8000 is 100%).
+
+ 	 \return void.
+ */
+static void mc_start_pwm(const MC_motor_t* motor, uint32_t stop_instance, uint32_t start_instance,
+						 const ftm_pwm_param_t* start_pwm, uint16_t duty_cycle);
+
+/*!
+ 	 \brief This function drives the PWM of a direction, or stops both.
+
+ 	 \param[in,out] motor Motor.
+ 	 \param[in] direction Direction of the motor.
+ 	 \param[in] drive Drive of the motor, in Q15 (0 stops the motor).
+
+ 	 \return void.
+ */
+static void mc_apply_drive(MC_motor_t* motor, motor_direction_t direction, uint16_t drive);
+
+/*!
+ 	 \brief This function sets the clock source of an FTM. A stopped FTM gets only
+ 	 	 	 its prescaler, the clock source is set when it starts again.
+
+ 	 \param[in] instance FTM instance.
+ 	 \param[in] clock Clock of the FTM.
+ 	 \param[in] keep_rate The prescaler follows the clock, so the counting rate does not change.
+
+ 	 \return void.
+ */
+static void mc_set_ftm_clock(uint32_t instance, mc_clock_t clock, bool keep_rate);
+
+
+/** Synchronization of the PWM, CnV is loaded by the software trigger at the counter maximum*/
+static const ftm_pwm_sync_t mc_pwm_sync =
 {
-	/** Variable to calculate the new duty cycle*/
-	uint16_t new_duty_cycle = INIT_VAL;
-	/** Variable to calculate the duty cycle (Inverse slope)*/
-	uint16_t inv_duty_cycle = INIT_VAL;
+	true,						/* Software trigger state */
+	false,						/* Hardware trigger 1 state */
+	false,						/* Hardware trigger 2 state */
+	false,						/* Hardware trigger 3 state */
+	true,						/* Max loading point state */
+	false,						/* Min loading point state */
+	FTM_SYSTEM_CLOCK,			/* Update mode for INVCTRL register */
+	FTM_SYSTEM_CLOCK,			/* Update mode for SWOCTRL register */
+	FTM_SYSTEM_CLOCK,			/* Update mode for OUTMASK register */
+	FTM_SYSTEM_CLOCK,			/* Update mode for CNTIN register */
+	true,						/* Automatic clear of the trigger*/
+	FTM_WAIT_LOADING_POINTS,	/* Synchronization point */
+};
+
+/** This function initializes a motor*/
+status_t MC_init(MC_motor_t* motor, const MC_config_t* config)
+{
+	/** Status of the feedback*/
+	status_t retval;
+
+	motor->init_val = NOT_INIT;
+	motor->config = *config;
+	motor->current_speed.RPM = INIT_VAL;
+	motor->current_speed.direction = motor_forward;
+	motor->pwm_state = pwm_stopped;
+	motor->clock = mc_clock_sirc;
+	motor->update_cycles = INIT_VAL;
+	motor->update_cycles_max = INIT_VAL;
+
+#if MC_FEEDBACK_MODE
+	/** The quadrature decoder has no interrupts per edge*/
+	retval = QENC_init(&motor->encoder, config->encoder_instance);
+#else
+	/** The input capture of phase A, with the speed measurement callback*/
+	retval = SPEED_MEAS_init(&motor->meas, config->encoder_instance, config->capture_channel);
+#endif
+
+	if(STATUS_SUCCESS == retval)
+	{
+		/** Sets the motor as initialized*/
+		motor->init_val = IS_INIT;
+	}
 
+	return retval;
+}
+
+/** This function updates the PWM ducy cycle according to the speed given*/
+void MC_update_duty_cycle(MC_motor_t* motor, motor_speed_t new_speed)
+{
 	/** If the RPM received is greater than the maximum RPM*/
 	if(MAX_RPM < new_speed.RPM)
 	{
@@ -59,76 +163,334 @@ void MC_update_duty_cycle(motor_speed_t new_speed)
 	}
 
 	/** Stores the received variable*/
-	current_speed.RPM = new_speed.RPM;
-	current_speed.direction = new_speed.direction;
+	motor->current_speed.RPM = new_speed.RPM;
+	motor->current_speed.direction = new_speed.direction;
 
-	/** Calculates the duty cycle (Inverse slope)*/
-	inv_duty_cycle = (uint16_t)((new_speed.RPM * DUTY_CYCLE_INV) / MAX_RPM);
+	/** Drives the motor proportional to the RPM*/
+	mc_apply_drive(motor, new_speed.direction, (uint16_t)((new_speed.RPM * DUTY_CYCLE_INV) / MAX_RPM));
+}
 
-	/** Calculates the new duty cycle*/
-	new_duty_cycle = (uint16_t)(DUTY_CYCLE_INV - inv_duty_cycle);
+/** This function sets the drive of the motor*/
+void MC_set_drive(MC_motor_t* motor, int16_t drive)
+{
+	/** Negative drives are reverse*/
+	if(INIT_VAL > drive)
+	{
+		motor->current_speed.direction = motor_reverse;
+		mc_apply_drive(motor, motor_reverse, (uint16_t)(-(int32_t)drive));
+	}
 
-	/** If the motor has stopped*/
-	if(INIT_VAL == new_speed.RPM)
+	else
 	{
-        /** Stops both PWM*/
-        FTM_DRV_DeinitPwm(INST_FLEXTIMER1);
-        FTM_DRV_DeinitPwm(INST_FLEXTIMER2);
+		motor->current_speed.direction = motor_forward;
+		mc_apply_drive(motor, motor_forward, (uint16_t)drive);
 	}
+}
 
-	/** If the direction set is reverse*/
-	else if(motor_reverse == new_speed.direction)
+/** This function converts a speed to Q15*/
+int16_t MC_speed_to_q15(motor_speed_t speed)
+{
+	/** Speed in Q15*/
+	int32_t speed_q15;
+
+	/** The same limits of MC_update_duty_cycle*/
+	if(MAX_RPM < speed.RPM)
 	{
-        /** Stops both PWM*/
-        FTM_DRV_DeinitPwm(INST_FLEXTIMER1);
-        FTM_DRV_DeinitPwm(INST_FLEXTIMER2);
+		speed.RPM = MAX_RPM;
+	}
 
-        /** Restarts PWM 2 (Reverse)*/
-        FTM_DRV_InitPwm(INST_FLEXTIMER2, &flexTimer2_PwmConfig);
-        /** Updates the PWM duty cycle*/
-	    FTM_DRV_UpdatePwmChannel(INST_FLEXTIMER2, PWM_CHANNEL, FTM_PWM_UPDATE_IN_DUTY_CYCLE, new_duty_cycle, PWM_EDGE, true);
+	else if(MIN_RPM > speed.RPM)
+	{
+		speed.RPM = INIT_VAL;
 	}
 
-	/** If the direction is set forward*/
-	else
+	speed_q15 = (speed.RPM * MC_SPEED_Q15_MAX) / MAX_RPM;
+
+	return (int16_t)((motor_reverse == speed.direction) ? -speed_q15 : speed_q15);
+}
+
+/** This function gets the measured speed in Q15*/
+int16_t MC_get_speed_q15(MC_motor_t* motor)
+{
+#if MC_FEEDBACK_MODE
+	/** Speed in Q15, signed by the direction of the decoder*/
+	int32_t speed_q15;
+
+	QENC_update(&motor->encoder);
+	speed_q15 = (QENC_get_speed(&motor->encoder) * MC_SPEED_Q15_MAX) / MAX_COUNTS_PER_SECOND;
+
+	if(MC_SPEED_Q15_MAX < speed_q15)
 	{
-        /** Stops both PWM*/
-		FTM_DRV_DeinitPwm(INST_FLEXTIMER2);
-        FTM_DRV_DeinitPwm(INST_FLEXTIMER1);
+		speed_q15 = MC_SPEED_Q15_MAX;
+	}
 
-        /** Restarts PWM 1 (Forward)*/
-        FTM_DRV_InitPwm(INST_FLEXTIMER1, &flexTimer2_PwmConfig);
-        /** Updates the PWM duty cycle*/
-	    FTM_DRV_UpdatePwmChannel(INST_FLEXTIMER1, PWM_CHANNEL, FTM_PWM_UPDATE_IN_DUTY_CYCLE, new_duty_cycle, PWM_EDGE, true);
+	else if(-MC_SPEED_Q15_MAX > speed_q15)
+	{
+		speed_q15 = -MC_SPEED_Q15_MAX;
+	}
+
+	return (int16_t)speed_q15;
+#else
+	/** Speed in Q15 of MAX_RPM*/
+	uint32_t speed_q15 = (SPEED_MEAS_get_rpm(&motor->meas) * MC_SPEED_Q15_MAX) / (MAX_RPM << SPEED_MEAS_RPM_SHIFT);
+
+	if(MC_SPEED_Q15_MAX < speed_q15)
+	{
+		speed_q15 = MC_SPEED_Q15_MAX;
 	}
+
+	/** The direction cannot be known by reading the IC*/
+	return (int16_t)((motor_reverse == motor->current_speed.direction) ? -(int32_t)speed_q15 : (int32_t)speed_q15);
+#endif
+}
+
+/** This function gets the position of the motor*/
+int32_t MC_get_position(MC_motor_t* motor)
+{
+#if MC_FEEDBACK_MODE
+	QENC_update(&motor->encoder);
+	return QENC_get_position(&motor->encoder);
+#else
+	/** The input capture has no position*/
+	(void)motor;
+	return INIT_VAL;
+#endif
 }
 
 /** This function returns the RPM and direction of the motor*/
-void MC_get_RPM(motor_speed_t* speed)
+void MC_get_RPM(MC_motor_t* motor, motor_speed_t* speed)
 {
-	/** Variable to calculate the RPM*/
-	uint8_t RPM = INIT_VAL;
-	/** Variable to read the input capture*/
-	uint16_t inputCaptureMeas = INIT_VAL;
+#if MC_FEEDBACK_MODE
+	/** Variable to read the speed of the decoder*/
+	int32_t counts_per_second = INIT_VAL;
+
+	QENC_update(&motor->encoder);
+	counts_per_second = QENC_get_speed(&motor->encoder);
+
+	/** Sets the direction measured by the decoder (Stopped keeps the set direction)*/
+	if(INIT_VAL > counts_per_second)
+	{
+		speed->direction = motor_reverse;
+		counts_per_second = -counts_per_second;
+	}
+
+	else if(INIT_VAL < counts_per_second)
+	{
+		speed->direction = motor_forward;
+	}
+
+	else
+	{
+		speed->direction = motor->current_speed.direction;
+	}
 
-    /* Get the FTM1 frequency to calculate
-     * the frequency of the measured signal.
-     */
-    frequency = FTM_DRV_GetFrequency(INST_FLEXTIMER3);
+	/** Calculates the RPM of the output shaft*/
+	speed->RPM = (uint8_t)((counts_per_second * SECONDS_PER_MINUTE) / (GEAR_RATIO * ENCODER_CPR));
+#else
+	/** Variable to read the measured speed (With fractional bits)*/
+	uint32_t RPM = INIT_VAL;
 
     /** Sets the direction of the motor
      	 (In this case, the direction cannot be known by
      	 reading the IC)*/
-	speed->direction = current_speed.direction;
+	speed->direction = motor->current_speed.direction;
 
-    /** Gets the IC frequency*/
-    inputCaptureMeas = FTM_DRV_GetInputCaptureMeasurement(INST_FLEXTIMER3, IC_CHANNEL);
-    /** Calculate the signal frequency using recorded data*/
-    inputCaptureMeas = frequency / (inputCaptureMeas);
+    /** Gets the measured speed, rounded to RPM*/
+    RPM = (SPEED_MEAS_get_rpm(&motor->meas) + (1U << (SPEED_MEAS_RPM_SHIFT - 1))) >> SPEED_MEAS_RPM_SHIFT;
 
-    /** Calculates the RPM according to the frequency*/
-    RPM = (uint8_t)((inputCaptureMeas * MAX_RPM) / (MAX_FREQ * RPM_DIVIDER));
+    if(UINT8_MAX < RPM)
+    {
+    	RPM = UINT8_MAX;
+    }
 
     /** Sets the RPM*/
-    speed->RPM = RPM;
+    speed->RPM = (uint8_t)RPM;
+#endif
+}
+
+/** This function gets the cycles of the duty cycle updates*/
+void MC_get_update_cycles(const MC_motor_t* motor, uint32_t* last, uint32_t* max)
+{
+	*last = motor->update_cycles;
+	*max = motor->update_cycles_max;
+}
+
+/** This function sets the clock of the FTMs of the motor*/
+void MC_set_clock(MC_motor_t* motor, mc_clock_t clock, uint32_t clock_hz)
+{
+	if((IS_INIT != motor->init_val) || (clock == motor->clock))
+	{
+		return;
+	}
+
+	/** The PWM keeps its period and duty cycle*/
+	mc_set_ftm_clock(motor->config.forward_instance, clock, true);
+	mc_set_ftm_clock(motor->config.reverse_instance, clock, true);
+
+	/** The speed measurement ranges its own prescaler, the quadrature decoder counts the edges*/
+	mc_set_ftm_clock(motor->config.encoder_instance, clock, false);
+
+#if MC_FEEDBACK_MODE
+	(void)clock_hz;
+#else
+	SPEED_MEAS_set_clock(&motor->meas, clock_hz);
+#endif
+
+	motor->clock = clock;
+}
+
+/** This function writes the duty cycle of a running PWM*/
+static void mc_write_duty_cycle(uint32_t instance, uint8_t channel, uint16_t duty_cycle)
+{
+	/** Base of the FTM*/
+	FTM_Type* base = g_ftmBase[instance];
+	/** In center aligned mode the modulo is half of the period, the same scale as CnV*/
+	uint16_t count = (uint16_t)(((uint32_t)FTM_HAL_GetMod(base) * duty_cycle) >> DUTY_CYCLE_SHIFT);
+
+	/** A CnV equal to the modulo still toggles at the maximum, the 100% must exceed it (As the FTM driver does)*/
+	if(FTM_MAX_DUTY_CYCLE == duty_cycle)
+	{
+		count ++;
+	}
+
+	FTM_HAL_SetChnCountVal(base, channel, count);
+	/** The software trigger loads CnV at the next loading point*/
+	FTM_HAL_SetSoftwareTriggerCmd(base, true);
+}
+
+/** This function stops the PWM of one direction and starts the other*/
+static void mc_start_pwm(const MC_motor_t* motor, uint32_t stop_instance, uint32_t start_instance,
+						 const ftm_pwm_param_t* start_pwm, uint16_t duty_cycle)
+{
+	/** Stops both PWM*/
+	FTM_DRV_DeinitPwm(stop_instance);
+	FTM_DRV_DeinitPwm(start_instance);
+
+	/** Restarts the PWM, with the synchronized loading of CnV*/
+	FTM_DRV_InitPwm(start_instance, start_pwm);
+	FTM_DRV_SetSync(start_instance, &mc_pwm_sync);
+
+	/** The driver starts the counter with the clock source of FTM_DRV_Init*/
+	if(mc_clock_sirc != motor->clock)
+	{
+		mc_set_ftm_clock(start_instance, motor->clock, false);
+	}
+
+	/** Updates the PWM duty cycle*/
+	FTM_DRV_UpdatePwmChannel(start_instance, motor->config.pwm_channel, FTM_PWM_UPDATE_IN_DUTY_CYCLE, duty_cycle, PWM_EDGE, true);
+
+	/** The current is sampled in the drive pulses of this PWM*/
+	if(motor->config.current_scan)
+	{
+		ADC_SCAN_sync(start_instance);
+	}
+}
+
+/** This function drives the PWM of a direction*/
+static void mc_apply_drive(MC_motor_t* motor, motor_direction_t direction, uint16_t drive)
+{
+	/** Hardware of the motor*/
+	const MC_config_t* config = &motor->config;
+	/** Variable to calculate the new duty cycle (Inverse slope)*/
+	uint16_t new_duty_cycle = INIT_VAL;
+	/** Cycle count at the start of the update*/
+	uint32_t start_cycles = CYCLE_COUNTER_GET();
+
+	/** The FTMs of the motor are not known before its initialization*/
+	if(IS_INIT != motor->init_val)
+	{
+		return;
+	}
+
+	if(DUTY_CYCLE_INV < drive)
+	{
+		drive = DUTY_CYCLE_INV;
+	}
+
+	/** Calculates the new duty cycle*/
+	new_duty_cycle = (uint16_t)(DUTY_CYCLE_INV - drive);
+
+	/** If the motor has stopped*/
+	if(INIT_VAL == drive)
+	{
+		/** Stops both PWM, only if one is running*/
+		if(pwm_stopped != motor->pwm_state)
+		{
+			FTM_DRV_DeinitPwm(config->forward_instance);
+			FTM_DRV_DeinitPwm(config->reverse_instance);
+			motor->pwm_state = pwm_stopped;
+
+			/** Without PWM the current scan runs on its own*/
+			if(config->current_scan)
+			{
+				ADC_SCAN_sync(ADC_SCAN_FREE_RUN);
+			}
+		}
+	}
+
+	/** If the direction set is reverse*/
+	else if(motor_reverse == direction)
+	{
+		/** The PWM is already running, only the duty cycle changes*/
+		if(pwm_reverse == motor->pwm_state)
+		{
+			mc_write_duty_cycle(config->reverse_instance, config->pwm_channel, new_duty_cycle);
+		}
+
+		else
+		{
+			mc_start_pwm(motor, config->forward_instance, config->reverse_instance, config->reverse_pwm, new_duty_cycle);
+			motor->pwm_state = pwm_reverse;
+		}
+	}
+
+	/** If the direction is set forward*/
+	else
+	{
+		/** The PWM is already running, only the duty cycle changes*/
+		if(pwm_forward == motor->pwm_state)
+		{
+			mc_write_duty_cycle(config->forward_instance, config->pwm_channel, new_duty_cycle);
+		}
+
+		else
+		{
+			mc_start_pwm(motor, config->reverse_instance, config->forward_instance, config->forward_pwm, new_duty_cycle);
+			motor->pwm_state = pwm_forward;
+		}
+	}
+
+	/** Stores the cycles of the update*/
+	motor->update_cycles = CYCLE_COUNTER_GET() - start_cycles;
+
+	if(motor->update_cycles > motor->update_cycles_max)
+	{
+		motor->update_cycles_max = motor->update_cycles;
+	}
+}
+
+/** This function sets the clock source of an FTM*/
+static void mc_set_ftm_clock(uint32_t instance, mc_clock_t clock, bool keep_rate)
+{
+	/** Base of the FTM*/
+	FTM_Type* base = g_ftmBase[instance];
+	/** Clock source running (None if the FTM is stopped)*/
+	ftm_clock_source_t source = FTM_HAL_GetClockSource(base);
+	/** Prescaler of the FTM*/
+	uint8_t prescaler = FTM_HAL_GetClockPs(base);
+
+	if(keep_rate)
+	{
+		prescaler = (mc_clock_system == clock) ? (uint8_t)(prescaler - SYSTEM_CLOCK_PS_SHIFT) :
+												 (uint8_t)(prescaler + SYSTEM_CLOCK_PS_SHIFT);
+	}
+
+	/** The prescaler is written with the counter stopped*/
+	FTM_HAL_SetClockSource(base, FTM_CLOCK_SOURCE_NONE);
+	FTM_HAL_SetClockPs(base, (ftm_clock_ps_t)prescaler);
+
+	if(FTM_CLOCK_SOURCE_NONE != source)
+	{
+		FTM_HAL_SetClockSource(base, (mc_clock_system == clock) ? FTM_CLOCK_SOURCE_SYSTEMCLK : FTM_CLOCK_SOURCE_EXTERNALCLK);
+	}
 }
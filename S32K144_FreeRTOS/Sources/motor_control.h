@@ -16,9 +16,12 @@
 #define MOTOR_CONTROL_H_
 
 #include "stdint.h"
+#include "stdbool.h"
 #include "flexTimer1.h"
 #include "flexTimer2.h"
 #include "flexTimer3.h"
+#include "quad_encoder.h"
+#include "speed_meas.h"
 
 /** Defines the value for a duty cycle of 0%*/
 #define DUTY_CYCLE_INV				(0x8000)
@@ -28,6 +31,18 @@
 #define PWM_EDGE					(0U)
 /** Defines the channel used for the input capture*/
 #define IC_CHANNEL					(0U)
+/** Defines the full scale of a speed or a drive in Q15*/
+#define MC_SPEED_Q15_MAX			(32767)
+
+/** Defines the speed to be measured by the input capture of one phase of the encoder*/
+#define MC_FEEDBACK_IC				(0)
+/** Defines the speed, direction and position to be measured by the quadrature decoder*/
+#define MC_FEEDBACK_QUADRATURE		(1)
+
+/** Sets the feedback of the motor (The pin settings route only phase A to PTC5, the quadrature decoder needs QD_PHA and QD_PHB routed)*/
+#ifndef MC_FEEDBACK_MODE
+#define MC_FEEDBACK_MODE			MC_FEEDBACK_IC
+#endif
 
 /*!
  	 \brief Enumerator to define the direction of the motor.
@@ -47,24 +62,172 @@ typedef struct
 	motor_direction_t direction;	/*!< Direction of the motor*/
 }motor_speed_t;
 
+/*!
+ 	 \brief Enumerator to define which PWM of a motor is running.
+ */
+typedef enum
+{
+	pwm_stopped,	/*!< Both PWM are stopped*/
+	pwm_reverse,	/*!< Reverse PWM is running*/
+	pwm_forward		/*!< Forward PWM is running*/
+}mc_pwm_state_t;
+
+/*!
+ 	 \brief Enumerator to define the clock of the FTMs of a motor.
+ */
+typedef enum
+{
+	mc_clock_sirc,		/*!< External clock, SIRCDIV1 (8 MHz) selected in the PCC (RUN and HSRUN)*/
+	mc_clock_system		/*!< System clock, the core clock of VLPR (4 MHz)*/
+}mc_clock_t;
+
+/*!
+ 	 \brief Structure for the hardware of a motor. Each motor has its own FTMs, so
+ 	 	 	 several motors can be driven by the same controller.
+ */
+typedef struct
+{
+	uint32_t forward_instance;				/*!< FTM of the forward PWM*/
+	const ftm_pwm_param_t* forward_pwm;		/*!< PWM configuration of the forward FTM*/
+	uint32_t reverse_instance;				/*!< FTM of the reverse PWM*/
+	const ftm_pwm_param_t* reverse_pwm;		/*!< PWM configuration of the reverse FTM*/
+	uint8_t pwm_channel;					/*!< Channel of both PWM configurations*/
+	uint32_t encoder_instance;				/*!< FTM of the encoder (Quadrature decoder or input capture)*/
+	uint8_t capture_channel;				/*!< Channel of the input capture (Phase A of the encoder)*/
+	bool current_scan;						/*!< The ADC scan follows the PWM of this motor (Only one motor)*/
+}MC_config_t;
+
+/*!
+ 	 \brief Structure for a motor.
+ */
+typedef struct
+{
+	uint8_t init_val;						/*!< Defines whether the motor has been initialized or not*/
+	MC_config_t config;						/*!< Hardware of the motor*/
+	volatile motor_speed_t current_speed;	/*!< Speed set to the motor*/
+	mc_pwm_state_t pwm_state;				/*!< PWM running*/
+	mc_clock_t clock;						/*!< Clock of the FTMs*/
+	uint32_t update_cycles;					/*!< Cycles of the last duty cycle update*/
+	uint32_t update_cycles_max;				/*!< Cycles of the slowest duty cycle update*/
+#if MC_FEEDBACK_MODE
+	QENC_t encoder;							/*!< Quadrature decoder of the encoder*/
+#else
+	SPEED_MEAS_t meas;						/*!< Input capture of the encoder*/
+#endif
+}MC_motor_t;
+
+/*!
+ 	 \brief This function initializes a motor stopped and starts its feedback (See
+ 	 	 	 MC_FEEDBACK_MODE).
+
+ 	 \note The FTMs must be initialized with FTM_DRV_Init. The configuration is
+ 	 	 	 copied, the PWM configurations are only referenced.
+
+ 	 \param[out] motor Motor to be initialized.
+ 	 \param[in] config Hardware of the motor.
+
+ 	 \return STATUS_SUCCESS, or STATUS_ERROR if the encoder FTM could not be started.
+ */
+status_t MC_init(MC_motor_t* motor, const MC_config_t* config);
+
 /*!
  	 \brief This function updates the duty cycle of the motor according
  	 	 	 to the desired RPM.
 
+ 	 \param[in,out] motor Motor.
  	 \param[in] new_speed Speed in RPM and direction of the motor.
 
  	 \return void.
  */
-void MC_update_duty_cycle(motor_speed_t new_speed);
+void MC_update_duty_cycle(MC_motor_t* motor, motor_speed_t new_speed);
 
 /*!
  	 \brief This function returns the speed of the motor according to
- 	 	 	 the value received from the IC.
+ 	 	 	 the encoder (IC or quadrature decoder, see MC_FEEDBACK_MODE).
 
+ 	 \note The IC can not measure the direction, so it returns the set direction.
+
+ 	 \param[in,out] motor Motor.
  	 \param[out] speed Speed in RPM and direction of the motor.
 
  	 \return void.
  */
-void MC_get_RPM(motor_speed_t* speed);
+void MC_get_RPM(MC_motor_t* motor, motor_speed_t* speed);
+
+/*!
+ 	 \brief This function sets the drive of the motor, without the RPM limits.
+
+ 	 \note The drive is the same scale of the duty cycle that MC_update_duty_cycle
+ 	 	 	 sets for a speed, so MC_speed_to_q15 is also the open loop drive of a speed.
+
+ 	 \param[in,out] motor Motor.
+ 	 \param[in] drive Drive in Q15 (MC_SPEED_Q15_MAX is 100%), negative is reverse and 0 stops the motor.
+
+ 	 \return void.
+ */
+void MC_set_drive(MC_motor_t* motor, int16_t drive);
+
+/*!
+ 	 \brief This function converts a speed to Q15 of the maximum RPM, with the
+ 	 	 	 limits of MC_update_duty_cycle.
+
+ 	 \param[in] speed Speed in RPM and direction of the motor.
+
+ 	 \return Speed in Q15, negative is reverse.
+ */
+int16_t MC_speed_to_q15(motor_speed_t speed);
+
+/*!
+ 	 \brief This function returns the speed of the motor, measured by the encoder,
+ 	 	 	 in Q15 of the maximum RPM.
+
+ 	 \param[in,out] motor Motor.
+
+ 	 \return Speed in Q15, negative is reverse.
+ */
+int16_t MC_get_speed_q15(MC_motor_t* motor);
+
+/*!
+ 	 \brief This function returns the position of the motor shaft.
+
+ 	 \note Only the quadrature feedback has a position, the input capture returns 0.
+
+ 	 \param[in,out] motor Motor.
+
+ 	 \return Position in counts of the encoder (64 per revolution of the motor).
+ */
+int32_t MC_get_position(MC_motor_t* motor);
+
+/*!
+ 	 \brief This function gets the core cycles spent in MC_update_duty_cycle.
+
+ 	 \note The cycle counter must be enabled with CYCLE_COUNTER_ENABLE.
+
+ 	 \param[in] motor Motor.
+ 	 \param[out] last Cycles of the last update.
+ 	 \param[out] max Cycles of the slowest update.
+
+ 	 \return void.
+ */
+void MC_get_update_cycles(const MC_motor_t* motor, uint32_t* last, uint32_t* max);
+
+/*!
+ 	 \brief This function sets the clock of the FTMs of the motor. The external clock
+ 	 	 	 must be below a quarter of the system clock, so VLPR (4 MHz) needs the
+ 	 	 	 system clock instead of SIRCDIV1 (8 MHz).
+
+ 	 \note The PWM FTMs keep their counting rate (The prescaler follows the clock),
+ 	 	 	 so the PWM frequency and the duty cycles do not change. The encoder
+ 	 	 	 FTM keeps its prescaler, the input capture gets the new clock.
+
+ 	 \note It is called by the clock manager, with the interrupts disabled.
+
+ 	 \param[in,out] motor Motor.
+ 	 \param[in] clock Clock of the FTMs.
+ 	 \param[in] clock_hz Clock of the encoder FTM before the prescaler, in Hz.
+
+ 	 \return void.
+ */
+void MC_set_clock(MC_motor_t* motor, mc_clock_t clock, uint32_t clock_hz);
 
 #endif /* MOTOR_CONTROL_H_ */
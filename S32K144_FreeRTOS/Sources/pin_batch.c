@@ -0,0 +1,70 @@
+/*!
+ 	 \file pin_batch.c
+
+ 	 \brief This is the source file of the batched pin initialization.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include "pin_batch.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL							(0)
+/** Defines the mask of the pins of a half of a port*/
+#define PIN_BATCH_HALF_MASK					(0xFFFFUL)
+/** Defines the mask of the bits of the PCR written by the global pin control registers*/
+#define PIN_BATCH_PCR_LOW_MASK				(0x0000FFFFUL)
+
+/** This function configures the pins*/
+void PIN_BATCH_init(const PIN_BATCH_config_t* config)
+{
+	/** Counter for the batches, pins and ports*/
+	uint32_t index;
+	/** Pin with an interrupt configuration*/
+	const PIN_BATCH_irq_t* irq;
+
+	for(index = INIT_VAL ; index < config->batches_count ; index ++)
+	{
+		PIN_BATCH_set(config->batches[index].port,
+					  ((uint32_t)config->batches[index].high_pins << PIN_BATCH_HALF_PINS) | config->batches[index].low_pins,
+					  config->batches[index].pcr);
+	}
+
+	/** The interrupt configuration is not in the global pin control registers*/
+	for(index = INIT_VAL ; index < config->irqs_count ; index ++)
+	{
+		irq = &config->irqs[index];
+		irq->port->PCR[irq->pin] = (irq->port->PCR[irq->pin] & PIN_BATCH_PCR_LOW_MASK) | irq->irq;
+	}
+
+	/** One write of the directions per port*/
+	for(index = INIT_VAL ; index < config->directions_count ; index ++)
+	{
+		config->directions[index].gpio->PDDR = (config->directions[index].gpio->PDDR | config->directions[index].outputs) &
+											   (~config->directions[index].inputs);
+	}
+}
+
+/** This function configures a batch of pins*/
+void PIN_BATCH_set(PORT_Type* port, uint32_t pins, uint16_t pcr)
+{
+	/** Pins 0 to 15*/
+	uint32_t low_pins = pins & PIN_BATCH_HALF_MASK;
+	/** Pins 16 to 31*/
+	uint32_t high_pins = (pins >> PIN_BATCH_HALF_PINS) & PIN_BATCH_HALF_MASK;
+
+	if(INIT_VAL != low_pins)
+	{
+		port->GPCLR = PORT_GPCLR_GPWE(low_pins) | PORT_GPCLR_GPWD(pcr);
+	}
+
+	if(INIT_VAL != high_pins)
+	{
+		port->GPCHR = PORT_GPCHR_GPWE(high_pins) | PORT_GPCHR_GPWD(pcr);
+	}
+}
@@ -0,0 +1,103 @@
+/*!
+ 	 \file pin_batch.h
+
+ 	 \brief This is the header file of the batched pin initialization. The pins of
+ 	 	 	 a port with the same configuration are written together through the
+ 	 	 	 global pin control registers (GPCLR for the pins 0 to 15, GPCHR for the
+ 	 	 	 pins 16 to 31), so a batch of up to 16 pins costs one write instead of
+ 	 	 	 the several read-modify-writes per pin of PINS_DRV_Init.
+
+ 	 \note The global pin control registers only write the bits 15:0 of the PCRs
+ 	 	 	 (Pull, passive filter, drive strength, mux and lock). The interrupt
+ 	 	 	 configuration (Bits 19:16) and the flag are written per pin, only for
+ 	 	 	 the pins that have them, so PIN_BATCH_init expects the PCRs as they are
+ 	 	 	 after a reset.
+
+ 	 \note The batches of the Processor Expert pin table are generated by
+ 	 	 	 Host/pin_codegen.py (pin_batches.h), run it again when the pins change.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef PIN_BATCH_H_
+#define PIN_BATCH_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "pins_driver.h"
+
+/** Defines the pins of a half of a port (A global pin control register)*/
+#define PIN_BATCH_HALF_PINS					(16U)
+
+/*!
+ 	 \brief Structure for a batch of pins of a port with the same configuration.
+ */
+typedef struct
+{
+	PORT_Type* port;			/*!< Port of the pins*/
+	uint16_t low_pins;			/*!< Pins 0 to 15 of the batch, one bit per pin*/
+	uint16_t high_pins;			/*!< Pins 16 to 31 of the batch, one bit per pin (Bit 0 is pin 16)*/
+	uint16_t pcr;				/*!< Bits 15:0 of the PCR of the pins*/
+}PIN_BATCH_t;
+
+/*!
+ 	 \brief Structure for a pin with an interrupt or DMA request, or whose flag is cleared.
+ */
+typedef struct
+{
+	PORT_Type* port;			/*!< Port of the pin*/
+	uint8_t pin;				/*!< Pin*/
+	uint32_t irq;				/*!< Bits 31:16 of the PCR (Interrupt configuration, and the flag to clear it)*/
+}PIN_BATCH_irq_t;
+
+/*!
+ 	 \brief Structure for the directions of the GPIO pins of a port.
+ */
+typedef struct
+{
+	GPIO_Type* gpio;			/*!< GPIO of the port*/
+	uint32_t outputs;			/*!< Pins set as outputs*/
+	uint32_t inputs;			/*!< Pins set as inputs*/
+}PIN_BATCH_direction_t;
+
+/*!
+ 	 \brief Structure for the configuration of the pins.
+ */
+typedef struct
+{
+	const PIN_BATCH_t* batches;					/*!< Batches*/
+	uint32_t batches_count;						/*!< Number of batches*/
+	const PIN_BATCH_irq_t* irqs;				/*!< Pins with an interrupt configuration*/
+	uint32_t irqs_count;						/*!< Number of pins with an interrupt configuration*/
+	const PIN_BATCH_direction_t* directions;	/*!< Directions of the GPIO pins, per port*/
+	uint32_t directions_count;					/*!< Number of ports with GPIO pins*/
+}PIN_BATCH_config_t;
+
+/*!
+ 	 \brief This function configures the pins, batch by batch. The clocks of the
+ 	 	 	 ports must be enabled (Clock manager).
+
+ 	 \param[in] config Configuration (e.g. pin_batches_config of pin_batches.h).
+
+ 	 \return void.
+ */
+void PIN_BATCH_init(const PIN_BATCH_config_t* config);
+
+/*!
+ 	 \brief This function configures a batch of pins.
+
+ 	 \param[in] port Port of the pins.
+ 	 \param[in] pins Pins of the batch, one bit per pin (0 to 31).
+ 	 \param[in] pcr Bits 15:0 of the PCR of the pins.
+
+ 	 \return void.
+ */
+void PIN_BATCH_set(PORT_Type* port, uint32_t pins, uint16_t pcr);
+
+#endif /* PIN_BATCH_H_ */
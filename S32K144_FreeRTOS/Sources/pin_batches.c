@@ -0,0 +1,59 @@
+/*!
+ 	 \file pin_batches.c
+
+ 	 \brief This is the source file of the pin batches. The pins of pin_mux.c are
+ 	 	 	 found in this source file, grouped by port and configuration.
+
+ 	 \note Generated by Host/pin_codegen.py, do not modify it by hand.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include "pin_batches.h"
+
+/** Pins with the same configuration, per port*/
+static const PIN_BATCH_t pin_batches[PIN_BATCHES_COUNT] =
+{
+	/* PTA0, PTA1, PTA2, PTA3, PTA6, PTA7, PTA8, PTA9, PTA11, PTA12, PTA13, PTA14, PTA15, PTA16, PTA17 */
+	{ PORTA, 0xFBCFU, 0x0003U, (uint16_t)(0U) },
+	/* PTA4 */
+	{ PORTA, 0x0010U, 0x0000U, (uint16_t)(PORT_PCR_MUX(PORT_MUX_ALT7) | PORT_PCR_PE_MASK | PORT_PCR_PS_MASK) },
+	/* PTA5 */
+	{ PORTA, 0x0020U, 0x0000U, (uint16_t)(PORT_PCR_MUX(PORT_MUX_ALT7) | PORT_PCR_PE_MASK | PORT_PCR_PS_MASK | PORT_PCR_PFE_MASK) },
+	/* PTA10 */
+	{ PORTA, 0x0400U, 0x0000U, (uint16_t)(PORT_PCR_MUX(PORT_MUX_ALT7) | PORT_PCR_DSE_MASK) },
+	/* PTB0, PTB1, PTB3, PTB4, PTB5, PTB6, PTB7, PTB8, PTB9, PTB10, PTB11, PTB12, PTB13, PTB14, PTB15, PTB16, PTB17 */
+	{ PORTB, 0xFFFBU, 0x0003U, (uint16_t)(0U) },
+	/* PTB2 */
+	{ PORTB, 0x0004U, 0x0000U, (uint16_t)(PORT_PCR_MUX(PORT_MUX_ALT2)) },
+	/* PTC0 */
+	{ PORTC, 0x0001U, 0x0000U, (uint16_t)(PORT_PCR_MUX(PORT_MUX_ALT2)) },
+	/* PTC1 */
+	{ PORTC, 0x0002U, 0x0000U, (uint16_t)(PORT_PCR_MUX(PORT_MUX_ALT6)) },
+	/* PTC2, PTC3, PTC6, PTC7, PTC8, PTC9, PTC10, PTC11, PTC12, PTC13, PTC14, PTC15, PTC16, PTC17 */
+	{ PORTC, 0xFFCCU, 0x0003U, (uint16_t)(0U) },
+	/* PTC4 */
+	{ PORTC, 0x0010U, 0x0000U, (uint16_t)(PORT_PCR_MUX(PORT_MUX_ALT7) | PORT_PCR_PE_MASK) },
+	/* PTC5 */
+	{ PORTC, 0x0020U, 0x0000U, (uint16_t)(PORT_PCR_MUX(PORT_MUX_ALT2) | PORT_PCR_PE_MASK | PORT_PCR_PS_MASK) },
+	/* PTD0, PTD1, PTD2, PTD3, PTD4, PTD5, PTD6, PTD7, PTD8, PTD9, PTD10, PTD11, PTD12, PTD13, PTD14, PTD15, PTD16, PTD17 */
+	{ PORTD, 0xFFFFU, 0x0003U, (uint16_t)(0U) },
+	/* PTE0, PTE1, PTE2, PTE3, PTE4, PTE5, PTE6, PTE7, PTE8, PTE9, PTE10, PTE11, PTE12, PTE13, PTE14, PTE15, PTE16 */
+	{ PORTE, 0xFFFFU, 0x0001U, (uint16_t)(0U) }
+};
+
+/** Configuration of the pins of the table*/
+const PIN_BATCH_config_t pin_batches_config =
+{
+	pin_batches,
+	PIN_BATCHES_COUNT,
+	NULL,
+	0U,
+	NULL,
+	0U
+};
@@ -0,0 +1,30 @@
+/*!
+ 	 \file pin_batches.h
+
+ 	 \brief This is the header file of the pin batches. It has the pins of pin_mux.c
+ 	 	 	 grouped by port and configuration, for PIN_BATCH_init.
+
+ 	 \note Generated by Host/pin_codegen.py, do not modify it by hand.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef PIN_BATCHES_H_
+#define PIN_BATCHES_H_
+
+#include "pin_batch.h"
+
+/** Defines the number of pins of the table*/
+#define PIN_BATCHES_PINS					(89)
+/** Defines the number of batches (18 writes to GPCLR/GPCHR)*/
+#define PIN_BATCHES_COUNT					(13)
+
+/** Configuration of the pins of the table*/
+extern const PIN_BATCH_config_t pin_batches_config;
+
+#endif /* PIN_BATCHES_H_ */
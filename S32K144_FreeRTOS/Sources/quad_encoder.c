@@ -0,0 +1,141 @@
+/*!
+ 	 \file quad_encoder.c
+
+ 	 \brief This is the source file of the quadrature encoder.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include "quad_encoder.h"
+#include "tick_period.h"
+
+/* Kernel includes. */
+#include "task.h"
+
+/** Defines the encoder as initialized*/
+#define IS_INIT								(1)
+/** Defines the encoder as not initialized*/
+#define NOT_INIT							(0)
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL							(0)
+/** Defines the maximum value of the counter*/
+#define QENC_COUNTER_MAX					(0xFFFF)
+/** Defines the ms of a second*/
+#define MS_IN_S								(1000.0F)
+
+/** Configuration of the decoder, counting the four edges of both phases*/
+static const ftm_quad_decode_config_t qenc_config =
+{
+	FTM_QUAD_PHASE_ENCODE,		/* Phase A and phase B encoding */
+	INIT_VAL,					/* Initial value of the counter */
+	QENC_COUNTER_MAX,			/* Maximum value of the counter */
+	{
+		true,					/* Filter of phase A */
+		QENC_PHASE_FILTER,		/* Filter value of phase A */
+		FTM_QUAD_PHASE_NORMAL	/* Polarity of phase A */
+	},
+	{
+		true,					/* Filter of phase B */
+		QENC_PHASE_FILTER,		/* Filter value of phase B */
+		FTM_QUAD_PHASE_NORMAL	/* Polarity of phase B */
+	}
+};
+
+/** This function starts the quadrature decoder*/
+status_t QENC_init(QENC_t* encoder, uint32_t instance)
+{
+	/** Status of the decoder*/
+	status_t retval;
+
+	/** The encoder is not updated while its decoder is started*/
+	encoder->init_val = NOT_INIT;
+	retval = FTM_DRV_QuadDecodeStart(instance, &qenc_config);
+
+	if(STATUS_SUCCESS == retval)
+	{
+		encoder->base = g_ftmBase[instance];
+		encoder->last_counter = FTM_HAL_GetCounter(encoder->base);
+		encoder->position = INIT_VAL;
+		encoder->newest = INIT_VAL;
+		encoder->count = INIT_VAL;
+
+		/** Sets the handler as initialized*/
+		encoder->init_val = IS_INIT;
+	}
+
+	return retval;
+}
+
+/** This function extends the position*/
+void QENC_update(QENC_t* encoder)
+{
+	/** Counter of the decoder*/
+	uint16_t counter;
+	/** Tick of the update*/
+	TickType_t tick = xTaskGetTickCount();
+
+	if(IS_INIT == encoder->init_val)
+	{
+		taskENTER_CRITICAL();
+
+		/** The counter wraps on 16 bits, so the signed difference is the movement*/
+		counter = FTM_HAL_GetCounter(encoder->base);
+		encoder->position += (int16_t)(uint16_t)(counter - encoder->last_counter);
+		encoder->last_counter = counter;
+
+		/** Only one sample per tick, the window covers at least QENC_SPEED_WINDOW ticks*/
+		if((INIT_VAL == encoder->count) || (encoder->samples[encoder->newest].tick != tick))
+		{
+			encoder->newest = (uint8_t)((encoder->newest + 1) % QENC_SPEED_WINDOW);
+			encoder->samples[encoder->newest].position = encoder->position;
+			encoder->samples[encoder->newest].tick = tick;
+
+			if(QENC_SPEED_WINDOW > encoder->count)
+			{
+				encoder->count ++;
+			}
+		}
+
+		taskEXIT_CRITICAL();
+	}
+}
+
+/** This function returns the position*/
+int32_t QENC_get_position(const QENC_t* encoder)
+{
+	return encoder->position;
+}
+
+/** This function returns the speed*/
+int32_t QENC_get_speed(const QENC_t* encoder)
+{
+	/** Oldest sample of the window*/
+	const QENC_sample_t* oldest;
+	/** Newest sample of the window*/
+	const QENC_sample_t* newest;
+	/** Ticks of the window*/
+	TickType_t ticks;
+	/** Speed in counts per second*/
+	int32_t speed = INIT_VAL;
+
+	taskENTER_CRITICAL();
+
+	if(1 < encoder->count)
+	{
+		newest = &encoder->samples[encoder->newest];
+		oldest = &encoder->samples[(encoder->newest + QENC_SPEED_WINDOW + 1 - encoder->count) % QENC_SPEED_WINDOW];
+		ticks = newest->tick - oldest->tick;
+
+		speed = (int32_t)(((float)(newest->position - oldest->position) * (MS_IN_S * FIX_PERIOD)) / (float)ticks);
+	}
+
+	taskEXIT_CRITICAL();
+
+	return speed;
+}
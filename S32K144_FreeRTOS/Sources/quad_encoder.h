@@ -0,0 +1,101 @@
+/*!
+ 	 \file quad_encoder.h
+
+ 	 \brief This is the header file of the quadrature encoder. The FTM decodes
+ 	 	 	 both phases in hardware, and this module extends its 16 bit counter
+ 	 	 	 to a signed 32 bit position and gets the speed from the position deltas.
+
+ 	 \note There are no interrupts per edge nor per overflow. QENC_update must be
+ 	 	 	 called before the counter moves half of its range (32768 counts), the
+ 	 	 	 readers of the speed call it on every read.
+
+ 	 \note Only FTM1 and FTM2 have a quadrature decoder, and their QD_PHA and QD_PHB
+ 	 	 	 signals must be routed to the encoder phases in the pin settings.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef QUAD_ENCODER_H_
+#define QUAD_ENCODER_H_
+
+#include <stdint.h>
+#include "ftm_driver.h"
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+
+/** Defines the samples used to get the speed (The window is from the oldest to the newest)*/
+#define QENC_SPEED_WINDOW					(8)
+/** Defines the input filter of the phases, in clocks of the FTM*/
+#define QENC_PHASE_FILTER					(4)
+
+/*!
+ 	 \brief Structure for a sample of the position.
+ */
+typedef struct
+{
+	int32_t position;	/*!< Position when the sample was taken*/
+	TickType_t tick;	/*!< Tick when the sample was taken*/
+}QENC_sample_t;
+
+/*!
+ 	 \brief Structure for an encoder. Each motor has its own, on its own FTM.
+ */
+typedef struct
+{
+	uint8_t init_val;							/*!< Defines whether the encoder has been initialized or not*/
+	FTM_Type* base;								/*!< FTM of the decoder*/
+	uint16_t last_counter;						/*!< Counter on the last update*/
+	int32_t position;							/*!< Extended position*/
+	QENC_sample_t samples[QENC_SPEED_WINDOW];	/*!< Ring of samples for the speed*/
+	uint8_t newest;								/*!< Index of the newest sample*/
+	uint8_t count;								/*!< Number of valid samples*/
+}QENC_t;
+
+/*!
+ 	 \brief This function starts the quadrature decoder and clears the position.
+
+ 	 \note The FTM must be initialized with FTM_DRV_Init and must not be running
+ 	 	 	 in another mode.
+
+ 	 \param[out] encoder Encoder to be initialized.
+ 	 \param[in] instance FTM instance of the decoder (FTM1 or FTM2).
+
+ 	 \return STATUS_SUCCESS, or STATUS_ERROR if the FTM is already in another mode.
+ */
+status_t QENC_init(QENC_t* encoder, uint32_t instance);
+
+/*!
+ 	 \brief This function reads the counter, extends the position and stores a
+ 	 	 	 sample for the speed (One per tick).
+
+ 	 \param[in,out] encoder Encoder to be updated.
+
+ 	 \return void.
+ */
+void QENC_update(QENC_t* encoder);
+
+/*!
+ 	 \brief This function returns the position of the encoder.
+
+ 	 \param[in] encoder Encoder.
+
+ 	 \return Position in counts, positive when the counter increases.
+ */
+int32_t QENC_get_position(const QENC_t* encoder);
+
+/*!
+ 	 \brief This function returns the speed of the encoder over the samples window.
+
+ 	 \param[in] encoder Encoder.
+
+ 	 \return Speed in counts per second, positive when the counter increases.
+ */
+int32_t QENC_get_speed(const QENC_t* encoder);
+
+#endif /* QUAD_ENCODER_H_ */
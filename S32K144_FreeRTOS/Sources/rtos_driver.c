@@ -15,17 +15,25 @@
 
 
 #include "rtos_driver.h"
-#include "ADC.h"
-#include "motor_control.h"
+#include "tick_period.h"
+#include "adc_monitor.h"
+#include "xcp.h"
+#include "can_signals.h"
+#include "can_stats.h"
+#include "boot_profile.h"
 
 /** Defines the CAN hanlder as initialized*/
 #define IS_INIT								(1)
 /** Defines the CAN handler as not initialzied*/
 #define NOT_INIT							(0)
-/** Defines the bits for the ADC event group*/
-#define EVENT_GROUP_RPM						(0x01)
 /** Defines the bits for the SW3 event group*/
-#define EVENT_GROUP_SW						(0x02)
+#define EVENT_GROUP_SW						(0x01)
+/** Defines the bits for the speed event group of the first motor (The next motors follow)*/
+#define EVENT_GROUP_RPM						(0x02)
+/** Defines the bits for the speed event groups of all the motors*/
+#define EVENT_GROUP_RPM_ALL					(((BIT_TO_SHIFT << RTOS_MOTORS_MAX) - 1) * EVENT_GROUP_RPM)
+/** Defines the bits for the analog zone event group (After the motors)*/
+#define EVENT_GROUP_ZONE					(EVENT_GROUP_RPM << RTOS_MOTORS_MAX)
 
 /** Defines the pin for the red LED*/
 #define RED_LED_PIN            				(15U)
@@ -60,30 +68,21 @@
 /** Defines a bit to be shifted in masks*/
 #define BIT_TO_SHIFT						(1)
 
-/** Defines the interrupt bits of MB4 in IFLAG1*/
-#define MB_4_INTERRUPT						(0x10)
-/** Defines the bits to clear all IFLAG1 bits*/
-#define CLEAR_ALL_FLAGS						(0xFFFFFFFE)
-
-/** Defines the ID of the ADC message*/
-#define RPM_TX_ID							(0x11)
+/** Defines the frames available bit of the Rx FIFO in IFLAG1*/
+#define RX_FIFO_INTERRUPT					(0x20)
 
 /** Defines a mask to get a low byte*/
 #define LOW_BYTE_MASK						(0x00FF)
 /** Defines a mask to get a high byte*/
 #define HIGH_BYTE_MASK						(0xFF00)
 
-/** Defines the ID of the ADC message*/
-#define RPM_RX_ID							(0x10)
+/** Defines the ID of the speed commands, the lowest ID of the ID function vector*/
+#define RPM_RX_ID							(CAN_SIG_SPEED_RX_ID)
 /** Defines the maximum possible ID*/
 #define MAX_ID								(0x7FF)
 
 /** Defines the bit shifts for a byte*/
 #define BYTE_SHIFT							(8)
-/** Defines the position of the ADC low byte in the ADC vector*/
-#define ADC_LOW_BYTE_POS					(0)
-/** Defines the position of the ADC high byte in the ADC vector*/
-#define ADC_HIGH_BYTE_POS					(1)
 
 /** Defines the ID as not repeated in the ID function vector*/
 #define ID_NOT_REPEATED						(0)
@@ -95,30 +94,52 @@
 /** Defines the ID as not found in the ID function vector*/
 #define ID_NOT_FOUND						(1)
 
-/** Defines the relation to get the ticks for 1 ms*/
-#define FIX_PERIOD							((10.0025F) / (6.0F))
 
 /** Defines the initial period of the Rx task*/
 #define RX_TASK_INIT_PERIOD					(100U)
+/** Defines the window of the frame rate of the adaptive RX, in milliseconds*/
+#define RX_ADAPTIVE_WINDOW					(50U)
+/** Defines the frames of a window to switch to polling (500 frames/s)*/
+#define RX_ADAPTIVE_HIGH_FRAMES				(25U)
+/** Defines the frames of a window to switch back to the interruption (200 frames/s)*/
+#define RX_ADAPTIVE_LOW_FRAMES				(10U)
+/** Defines the period of the adaptive polling, in milliseconds*/
+#define RX_ADAPTIVE_POLL_PERIOD				(1U)
+/** Defines the maximum frames received by a poll or an interruption (A full Rx FIFO)*/
+#define RX_ADAPTIVE_POLL_BUDGET				(CAN_RX_FIFO_DEPTH)
+/** Defines the RX thread as waiting for the interruption*/
+#define RX_STATE_INTERRUPT					(0)
+/** Defines the RX thread as polling (Interruption masked)*/
+#define RX_STATE_POLLING					(1)
 /** Defines the initial period of the Tx task*/
 #define TX_TASK_INIT_PERIOD					(1000U)
 /** Defines the initial period of the ADC task*/
 #define ADC_TX_TASK_INIT_PERIOD				(1000U)
+/** Defines the period of the SBC flags read, in milliseconds*/
+#define SBC_POLL_PERIOD						(1000U)
 
 /** Defines the maximum DLC message size*/
 #define CAN_MESSAGE_MAX_SIZE				(8)
 /** Defines the maximum size of the ID function vector*/
 #define ID_VECTOR_MAX_SIZE					(15)
 
-/** Defines the initial threshold of the red LED*/
-#define RED_LED_INIT_THRESHOLD				(3750)
-/** Defines the initial threshold of the yellow LED*/
-#define YELLOW_LED_INIT_THRESHOLD			(2500)
-/** Defines the initial threshold of the green LED*/
-#define GREEN_LED_INIT_THRESHOLD			(1250)
-
-/** Defines the ADC channel to read the potentiometer*/
-#define ADC_POT_CHANNEL						(12)
+/** Defines the default hysteresis of the speed message, in RPM*/
+#define SPEED_TX_HYSTERESIS					(1U)
+/** Defines the default minimum interval of the speed message, in milliseconds*/
+#define SPEED_TX_MIN_INTERVAL				(50U)
+/** Defines the default heartbeat of the speed message, in milliseconds*/
+#define SPEED_TX_HEARTBEAT					(1000U)
+
+/** Defines the threshold of the green zone of the analog input, in mV*/
+#define GREEN_ZONE_THRESHOLD				(1250)
+/** Defines the threshold of the yellow zone of the analog input, in mV*/
+#define YELLOW_ZONE_THRESHOLD				(2500)
+/** Defines the threshold of the red zone of the analog input, in mV*/
+#define RED_ZONE_THRESHOLD					(3750)
+/** Defines the hysteresis of the zones, in mV*/
+#define ZONE_HYSTERESIS						(50)
+/** Defines the DLC of the zone message (Zone, and the voltage in mV)*/
+#define ZONE_MSG_DLC						(3)
 
 /** Defines an oversize of the ID function vector*/
 #define ID_VECTOR_OVER_SIZE					(200)
@@ -133,19 +154,120 @@
 typedef struct
 {
 	uint8_t init_val;					/*!< Defines whether the handler has been initialized or not*/
+	uint8_t start_val;					/*!< Defines whether the hardware has been started or not (rtos_can_start)*/
 	SemaphoreHandle_t sem_rx_binary;	/*!< Binary semaphore for the Rx task*/
 	SemaphoreHandle_t mutex;			/*!< Mutex to protect the CAN when sending and receiving*/
 	EventGroupHandle_t event_group;		/*!< Event group for the Tx task*/
+	TimerHandle_t sbc_timer;			/*!< Timer of the SBC flags read*/
 }RTOS_CAN_Handler_t;
 
+/*!
+ 	 \brief Structure for the RX handler.
+ */
+typedef struct
+{
+	volatile rtos_rx_mode_t mode;		/*!< Mode set with set_rx_mode*/
+	uint8_t state;						/*!< Whether the thread waits for the interruption or polls*/
+	TickType_t state_start;				/*!< Tick count when the current state started*/
+	TickType_t interrupt_ticks;			/*!< Ticks of the previous interruption states*/
+	TickType_t polling_ticks;			/*!< Ticks of the previous polling states*/
+	uint32_t interrupt_frames;			/*!< Frames received with the interruption*/
+	uint32_t polling_frames;			/*!< Frames received by polling*/
+	uint32_t switches;					/*!< Switches from the interruption to polling*/
+	uint32_t overflows;					/*!< Drains that found the Rx FIFO overflowed*/
+}rtos_rx_handler_t;
+
+/*!
+ 	 \brief Structure for a motor on the CAN.
+ */
+typedef struct
+{
+	rtos_motor_t config;		/*!< CAN identity, motor and control loop*/
+	motor_speed_t speed;		/*!< Speed read from the motor*/
+	TX_POLICY_t tx_policy;		/*!< Transmission policy of the speed message*/
+}rtos_motor_handler_t;
+
 /*********************************************************************************************/
 
+/*!
+ 	 \brief This function sets a received speed command as the target of its motor.
+
+ 	 \param[in] rx_msg Message received.
+
+ 	 \return ID_FOUND if the ID is of a motor, ID_NOT_FOUND otherwise.
+ */
+static uint8_t rtos_speed_command(const can_message_rx_config_t* rx_msg);
+
+/*!
+ 	 \brief This function receives a message and calls its callback (Speed command of a
+ 	 	 	 motor, or the ID function vector).
+
+ 	 \return void.
+ */
+static void rtos_rx_process(void);
+
+/*!
+ 	 \brief This function sets the state of the RX thread: it masks the RX interruption
+ 	 	 	 to poll, or enables it, and accounts the time of the state that ends.
+
+ 	 \param[in] state RX_STATE_INTERRUPT or RX_STATE_POLLING.
+
+ 	 \return void.
+ */
+static void rtos_rx_set_state(uint8_t state);
+
+/*!
+ 	 \brief This function is the callback of the analog zone changes, in the ADC
+ 	 	 	 interrupt. It sets the zone event of the tx thread.
+
+ 	 \param[in] zone New zone.
+ 	 \param[in] result Conversion that left the previous zone.
+
+ 	 \return void.
+ */
+static void rtos_zone_callback(uint8_t zone, uint16_t result);
+
+/*!
+ 	 \brief This function is the callback of the SBC timer. It only queues the read
+ 	 	 	 of the SBC flags, the SPI runs by interrupt.
+
+ 	 \param[in] timer Timer.
+
+ 	 \return void.
+ */
+static void rtos_sbc_poll(TimerHandle_t timer);
+
+/*!
+ 	 \brief This function sends a message via CAN and accounts it in the bus statistics
+ 	 	 	 and the boot profile.
+
+ 	 \note Call it with the CAN mutex taken.
+
+ 	 \param[in] can_message_tx Message structure with the data to be transmitted.
+
+ 	 \return Time stamp of the message.
+ */
+static uint16_t rtos_send_message(can_message_tx_config_t can_message_tx);
+
+/*!
+ 	 \brief This function receives a message from CAN and accounts it in the bus statistics.
+
+ 	 \note Call it with the CAN mutex taken.
+
+ 	 \param[out] can_message_rx Message structure where the data is received.
+
+ 	 \return void.
+ */
+static void rtos_receive_message(can_message_rx_config_t* can_message_rx);
+
 /*********************************************************************************************/
 
 /** RTOS handler for the CAN*/
 static RTOS_CAN_Handler_t can_handler = { INIT_VAL };
 /** Variable for the rx thread period*/
 static uint32_t rx_task_period = RX_TASK_INIT_PERIOD;
+/** RX handler, starts in RX_MODE*/
+static rtos_rx_handler_t rx_handler = { RX_MODE };
 /** Variable for the tx thread period*/
 static uint32_t tx_task_period = TX_TASK_INIT_PERIOD;
 /** Variable for the speed thread period*/
@@ -157,8 +279,30 @@ static uint8_t ID_SW = INIT_VAL;
 static uint8_t msg_SW[CAN_MESSAGE_MAX_SIZE] = {INIT_VAL};
 /** DLC of the SW3 message*/
 static uint8_t DLC_SW = INIT_VAL;
-/** Variable for the value read from the motor*/
-static motor_speed_t speed = {INIT_VAL, motor_forward};
+/** ID for the zone message*/
+static uint16_t ID_zone = INIT_VAL;
+/** Zones of the analog input, from its thresholds*/
+static const uint16_t zone_thresholds[] =
+{
+	ADC_MONITOR_MV(GREEN_ZONE_THRESHOLD),
+	ADC_MONITOR_MV(YELLOW_ZONE_THRESHOLD),
+	ADC_MONITOR_MV(RED_ZONE_THRESHOLD)
+};
+/** Last zone of the analog input*/
+static volatile uint8_t zone_current = INIT_VAL;
+/** Conversion that changed the zone*/
+static volatile uint16_t zone_result = INIT_VAL;
+/** Motors on the CAN*/
+static rtos_motor_handler_t motors[RTOS_MOTORS_MAX];
+/** Motors counter*/
+static uint8_t motors_counter = INIT_VAL;
+/** Transmission policy of the speed messages*/
+static TX_POLICY_config_t speed_tx_policy =
+{
+	SPEED_TX_HYSTERESIS,
+	SPEED_TX_MIN_INTERVAL,
+	SPEED_TX_HEARTBEAT
+};
 
 /** ID function vector*/
 static ID_function_t ID_function[ID_VECTOR_MAX_SIZE] = {{INIT_VAL, NULL}};
@@ -178,18 +322,18 @@ static CAN_Type* can_base;
 
 /*********************************************************************************************/
 
-/** Interruption for the RX message buffer*/
-void CAN_RX_Interrupt(void)
+/** Interruption for the Rx FIFO (It runs from RAM in the flash builds)*/
+HOT_PATH_RAMSECTION void CAN_RX_Interrupt(void)
 {
-	/** If the interruption was caused by the MB*/
-	if(can_base->IFLAG1 & MB_4_INTERRUPT)
+	/** If the interruption was caused by the Rx FIFO*/
+	if(can_base->IFLAG1 & RX_FIFO_INTERRUPT)
 	{
+		/** The flag stays set until the FIFO is drained, the RX thread enables the interruption again*/
+		can_base->IMASK1 &= ~RX_FIFO_INTERRUPT;
+
 		/** Releases the semaphore to received the data*/
 		xSemaphoreGiveFromISR(can_handler.sem_rx_binary, pdFALSE);
 	}
-
-	/** Clears the interruption flags*/
-	can_base->IFLAG1 = CLEAR_ALL_FLAGS;
 }
 
 /** Interruption for the SW3*/
@@ -202,9 +346,31 @@ void SW3_ISR(void)
 	xEventGroupSetBitsFromISR(can_handler.event_group, EVENT_GROUP_SW, pdFALSE);
 }
 
+/** This function starts the hardware of the CAN*/
+void rtos_can_start(CAN_Type* base)
+{
+	/*********************** NOTE ***************************/
+	/** This module is taken from the driver example FlexCAN*/
+	/********************************************************/
+	/** From here *****************************************************************************/
+	PORT_init();             /* Configure ports */
+	LPSPI1_init_master();    /* Initialize LPSPI1 for communication with MC33903 */
+	LPSPI1_init_MC33903();   /* Configure SBC via SPI for CAN transceiver operation */
+	/** To here *******************************************************************************/
+
+	/** The FlexCAN enters freeze mode while the rest is initialized*/
+	CAN_enable(base);
+
+	/** Sets the hardware as started*/
+	can_handler.start_val = IS_INIT;
+}
+
 /** This function initializes the RTOS*/
-void rtos_can_init(can_init_config_t can_init)
+status_t rtos_can_init(can_init_config_t can_init)
 {
+	/** Status of the CAN init*/
+	status_t status;
+
 	/** Set the handler as initialized*/
 	can_handler.init_val = IS_INIT;
 	/** Creates the semaphores and the event group*/
@@ -212,26 +378,19 @@ void rtos_can_init(can_init_config_t can_init)
 	can_handler.mutex = xSemaphoreCreateMutex();
 	can_handler.event_group = xEventGroupCreate();
 
-	/*********************** NOTE ***************************/
-	/** This module is taken from the driver example FlexCAN*/
-	/********************************************************/
-	/** From here *****************************************************************************/
-	SOSC_init_8MHz();       /* Initialize system oscillator for 8 MHz xtal */
-	SPLL_init_160MHz();     /* Initialize SPLL to 160 MHz with 8 MHz SOSC */
-	NormalRUNmode_80MHz();  /* Init clocks: 80 MHz sysclk & core, 40 MHz bus, 20 MHz flash */
-	/** To here *******************************************************************************/
+	/** The clocks (80 MHz core, 40 MHz bus, SPLLDIV2 at 40 MHz for the LPSPI) are set by the clock manager*/
+	if(IS_INIT != can_handler.start_val)
+	{
+		rtos_can_start(can_init.base);
+	}
 
 	/** Sets the configured base*/
 	can_base = can_init.base;
 
 	/** Initializes the CAN*/
-	CAN_Init(can_init);
+	status = CAN_Init(can_init);
 
-#if(!RX_MODE)
-	/** Enables the CAN RX message buffer interruption*/
-	CAN_enable_rx_interruption(can_base);
-
-	/** Sets the IRQ hadler, enables it and sets its priority*/
+	/** Sets the IRQ hadler, enables it and sets its priority (The RX thread masks the MB interruption to poll)*/
 	if(CAN0 == can_base)
 	{
 		INT_SYS_InstallHandler(CAN0_ORed_0_15_MB_IRQn, CAN_RX_Interrupt, (isr_t *)NULL);
@@ -250,17 +409,16 @@ void rtos_can_init(can_init_config_t can_init)
 		INT_SYS_EnableIRQ(CAN2_ORed_0_15_MB_IRQn);
 		INT_SYS_SetPriority(CAN2_ORed_0_15_MB_IRQn, CAN_RX_INTERRUPT_PRIO);
 	}
-#endif
+
+	/** Reads the SBC flags periodically, without a thread*/
+	can_handler.sbc_timer = xTimerCreate("SBC", (SBC_POLL_PERIOD * FIX_PERIOD), pdTRUE, NULL, rtos_sbc_poll);
+	xTimerStart(can_handler.sbc_timer, INIT_VAL);
 
 	/*********************** NOTE ***************************/
 	/** This module is taken from the driver example FlexCAN,
 	 	 and the Blinking_LED example*/
 	/********************************************************/
 	/** From here *****************************************************************************/
-	PORT_init();             /* Configure ports */
-	LPSPI1_init_master();    /* Initialize LPSPI1 for communication with MC33903 */
-	LPSPI1_init_MC33903();   /* Configure SBC via SPI for CAN transceiver operation */
-
 	/**************** LED CONFIGURATION ********************/
 	 /* Configure clock source */
 	PCC_HAL_SetClockMode(PCC, LED_PORT_PCC, false);
@@ -271,9 +429,7 @@ void rtos_can_init(can_init_config_t can_init)
 	PCC_HAL_SetClockSourceSel(PCC, BTN_PORT_PCC, CLK_SRC_FIRC);
 	PCC_HAL_SetClockMode(PCC, BTN_PORT_PCC, true);
 
-	/* Configure ports */
-	PORT_HAL_SetMuxModeSel(LED_PORT, RED_LED_PIN,      PORT_MUX_AS_GPIO);
-	PORT_HAL_SetMuxModeSel(LED_PORT, GREEN_LED_PIN,      PORT_MUX_AS_GPIO);
+	/* Configure ports (The LED pins are set as GPIO by PORT_init) */
 	PORT_HAL_SetMuxModeSel(BTN_PORT, BTN_PIN,   PORT_MUX_AS_GPIO);
 	PORT_HAL_SetPinIntSel(BTN_PORT, BTN_PIN, PORT_INT_RISING_EDGE);
 
@@ -296,6 +452,8 @@ void rtos_can_init(can_init_config_t can_init)
     INT_SYS_SetPriority( BTN_PORT_IRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY );
 
 	/** To here *******************************************************************************/
+
+	return status;
 }
 
 /** CAN tx thread that transmits either the message of the ADC, or the
@@ -303,9 +461,17 @@ void rtos_can_init(can_init_config_t can_init)
 void rtos_can_tx_thread_EG(void* args)
 {
 	/** Initializes the ADC message array*/
-	uint8_t speed_tx_msg[2] = {INIT_VAL};
+	uint8_t speed_tx_msg[CAN_SIG_SPEED_TX_DLC] = {INIT_VAL};
+	/** Zone message array*/
+	uint8_t zone_msg[ZONE_MSG_DLC] = {INIT_VAL};
+	/** Voltage of the zone change, in mV*/
+	uint16_t zone_mv;
+	/** Signals of the ADC message*/
+	can_sig_speed_tx_t speed_tx_signals;
 	/** Variable to get the event group bits*/
 	EventBits_t tx_event;
+	/** Counter for the motors*/
+	uint8_t motor = INIT_VAL;
 
 	/** If the CAN handler has been initialized*/
 	if (IS_INIT == can_handler.init_val)
@@ -314,27 +480,34 @@ void rtos_can_tx_thread_EG(void* args)
 		for(;;)
 		{
 			/** Waits for any of the event group bits to be released*/
-			xEventGroupWaitBits(can_handler.event_group, EVENT_GROUP_RPM | EVENT_GROUP_SW, pdFALSE, pdFALSE, portMAX_DELAY);
+			xEventGroupWaitBits(can_handler.event_group, EVENT_GROUP_RPM_ALL | EVENT_GROUP_SW | EVENT_GROUP_ZONE, pdFALSE, pdFALSE, portMAX_DELAY);
 			/** Gets the event group bits*/
 			tx_event = xEventGroupGetBits(can_handler.event_group);
 			/** Clears the event group bits*/
 			xEventGroupClearBits(can_handler.event_group, tx_event);
 
-			/** For the ADC event group*/
-			if(EVENT_GROUP_RPM == (tx_event & EVENT_GROUP_RPM))
+			/** For the speed event group of each motor*/
+			for(motor = INIT_VAL ; motor < motors_counter ; motor ++)
 			{
-				speed_tx_msg[0] = (uint8_t)speed.direction;
-				speed_tx_msg[1] = speed.RPM;
+				if(INIT_VAL == (tx_event & (EVENT_GROUP_RPM << motor)))
+				{
+					continue;
+				}
+
+				/** Packs the signals with the layout generated from the DBC*/
+				speed_tx_signals.direction = (uint8_t)motors[motor].speed.direction;
+				speed_tx_signals.RPM = motors[motor].speed.RPM;
+				CAN_SIG_pack_speed_tx(speed_tx_msg, &speed_tx_signals);
 
-				/** Sets the values for the tx message*/
+				/** Sets the values for the tx message, with the ID of the motor*/
 				tx_message.base = can_base;
-				tx_message.ID = RPM_TX_ID;
+				tx_message.ID = motors[motor].config.tx_ID;
 				tx_message.msg = speed_tx_msg;
 				tx_message.DLC = sizeof(speed_tx_msg);
 
 				/** Sends the message protecting the CAN with a mutex*/
 				xSemaphoreTake(can_handler.mutex, portMAX_DELAY);
-				CAN_send_message(tx_message);
+				rtos_send_message(tx_message);
 				xSemaphoreGive(can_handler.mutex);
 			}
 
@@ -349,7 +522,27 @@ void rtos_can_tx_thread_EG(void* args)
 
 				/** Sends the message protecting the CAN with a mutex*/
 				xSemaphoreTake(can_handler.mutex, portMAX_DELAY);
-				CAN_send_message(tx_message);
+				rtos_send_message(tx_message);
+				xSemaphoreGive(can_handler.mutex);
+			}
+
+			/** For the analog zone event group*/
+			if(EVENT_GROUP_ZONE == (tx_event & EVENT_GROUP_ZONE))
+			{
+				/** Sends the last zone, with the voltage that changed it*/
+				zone_mv = (uint16_t)((zone_result * ADC_MONITOR_VREF_MV) / ADC_MONITOR_RESULT_MAX);
+				zone_msg[0] = zone_current;
+				zone_msg[1] = (uint8_t)((zone_mv & HIGH_BYTE_MASK) >> BYTE_SHIFT);
+				zone_msg[2] = (uint8_t)(zone_mv & LOW_BYTE_MASK);
+
+				tx_message.base = can_base;
+				tx_message.ID = ID_zone;
+				tx_message.msg = zone_msg;
+				tx_message.DLC = sizeof(zone_msg);
+
+				/** Sends the message protecting the CAN with a mutex*/
+				xSemaphoreTake(can_handler.mutex, portMAX_DELAY);
+				rtos_send_message(tx_message);
 				xSemaphoreGive(can_handler.mutex);
 			}
 		}
@@ -379,7 +572,7 @@ void rtos_can_tx_thread_periodic(void *args)
 
 			/** Sends the message protecting the CAN with a mutex*/
 			xSemaphoreTake(can_handler.mutex, portMAX_DELAY);
-			CAN_send_message(tx_message);
+			rtos_send_message(tx_message);
 			xSemaphoreGive(can_handler.mutex);
 
 			/** Delay to make the function periodical*/
@@ -388,146 +581,130 @@ void rtos_can_tx_thread_periodic(void *args)
 	}
 }
 
-#if(!RX_MODE)
-/** This thread receives a message using interruption.*/
-void rtos_can_rx_thread_interruption(void *args)
+/** This thread receives the messages in the mode set*/
+void rtos_can_rx_thread(void *args)
 {
-	/** Variable for the received ADC value*/
-	motor_speed_t received_speed_val = {INIT_VAL, motor_forward};
-	/** Counter for the ID function vector*/
-	uint8_t ID_counter = INIT_VAL;
+	/** Variable to count the ticks passed since the delay*/
+	TickType_t xLastWakeTime;
+	/** Tick count when the current window started*/
+	TickType_t window_start;
+	/** Frames received in the current window*/
+	uint32_t window_frames = INIT_VAL;
+	/** Frames received by the current poll*/
+	uint32_t budget = INIT_VAL;
+	/** State for the next window*/
+	uint8_t state = RX_STATE_INTERRUPT;
 
 	/** If the CAN handler has been initialized*/
 	if(IS_INIT == can_handler.init_val)
 	{
+		/** Gets the current tick count*/
+		xLastWakeTime = xTaskGetTickCount();
+		window_start = xLastWakeTime;
+
+		/** Only the periodic mode starts polling*/
+		rx_handler.state_start = xLastWakeTime;
+		rtos_rx_set_state((rx_mode_periodic == rx_handler.mode) ? RX_STATE_POLLING : RX_STATE_INTERRUPT);
+
 		/** Infinite cycle*/
 		for(;;)
 		{
-			/** Takes the interruption semaphore*/
-			xSemaphoreTake(can_handler.sem_rx_binary, portMAX_DELAY);
+			if(RX_STATE_INTERRUPT == rx_handler.state)
+			{
+				/** Takes the interruption semaphore, the timeout lets the window end without frames*/
+				if(pdTRUE == xSemaphoreTake(can_handler.sem_rx_binary, (RX_ADAPTIVE_WINDOW * FIX_PERIOD)))
+				{
+					/** Drains the Rx FIFO, the frames queued meanwhile are read by the same interruption*/
+					for(budget = INIT_VAL ; (budget < RX_ADAPTIVE_POLL_BUDGET) && CAN_get_rx_status(can_base) ; budget ++)
+					{
+						rtos_rx_process();
+						window_frames ++;
+						rx_handler.interrupt_frames ++;
+					}
 
-			/** Sets the base*/
-			rx_message.base = can_base;
+					/** Frames were lost since the last drain*/
+					if(CAN_clear_rx_overflow(can_base))
+					{
+						rx_handler.overflows ++;
+					}
 
-			/** Receives a message protecting CAN*/
-			xSemaphoreTake(can_handler.mutex, portMAX_DELAY);
-			CAN_receive_message(&rx_message);
-			xSemaphoreGive(can_handler.mutex);
+					/** The frames left in the FIFO interrupt right away*/
+					CAN_enable_rx_interruption(can_base);
+				}
+			}
 
-			/** Checks the received IDs*/
-			switch(rx_message.ID)
+			else
 			{
-				/** Specific case for the RPM ID*/
-				case RPM_RX_ID:
-					/** Sets the value received the speed variable*/
-					received_speed_val.direction = (motor_direction_t)(rx_message.msg[ADC_LOW_BYTE_POS]);
-					received_speed_val.RPM = (uint8_t)(rx_message.msg[ADC_HIGH_BYTE_POS]);
-
-					/** Turns on the LED according to the received speed value*/
-					rtos_turn_on_leds(received_speed_val);
-
-					/** Updates the duty cycle according to the values received*/
-					MC_update_duty_cycle(received_speed_val);
+				/** The periodic mode keeps its period, the adaptive one polls faster than the frames arrive*/
+				vTaskDelayUntil(&xLastWakeTime, (((rx_mode_periodic == rx_handler.mode) ? rx_task_period : RX_ADAPTIVE_POLL_PERIOD) * FIX_PERIOD));
 
-				    /* Wait a number of cycles for the PWM to reach stability */
-					vTaskDelay(10);
-				break;
+				/** Queries the status of the Rx flag, the budget bounds the time of a poll*/
+				for(budget = INIT_VAL ; (budget < RX_ADAPTIVE_POLL_BUDGET) && CAN_get_rx_status(can_base) ; budget ++)
+				{
+					rtos_rx_process();
+					window_frames ++;
+					rx_handler.polling_frames ++;
+				}
 
-				/** For any other ID*/
-				default:
-					/** Checks the ID function vector (Only the initialized IDs)*/
-					for(ID_counter = INIT_VAL ; ID_counter < ID_func_counter ; ID_counter ++)
-					{
-						/** If the received ID exists in the ID function vector*/
-						if(rx_message.ID == ID_function[ID_counter].ID)
-						{
-							/** Calls the corresponding function*/
-							ID_function[ID_counter].ID_func(rx_message);
-						}
-					}
-				break;
+				/** Frames were lost since the last drain*/
+				if(CAN_clear_rx_overflow(can_base))
+				{
+					rx_handler.overflows ++;
+				}
 			}
-		}
-	}
-}
-#endif
-
-#if(RX_MODE)
-/** This thread receives a message, by checking the RX flag
- 	 periodically (Polling). The default period is 100ms.*/
-void rtos_can_rx_thread_periodic(void *args)
-{
-	/** Variable for the received ADC value*/
-	motor_speed_t received_speed_val = {INIT_VAL, motor_forward};
-	/** Counter for the ID function vector*/
-	uint8_t ID_counter = INIT_VAL;
-	/** Variable to count the ticks passed since the delay*/
-	TickType_t xLastWakeTime;
 
-	/** If the CAN handler has been initialized*/
-	if(IS_INIT == can_handler.init_val)
-	{
-		/** Gets the current tick count*/
-		xLastWakeTime = xTaskGetTickCount();
+			/** The state is decided once per window, from the mode and the frame rate*/
+			if((xTaskGetTickCount() - window_start) < (TickType_t)(RX_ADAPTIVE_WINDOW * FIX_PERIOD))
+			{
+				continue;
+			}
 
-		/** Infinite cycle*/
-		for(;;)
-		{
-			/** Queries the status of the Rx interruption*/
-			if(CAN_get_rx_status(can_base))
+			switch(rx_handler.mode)
 			{
-				/** Gets the configured bas*/
-				rx_message.base = can_base;
+				case rx_mode_interrupt:
+					state = RX_STATE_INTERRUPT;
+					break;
 
-				/** Receives the message protecting the CAN first*/
-				xSemaphoreTake(can_handler.mutex, portMAX_DELAY);
-				CAN_receive_message(&rx_message);
-				xSemaphoreGive(can_handler.mutex);
+				case rx_mode_periodic:
+					state = RX_STATE_POLLING;
+					break;
 
-				/** Clears the interruption flags*/
-				CAN_clear_tx_and_rx_flags(rx_message.base);
+				default:
+					/** Hysteresis between both thresholds*/
+					if(RX_ADAPTIVE_HIGH_FRAMES <= window_frames)
+					{
+						state = RX_STATE_POLLING;
+					}
 
-				/** Checks the received ID*/
-				switch(rx_message.ID)
-				{
-					/** For the RPM ID*/
-					case RPM_RX_ID:
-						/** Sets the value received into one variable*/
-						received_speed_val.direction = (motor_direction_t)(rx_message.msg[ADC_LOW_BYTE_POS]);
-						received_speed_val.RPM = (uint8_t)(rx_message.msg[ADC_HIGH_BYTE_POS]);
+					else if(RX_ADAPTIVE_LOW_FRAMES > window_frames)
+					{
+						state = RX_STATE_INTERRUPT;
+					}
 
-						/** Turns on the LED according to the received speed value*/
-						rtos_turn_on_leds(received_speed_val);
+					else
+					{
+						state = rx_handler.state;
+					}
+					break;
+			}
 
-						/** Updates the duty cycle according to the received value*/
-						MC_update_duty_cycle(received_speed_val);
+			window_frames = INIT_VAL;
+			window_start = xTaskGetTickCount();
 
-					    /* Wait a number of cycles for the PWM to reach stability */
-						vTaskDelay(10);
-					break;
+			if(state != rx_handler.state)
+			{
+				rtos_rx_set_state(state);
+				xLastWakeTime = window_start;
 
-					/** For any other ID*/
-					default:
-						/** Checks the ID function vector*/
-						for(ID_counter = INIT_VAL ; ID_counter < ID_func_counter ; ID_counter ++)
-						{
-							/** If the ID received exists in the function vector*/
-							if(rx_message.ID == ID_function[ID_counter].ID)
-							{
-								/** Calls the corresponding function*/
-								ID_function[ID_counter].ID_func(rx_message);
-							}
-						}
-					break;
+				/** A frame signaled right before the mask stays in the FIFO, and is polled*/
+				if(RX_STATE_POLLING == state)
+				{
+					xSemaphoreTake(can_handler.sem_rx_binary, INIT_VAL);
 				}
 			}
-
-			/** Delay to make the function periodic*/
-			vTaskDelayUntil(&xLastWakeTime, (rx_task_period * FIX_PERIOD));
 		}
 	}
 }
-#endif
 
 /** This function sets the message to be sent when a SW3 interruption occurrs*/
 void rtos_can_set_sw_msg(can_message_tx_config_t can_message_tx)
@@ -547,13 +724,36 @@ void rtos_can_set_sw_msg(can_message_tx_config_t can_message_tx)
 	DLC_SW = can_message_tx.DLC;
 }
 
+/** This function starts the monitor of the analog zones*/
+status_t rtos_zone_init(uint16_t tx_ID, uint8_t channel)
+{
+	/** Configuration of the monitor*/
+	ADC_MONITOR_config_t config;
+
+	/** The zone changes are events of the tx thread*/
+	if(IS_INIT != can_handler.init_val)
+	{
+		return STATUS_ERROR;
+	}
+
+	ID_zone = tx_ID;
+
+	config.channel = channel;
+	config.thresholds = zone_thresholds;
+	config.thresholds_count = sizeof(zone_thresholds) / sizeof(zone_thresholds[0]);
+	config.hysteresis = ADC_MONITOR_MV(ZONE_HYSTERESIS);
+	config.callback = rtos_zone_callback;
+
+	return ADC_MONITOR_init(&config);
+}
+
 /** This function receives from CAN protecting it with mutex*/
 void rtos_can_receive(can_message_rx_config_t *can_message_tx)
 {
 	/** Takes the mutex*/
 	xSemaphoreTake(can_handler.mutex, portMAX_DELAY);
 	/** Receives the message*/
-	CAN_receive_message(can_message_tx);
+	rtos_receive_message(can_message_tx);
 	/** Releases the mutex*/
 	xSemaphoreGive(can_handler.mutex);
 }
@@ -564,16 +764,36 @@ void rtos_can_transmit(can_message_tx_config_t can_message_tx)
 	/** Takes the mutex*/
 	xSemaphoreTake(can_handler.mutex, portMAX_DELAY);
 	/** Sends the message*/
-	CAN_send_message(can_message_tx);
+	rtos_send_message(can_message_tx);
+	/** Releases the mutex*/
+	xSemaphoreGive(can_handler.mutex);
+}
+
+/** This function transmits a message and gets its time stamp*/
+uint16_t rtos_can_transmit_timestamped(can_message_tx_config_t can_message_tx)
+{
+	/** Time stamp of the message*/
+	uint16_t timestamp;
+
+	/** Takes the mutex*/
+	xSemaphoreTake(can_handler.mutex, portMAX_DELAY);
+	/** Sends the message, it returns once the frame is on the bus with its time stamp*/
+	timestamp = rtos_send_message(can_message_tx);
 	/** Releases the mutex*/
 	xSemaphoreGive(can_handler.mutex);
+
+	return timestamp;
 }
 
-/** This function reads periodically the frequency of the motor*/
+/** This function reads periodically the speed of the motors*/
 void rtos_speed_read_thread(void *args)
 {
 	/** Variable to count the ticks passed since the delay*/
 	TickType_t xLastWakeTime;
+	/** Counter for the motors*/
+	uint8_t motor = INIT_VAL;
+	/** Speed events of the motors to be sent*/
+	EventBits_t rpm_events;
 
 	/** If the handler has been initialized*/
 	if(IS_INIT == can_handler.init_val)
@@ -584,11 +804,29 @@ void rtos_speed_read_thread(void *args)
 		/** Infinite cycle*/
 		for(;;)
 		{
-			/** Gets the speed using input capture*/
-			MC_get_RPM(&speed);
+			rpm_events = INIT_VAL;
+
+			for(motor = INIT_VAL ; motor < motors_counter ; motor ++)
+			{
+				/** Gets the speed of the motor from its encoder*/
+				MC_get_RPM(motors[motor].config.motor, &motors[motor].speed);
 
-			/** Releases the event group*/
-			xEventGroupSetBits(can_handler.event_group, EVENT_GROUP_RPM);
+				/** Releases the event group only on a change or a heartbeat (Reverse is negative)*/
+				if(tx_policy_skip != TX_POLICY_evaluate(&motors[motor].tx_policy,
+						(motor_reverse == motors[motor].speed.direction) ? -(int32_t)motors[motor].speed.RPM :
+																		   (int32_t)motors[motor].speed.RPM))
+				{
+					rpm_events |= (EVENT_GROUP_RPM << motor);
+				}
+			}
+
+			/** Samples the DAQ lists bound to the speed thread*/
+			XCP_event(XCP_EVENT_SPEED_TASK);
+
+			if(INIT_VAL != rpm_events)
+			{
+				xEventGroupSetBits(can_handler.event_group, rpm_events);
+			}
 
 			/** Delay to make the task periodically*/
 			vTaskDelayUntil(&xLastWakeTime, (speed_tx_task_period * FIX_PERIOD));
@@ -634,6 +872,52 @@ void set_rx_thread_period(uint32_t new_value)
 	rx_task_period = new_value;
 }
 
+/** This function sets the mode of the RX thread*/
+void set_rx_mode(rtos_rx_mode_t mode)
+{
+	rx_handler.mode = mode;
+}
+
+/** This function gets the mode of the RX thread*/
+rtos_rx_mode_t rtos_get_rx_mode(void)
+{
+	return rx_handler.mode;
+}
+
+/** This function gets the statistics of the RX thread*/
+void rtos_get_rx_stats(rtos_rx_stats_t* stats)
+{
+	/** Ticks with the interruption and polling*/
+	TickType_t interrupt_ticks;
+	TickType_t polling_ticks;
+
+	taskENTER_CRITICAL();
+
+	interrupt_ticks = rx_handler.interrupt_ticks;
+	polling_ticks = rx_handler.polling_ticks;
+
+	/** Adds the time of the current state*/
+	if(RX_STATE_POLLING == rx_handler.state)
+	{
+		polling_ticks += xTaskGetTickCount() - rx_handler.state_start;
+	}
+
+	else
+	{
+		interrupt_ticks += xTaskGetTickCount() - rx_handler.state_start;
+	}
+
+	stats->interrupt_frames = rx_handler.interrupt_frames;
+	stats->polling_frames = rx_handler.polling_frames;
+	stats->switches = rx_handler.switches;
+	stats->overflows = rx_handler.overflows;
+
+	taskEXIT_CRITICAL();
+
+	stats->interrupt_ms = (uint32_t)(interrupt_ticks / FIX_PERIOD);
+	stats->polling_ms = (uint32_t)(polling_ticks / FIX_PERIOD);
+}
+
 /** This function sets the period for the TX thread*/
 void set_tx_thread_period(uint32_t new_value)
 {
@@ -646,6 +930,24 @@ void set_speed_tx_thread_period(uint32_t new_value)
 	speed_tx_task_period = new_value;
 }
 
+/** This function sets the transmission policy of the speed message*/
+void set_speed_tx_policy(TX_POLICY_config_t config)
+{
+	/** Counter for the motors*/
+	uint8_t motor = INIT_VAL;
+
+	taskENTER_CRITICAL();
+
+	speed_tx_policy = config;
+
+	for(motor = INIT_VAL ; motor < motors_counter ; motor ++)
+	{
+		TX_POLICY_init(&motors[motor].tx_policy, config);
+	}
+
+	taskEXIT_CRITICAL();
+}
+
 /** This function turns on the red LED, turning off other LEDs*/
 void turn_on_red_LED()
 {
@@ -871,12 +1173,171 @@ ID_func_vector_state_t rtos_change_ID_function(ID_function_t ID_func_old, ID_fun
 	return retval;
 }
 
+/** This function adds a motor to the CAN*/
+ID_func_vector_state_t rtos_add_motor(rtos_motor_t motor)
+{
+	/** Sets the return value as successful*/
+	ID_func_vector_state_t retval = ID_func_vector_success;
+	/** Counter for the motors*/
+	uint8_t motor_counter = INIT_VAL;
+
+	/** If all the motors are set*/
+	if(RTOS_MOTORS_MAX <= motors_counter)
+	{
+		retval = ID_func_vector_full;
+	}
+
+	/** If an ID is not an 11-bit value*/
+	else if((MAX_ID < motor.rx_ID) || (MAX_ID < motor.tx_ID))
+	{
+		retval = ID_not_allowed;
+	}
+
+	else
+	{
+		/** The commands of each motor have their own ID*/
+		for(motor_counter = INIT_VAL ; motor_counter < motors_counter ; motor_counter ++)
+		{
+			if(motor.rx_ID == motors[motor_counter].config.rx_ID)
+			{
+				retval = ID_already_exist;
+			}
+		}
+
+		if(ID_func_vector_success == retval)
+		{
+			/** The threads do not see the motor before it is complete*/
+			taskENTER_CRITICAL();
+
+			motors[motors_counter].config = motor;
+			motors[motors_counter].speed.RPM = INIT_VAL;
+			motors[motors_counter].speed.direction = motor_forward;
+			TX_POLICY_init(&motors[motors_counter].tx_policy, speed_tx_policy);
+			motors_counter ++;
+
+			taskEXIT_CRITICAL();
+		}
+	}
+
+	return retval;
+}
+
 /** This function returns the ID function vector size*/
 uint8_t rtos_get_ID_function_vector_size(void)
 {
 	return ID_func_counter;
 }
 
+/** This function receives a message and calls its callback*/
+static void rtos_rx_process(void)
+{
+	/** Counter for the ID function vector*/
+	uint8_t ID_counter = INIT_VAL;
+
+	/** Sets the base*/
+	rx_message.base = can_base;
+
+	/** Receives a message protecting CAN (It pops the frame of the Rx FIFO)*/
+	xSemaphoreTake(can_handler.mutex, portMAX_DELAY);
+	rtos_receive_message(&rx_message);
+	xSemaphoreGive(can_handler.mutex);
+
+	/** Checks the IDs of the motors, the command is set as the target of the motor (The motion profile ramps the PWM)*/
+	if(ID_FOUND != rtos_speed_command(&rx_message))
+	{
+		/** Checks the ID function vector (Only the initialized IDs)*/
+		for(ID_counter = INIT_VAL ; ID_counter < ID_func_counter ; ID_counter ++)
+		{
+			/** If the received ID exists in the ID function vector*/
+			if(rx_message.ID == ID_function[ID_counter].ID)
+			{
+				/** Calls the corresponding function*/
+				ID_function[ID_counter].ID_func(rx_message);
+			}
+		}
+	}
+
+	/** Samples the DAQ lists bound to the reception*/
+	XCP_event(XCP_EVENT_CAN_RX);
+}
+
+/** This function sets the state of the RX thread*/
+static void rtos_rx_set_state(uint8_t state)
+{
+	/** Tick count when the state changes*/
+	TickType_t now = xTaskGetTickCount();
+
+	if(RX_STATE_POLLING == state)
+	{
+		/** The Rx flag is still set, and polled*/
+		CAN_disable_rx_interruption(can_base);
+	}
+
+	else
+	{
+		/** A flag set while polling interrupts right away*/
+		CAN_enable_rx_interruption(can_base);
+	}
+
+	taskENTER_CRITICAL();
+
+	/** Accounts the time of the state that ends*/
+	if(RX_STATE_POLLING == rx_handler.state)
+	{
+		rx_handler.polling_ticks += now - rx_handler.state_start;
+	}
+
+	else
+	{
+		rx_handler.interrupt_ticks += now - rx_handler.state_start;
+	}
+
+	if((RX_STATE_POLLING == state) && (RX_STATE_POLLING != rx_handler.state))
+	{
+		rx_handler.switches ++;
+	}
+
+	rx_handler.state = state;
+	rx_handler.state_start = now;
+
+	taskEXIT_CRITICAL();
+}
+
+/** This function sets a received speed command as the target of its motor*/
+static uint8_t rtos_speed_command(const can_message_rx_config_t* rx_msg)
+{
+	/** Variable for the received speed*/
+	motor_speed_t received_speed_val = {INIT_VAL, motor_forward};
+	/** Signals of the received speed message*/
+	can_sig_speed_rx_t speed_rx_signals;
+	/** Counter for the motors*/
+	uint8_t motor = INIT_VAL;
+
+	for(motor = INIT_VAL ; motor < motors_counter ; motor ++)
+	{
+		if(rx_msg->ID == motors[motor].config.rx_ID)
+		{
+			/** Sets the value received the speed variable*/
+			CAN_SIG_unpack_speed_rx(rx_msg->msg, &speed_rx_signals);
+			received_speed_val.direction = (motor_direction_t)speed_rx_signals.direction;
+			received_speed_val.RPM = speed_rx_signals.RPM;
+
+			/** Turns on the LED according to the received speed value (Only for the first motor)*/
+			if(INIT_VAL == motor)
+			{
+				rtos_turn_on_leds(received_speed_val);
+			}
+
+			/** Sets the values received as the target, the motion profile moves the PWM to it*/
+			SPEED_CTRL_set_target(motors[motor].config.control, received_speed_val);
+
+			return ID_FOUND;
+		}
+	}
+
+	return ID_NOT_FOUND;
+}
+
 /** This function sets the periodic message for TX*/
 void rtos_define_tx_periodic_msg(can_message_tx_config_t can_message_tx)
 {
@@ -886,3 +1347,48 @@ void rtos_define_tx_periodic_msg(can_message_tx_config_t can_message_tx)
 	message_to_send.msg = can_message_tx.msg;
 	message_to_send.DLC = can_message_tx.DLC;
 }
+
+/** This function is the callback of the analog zone changes*/
+static void rtos_zone_callback(uint8_t zone, uint16_t result)
+{
+	zone_current = zone;
+	zone_result = result;
+
+	/** Sets the event group bits*/
+	xEventGroupSetBitsFromISR(can_handler.event_group, EVENT_GROUP_ZONE, pdFALSE);
+}
+
+/** This function is the callback of the SBC timer*/
+static void rtos_sbc_poll(TimerHandle_t timer)
+{
+	LPSPI1_poll_MC33903();
+}
+
+/** This function sends a message and accounts it*/
+static uint16_t rtos_send_message(can_message_tx_config_t can_message_tx)
+{
+	/** Time stamp of the message*/
+	uint16_t timestamp;
+
+	/** It returns once the frame is on the bus*/
+	CAN_send_message(can_message_tx);
+	/** Reads the time stamp before another message uses the tx buffer*/
+	timestamp = CAN_get_tx_timestamp(can_message_tx.base);
+
+	/** Accounts the frame in the bus statistics*/
+	CAN_STATS_record(can_message_tx.ID, can_message_tx.DLC, timestamp);
+
+	/** The boot ends with the first frame on the bus*/
+	BOOT_PROFILE_mark(boot_profile_first_frame);
+
+	return timestamp;
+}
+
+/** This function receives a message and accounts it*/
+static void rtos_receive_message(can_message_rx_config_t* can_message_rx)
+{
+	CAN_receive_message(can_message_rx);
+
+	/** Accounts the frame in the bus statistics*/
+	CAN_STATS_record(can_message_rx->ID, can_message_rx->DLC, can_message_rx->timestamp);
+}
@@ -34,22 +34,22 @@
 /* RTOS includes. */
 #include "projdefs.h"
 #include "can_driver.h"
+#include "tx_policy.h"
 #include "semphr.h"
 #include "event_groups.h"
 
 /* Drivers include. */
 #include "transceiver.h"
-#include "clocks_and_modes.h"
+#include "status.h"
 
 #include "motor_control.h"
+#include "speed_control.h"
 
-/** Defines the RX thread to work by semaphores (Aperiodically)*/
-#define RX_INTERRUPT						(0)
-/** Defines the RX thread to work periodically*/
-#define RX_PERIODIC							(1)
+/** Sets the initial mode of the RX thread (set_rx_mode changes it at runtime)*/
+#define RX_MODE								rx_mode_adaptive
 
-/** Sets the mode of the RX thread*/
-#define RX_MODE								RX_INTERRUPT
+/** Defines the maximum number of motors on the CAN*/
+#define RTOS_MOTORS_MAX						(2)
 
 /*!
  	 \brief Enumerator to define the states of the ID function vector.
@@ -64,6 +64,29 @@ typedef enum
 	ID_already_exist		/*!< ID already exists in the ID vector*/
 }ID_func_vector_state_t;
 
+/*!
+ 	 \brief Enumerator to define the modes of the RX thread.
+ */
+typedef enum
+{
+	rx_mode_interrupt,		/*!< Every frame is signaled by the RX interruption*/
+	rx_mode_periodic,		/*!< The RX flag is polled with the period of set_rx_thread_period*/
+	rx_mode_adaptive		/*!< Interruption at low load, polling (RX interruption masked) at high load*/
+}rtos_rx_mode_t;
+
+/*!
+ 	 \brief Structure for the statistics of the RX thread.
+ */
+typedef struct
+{
+	uint32_t interrupt_ms;		/*!< Time spent with the RX interruption, in milliseconds*/
+	uint32_t polling_ms;		/*!< Time spent polling the RX flag, in milliseconds*/
+	uint32_t interrupt_frames;	/*!< Frames received with the RX interruption*/
+	uint32_t polling_frames;	/*!< Frames received by polling*/
+	uint32_t switches;			/*!< Switches from the interruption to polling*/
+	uint32_t overflows;			/*!< Drains that found the Rx FIFO overflowed (Frames were lost)*/
+}rtos_rx_stats_t;
+
 /*!
  	 \brief Structure to define the ID vector.
  */
@@ -73,15 +96,52 @@ typedef struct
 	void (*ID_func)(can_message_rx_config_t can_message_rx);	/*!< Pointer to the function to be executed*/
 }ID_function_t;
 
+/*!
+ 	 \brief Structure to define the CAN identity of a motor.
+ */
+typedef struct
+{
+	uint16_t rx_ID;			/*!< ID of the speed commands of the motor*/
+	uint16_t tx_ID;			/*!< ID of the speed read from the motor*/
+	MC_motor_t* motor;		/*!< Motor (Initialized with MC_init)*/
+	SPEED_CTRL_t* control;	/*!< Control loop of the motor (Initialized with SPEED_CTRL_init)*/
+}rtos_motor_t;
+
+/*!
+ 	 \brief This function starts the hardware of the CAN that takes long to be ready,
+ 	 	 	 without waiting for it: the configuration of the SBC is queued on
+ 	 	 	 LPSPI1 (spi_queue.h), and the FlexCAN is enabled in freeze mode. The
+ 	 	 	 init after it overlaps the SPI transfer and the freeze acknowledge.
+
+ 	 \note Call it right after the clocks and pins, before the scheduler starts
+ 	 	 	 (rtos_can_init calls it if it was not).
+
+ 	 \param[in] base CAN to be started.
+
+ 	 \return void.
+ */
+void rtos_can_start(CAN_Type* base);
+
+/*!
+ 	 \brief This function is the interruption of the Rx FIFO, it wakes up the RX thread
+ 	 	 	 and masks the interruption until the FIFO is drained.
+
+ 	 \note It is installed by rtos_can_init, it is public for the code placement
+ 	 	 	 benchmark (code_bench.h).
+
+ 	 \return void.
+ */
+void CAN_RX_Interrupt(void) HOT_PATH_RAMSECTION;
+
 /*!
  	 \brief This function initializes the handlers and drivers necessary to run
  	 	 	 CAN in FreeRTOS.
 
  	 \param[in] can_init Configuration for the CAN driver.
 
- 	 \return void.
+ 	 \return The status of the CAN init (STATUS_TIMEOUT if the FlexCAN is not ready).
  */
-void rtos_can_init(can_init_config_t can_init);
+status_t rtos_can_init(can_init_config_t can_init);
 
 /*!
  	 \brief CAN tx thread that transmits either the message of the speed, or the
@@ -90,6 +150,9 @@ void rtos_can_init(can_init_config_t can_init);
  	 \note The speed message is sent periodically, and the SW message is sent
  	 	 	 when SW3 is pressed.
 
+ 	 \note The zone message is sent when the analog input changes its zone (See
+ 	 	 	 rtos_zone_init).
+
  	 \note The ADC message period can be set with set_adc_tx_thread_period.
 
  	 \param[in] args Thread arguments. Set to NULL.
@@ -128,9 +191,17 @@ void rtos_define_tx_periodic_msg(can_message_tx_config_t can_message_tx);
  */
 void set_tx_thread_period(uint32_t new_value);
 
-#if(!RX_MODE)
 /*!
- 	 \brief This thread receives a message using interruption.
+ 	 \brief This thread receives the messages, in the mode set with set_rx_mode.
+
+ 	 \note In the adaptive mode the thread waits for the RX interruption while the
+ 	 	 	 frame rate is low. When the frames of a window reach RX_ADAPTIVE_HIGH_FRAMES,
+ 	 	 	 the interruption is masked and the RX flag is polled every
+ 	 	 	 RX_ADAPTIVE_POLL_PERIOD ms, up to RX_ADAPTIVE_POLL_BUDGET frames per
+ 	 	 	 poll. Under RX_ADAPTIVE_LOW_FRAMES the interruption is enabled again.
+
+ 	 \note The frames are queued by the Rx FIFO (CAN_RX_FIFO_DEPTH), in both states
+ 	 	 	 the thread drains it up to RX_ADAPTIVE_POLL_BUDGET frames.
 
  	 \note Use rtos_add_ID_function or rtos_change_ID_function to set a callback
  	 	 	 for when a certain ID is received.
@@ -139,32 +210,52 @@ void set_tx_thread_period(uint32_t new_value);
 
  	 \return void.
  */
-void rtos_can_rx_thread_interruption(void *args);
-#endif
+void rtos_can_rx_thread(void *args);
 
-#if RX_MODE
 /*!
- 	 \brief This thread receives a message, by checking the RX flag
- 	 	 	 periodically (Polling). The default period is 100ms.
+ 	 \brief This function sets the period of the RX thread in the periodic mode.
+ 	 	 	 The default period is 100ms.
 
- 	 \param[in] args Thread arguments. Set to NULL.
+ 	 \param[in] new_value New period, in milliseconds, of the RX thread.
 
  	 \return void.
  */
-void rtos_can_rx_thread_periodic(void *args);
+void set_rx_thread_period(uint32_t new_value);
 
 /*!
- 	 \brief This function sets the period of the RX thread.
+ 	 \brief This function sets the mode of the RX thread. The thread applies it
+ 	 	 	 within a window (RX_ADAPTIVE_WINDOW ms).
 
- 	 \param[in] new_value New period, in milliseconds, of the RX thread.
+ 	 \param[in] mode Interruption, periodic or adaptive.
 
  	 \return void.
  */
-void set_rx_thread_period(uint32_t new_value);
-#endif
+void set_rx_mode(rtos_rx_mode_t mode);
+
+/*!
+ 	 \brief This function gets the mode of the RX thread.
+
+ 	 \return Mode set with set_rx_mode (RX_MODE by default).
+ */
+rtos_rx_mode_t rtos_get_rx_mode(void);
 
 /*!
+ 	 \brief This function gets the statistics of the RX thread, the time of the
+ 	 	 	 current state included.
 
+ 	 \param[out] stats Time and frames with the interruption and polling.
+
+ 	 \return void.
+ */
+void rtos_get_rx_stats(rtos_rx_stats_t* stats);
+
+/*!
+ 	 \brief This thread reads the speed of every motor periodically, and releases
+ 	 	 	 the transmission of each one according to the speed tx policy.
+
+ 	 \param[in] args Thread arguments. Set to NULL.
+
+ 	 \return void.
  */
 void rtos_speed_read_thread(void *args);
 
@@ -177,6 +268,20 @@ void rtos_speed_read_thread(void *args);
  */
 void set_speed_tx_thread_period(uint32_t new_value);
 
+/*!
+ 	 \brief This function sets the transmission policy of the speed message.
+
+ 	 \note The speed is compared with the sign of the direction, so a change of
+ 	 	 	 direction is always beyond the hysteresis.
+
+ 	 \note The same policy applies to every motor, each one with its own state.
+
+ 	 \param[in] config Hysteresis (RPM), minimum interval and heartbeat interval (ms).
+
+ 	 \return void.
+ */
+void set_speed_tx_policy(TX_POLICY_config_t config);
+
 
 /*!
  	 \brief This function sets the message to be sent when the SW3 is pressed.
@@ -187,6 +292,21 @@ void set_speed_tx_thread_period(uint32_t new_value);
  */
 void rtos_can_set_sw_msg(can_message_tx_config_t can_message_tx);
 
+/*!
+ 	 \brief This function starts the monitor of an analog input (adc_monitor.h) with
+ 	 	 	 the green, yellow and red zones. Every zone change is an event of the tx
+ 	 	 	 thread, which sends the zone (Byte 0) and the voltage that changed it,
+ 	 	 	 in mV (Bytes 1 and 2, big endian). The CPU does not poll the input.
+
+ 	 \note Call it after rtos_can_init, and before the scheduler starts.
+
+ 	 \param[in] tx_ID ID of the zone message.
+ 	 \param[in] channel ADC1 channel of the input.
+
+ 	 \return STATUS_ERROR if the CAN is not initialized, or the status of ADC_MONITOR_init.
+ */
+status_t rtos_zone_init(uint16_t tx_ID, uint8_t channel);
+
 /*!
  	 \brief This function receives a message protecting the CAN with a mutex.
 
@@ -207,6 +327,16 @@ void rtos_can_receive(can_message_rx_config_t *can_message_tx);
  */
 void rtos_can_transmit(can_message_tx_config_t can_message_tx);
 
+/*!
+ 	 \brief This function transmits a message protecting the CAN with a mutex, and
+ 	 	 	 gets its tx time stamp before another message can be sent.
+
+ 	 \param[in] can_message_tx Message structure with the data to be transmitted.
+
+ 	 \return Value of the free running timer when the message was sent.
+ */
+uint16_t rtos_can_transmit_timestamped(can_message_tx_config_t can_message_tx);
+
 /*!
  	 \brief This function turns on the LEDs according to the RPM and direction
  	 	 	 of the motor
@@ -252,6 +382,20 @@ ID_func_vector_state_t rtos_remove_ID_function(ID_function_t ID_func);
  */
 ID_func_vector_state_t rtos_change_ID_function(ID_function_t ID_func_old, ID_function_t ID_func_new);
 
+/*!
+ 	 \brief This function adds a motor to the CAN. Its speed commands are set as the
+ 	 	 	 target of its control loop, and its speed is sent with its own ID.
+
+ 	 \note The IDs of the motors are checked before the ID function vector. The LEDs
+ 	 	 	 show the commands of the first motor added.
+
+ 	 \param[in] motor CAN identity, motor and control loop.
+
+ 	 \return ID_func_vector_success, ID_func_vector_full (RTOS_MOTORS_MAX), ID_not_allowed
+ 	 	 	 or ID_already_exist (The rx ID of another motor).
+ */
+ID_func_vector_state_t rtos_add_motor(rtos_motor_t motor);
+
 /*!
  	 \brief This function returns the number of IDs stored in the ID vector.
 
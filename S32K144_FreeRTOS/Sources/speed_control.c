@@ -0,0 +1,176 @@
+/*!
+ 	 \file speed_control.c
+
+ 	 \brief This is the source file of the closed loop speed control.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include "speed_control.h"
+#include "cycle_counter.h"
+#include "xcp.h"
+
+/** Defines the control loop as initialized*/
+#define IS_INIT								(1)
+/** Defines the control loop as not initialized*/
+#define NOT_INIT							(0)
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL							(0)
+
+/** Default gains and limits*/
+static const SPEED_PID_config_t speed_ctrl_default_config =
+{
+	SPEED_CTRL_DEFAULT_KP,
+	SPEED_CTRL_DEFAULT_KI,
+	SPEED_CTRL_DEFAULT_KD,
+	SPEED_CTRL_DEFAULT_OUT_MIN,
+	SPEED_CTRL_DEFAULT_OUT_MAX
+};
+
+/** Default limits of the profile*/
+static const MOTION_PROFILE_config_t speed_ctrl_default_profile =
+{
+	SPEED_CTRL_DEFAULT_ACCEL,
+	SPEED_CTRL_DEFAULT_JERK
+};
+
+/** This function initializes the control loop of a motor*/
+void SPEED_CTRL_init(SPEED_CTRL_t* ctrl, MC_motor_t* motor, uint8_t xcp_event, const SPEED_PID_config_t* config)
+{
+	if(NULL == config)
+	{
+		config = &speed_ctrl_default_config;
+	}
+
+	/** The thread does not step the loop while it is set*/
+	ctrl->init_val = NOT_INIT;
+	ctrl->motor = motor;
+	ctrl->xcp_event = xcp_event;
+	SPEED_PID_init(&ctrl->pid, config);
+	MOTION_PROFILE_init(&ctrl->profile, &speed_ctrl_default_profile);
+	ctrl->target = INIT_VAL;
+	ctrl->last_setpoint = INIT_VAL;
+	ctrl->cycles = INIT_VAL;
+	ctrl->cycles_max = INIT_VAL;
+
+	/** Sets the loop as initialized*/
+	ctrl->init_val = IS_INIT;
+}
+
+/** This function changes the gains and limits*/
+void SPEED_CTRL_set_config(SPEED_CTRL_t* ctrl, const SPEED_PID_config_t* config)
+{
+	/** The thread must not see half of the configuration*/
+	taskENTER_CRITICAL();
+	ctrl->pid.config = *config;
+	taskEXIT_CRITICAL();
+}
+
+/** This function changes the limits of the profile*/
+void SPEED_CTRL_set_profile(SPEED_CTRL_t* ctrl, const MOTION_PROFILE_config_t* config)
+{
+	/** The thread must not see half of the configuration*/
+	taskENTER_CRITICAL();
+	ctrl->profile.config = *config;
+	taskEXIT_CRITICAL();
+}
+
+/** This function sets the target speed*/
+void SPEED_CTRL_set_target(SPEED_CTRL_t* ctrl, motor_speed_t target)
+{
+	ctrl->target = MC_speed_to_q15(target);
+}
+
+/** This thread executes the control loop*/
+void SPEED_CTRL_thread(void* args)
+{
+	/** Control loop of the thread*/
+	SPEED_CTRL_t* ctrl = (SPEED_CTRL_t*)args;
+	/** Variable to store the last time the thread woke*/
+	TickType_t xLastWakeTime = xTaskGetTickCount();
+
+	for(;;)
+	{
+		vTaskDelayUntil(&xLastWakeTime, SPEED_CTRL_PERIOD_TICKS);
+
+		if(IS_INIT == ctrl->init_val)
+		{
+			SPEED_CTRL_step(ctrl);
+
+			/** Samples the DAQ lists of the control loop, the XCP thread sends them (The period never waits for the bus)*/
+			XCP_event(ctrl->xcp_event);
+		}
+	}
+}
+
+/** This function gets the cycles of a step*/
+void SPEED_CTRL_get_cycles(const SPEED_CTRL_t* ctrl, uint32_t* last, uint32_t* max)
+{
+	*last = ctrl->cycles;
+	*max = ctrl->cycles_max;
+}
+
+/** This function executes a step of the control loop*/
+void SPEED_CTRL_step(SPEED_CTRL_t* ctrl)
+{
+	/** Cycle count at the start of the step*/
+	uint32_t start_cycles = CYCLE_COUNTER_GET();
+	/** Setpoint of this step, moved towards the target (Read once since CAN can change it)*/
+	int16_t setpoint;
+#if SPEED_CTRL_MODE
+	/** Setpoint magnitude*/
+	int16_t target;
+	/** Measured speed, in the direction of the setpoint*/
+	int16_t measurement = MC_get_speed_q15(ctrl->motor);
+	/** Drive of the motor*/
+	int16_t drive = INIT_VAL;
+#endif
+
+	MOTION_PROFILE_set_target(&ctrl->profile, ctrl->target);
+	setpoint = MOTION_PROFILE_update(&ctrl->profile);
+
+#if SPEED_CTRL_MODE
+	target = setpoint;
+
+	/** The PID works on magnitudes, so the limits are the same for both directions*/
+	if(INIT_VAL > setpoint)
+	{
+		target = (int16_t)-setpoint;
+		measurement = (int16_t)-measurement;
+	}
+
+	/** A stop, or a change of direction, starts again from the open loop drive*/
+	if((INIT_VAL == setpoint) ||
+	   ((INIT_VAL > setpoint) != (INIT_VAL > ctrl->last_setpoint)))
+	{
+		SPEED_PID_reset(&ctrl->pid, measurement);
+	}
+
+	if(INIT_VAL != target)
+	{
+		/** The feed forward is the open loop drive of the setpoint*/
+		drive = SPEED_PID_update(&ctrl->pid, target, measurement, target);
+	}
+
+	MC_set_drive(ctrl->motor, (INIT_VAL > setpoint) ? (int16_t)-drive : drive);
+#else
+	/** The setpoint is the drive, as MC_update_duty_cycle*/
+	MC_set_drive(ctrl->motor, setpoint);
+#endif
+
+	ctrl->last_setpoint = setpoint;
+
+	/** Stores the cycles of the step*/
+	ctrl->cycles = CYCLE_COUNTER_GET() - start_cycles;
+
+	if(ctrl->cycles > ctrl->cycles_max)
+	{
+		ctrl->cycles_max = ctrl->cycles;
+	}
+}
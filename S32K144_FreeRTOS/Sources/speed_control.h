@@ -0,0 +1,167 @@
+/*!
+ 	 \file speed_control.h
+
+ 	 \brief This is the header file of the closed loop speed control. A fixed rate
+ 	 	 	 thread moves the setpoint towards the target with the motion profile,
+ 	 	 	 compares the speed measured by the encoder with the setpoint, and
+ 	 	 	 drives the motor with the fixed point PID.
+
+ 	 \note The feed forward is the open loop drive of MC_update_duty_cycle, so the
+ 	 	 	 PID only corrects the error of the linear map.
+
+ 	 \note Each motor has its own control loop and thread, with the loop as the
+ 	 	 	 argument of the thread.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef SPEED_CONTROL_H_
+#define SPEED_CONTROL_H_
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "motor_control.h"
+#include "speed_pid.h"
+#include "motion_profile.h"
+#include "tick_period.h"
+
+/** Defines the profiled speed received by CAN to be set directly as a duty cycle*/
+#define SPEED_CTRL_OPEN_LOOP				(0)
+/** Defines the speed received by CAN to be the target of the control loop*/
+#define SPEED_CTRL_CLOSED_LOOP				(1)
+
+/** Sets the mode of the speed control*/
+#define SPEED_CTRL_MODE						SPEED_CTRL_CLOSED_LOOP
+
+/** Defines the period of the control loop, in ticks (600 us, the tick runs at 1667 Hz, not 1 kHz)*/
+#define SPEED_CTRL_PERIOD_TICKS				(1)
+/** Defines the updates of the control loop per second (FIX_PERIOD ticks per ms)*/
+#define SPEED_CTRL_UPDATES_PER_S			((1000.0F * FIX_PERIOD) / SPEED_CTRL_PERIOD_TICKS)
+/** Defines the updates of the control loop in a time, in ms*/
+#define SPEED_CTRL_UPDATES(ms)				((int32_t)(((ms) * SPEED_CTRL_UPDATES_PER_S) / 1000.0F))
+
+/** Defines the default proportional gain (0.5)*/
+#define SPEED_CTRL_DEFAULT_KP				(16384)
+/** Defines the default integral gain per update (10 per second, 0.006 per update)*/
+#define SPEED_CTRL_DEFAULT_KI				((int32_t)((10.0F * 32768.0F) / SPEED_CTRL_UPDATES_PER_S))
+/** Defines the default derivative gain per update*/
+#define SPEED_CTRL_DEFAULT_KD				(0)
+/** Defines the default minimum drive (The loop does not brake by reversing)*/
+#define SPEED_CTRL_DEFAULT_OUT_MIN			(0)
+/** Defines the default maximum drive*/
+#define SPEED_CTRL_DEFAULT_OUT_MAX			(MC_SPEED_Q15_MAX)
+/** Defines the default acceleration of the profile (Full speed in 200 ms)*/
+#define SPEED_CTRL_DEFAULT_ACCEL			(((int32_t)MC_SPEED_Q15_MAX << MOTION_PROFILE_FRAC_BITS) / SPEED_CTRL_UPDATES(200))
+/** Defines the default jerk of the profile (Full acceleration in 50 ms)*/
+#define SPEED_CTRL_DEFAULT_JERK				(SPEED_CTRL_DEFAULT_ACCEL / SPEED_CTRL_UPDATES(50))
+
+/*!
+ 	 \brief Structure for the control loop of a motor.
+ */
+typedef struct
+{
+	uint8_t init_val;			/*!< Defines whether the loop has been initialized or not*/
+	MC_motor_t* motor;			/*!< Motor driven by the loop*/
+	uint8_t xcp_event;			/*!< XCP event sampled on every step (Sent later by XCP_thread)*/
+	SPEED_PID_t pid;			/*!< PID of the speed*/
+	MOTION_PROFILE_t profile;	/*!< Profile from the target to the setpoint*/
+	volatile int16_t target;	/*!< Target speed, in Q15 (Negative is reverse)*/
+	int16_t last_setpoint;		/*!< Setpoint of the last step*/
+	uint32_t cycles;			/*!< Cycles of the last step*/
+	uint32_t cycles_max;		/*!< Cycles of the slowest step*/
+}SPEED_CTRL_t;
+
+/*!
+ 	 \brief This function initializes the control loop of a motor, with the motor stopped.
+
+ 	 \param[out] ctrl Control loop to be initialized.
+ 	 \param[in] motor Motor driven by the loop (Initialized with MC_init).
+ 	 \param[in] xcp_event XCP event sampled by the loop (e.g. XCP_EVENT_CONTROL_LOOP, below XCP_MAX_EVENT).
+ 	 \param[in] config Gains and limits of the PID. NULL sets the default ones.
+
+ 	 \return void.
+ */
+void SPEED_CTRL_init(SPEED_CTRL_t* ctrl, MC_motor_t* motor, uint8_t xcp_event, const SPEED_PID_config_t* config);
+
+/*!
+ 	 \brief This function changes the gains and limits of the PID, keeping its state.
+
+ 	 \param[in,out] ctrl Control loop.
+ 	 \param[in] config Gains and limits of the PID.
+
+ 	 \return void.
+ */
+void SPEED_CTRL_set_config(SPEED_CTRL_t* ctrl, const SPEED_PID_config_t* config);
+
+/*!
+ 	 \brief This function changes the limits of the motion profile, keeping its state.
+
+ 	 \param[in,out] ctrl Control loop.
+ 	 \param[in] config Acceleration and jerk limits.
+
+ 	 \return void.
+ */
+void SPEED_CTRL_set_profile(SPEED_CTRL_t* ctrl, const MOTION_PROFILE_config_t* config);
+
+/*!
+ 	 \brief This function sets the target speed of the control loop. The setpoint
+ 	 	 	 reaches it with the motion profile, also from the middle of a profile.
+
+ 	 \note The RPM limits of MC_update_duty_cycle apply, so a target below the
+ 	 	 	 minimum RPM stops the motor.
+
+ 	 \param[in,out] ctrl Control loop.
+ 	 \param[in] target Speed in RPM and direction of the motor.
+
+ 	 \return void.
+ */
+void SPEED_CTRL_set_target(SPEED_CTRL_t* ctrl, motor_speed_t target);
+
+/*!
+ 	 \brief This thread executes the control loop every SPEED_CTRL_PERIOD_TICKS (In
+ 	 	 	 open loop only the motion profile).
+
+ 	 \note Run it at the highest priority, so the period has no jitter. The XCP event
+ 	 	 	 of the loop only samples its DAQ lists, the frames are sent by XCP_thread.
+
+ 	 \param[in] args Control loop (SPEED_CTRL_t*).
+
+ 	 \return void.
+ */
+void SPEED_CTRL_thread(void* args);
+
+/*!
+ 	 \brief This function executes a step of the control loop: the profile, the
+ 	 	 	 measurement, the PID and the duty cycle update.
+
+ 	 \note The thread calls it every SPEED_CTRL_PERIOD_TICKS, the host simulation
+ 	 	 	 calls it directly.
+
+ 	 \param[in,out] ctrl Control loop.
+
+ 	 \return void.
+ */
+void SPEED_CTRL_step(SPEED_CTRL_t* ctrl);
+
+/*!
+ 	 \brief This function gets the core cycles of a step of the control loop
+ 	 	 	 (Profile, measurement, PID and duty cycle update).
+
+ 	 \note The cycle counter must be enabled with CYCLE_COUNTER_ENABLE.
+
+ 	 \param[in] ctrl Control loop.
+ 	 \param[out] last Cycles of the last step.
+ 	 \param[out] max Cycles of the slowest step.
+
+ 	 \return void.
+ */
+void SPEED_CTRL_get_cycles(const SPEED_CTRL_t* ctrl, uint32_t* last, uint32_t* max);
+
+#endif /* SPEED_CONTROL_H_ */
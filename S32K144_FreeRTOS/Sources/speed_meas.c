@@ -0,0 +1,297 @@
+/*!
+ 	 \file speed_meas.c
+
+ 	 \brief This is the source file of the speed measurement by input capture.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include "speed_meas.h"
+#include "tick_period.h"
+#include "interrupt_manager.h"
+
+/* Kernel includes. */
+#include "task.h"
+
+/** Defines the speed measurement as initialized*/
+#define IS_INIT								(1)
+/** Defines the speed measurement as not initialized*/
+#define NOT_INIT							(0)
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL							(0)
+/** Defines the maximum value of the counter*/
+#define SPEED_MEAS_COUNTER_MAX				(0xFFFF)
+/** Defines the half of the counter, to know on which side of an overflow a capture is*/
+#define SPEED_MEAS_COUNTER_HALF				(0x8000)
+/** Defines the bit shifts of the overflows in the extended counter*/
+#define SPEED_MEAS_OVERFLOW_SHIFT			(16)
+/** Defines the maximum prescaler of the FTM (Divided by 128)*/
+#define SPEED_MEAS_PS_MAX					(7)
+/** Defines the seconds in a minute*/
+#define SECONDS_PER_MINUTE					(60)
+/** Defines the ticks without edges for the motor to be stopped*/
+#define SPEED_MEAS_TIMEOUT_TICKS			((TickType_t)(SPEED_MEAS_TIMEOUT_MS * FIX_PERIOD))
+
+/*!
+ 	 \brief This function extends the counter of an FTM on its overflow.
+
+ 	 \param[in] instance FTM instance that overflowed.
+
+ 	 \return void.
+ */
+static void speed_meas_overflow(uint32_t instance) HOT_PATH_RAMSECTION;
+
+/*!
+ 	 \brief This function changes the prescaler and starts the window again.
+
+ 	 \param[in,out] meas Measurement.
+ 	 \param[in] prescaler New prescaler.
+
+ 	 \return void.
+ */
+static void speed_meas_set_prescaler(SPEED_MEAS_t* meas, uint8_t prescaler) HOT_PATH_RAMSECTION;
+
+/** Channel interrupts of the FTMs*/
+static const IRQn_Type speed_meas_channel_irqs[FTM_INSTANCE_COUNT][FTM_IRQS_CH_COUNT] = FTM_IRQS;
+/** Overflow interrupts of the FTMs*/
+static const IRQn_Type speed_meas_overflow_irqs[FTM_INSTANCE_COUNT] = FTM_Overflow_IRQS;
+/** Measurement started on each FTM, for its overflow handler*/
+static SPEED_MEAS_t* speed_meas_by_instance[FTM_INSTANCE_COUNT] = { NULL };
+
+/** This function starts the input capture*/
+status_t SPEED_MEAS_init(SPEED_MEAS_t* meas, uint32_t instance, uint8_t channel)
+{
+	/** Input capture of the rising edges of one phase*/
+	ftm_input_ch_param_t channel_config =
+	{
+		channel,					/* Channel id */
+		FTM_EDGE_DETECT,			/* Input capture operation mode */
+		FTM_RISING_EDGE,			/* Edge alignment mode */
+		FTM_NO_MEASUREMENT,			/* Signal measurement operation type */
+		0U,							/* Filter value */
+		false,						/* Filter state (enabled/disabled) */
+		true,						/* Continuous mode */
+		meas,						/* Callback parameters */
+		SPEED_MEAS_edge_callback	/* Callback */
+	};
+	/** Input capture configuration, the counter runs the full 16 bits (The driver copies it)*/
+	ftm_input_param_t config =
+	{
+		1U,							/* Number of channels */
+		SPEED_MEAS_COUNTER_MAX,		/* Max count value */
+		&channel_config				/* Channels configuration */
+	};
+	/** Status of the input capture*/
+	status_t retval = STATUS_ERROR;
+
+	/** The prescaler and the overflows of the FTM belong to one measurement*/
+	if((NULL != speed_meas_by_instance[instance]) && (meas != speed_meas_by_instance[instance]))
+	{
+		return retval;
+	}
+
+	meas->init_val = NOT_INIT;
+	meas->instance = instance;
+	meas->channel = channel;
+	meas->base = g_ftmBase[instance];
+	meas->prescaler = FTM_HAL_GetClockPs(meas->base);
+	/** The clock tree is read only once, the prescaler is tracked here*/
+	meas->clock_hz = FTM_DRV_GetFrequency(instance) << meas->prescaler;
+	meas->overflows = INIT_VAL;
+	meas->newest = INIT_VAL;
+	meas->count = INIT_VAL;
+	meas->last_edge_tick = xTaskGetTickCount();
+
+	/** Both interrupts use the tick count, and with the same priority the channel is served first*/
+	INT_SYS_SetPriority(speed_meas_channel_irqs[instance][channel], configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY);
+	INT_SYS_SetPriority(speed_meas_overflow_irqs[instance], configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY);
+
+	retval = FTM_DRV_InitInputCapture(instance, &config);
+
+	if(STATUS_SUCCESS == retval)
+	{
+		speed_meas_by_instance[instance] = meas;
+
+		/** The overflows extend the counter*/
+		FTM_HAL_ClearTimerOverflow(meas->base);
+		FTM_HAL_SetTimerOverflowInt(meas->base, true);
+		INT_SYS_EnableIRQ(speed_meas_overflow_irqs[instance]);
+
+#ifdef INT_SYS_PROFILING
+		/** The FTM handlers are linked in the vector table, they are wrapped to be profiled*/
+		INT_SYS_ProfileIRQ(speed_meas_channel_irqs[instance][channel]);
+		INT_SYS_ProfileIRQ(speed_meas_overflow_irqs[instance]);
+#endif
+
+		/** Sets the measurement as initialized*/
+		meas->init_val = IS_INIT;
+	}
+
+	return retval;
+}
+
+/** This function time stamps an edge*/
+void SPEED_MEAS_edge_callback(void* user_data)
+{
+	/** Measurement of the channel*/
+	SPEED_MEAS_t* meas = (SPEED_MEAS_t*)user_data;
+	/** Capture of the edge*/
+	uint16_t capture = FTM_DRV_GetInputCaptureMeasurement(meas->instance, meas->channel);
+	/** Overflows at the capture*/
+	uint16_t overflows = meas->overflows;
+	/** Tick of the edge*/
+	TickType_t tick = xTaskGetTickCountFromISR();
+	/** Extended time stamp of the edge*/
+	uint32_t edge;
+	/** Counts of the last period*/
+	uint32_t period;
+
+	/** The channel interrupt is served before the overflow (Lower IRQ number), so a
+	 	 pending overflow with a small capture happened before the edge*/
+	if(FTM_HAL_HasTimerOverflowed(meas->base) && (SPEED_MEAS_COUNTER_HALF > capture))
+	{
+		overflows ++;
+	}
+
+	edge = ((uint32_t)overflows << SPEED_MEAS_OVERFLOW_SHIFT) | capture;
+
+	/** After a stop the old edges are not part of the window*/
+	if((tick - meas->last_edge_tick) > SPEED_MEAS_TIMEOUT_TICKS)
+	{
+		meas->count = INIT_VAL;
+	}
+
+	meas->last_edge_tick = tick;
+	meas->newest = (uint8_t)((meas->newest + 1) % SPEED_MEAS_WINDOW);
+	meas->edges[meas->newest] = edge;
+
+	if(SPEED_MEAS_WINDOW > meas->count)
+	{
+		meas->count ++;
+	}
+
+	if(1 < meas->count)
+	{
+		period = edge - meas->edges[(meas->newest + SPEED_MEAS_WINDOW - 1) % SPEED_MEAS_WINDOW];
+
+		/** Slow edges, fewer counts per period*/
+		if((SPEED_MEAS_PERIOD_MAX < period) && (SPEED_MEAS_PS_MAX > meas->prescaler))
+		{
+			speed_meas_set_prescaler(meas, meas->prescaler + 1);
+		}
+
+		/** Fast edges, more counts per period*/
+		else if((SPEED_MEAS_PERIOD_MIN > period) && (INIT_VAL < meas->prescaler))
+		{
+			speed_meas_set_prescaler(meas, meas->prescaler - 1);
+		}
+	}
+}
+
+/** This function returns the speed*/
+uint32_t SPEED_MEAS_get_rpm(const SPEED_MEAS_t* meas)
+{
+	/** Counts of the window*/
+	uint32_t counts = INIT_VAL;
+	/** Periods of the window*/
+	uint32_t periods = INIT_VAL;
+	/** Clock of the counter*/
+	uint32_t clock_hz;
+	/** Speed with the fractional bits*/
+	uint32_t rpm = INIT_VAL;
+
+	taskENTER_CRITICAL();
+
+	clock_hz = meas->clock_hz >> meas->prescaler;
+
+	if((1 < meas->count) &&
+	   ((xTaskGetTickCount() - meas->last_edge_tick) <= SPEED_MEAS_TIMEOUT_TICKS))
+	{
+		periods = meas->count - 1;
+		counts = meas->edges[meas->newest] -
+				 meas->edges[(meas->newest + SPEED_MEAS_WINDOW - periods) % SPEED_MEAS_WINDOW];
+	}
+
+	taskEXIT_CRITICAL();
+
+	/** RPM = edges per second * 60 / (edges per revolution * gear ratio)*/
+	if(INIT_VAL != counts)
+	{
+		rpm = (uint32_t)((((uint64_t)clock_hz * periods * SECONDS_PER_MINUTE) << SPEED_MEAS_RPM_SHIFT) /
+						 ((uint64_t)counts * SPEED_MEAS_EDGES_PER_REV * SPEED_MEAS_GEAR_RATIO));
+	}
+
+	return rpm;
+}
+
+/** This function returns the prescaler*/
+uint8_t SPEED_MEAS_get_prescaler(const SPEED_MEAS_t* meas)
+{
+	return meas->prescaler;
+}
+
+/** This function sets the clock of the FTM*/
+void SPEED_MEAS_set_clock(SPEED_MEAS_t* meas, uint32_t clock_hz)
+{
+	taskENTER_CRITICAL();
+
+	meas->clock_hz = clock_hz;
+
+	/** The period in progress mixes both clocks, the window starts on the next edge*/
+	meas->count = INIT_VAL;
+
+	taskEXIT_CRITICAL();
+}
+
+/** This function extends the counter of FTM 0 on its overflow*/
+HOT_PATH_RAMSECTION void FTM0_Ovf_Reload_IRQHandler(void)
+{
+	speed_meas_overflow(0U);
+}
+
+/** This function extends the counter of FTM 1 on its overflow*/
+HOT_PATH_RAMSECTION void FTM1_Ovf_Reload_IRQHandler(void)
+{
+	speed_meas_overflow(1U);
+}
+
+/** This function extends the counter of FTM 2 on its overflow*/
+HOT_PATH_RAMSECTION void FTM2_Ovf_Reload_IRQHandler(void)
+{
+	speed_meas_overflow(2U);
+}
+
+/** This function extends the counter of FTM 3 on its overflow*/
+HOT_PATH_RAMSECTION void FTM3_Ovf_Reload_IRQHandler(void)
+{
+	speed_meas_overflow(3U);
+}
+
+/** This function extends the counter of an FTM on its overflow*/
+static void speed_meas_overflow(uint32_t instance)
+{
+	/** Measurement of the FTM*/
+	SPEED_MEAS_t* meas = speed_meas_by_instance[instance];
+
+	if(NULL != meas)
+	{
+		FTM_HAL_ClearTimerOverflow(meas->base);
+		meas->overflows ++;
+	}
+}
+
+/** This function changes the prescaler*/
+static void speed_meas_set_prescaler(SPEED_MEAS_t* meas, uint8_t prescaler)
+{
+	meas->prescaler = prescaler;
+	FTM_HAL_SetClockPs(meas->base, (ftm_clock_ps_t)prescaler);
+
+	/** The period in progress mixes both counts, the window starts on the next edge*/
+	meas->count = INIT_VAL;
+}
@@ -0,0 +1,128 @@
+/*!
+ 	 \file speed_meas.h
+
+ 	 \brief This is the header file of the speed measurement by input capture.
+ 	 	 	 The rising edges of one phase of the encoder are time stamped on
+ 	 	 	 the FTM counter extended to 32 bits, and the speed is the average
+ 	 	 	 period of a window of edges.
+
+ 	 \note The prescaler of the FTM is changed automatically so a period is always
+ 	 	 	 between SPEED_MEAS_PERIOD_MIN and SPEED_MEAS_PERIOD_MAX counts, which
+ 	 	 	 keeps the resolution over the whole range (13 to 150 RPM). The window
+ 	 	 	 starts again after a change, since the counts are of a different size.
+
+ 	 \note The prescaler and the overflows are of the whole FTM, so there is only one
+ 	 	 	 measurement per FTM. The overflow handlers of all the FTMs are in this
+ 	 	 	 module, and serve the measurement started on each one.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef SPEED_MEAS_H_
+#define SPEED_MEAS_H_
+
+#include <stdint.h>
+#include "ftm_driver.h"
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+
+/** Defines the edges averaged for the speed (The window has one period less)*/
+#define SPEED_MEAS_WINDOW					(8)
+/** Defines the time without edges, in milliseconds, to consider the motor stopped*/
+#define SPEED_MEAS_TIMEOUT_MS				(50)
+
+/** Defines the rising edges of one phase per revolution of the motor (64 CPR counts the four edges)*/
+#define SPEED_MEAS_EDGES_PER_REV			(16)
+/** Defines the gear ratio between the motor and the output shaft*/
+#define SPEED_MEAS_GEAR_RATIO				(70)
+
+/** Defines the counts per period above which the prescaler is increased*/
+#define SPEED_MEAS_PERIOD_MAX				(0xC000)
+/** Defines the counts per period below which the prescaler is decreased*/
+#define SPEED_MEAS_PERIOD_MIN				(0x3000)
+
+/** Defines the fractional bits of the RPM*/
+#define SPEED_MEAS_RPM_SHIFT				(8)
+
+/*!
+ 	 \brief Structure for a speed measurement. Each motor has its own, on its own FTM.
+ */
+typedef struct
+{
+	uint8_t init_val;							/*!< Defines whether the measurement has been initialized or not*/
+	uint32_t instance;							/*!< FTM of the input capture*/
+	uint8_t channel;							/*!< Channel of the input capture*/
+	FTM_Type* base;								/*!< Registers of the FTM*/
+	uint32_t clock_hz;							/*!< Clock of the FTM before the prescaler*/
+	uint8_t prescaler;							/*!< Prescaler of the FTM*/
+	volatile uint16_t overflows;				/*!< Overflows of the counter (Upper half of the extended counter)*/
+	uint32_t edges[SPEED_MEAS_WINDOW];			/*!< Ring of the time stamps of the edges*/
+	uint8_t newest;								/*!< Index of the newest edge*/
+	uint8_t count;								/*!< Number of valid edges*/
+	volatile TickType_t last_edge_tick;			/*!< Tick of the newest edge*/
+}SPEED_MEAS_t;
+
+/*!
+ 	 \brief This function starts the input capture with the edge callback and the overflow interrupt.
+
+ 	 \note The FTM must be initialized with FTM_DRV_Init. Its clock is read once here.
+
+ 	 \param[out] meas Measurement to be initialized.
+ 	 \param[in] instance FTM instance of the input capture.
+ 	 \param[in] channel Channel of the input capture.
+
+ 	 \return STATUS_SUCCESS, or STATUS_ERROR if the FTM is already in another mode
+ 	 	 	 or has another measurement.
+ */
+status_t SPEED_MEAS_init(SPEED_MEAS_t* meas, uint32_t instance, uint8_t channel);
+
+/*!
+ 	 \brief This function is the callback of the input capture channel. It time
+ 	 	 	 stamps the edge and adjusts the prescaler.
+
+ 	 \note It is called by the FTM driver from the channel interrupt, it runs from
+ 	 	 	 RAM in the flash builds (HOT_PATH_RAMSECTION).
+
+ 	 \param[in] user_data Measurement of the channel (Set by SPEED_MEAS_init).
+
+ 	 \return void.
+ */
+void SPEED_MEAS_edge_callback(void* user_data) HOT_PATH_RAMSECTION;
+
+/*!
+ 	 \brief This function returns the speed of the output shaft.
+
+ 	 \param[in] meas Measurement.
+
+ 	 \return Speed in RPM with SPEED_MEAS_RPM_SHIFT fractional bits, 0 after
+ 	 	 	 SPEED_MEAS_TIMEOUT_MS without edges.
+ */
+uint32_t SPEED_MEAS_get_rpm(const SPEED_MEAS_t* meas);
+
+/*!
+ 	 \brief This function returns the prescaler selected by the auto ranging.
+
+ 	 \param[in] meas Measurement.
+
+ 	 \return Prescaler of the FTM (The clock is divided by 2^prescaler).
+ */
+uint8_t SPEED_MEAS_get_prescaler(const SPEED_MEAS_t* meas);
+
+/*!
+ 	 \brief This function sets the clock of the FTM, after its clock source changed.
+ 	 	 	 The prescaler is kept, the period in progress is dropped.
+
+ 	 \param[in,out] meas Measurement.
+ 	 \param[in] clock_hz Clock of the FTM before the prescaler, in Hz.
+
+ 	 \return void.
+ */
+void SPEED_MEAS_set_clock(SPEED_MEAS_t* meas, uint32_t clock_hz);
+
+#endif /* SPEED_MEAS_H_ */
@@ -0,0 +1,108 @@
+/*!
+ 	 \file speed_pid.c
+
+ 	 \brief This is the source file of the fixed point PID of the speed control.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include "speed_pid.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL							(0)
+/** Defines the shifts of a Q15 product*/
+#define Q15_SHIFT							(15)
+/** Defines the shifts from Q15 to Q31*/
+#define Q31_SHIFT							(16)
+
+/*!
+ 	 \brief This function limits a value to a range.
+
+ 	 \param[in] value Value to be limited.
+ 	 \param[in] min Lower limit.
+ 	 \param[in] max Upper limit.
+
+ 	 \return The limited value.
+ */
+static inline int32_t speed_pid_clamp(int32_t value, int32_t min, int32_t max);
+
+/** This function initializes a PID*/
+void SPEED_PID_init(SPEED_PID_t* pid, const SPEED_PID_config_t* config)
+{
+	pid->config = *config;
+	SPEED_PID_reset(pid, INIT_VAL);
+}
+
+/** This function clears the state of a PID*/
+void SPEED_PID_reset(SPEED_PID_t* pid, int16_t measurement)
+{
+	pid->integral = INIT_VAL;
+	pid->last_measurement = measurement;
+	pid->output = INIT_VAL;
+}
+
+/** This function executes one step of the PID*/
+int16_t SPEED_PID_update(SPEED_PID_t* pid, int16_t setpoint, int16_t measurement, int16_t feed_forward)
+{
+	/** Error, it needs 17 bits*/
+	int32_t error = (int32_t)setpoint - measurement;
+	/** Proportional term, in Q15*/
+	int32_t proportional = (int32_t)(((int64_t)pid->config.kp * error) >> Q15_SHIFT);
+	/** Derivative term on the measurement, in Q15*/
+	int32_t derivative = (int32_t)(((int64_t)pid->config.kd * ((int32_t)pid->last_measurement - measurement)) >> Q15_SHIFT);
+	/** Integral term with the error of this step, in Q31 (Q15 * Q15 is Q30)*/
+	int64_t integral = (int64_t)pid->integral + ((int64_t)pid->config.ki * error * 2);
+	/** Output before the limits*/
+	int32_t output;
+
+	/** The integral alone can not exceed the output range (Q31 is [-1.0, 1.0))*/
+	if(INT32_MAX < integral)
+	{
+		integral = INT32_MAX;
+	}
+
+	else if(INT32_MIN > integral)
+	{
+		integral = INT32_MIN;
+	}
+
+	output = (int32_t)feed_forward + proportional + derivative + (int32_t)(integral >> Q31_SHIFT);
+
+	/** Anti-windup, the integral is only kept if it does not push the output further into the limit*/
+	if(((pid->config.out_max < output) && (INIT_VAL < error)) ||
+	   ((pid->config.out_min > output) && (INIT_VAL > error)))
+	{
+		output = (int32_t)feed_forward + proportional + derivative + (pid->integral >> Q31_SHIFT);
+	}
+
+	else
+	{
+		pid->integral = (int32_t)integral;
+	}
+
+	pid->last_measurement = measurement;
+	pid->output = (int16_t)speed_pid_clamp(output, pid->config.out_min, pid->config.out_max);
+
+	return pid->output;
+}
+
+/** This function limits a value to a range*/
+static inline int32_t speed_pid_clamp(int32_t value, int32_t min, int32_t max)
+{
+	if(max < value)
+	{
+		value = max;
+	}
+
+	else if(min > value)
+	{
+		value = min;
+	}
+
+	return value;
+}
@@ -0,0 +1,88 @@
+/*!
+ 	 \file speed_pid.h
+
+ 	 \brief This is the header file of the fixed point PID of the speed control.
+ 	 	 	 The speed and the output are Q15 fractions of the full scale, and the
+ 	 	 	 gains are Q15 numbers (32768 is a gain of 1.0).
+
+ 	 \note The update has no loops nor divisions, so its execution time is the same
+ 	 	 	 on every call.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef SPEED_PID_H_
+#define SPEED_PID_H_
+
+#include <stdint.h>
+
+/** Defines the value of 1.0 in Q15*/
+#define SPEED_PID_Q15_ONE					(32768)
+/** Defines the maximum value of a Q15 number*/
+#define SPEED_PID_Q15_MAX					(32767)
+
+/*!
+ 	 \brief Structure for the configuration of the PID.
+ */
+typedef struct
+{
+	int32_t kp;			/*!< Proportional gain, in Q15*/
+	int32_t ki;			/*!< Integral gain per update, in Q15*/
+	int32_t kd;			/*!< Derivative gain per update, in Q15*/
+	int16_t out_min;	/*!< Minimum output, in Q15*/
+	int16_t out_max;	/*!< Maximum output, in Q15*/
+}SPEED_PID_config_t;
+
+/*!
+ 	 \brief Structure for the PID.
+ */
+typedef struct
+{
+	SPEED_PID_config_t config;	/*!< Gains and limits*/
+	int32_t integral;			/*!< Integral term, in Q31*/
+	int16_t last_measurement;	/*!< Measurement of the last update, for the derivative*/
+	int16_t output;				/*!< Output of the last update*/
+}SPEED_PID_t;
+
+/*!
+ 	 \brief This function initializes a PID and clears its state.
+
+ 	 \param[out] pid PID to be initialized.
+ 	 \param[in] config Gains and limits.
+
+ 	 \return void.
+ */
+void SPEED_PID_init(SPEED_PID_t* pid, const SPEED_PID_config_t* config);
+
+/*!
+ 	 \brief This function clears the integral and derivative state of a PID.
+
+ 	 \param[in,out] pid PID to be reset.
+ 	 \param[in] measurement Current measurement, so the derivative does not kick.
+
+ 	 \return void.
+ */
+void SPEED_PID_reset(SPEED_PID_t* pid, int16_t measurement);
+
+/*!
+ 	 \brief This function executes one step of the PID.
+
+ 	 \note The derivative is taken on the measurement, so a setpoint step does not
+ 	 	 	 kick the output. The integral does not grow while the output is saturated
+ 	 	 	 in the direction of the error (Anti-windup).
+
+ 	 \param[in,out] pid PID to be updated.
+ 	 \param[in] setpoint Desired speed, in Q15.
+ 	 \param[in] measurement Measured speed, in Q15.
+ 	 \param[in] feed_forward Output expected for the setpoint, in Q15.
+
+ 	 \return Output limited to [out_min, out_max], in Q15.
+ */
+int16_t SPEED_PID_update(SPEED_PID_t* pid, int16_t setpoint, int16_t measurement, int16_t feed_forward);
+
+#endif /* SPEED_PID_H_ */
@@ -0,0 +1,193 @@
+/*!
+ 	 \file spi_queue.c
+
+ 	 \brief This is the source file of the transfer queue of LPSPI1.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include "spi_queue.h"
+#include "S32K144.h"
+#include "interrupt_manager.h"
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/** Defines the queue as initialized*/
+#define IS_INIT								(1)
+/** Defines the queue as not initialized*/
+#define NOT_INIT							(0)
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL							(0)
+
+/*!
+ 	 \brief Structure for the queue handler.
+ */
+typedef struct
+{
+	uint8_t init_val;								/*!< Defines whether the queue has been initialized or not*/
+	SPI_QUEUE_transfer_t queue[SPI_QUEUE_SIZE];		/*!< Transfers, the first one is in progress*/
+	uint8_t head;									/*!< Position of the transfer in progress*/
+	volatile uint8_t count;							/*!< Transfers in the queue*/
+	uint8_t tx_index;								/*!< Words of the transfer written to the TX FIFO*/
+	uint8_t rx_index;								/*!< Words of the transfer read from the RX FIFO*/
+}spi_queue_handler_t;
+
+/** Handler of the queue*/
+static spi_queue_handler_t spi_queue_handler = { NOT_INIT };
+
+/*!
+ 	 \brief This function starts the first transfer of the queue.
+
+ 	 \return void.
+ */
+static void spi_queue_start(void);
+
+/*!
+ 	 \brief This function fills the TX FIFO with the next words of the transfer, and
+ 	 	 	 sets the RX watermark to all the words in flight.
+
+ 	 \return void.
+ */
+static void spi_queue_fill(void);
+
+/** This function initializes the queue*/
+void SPI_QUEUE_init(void)
+{
+	spi_queue_handler.head = INIT_VAL;
+	spi_queue_handler.count = INIT_VAL;
+
+	/** Only the RX data interrupt is used, every word received frees a word of the TX FIFO*/
+	LPSPI1->IER = INIT_VAL;
+	LPSPI1->FCR = INIT_VAL;
+
+	/** The callbacks may use the kernel*/
+	INT_SYS_SetPriority(LPSPI1_IRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY);
+	INT_SYS_EnableIRQ(LPSPI1_IRQn);
+
+	/** Sets the handler as initialized*/
+	spi_queue_handler.init_val = IS_INIT;
+}
+
+/** This function adds a transfer to the queue*/
+status_t SPI_QUEUE_submit(const SPI_QUEUE_transfer_t* transfer)
+{
+	if((IS_INIT != spi_queue_handler.init_val) || (NULL == transfer->tx) || (INIT_VAL == transfer->length))
+	{
+		return STATUS_ERROR;
+	}
+
+	/** The interrupt must not take the next transfer in between*/
+	taskENTER_CRITICAL();
+
+	if(SPI_QUEUE_SIZE <= spi_queue_handler.count)
+	{
+		taskEXIT_CRITICAL();
+		return STATUS_BUSY;
+	}
+
+	spi_queue_handler.queue[(spi_queue_handler.head + spi_queue_handler.count) % SPI_QUEUE_SIZE] = *transfer;
+	spi_queue_handler.count ++;
+
+	/** The LPSPI is idle, the transfer starts now*/
+	if(1U == spi_queue_handler.count)
+	{
+		spi_queue_start();
+	}
+
+	taskEXIT_CRITICAL();
+
+	return STATUS_SUCCESS;
+}
+
+/** This function gets the transfers pending*/
+uint8_t SPI_QUEUE_get_pending(void)
+{
+	return spi_queue_handler.count;
+}
+
+/** This function reads the words received and continues the queue*/
+void LPSPI1_IRQHandler(void)
+{
+	/** Transfer in progress*/
+	SPI_QUEUE_transfer_t* transfer = &spi_queue_handler.queue[spi_queue_handler.head];
+	/** Word received*/
+	uint16_t word;
+
+	if(INIT_VAL == spi_queue_handler.count)
+	{
+		LPSPI1->IER = INIT_VAL;
+		return;
+	}
+
+	/** Reading the words clears the RX data flag*/
+	while(LPSPI1->FSR & LPSPI_FSR_RXCOUNT_MASK)
+	{
+		word = (uint16_t)LPSPI1->RDR;
+
+		if((NULL != transfer->rx) && (transfer->length > spi_queue_handler.rx_index))
+		{
+			transfer->rx[spi_queue_handler.rx_index] = word;
+		}
+
+		spi_queue_handler.rx_index ++;
+	}
+
+	if(transfer->length > spi_queue_handler.rx_index)
+	{
+		spi_queue_fill();
+		return;
+	}
+
+	if(NULL != transfer->callback)
+	{
+		transfer->callback(transfer->rx, transfer->length);
+	}
+
+	spi_queue_handler.head = (spi_queue_handler.head + 1U) % SPI_QUEUE_SIZE;
+	spi_queue_handler.count --;
+
+	if(INIT_VAL != spi_queue_handler.count)
+	{
+		spi_queue_start();
+	}
+
+	else
+	{
+		LPSPI1->IER = INIT_VAL;
+	}
+}
+
+/** This function starts the first transfer*/
+static void spi_queue_start(void)
+{
+	spi_queue_handler.tx_index = INIT_VAL;
+	spi_queue_handler.rx_index = INIT_VAL;
+
+	spi_queue_fill();
+	LPSPI1->IER = LPSPI_IER_RDIE_MASK;
+}
+
+/** This function fills the TX FIFO*/
+static void spi_queue_fill(void)
+{
+	/** Transfer in progress*/
+	const SPI_QUEUE_transfer_t* transfer = &spi_queue_handler.queue[spi_queue_handler.head];
+
+	while((SPI_QUEUE_FIFO_SIZE > (uint8_t)(spi_queue_handler.tx_index - spi_queue_handler.rx_index)) &&
+		  (transfer->length > spi_queue_handler.tx_index))
+	{
+		LPSPI1->TDR = transfer->tx[spi_queue_handler.tx_index];
+		spi_queue_handler.tx_index ++;
+	}
+
+	/** The RX data flag is set when the last word in flight is received*/
+	LPSPI1->FCR = LPSPI_FCR_RXWATER(spi_queue_handler.tx_index - spi_queue_handler.rx_index - 1U);
+}
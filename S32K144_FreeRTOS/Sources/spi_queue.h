@@ -0,0 +1,85 @@
+/*!
+ 	 \file spi_queue.h
+
+ 	 \brief This is the header file of the transfer queue of LPSPI1. The transfers
+ 	 	 	 (Several 16 bit words) are queued and run one after the other from the
+ 	 	 	 LPSPI1 interrupt: the TX FIFO is filled with up to SPI_QUEUE_FIFO_SIZE
+ 	 	 	 words, and the RX watermark is set so the interrupt only comes once all
+ 	 	 	 of them are received. The CPU never waits for a word, and a transfer of
+ 	 	 	 up to 4 words costs one interrupt.
+
+ 	 \note Every word is one frame (As set in the TCR by LPSPI1_init_master), so the
+ 	 	 	 PCS is negated between the words, as the SBC expects.
+
+ 	 \note The transfers are submitted from the threads (Or before the scheduler
+ 	 	 	 starts, they run once it does), not from the callbacks.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef SPI_QUEUE_H_
+#define SPI_QUEUE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "status.h"
+
+/** Defines the maximum number of transfers in the queue*/
+#define SPI_QUEUE_SIZE						(8)
+/** Defines the words of the TX and RX FIFOs of the LPSPI*/
+#define SPI_QUEUE_FIFO_SIZE					(4U)
+
+/*!
+ 	 \brief Callback of a completed transfer. It runs in the LPSPI1 interrupt, so it
+ 	 	 	 must be short.
+
+ 	 \param[in] rx Words received (NULL if the transfer drops them).
+ 	 \param[in] length Number of words.
+ */
+typedef void (*SPI_QUEUE_callback_t)(const uint16_t* rx, uint8_t length);
+
+/*!
+ 	 \brief Structure for a transfer. The words are not copied, so they must be kept
+ 	 	 	 until the callback.
+ */
+typedef struct
+{
+	const uint16_t* tx;				/*!< Words to be sent*/
+	uint16_t* rx;					/*!< Words received, as many as sent (NULL to drop them)*/
+	uint8_t length;					/*!< Number of words*/
+	SPI_QUEUE_callback_t callback;	/*!< Callback of the transfer (NULL for none)*/
+}SPI_QUEUE_transfer_t;
+
+/*!
+ 	 \brief This function initializes the queue and the LPSPI1 interrupt. LPSPI1 must
+ 	 	 	 be configured as master (LPSPI1_init_master).
+
+ 	 \return void.
+ */
+void SPI_QUEUE_init(void);
+
+/*!
+ 	 \brief This function adds a transfer to the queue, it starts at once if the
+ 	 	 	 LPSPI1 is idle.
+
+ 	 \param[in] transfer Transfer (The descriptor is copied).
+
+ 	 \return STATUS_ERROR if the transfer is empty or the queue is not initialized,
+ 	 	 	 STATUS_BUSY if the queue is full.
+ */
+status_t SPI_QUEUE_submit(const SPI_QUEUE_transfer_t* transfer);
+
+/*!
+ 	 \brief This function gets the number of transfers in the queue, including the
+ 	 	 	 one in progress.
+
+ 	 \return Transfers pending.
+ */
+uint8_t SPI_QUEUE_get_pending(void);
+
+#endif /* SPI_QUEUE_H_ */
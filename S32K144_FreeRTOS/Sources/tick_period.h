@@ -0,0 +1,27 @@
+/*!
+ 	 \file tick_period.h
+
+ 	 \brief This is the header file of the time base of the kernel. The tick is set
+ 	 	 	 for a core clock of configCPU_CLOCK_HZ (48 MHz), but the core runs at
+ 	 	 	 80 MHz in RUN, so the tick runs at 1667 Hz and not 1 kHz. The delays
+ 	 	 	 in milliseconds are converted to ticks with FIX_PERIOD.
+
+ 	 \note The clock policy keeps the tick period on every level (It sets the reload
+ 	 	 	 of the SysTick for the core clock of the new level), so FIX_PERIOD
+ 	 	 	 does not change with the level.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef TICK_PERIOD_H_
+#define TICK_PERIOD_H_
+
+/** Defines the relation to get the ticks for 1 ms (The tick runs at 1667 Hz, not 1 kHz)*/
+#define FIX_PERIOD							((10.0025F) / (6.0F))
+
+#endif /* TICK_PERIOD_H_ */
@@ -1,4 +1,7 @@
 #include "transceiver.h"
+#include "spi_queue.h"
+#include "boot_profile.h"
+#include "pin_batch.h"
 
 /*********************** NOTE ***************************/
 /** This module is taken from the driver example FlexCAN*/
@@ -16,25 +19,23 @@ void PORT_init (void)
 	PCC->PCCn[PCC_PORTE_INDEX] |= PCC_PCCn_CGC_MASK; /* Enable clock for PORTE */
 	PCC->PCCn[PCC_PORTD_INDEX ]|=PCC_PCCn_CGC_MASK;   /* Enable clock for PORTD */
 
-	PORTE->PCR[4] |= PORT_PCR_MUX(5); /* Port E4: MUX = ALT5, CAN0_RX */
-	PORTE->PCR[5] |= PORT_PCR_MUX(5); /* Port E5: MUX = ALT5, CAN0_TX */
+	PIN_BATCH_set(PORTE, (1<<4) | (1<<5), PORT_PCR_MUX(5));
+	                             /* Port E4: MUX = ALT5, CAN0_RX */
+	                             /* Port E5: MUX = ALT5, CAN0_TX */
 
+	PIN_BATCH_set(PORTD, (1<<0) | (1<<15) | (1<<16), PORT_PCR_MUX(1));
+	                             /* Port D0, D15, D16: MUX = GPIO */
 
-	PORTD->PCR[0]  =  0x00000100;  /* Port D0: MUX = GPIO */
-	PORTD->PCR[15] =  0x00000100;  /* Port D15: MUX = GPIO */
-	PORTD->PCR[16] =  0x00000100;  /* Port D16: MUX = GPIO */
-
-	PTD->PDDR |= 1<<0;       	  /* Port D0:  Data Direction= output */
-	PTD->PDDR |= 1<<15;          /* Port D15: Data Direction= output */
-	PTD->PDDR |= 1<<16;          /* Port D16: Data Direction= output */
-
+	PTD->PDDR |= (1<<0) | (1<<15) | (1<<16);
+	                             /* Port D0, D15, D16: Data Direction= output */
 
 #ifdef SBC_MC33903  /* If board has MC33904, SPI pin config. is required */
 	PCC->PCCn[PCC_PORTB_INDEX] |= PCC_PCCn_CGC_MASK; /* Enable clock for PORTB */
-	PORTB->PCR[14] |= PORT_PCR_MUX(3);  /* Port B14: MUX = ALT3, LPSPI1_SCK */
-	PORTB->PCR[15] |= PORT_PCR_MUX(3);  /* Port B15: MUX = ALT3, LPSPI1_SIN */
-	PORTB->PCR[16] |= PORT_PCR_MUX(3);  /* Port B16: MUX = ALT3, LPSPI1_SOUT */
-	PORTB->PCR[17] |= PORT_PCR_MUX(3);  /* Port B17: MUX = ALT3, LPSPI1_PCS3 */
+	PIN_BATCH_set(PORTB, (1<<14) | (1<<15) | (1<<16) | (1<<17), PORT_PCR_MUX(3));
+	                             /* Port B14: MUX = ALT3, LPSPI1_SCK */
+	                             /* Port B15: MUX = ALT3, LPSPI1_SIN */
+	                             /* Port B16: MUX = ALT3, LPSPI1_SOUT */
+	                             /* Port B17: MUX = ALT3, LPSPI1_PCS3 */
 #endif
 }
 
@@ -79,57 +80,68 @@ void LPSPI1_init_master(void)
 	/* PCSSCK=4: PCS to SCK delay = 9+1 = 10 (1 usec) */
 	/* DBT=8: Delay between Transfers = 8+2 = 10 (1 usec) */
 	/* SCKDIV=8: SCK divider =8+2 = 10 (1 usec: 1 MHz baud rate) */
-	LPSPI1->FCR   = 0x00000003;   /* RXWATER=0: Rx flags set when Rx FIFO >0 */
-	/* TXWATER=3: Tx flags set when Tx FIFO <= 3 */
+	LPSPI1->FCR   = 0x00000000;   /* RXWATER=0: Rx flags set when Rx FIFO >0 */
+	/* TXWATER=0: Not used, the queue sets RXWATER per batch */
 	LPSPI1->CR    = 0x00000009;   /* Enable module for operation */
 	/* DBGEN=1: module enabled in debug mode */
 	/* DOZEN=0: module enabled in Doze mode */
 	/* RST=0: Master logic not reset */
 	/* MEN=1: Module is enabled */
+
+	SPI_QUEUE_init();             /* Transfers are queued and run by interrupt */
 }
 
-void LPSPI1_init_MC33903(void)
+static const uint16_t MC33903_spi_init[] = { /* SPI commands and data to initialize MC33903C */
+		0x2580,                     /* Read SAFE register flags: bits 4:0 contain nonzero ID */
+		0xDF80,                     /* Read Vreg High flags:  */
+		0x5A00,                     /* Write Watchdog reg.: Enter NORMAL mode*/
+		0x5E10,                     /* Write Regulator reg.: Enable 5V CAN regulator */
+		0x60C0,                     /* Write CAN reg.: CAN in Tx & Rx modes, fast slew */
+		0x66C4};                    /* Write LIN/1 reg.: Tx/Rx mode, 20 Kbps slew, term. on */
+static uint16_t MC33903_spi_init_result[sizeof(MC33903_spi_init)/2]; /* Results received from SBC */
+
+static const uint16_t MC33903_spi_poll[] = { /* SPI commands to read the MC33903C flags */
+		0x2580,                     /* Read SAFE register flags */
+		0xDF80};                    /* Read Vreg High flags */
+static uint16_t MC33903_spi_poll_result[sizeof(MC33903_spi_poll)/2]; /* Flags received from SBC */
+
+static void MC33903_init_done(const uint16_t* rx, uint8_t length)
 {
+	BOOT_PROFILE_mark(boot_profile_sbc); /* CAN transceiver ready */
+}
 
-	uint32_t i = 0;                 /* Loop counter */
-	uint16_t MC33903_spi_init[] = { /* SPI commands and data to initialize MC33903C */
-			0x2580,                     /* Read SAFE register flags: bits 4:0 contain nonzero ID */
-			0xDF80,                     /* Read Vreg High flags:  */
-			0x5A00,                     /* Write Watchdog reg.: Enter NORMAL mode*/
-			0x5E10,                     /* Write Regulator reg.: Enable 5V CAN regulator */
-			0x60C0,                     /* Write CAN reg.: CAN in Tx & Rx modes, fast slew */
-			0x66C4};                    /* Write LIN/1 reg.: Tx/Rx mode, 20 Kbps slew, term. on */
-	uint16_t spi_result = 0;      /* Result received SPI data from SBC */
+void LPSPI1_init_MC33903(void)
+{
+	SPI_QUEUE_transfer_t transfer;
 
 	/* Note: MC33904 DBG input on EVB is tied to 9V nominal, */
 	/*       which puts device in a debug state */
 	/*       which disables the SBC's watchdog. */
-	for (i=0; i< sizeof (MC33903_spi_init)/2; i++) {
-		LPSPI1_transmit_16bits (MC33903_spi_init[i]);   /* Transmit to MC33904 */
-		spi_result =  LPSPI1_receive_16bits();          /* Read result */
-		/* Note: It is good practice to verify SPI configuration by */
-		/*       reading appropriate flags/registers, especially */
-		/*       fault flags, after configuration routines. */
-	}
+	transfer.tx = MC33903_spi_init;
+	transfer.rx = MC33903_spi_init_result;
+	transfer.length = sizeof(MC33903_spi_init)/2;
+	transfer.callback = MC33903_init_done;
+	SPI_QUEUE_submit(&transfer);  /* All the commands in one transfer, no waits */
+	/* Note: It is good practice to verify SPI configuration by */
+	/*       reading appropriate flags/registers, especially */
+	/*       fault flags, after configuration routines (LPSPI1_poll_MC33903). */
 }
 
-void LPSPI1_transmit_16bits (uint16_t send)
+void LPSPI1_poll_MC33903(void)
 {
-	while((LPSPI1->SR & LPSPI_SR_TDF_MASK)>>LPSPI_SR_TDF_SHIFT==0);
-	/* Wait for Tx FIFO available */
-	LPSPI1->TDR = send;              /* Transmit data */
-	LPSPI1->SR |= LPSPI_SR_TDF_MASK; /* Clear TDF flag */
+	SPI_QUEUE_transfer_t transfer;
+
+	transfer.tx = MC33903_spi_poll;
+	transfer.rx = MC33903_spi_poll_result;
+	transfer.length = sizeof(MC33903_spi_poll)/2;
+	transfer.callback = NULL;
+	SPI_QUEUE_submit(&transfer);  /* The flags are updated by interrupt */
 }
 
-uint16_t LPSPI1_receive_16bits (void)
+void LPSPI1_get_MC33903_flags(uint16_t* safe, uint16_t* vreg)
 {
-	uint16_t recieve = 0;
-
-	while((LPSPI1->SR & LPSPI_SR_RDF_MASK)>>LPSPI_SR_RDF_SHIFT==0);
-	/* Wait at least one RxFIFO entry */
-	recieve= LPSPI1->RDR;            /* Read received data */
-	LPSPI1->SR |= LPSPI_SR_RDF_MASK; /* Clear RDF flag */
-	return recieve;                  /* Return received data */
+	*safe = MC33903_spi_poll_result[0];
+	*vreg = MC33903_spi_poll_result[1];
 }
 
 #endif
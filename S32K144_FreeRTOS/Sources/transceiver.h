@@ -16,10 +16,13 @@ void PORT_init (void);
 
 void LPSPI1_init_master(void);
 
+/** Queues the configuration of the SBC (Runs from the LPSPI1 interrupt, see spi_queue.h)*/
 void LPSPI1_init_MC33903(void);
 
-void LPSPI1_transmit_16bits(uint16_t send);
+/** Queues a read of the SAFE and Vreg flags of the SBC*/
+void LPSPI1_poll_MC33903(void);
 
-uint16_t LPSPI1_receive_16bits (void);
+/** Gets the SAFE and Vreg flags of the last read of the SBC*/
+void LPSPI1_get_MC33903_flags(uint16_t* safe, uint16_t* vreg);
 
 #endif /* TRANSCEIVER_H_ */
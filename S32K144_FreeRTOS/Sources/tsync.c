@@ -0,0 +1,282 @@
+/*!
+ 	 \file tsync.c
+
+ 	 \brief This is the source file of the CAN time synchronization. The SYNC and
+ 	 	 	 FUP handling and the extension of the FlexCAN timer are found in this
+ 	 	 	 source file.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include "tsync.h"
+#include "tick_period.h"
+
+/** Defines the time sync handler as initialized*/
+#define IS_INIT								(1)
+/** Defines the time sync handler as not initialized*/
+#define NOT_INIT							(0)
+/** Defines a flag as set*/
+#define FLAG_SET							(1)
+/** Defines a flag as cleared*/
+#define FLAG_CLEAR							(0)
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL							(0)
+
+
+/** Defines the period of the thread, in milliseconds (The 16 bit timer wraps after 65536 bit times)*/
+#define TSYNC_THREAD_PERIOD					(50)
+/** Defines the thread cycles between SYNC frames*/
+#define TSYNC_SYNC_CYCLES					(TSYNC_SYNC_PERIOD / TSYNC_THREAD_PERIOD)
+
+/** Defines the position of the type in a frame*/
+#define TYPE_POS							(0)
+/** Defines the position of the sequence in a frame*/
+#define SEQUENCE_POS						(1)
+/** Defines the position of the master time in a FUP frame*/
+#define TIME_POS							(2)
+/** Defines the size of the master time in a FUP frame*/
+#define TIME_SIZE							(6)
+/** Defines the size of a SYNC frame*/
+#define SYNC_SIZE							(2)
+/** Defines the size of a FUP frame*/
+#define FUP_SIZE							(TIME_POS + TIME_SIZE)
+
+/** Defines the bit shifts for a byte*/
+#define BYTE_SHIFT							(8)
+/** Defines a mask to get a byte*/
+#define BYTE_MASK							(0xFF)
+/** Defines the nanoseconds in a microsecond*/
+#define NS_PER_US							(1000)
+
+/*********************************************************************************************/
+
+/*!
+ 	 \brief Structure for the time sync handler.
+ */
+typedef struct
+{
+	uint8_t init_val;			/*!< Defines whether the handler has been initialized or not*/
+	CAN_Type* base;				/*!< CAN used for the synchronization*/
+	TSYNC_role_t role;			/*!< Role of the node*/
+	uint32_t bit_time_ns;		/*!< Duration of a timer tick*/
+	uint64_t local_ticks;		/*!< Timer extended to 64 bits*/
+	uint16_t last_timer;		/*!< Value of the timer on the last extension*/
+	uint8_t sequence;			/*!< Sequence of the last SYNC sent or received*/
+	uint8_t sync_valid;			/*!< Set when a SYNC was received and its FUP is awaited*/
+	int64_t sync_local;			/*!< Local time when the last SYNC was received*/
+	TSYNC_servo_t servo;		/*!< Servo of the slave*/
+}tsync_handler_t;
+
+/*********************************************************************************************/
+
+/*!
+ 	 \brief This function extends a time stamp of the timer to the local time.
+
+ 	 \note The time stamp must be at most 65536 bit times old.
+
+ 	 \param[in] timestamp Time stamp or value of the timer.
+
+ 	 \return Local time, in microseconds.
+ */
+static int64_t tsync_extend(uint16_t timestamp);
+
+/*!
+ 	 \brief This function sends a SYNC and its FUP.
+
+ 	 \return void.
+ */
+static void tsync_send_sync(void);
+
+/*********************************************************************************************/
+
+/** Time sync handler*/
+static tsync_handler_t tsync_handler = { INIT_VAL };
+
+/*********************************************************************************************/
+
+/** This function initializes the time synchronization*/
+ID_func_vector_state_t TSYNC_init(CAN_Type* base, TSYNC_role_t role, uint32_t bit_time_ns)
+{
+	/** ID and callback of the SYNC and FUP frames*/
+	ID_function_t ID_func;
+	/** Sets the return value as successful*/
+	ID_func_vector_state_t retval = ID_func_vector_success;
+
+	tsync_handler.base = base;
+	tsync_handler.role = role;
+	tsync_handler.bit_time_ns = bit_time_ns;
+	tsync_handler.local_ticks = INIT_VAL;
+	tsync_handler.last_timer = INIT_VAL;
+	tsync_handler.sequence = INIT_VAL;
+	tsync_handler.sync_valid = FLAG_CLEAR;
+	TSYNC_servo_init(&tsync_handler.servo);
+
+	/** Only the slaves listen to the frames*/
+	if(tsync_slave == role)
+	{
+		ID_func.ID = TSYNC_ID;
+		ID_func.ID_func = TSYNC_rx_callback;
+		retval = rtos_add_ID_function(ID_func);
+	}
+
+	/** Sets the handler as initialized*/
+	tsync_handler.init_val = IS_INIT;
+
+	return retval;
+}
+
+/** This thread sends the SYNC frames and extends the timer*/
+void TSYNC_thread(void* args)
+{
+	/** Cycles since the last SYNC*/
+	uint8_t cycles = INIT_VAL;
+
+	for(;;)
+	{
+		vTaskDelay(TSYNC_THREAD_PERIOD * FIX_PERIOD);
+
+		/** Reading the timer keeps the extension valid*/
+		tsync_extend(CAN_get_timer(tsync_handler.base));
+
+		cycles ++;
+
+		if((tsync_master == tsync_handler.role) && (TSYNC_SYNC_CYCLES <= cycles))
+		{
+			tsync_send_sync();
+			cycles = INIT_VAL;
+		}
+	}
+}
+
+/** This function handles the SYNC and FUP frames*/
+void TSYNC_rx_callback(can_message_rx_config_t can_message_rx)
+{
+	/** Master time of the SYNC*/
+	int64_t master_time = INIT_VAL;
+	/** Counter for the bytes of the master time*/
+	uint8_t counter;
+
+	if((IS_INIT != tsync_handler.init_val) || (SYNC_SIZE > can_message_rx.DLC))
+	{
+		return;
+	}
+
+	/** SYNC: the local time of the same bit that the master timestamped*/
+	if(TSYNC_TYPE_SYNC == can_message_rx.msg[TYPE_POS])
+	{
+		tsync_handler.sync_local = tsync_extend(can_message_rx.timestamp);
+		tsync_handler.sequence = can_message_rx.msg[SEQUENCE_POS];
+		tsync_handler.sync_valid = FLAG_SET;
+	}
+
+	/** FUP: only used if it belongs to the last SYNC received*/
+	else if((TSYNC_TYPE_FUP == can_message_rx.msg[TYPE_POS]) && (FUP_SIZE == can_message_rx.DLC) &&
+			(FLAG_SET == tsync_handler.sync_valid) && (tsync_handler.sequence == can_message_rx.msg[SEQUENCE_POS]))
+	{
+		for(counter = INIT_VAL ; counter < TIME_SIZE ; counter ++)
+		{
+			master_time = (master_time << BYTE_SHIFT) | can_message_rx.msg[TIME_POS + counter];
+		}
+
+		taskENTER_CRITICAL();
+		TSYNC_servo_update(&tsync_handler.servo, master_time, tsync_handler.sync_local);
+		taskEXIT_CRITICAL();
+
+		tsync_handler.sync_valid = FLAG_CLEAR;
+	}
+}
+
+/** This function gets the synchronized time*/
+int64_t TSYNC_get_time_us(void)
+{
+	/** Local time*/
+	int64_t local_time = tsync_extend(CAN_get_timer(tsync_handler.base));
+	/** Synchronized time*/
+	int64_t sync_time = local_time;
+
+	if(tsync_slave == tsync_handler.role)
+	{
+		taskENTER_CRITICAL();
+		sync_time = TSYNC_servo_time(&tsync_handler.servo, local_time);
+		taskEXIT_CRITICAL();
+	}
+
+	return sync_time;
+}
+
+/** This function gets whether the node is synchronized*/
+uint8_t TSYNC_is_synchronized(void)
+{
+	return ((tsync_master == tsync_handler.role) || (tsync_synchronized == tsync_handler.servo.state));
+}
+
+/** This function gets the last error*/
+int32_t TSYNC_get_last_error_us(void)
+{
+	return tsync_handler.servo.last_error;
+}
+
+/** This function extends a time stamp*/
+static int64_t tsync_extend(uint16_t timestamp)
+{
+	/** Value of the timer*/
+	uint16_t timer;
+	/** Local time of the time stamp, in ticks*/
+	uint64_t ticks;
+
+	taskENTER_CRITICAL();
+
+	/** Accumulates the ticks since the last extension (The subtraction wraps with the timer)*/
+	timer = CAN_get_timer(tsync_handler.base);
+	tsync_handler.local_ticks += (uint16_t)(timer - tsync_handler.last_timer);
+	tsync_handler.last_timer = timer;
+
+	/** The time stamp is in the past of the current value of the timer*/
+	ticks = tsync_handler.local_ticks - (uint16_t)(timer - timestamp);
+
+	taskEXIT_CRITICAL();
+
+	return (int64_t)((ticks * tsync_handler.bit_time_ns) / NS_PER_US);
+}
+
+/** This function sends a SYNC and its FUP*/
+static void tsync_send_sync(void)
+{
+	/** Frames to be sent*/
+	uint8_t frame[FUP_SIZE];
+	/** Message structure*/
+	can_message_tx_config_t tx_msg;
+	/** Master time of the SYNC*/
+	int64_t master_time;
+	/** Counter for the bytes of the master time*/
+	uint8_t counter;
+
+	tsync_handler.sequence ++;
+
+	tx_msg.base = tsync_handler.base;
+	tx_msg.ID = TSYNC_ID;
+	tx_msg.msg = frame;
+
+	/** SYNC, its tx time stamp is the master time*/
+	frame[TYPE_POS] = TSYNC_TYPE_SYNC;
+	frame[SEQUENCE_POS] = tsync_handler.sequence;
+	tx_msg.DLC = SYNC_SIZE;
+	master_time = tsync_extend(rtos_can_transmit_timestamped(tx_msg));
+
+	/** FUP with the master time of the SYNC*/
+	frame[TYPE_POS] = TSYNC_TYPE_FUP;
+
+	for(counter = INIT_VAL ; counter < TIME_SIZE ; counter ++)
+	{
+		frame[TIME_POS + counter] = (uint8_t)((master_time >> ((TIME_SIZE - 1 - counter) * BYTE_SHIFT)) & BYTE_MASK);
+	}
+
+	tx_msg.DLC = FUP_SIZE;
+	rtos_can_transmit(tx_msg);
+}
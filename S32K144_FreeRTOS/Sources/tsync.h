@@ -0,0 +1,109 @@
+/*!
+ 	 \file tsync.h
+
+ 	 \brief This is the header file of the CAN time synchronization. A master sends
+ 	 	 	 SYNC and follow up (FUP) frames with the hardware tx time stamp of the
+ 	 	 	 SYNC, and the slaves correct their clock with the servo of tsync_servo.h.
+
+ 	 \note The clock is the free running timer of FlexCAN, so the resolution is one bit
+ 	 	 	 time. After the servo converges (About 2 s) the synchronized time of a slave
+ 	 	 	 is within TSYNC_ACCURACY_US of the master at 500 kbit/s, regardless of the bus
+ 	 	 	 load (See Host/tsync_sim.c).
+
+ 	 \note Frames (ID TSYNC_ID):
+ 	 	 	 - SYNC [TSYNC_TYPE_SYNC, sequence].
+ 	 	 	 - FUP [TSYNC_TYPE_FUP, sequence, master time of the SYNC (6 bytes, us, big endian)].
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef TSYNC_H_
+#define TSYNC_H_
+
+#include "rtos_driver.h"
+#include "tsync_servo.h"
+
+/** Defines the ID of the SYNC and FUP frames (Low ID, so they win the arbitration)*/
+#define TSYNC_ID							(0x020)
+/** Defines the type of a SYNC frame*/
+#define TSYNC_TYPE_SYNC						(0x10)
+/** Defines the type of a FUP frame*/
+#define TSYNC_TYPE_FUP						(0x18)
+
+/** Defines the period of the SYNC frames, in milliseconds*/
+#define TSYNC_SYNC_PERIOD					(100)
+/** Defines the bit time at 500 kbit/s, in nanoseconds*/
+#define TSYNC_BIT_TIME_500KBPS_NS			(2000)
+/** Defines the accuracy of the synchronized time at 500 kbit/s, in microseconds (3 bit times)*/
+#define TSYNC_ACCURACY_US					(6)
+
+/*!
+ 	 \brief Enumerator to define the role of the node.
+ */
+typedef enum
+{
+	tsync_master,		/*!< The node sends the SYNC and FUP frames, its clock is the reference*/
+	tsync_slave			/*!< The node follows the clock of the master*/
+}TSYNC_role_t;
+
+/*!
+ 	 \brief This function initializes the time synchronization and, for slaves,
+ 	 	 	 adds TSYNC_ID to the ID function vector.
+
+ 	 \param[in] base CAN used for the synchronization.
+ 	 \param[in] role Role of the node.
+ 	 \param[in] bit_time_ns Bit time of the bus, in nanoseconds.
+
+ 	 \return This function indicates if the ID was added to the ID function vector.
+ */
+ID_func_vector_state_t TSYNC_init(CAN_Type* base, TSYNC_role_t role, uint32_t bit_time_ns);
+
+/*!
+ 	 \brief This thread sends the SYNC and FUP frames (Master), and keeps the local
+ 	 	 	 clock extended past the 16 bits of the timer (Master and slaves).
+
+ 	 \param[in] args Thread arguments. Set to NULL.
+
+ 	 \return void.
+ */
+void TSYNC_thread(void* args);
+
+/*!
+ 	 \brief This function is the callback of TSYNC_ID. It timestamps the SYNC frames
+ 	 	 	 and corrects the servo with the FUP frames.
+
+ 	 \param[in] can_message_rx Frame received.
+
+ 	 \return void.
+ */
+void TSYNC_rx_callback(can_message_rx_config_t can_message_rx);
+
+/*!
+ 	 \brief This function gets the synchronized time.
+
+ 	 \return Synchronized time, in microseconds.
+ */
+int64_t TSYNC_get_time_us(void);
+
+/*!
+ 	 \brief This function gets whether the node is synchronized.
+
+ 	 \note The master is always synchronized.
+
+ 	 \return 1 if the node is synchronized, 0 otherwise.
+ */
+uint8_t TSYNC_is_synchronized(void);
+
+/*!
+ 	 \brief This function gets the error measured with the last FUP frame.
+
+ 	 \return Error against the master, in microseconds.
+ */
+int32_t TSYNC_get_last_error_us(void);
+
+#endif /* TSYNC_H_ */
@@ -0,0 +1,83 @@
+/*!
+ 	 \file tsync_servo.c
+
+ 	 \brief This is the source file of the clock servo of the time synchronization.
+ 	 	 	 The PI correction of the offset and the rate is found in this source file.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include "tsync_servo.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL							(0)
+/** Defines the parts per billion of a unit*/
+#define PPB									(1000000000LL)
+
+/** This function initializes a servo*/
+void TSYNC_servo_init(TSYNC_servo_t* servo)
+{
+	servo->state = tsync_unsynchronized;
+	servo->sync_base = INIT_VAL;
+	servo->local_base = INIT_VAL;
+	servo->rate_ppb = INIT_VAL;
+	servo->last_error = INIT_VAL;
+}
+
+/** This function corrects the servo*/
+int32_t TSYNC_servo_update(TSYNC_servo_t* servo, int64_t master_time, int64_t local_time)
+{
+	/** Error before the correction*/
+	int64_t error = master_time - TSYNC_servo_time(servo, local_time);
+	/** Local time since the last correction*/
+	int64_t interval = local_time - servo->local_base;
+	/** New rate correction*/
+	int64_t rate;
+
+	/** The first measurement, or a big error, steps the clock and keeps the rate*/
+	if((tsync_unsynchronized == servo->state) || (TSYNC_STEP_THRESHOLD_US < error) ||
+	   (-TSYNC_STEP_THRESHOLD_US > error) || (INIT_VAL >= interval))
+	{
+		servo->sync_base = master_time;
+		servo->state = tsync_synchronized;
+	}
+
+	else
+	{
+		/** Integral term, the error over the interval is the rate that was missing*/
+		rate = servo->rate_ppb + (((error * PPB) / interval) >> TSYNC_KI_SHIFT);
+
+		if(TSYNC_MAX_RATE_PPB < rate)
+		{
+			rate = TSYNC_MAX_RATE_PPB;
+		}
+
+		else if(-TSYNC_MAX_RATE_PPB > rate)
+		{
+			rate = -TSYNC_MAX_RATE_PPB;
+		}
+
+		/** Proportional term, only a part of the offset is corrected to filter the jitter*/
+		servo->sync_base = TSYNC_servo_time(servo, local_time) + (error >> TSYNC_KP_SHIFT);
+		servo->rate_ppb = (int32_t)rate;
+	}
+
+	servo->local_base = local_time;
+	servo->last_error = (int32_t)error;
+
+	return servo->last_error;
+}
+
+/** This function converts a local time*/
+int64_t TSYNC_servo_time(const TSYNC_servo_t* servo, int64_t local_time)
+{
+	/** Local time since the last correction*/
+	int64_t elapsed = local_time - servo->local_base;
+
+	return servo->sync_base + elapsed + ((elapsed * servo->rate_ppb) / PPB);
+}
@@ -0,0 +1,85 @@
+/*!
+ 	 \file tsync_servo.h
+
+ 	 \brief This is the header file of the clock servo of the time synchronization.
+ 	 	 	 It corrects the offset and the rate of a local clock against the
+ 	 	 	 master time received in the follow up frames.
+
+ 	 \note It does not depend on the hardware nor on the RTOS, so it is also used by
+ 	 	 	 the host simulation (Host/tsync_sim.c).
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef TSYNC_SERVO_H_
+#define TSYNC_SERVO_H_
+
+#include <stdint.h>
+
+/** Defines the error, in microseconds, above which the clock is stepped instead of slewed*/
+#define TSYNC_STEP_THRESHOLD_US				(1000)
+/** Defines the maximum rate correction, in parts per billion*/
+#define TSYNC_MAX_RATE_PPB					(500000)
+/** Defines the shift of the proportional gain (The offset is corrected by 1/2 each sync)*/
+#define TSYNC_KP_SHIFT						(1)
+/** Defines the shift of the integral gain (The rate is corrected by 1/4 of the error each sync)*/
+#define TSYNC_KI_SHIFT						(2)
+
+/*!
+ 	 \brief Enumerator to define the state of the servo.
+ */
+typedef enum
+{
+	tsync_unsynchronized,	/*!< No follow up has been received, or the clock was stepped*/
+	tsync_synchronized		/*!< The clock is being slewed to the master*/
+}TSYNC_servo_state_t;
+
+/*!
+ 	 \brief Structure for the servo. The synchronized time is
+ 	 	 	 sync_base + (local - local_base) * (1 + rate_ppb / 10^9).
+ */
+typedef struct
+{
+	TSYNC_servo_state_t state;	/*!< State of the servo*/
+	int64_t sync_base;			/*!< Synchronized time at local_base, in microseconds*/
+	int64_t local_base;			/*!< Local time of the last correction, in microseconds*/
+	int32_t rate_ppb;			/*!< Rate correction, in parts per billion*/
+	int32_t last_error;			/*!< Error measured on the last update, in microseconds*/
+}TSYNC_servo_t;
+
+/*!
+ 	 \brief This function initializes a servo as unsynchronized.
+
+ 	 \param[out] servo Servo to be initialized.
+
+ 	 \return void.
+ */
+void TSYNC_servo_init(TSYNC_servo_t* servo);
+
+/*!
+ 	 \brief This function corrects the servo with a new measurement.
+
+ 	 \param[in,out] servo Servo to be corrected.
+ 	 \param[in] master_time Master time of the sync frame (Sent in the follow up).
+ 	 \param[in] local_time Local time when the sync frame was received.
+
+ 	 \return Error between the master and the synchronized time before the correction.
+ */
+int32_t TSYNC_servo_update(TSYNC_servo_t* servo, int64_t master_time, int64_t local_time);
+
+/*!
+ 	 \brief This function converts a local time into the synchronized time.
+
+ 	 \param[in] servo Servo used for the conversion.
+ 	 \param[in] local_time Local time, in microseconds.
+
+ 	 \return Synchronized time, in microseconds.
+ */
+int64_t TSYNC_servo_time(const TSYNC_servo_t* servo, int64_t local_time);
+
+#endif /* TSYNC_SERVO_H_ */
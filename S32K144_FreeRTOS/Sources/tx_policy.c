@@ -0,0 +1,70 @@
+/*!
+ 	 \file tx_policy.c
+
+ 	 \brief This is the source file of the transmission policy. The change,
+ 	 	 	 rate limit and heartbeat checks are found in this source file.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include "tx_policy.h"
+#include "tick_period.h"
+
+/** Defines a flag as set*/
+#define FLAG_SET							(1)
+/** Defines a flag as cleared*/
+#define FLAG_CLEAR							(0)
+
+
+/** This function initializes a policy*/
+void TX_POLICY_init(TX_POLICY_t* policy, TX_POLICY_config_t config)
+{
+	policy->config = config;
+	policy->min_ticks = (TickType_t)(config.min_interval * FIX_PERIOD);
+	policy->max_ticks = (TickType_t)(config.max_interval * FIX_PERIOD);
+	policy->sent = FLAG_CLEAR;
+}
+
+/** This function decides whether a sample is sent*/
+TX_POLICY_decision_t TX_POLICY_evaluate(TX_POLICY_t* policy, int32_t value)
+{
+	/** Sets the return value as not sent*/
+	TX_POLICY_decision_t retval = tx_policy_skip;
+	/** Current tick*/
+	TickType_t now = xTaskGetTickCount();
+	/** Ticks since the last transmission (The subtraction wraps with the tick)*/
+	TickType_t elapsed = now - policy->last_tx;
+	/** Change from the last value sent*/
+	uint32_t change = (uint32_t)((value > policy->last_value) ? (value - policy->last_value) : (policy->last_value - value));
+
+	/** The first sample is always sent*/
+	if(FLAG_SET != policy->sent)
+	{
+		retval = tx_policy_change;
+	}
+
+	/** Changes are sent once the minimum interval passed, otherwise they wait for the next sample*/
+	else if((change > policy->config.hysteresis) && (elapsed >= policy->min_ticks))
+	{
+		retval = tx_policy_change;
+	}
+
+	else if(elapsed >= policy->max_ticks)
+	{
+		retval = tx_policy_heartbeat;
+	}
+
+	if(tx_policy_skip != retval)
+	{
+		policy->last_value = value;
+		policy->last_tx = now;
+		policy->sent = FLAG_SET;
+	}
+
+	return retval;
+}
@@ -0,0 +1,80 @@
+/*!
+ 	 \file tx_policy.h
+
+ 	 \brief This is the header file of the transmission policy. It decides whether
+ 	 	 	 a periodic sample must be sent: when it changed beyond a hysteresis
+ 	 	 	 band (But not faster than a minimum interval), or as a heartbeat when
+ 	 	 	 nothing was sent for a maximum interval.
+
+ 	 \note Every message has its own policy structure, so each one is configured
+ 	 	 	 independently.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef TX_POLICY_H_
+#define TX_POLICY_H_
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*!
+ 	 \brief Enumerator to define the decision of the policy.
+ */
+typedef enum
+{
+	tx_policy_skip,			/*!< The sample must not be sent*/
+	tx_policy_change,		/*!< The sample changed beyond the hysteresis*/
+	tx_policy_heartbeat		/*!< Nothing was sent for the maximum interval*/
+}TX_POLICY_decision_t;
+
+/*!
+ 	 \brief Configuration of a policy.
+ */
+typedef struct
+{
+	uint32_t hysteresis;	/*!< Change from the last value sent that triggers a transmission*/
+	uint32_t min_interval;	/*!< Minimum time between transmissions, in milliseconds*/
+	uint32_t max_interval;	/*!< Maximum time between transmissions (Heartbeat), in milliseconds*/
+}TX_POLICY_config_t;
+
+/*!
+ 	 \brief Policy of a message.
+ */
+typedef struct
+{
+	TX_POLICY_config_t config;	/*!< Configuration of the policy*/
+	TickType_t min_ticks;		/*!< Minimum interval in ticks*/
+	TickType_t max_ticks;		/*!< Maximum interval in ticks*/
+	int32_t last_value;			/*!< Last value sent*/
+	TickType_t last_tx;			/*!< Tick of the last transmission*/
+	uint8_t sent;				/*!< Set once the first value was sent*/
+}TX_POLICY_t;
+
+/*!
+ 	 \brief This function initializes a policy, the next sample is always sent.
+
+ 	 \param[out] policy Policy to be initialized.
+ 	 \param[in] config Configuration of the policy.
+
+ 	 \return void.
+ */
+void TX_POLICY_init(TX_POLICY_t* policy, TX_POLICY_config_t config);
+
+/*!
+ 	 \brief This function decides whether a sample is sent, and if so, records it as
+ 	 	 	 the last value sent.
+
+ 	 \param[in,out] policy Policy of the message.
+ 	 \param[in] value Sample to be evaluated.
+
+ 	 \return Whether the sample must be sent and why.
+ */
+TX_POLICY_decision_t TX_POLICY_evaluate(TX_POLICY_t* policy, int32_t value);
+
+#endif /* TX_POLICY_H_ */
@@ -0,0 +1,850 @@
+/*!
+ 	 \file xcp.c
+
+ 	 \brief This is the source file of the XCP on CAN slave. All the command
+ 	 	 	 handling, DAQ list management and event sampling functions are found
+ 	 	 	 in this source file.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#include "xcp.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL							(0)
+/** Defines a flag as set*/
+#define FLAG_SET							(1)
+/** Defines a flag as cleared*/
+#define FLAG_CLEAR							(0)
+
+/** Defines the size of a CAN frame (MAX_CTO and MAX_DTO)*/
+#define XCP_FRAME_SIZE						(8)
+/** Defines the data bytes of a DAQ frame (The first byte is the PID)*/
+#define XCP_ODT_DATA_SIZE					(7)
+/** Defines the maximum data of an upload*/
+#define XCP_MAX_UPLOAD						(7)
+/** Defines the maximum data of a download*/
+#define XCP_MAX_DOWNLOAD					(6)
+/** Defines the version of the protocol and transport layer*/
+#define XCP_VERSION							(0x01)
+/** Defines the DAQ frames queued for the sender thread (The ODTs of two events)*/
+#define XCP_DTO_QUEUE_SIZE					(2 * XCP_MAX_ODT)
+
+#if defined(XCP_HOST_BUS)
+/** The RAM of the node is the memory of the stand-in master (CAN_BUS_SIM_set_ram)*/
+#define XCP_RAM_START						(CAN_BUS_SIM_get_ram_start())
+/** Defines the address after the RAM of the node*/
+#define XCP_RAM_END							(CAN_BUS_SIM_get_ram_end())
+/** The stand-in master has no flash*/
+#define XCP_FLASH_START						(0U)
+/** Defines the address after the flash of the node*/
+#define XCP_FLASH_END						(0U)
+#else
+/** Defines the first address of the RAM (SRAM_L)*/
+#define XCP_RAM_START						(0x1FFF8000U)
+/** Defines the address after the RAM (SRAM_U)*/
+#define XCP_RAM_END							(0x20007000U)
+/** Defines the first address of the program flash (Read only)*/
+#define XCP_FLASH_START						(0x00000000U)
+/** Defines the address after the program flash*/
+#define XCP_FLASH_END						(0x00080000U)
+#endif
+
+/** Command codes*/
+#define CMD_CONNECT							(0xFF)
+#define CMD_DISCONNECT						(0xFE)
+#define CMD_GET_STATUS						(0xFD)
+#define CMD_SYNCH							(0xFC)
+#define CMD_SET_MTA							(0xF6)
+#define CMD_UPLOAD							(0xF5)
+#define CMD_SHORT_UPLOAD					(0xF4)
+#define CMD_DOWNLOAD						(0xF0)
+#define CMD_WRITE_DAQ						(0xE1)
+#define CMD_SET_DAQ_PTR						(0xE2)
+#define CMD_SET_DAQ_LIST_MODE				(0xE0)
+#define CMD_START_STOP_DAQ_LIST				(0xDE)
+#define CMD_START_STOP_SYNCH				(0xDD)
+#define CMD_GET_DAQ_PROCESSOR_INFO			(0xDA)
+#define CMD_FREE_DAQ						(0xD6)
+#define CMD_ALLOC_DAQ						(0xD5)
+#define CMD_ALLOC_ODT						(0xD4)
+#define CMD_ALLOC_ODT_ENTRY					(0xD3)
+
+/** Defines the PID of a positive response*/
+#define PID_RES								(0xFF)
+/** Defines the PID of an error*/
+#define PID_ERR								(0xFE)
+
+/** Error codes*/
+#define ERR_CMD_SYNCH						(0x00)
+#define ERR_CMD_UNKNOWN						(0x20)
+#define ERR_CMD_SYNTAX						(0x21)
+#define ERR_OUT_OF_RANGE					(0x22)
+#define ERR_ACCESS_DENIED					(0x24)
+#define ERR_SEQUENCE						(0x29)
+#define ERR_DAQ_CONFIG						(0x2A)
+#define ERR_MEMORY_OVERFLOW					(0x30)
+
+/** Defines the resources available (CAL/PAG and DAQ)*/
+#define RESOURCE_CAL_DAQ					(0x05)
+/** Defines the basic communication mode (Intel byte order, byte granularity)*/
+#define COMM_MODE_BASIC						(0x00)
+/** Defines the session status bit of the running DAQ lists*/
+#define SESSION_DAQ_RUNNING					(0x40)
+/** Defines the DAQ properties (Dynamic configuration, prescaler supported)*/
+#define DAQ_PROPERTIES						(0x03)
+/** Defines the DAQ key byte (Absolute ODT number as identification field)*/
+#define DAQ_KEY_BYTE						(0x00)
+
+/** Defines the START_STOP_DAQ_LIST mode to stop*/
+#define DAQ_LIST_STOP						(0x00)
+/** Defines the START_STOP_DAQ_LIST mode to start*/
+#define DAQ_LIST_START						(0x01)
+/** Defines the START_STOP_DAQ_LIST mode to select*/
+#define DAQ_LIST_SELECT						(0x02)
+/** Defines the START_STOP_SYNCH mode to stop all*/
+#define SYNCH_STOP_ALL						(0x00)
+/** Defines the START_STOP_SYNCH mode to start the selected*/
+#define SYNCH_START_SELECTED				(0x01)
+/** Defines the START_STOP_SYNCH mode to stop the selected*/
+#define SYNCH_STOP_SELECTED					(0x02)
+
+/** Byte positions of the commands*/
+#define CMD_POS								(0)
+#define BYTE_1								(1)
+#define BYTE_2								(2)
+#define BYTE_3								(3)
+#define BYTE_4								(4)
+#define BYTE_5								(5)
+#define BYTE_6								(6)
+#define BYTE_7								(7)
+
+/** Defines the bit shifts for a byte*/
+#define BYTE_SHIFT							(8)
+/** Defines the bit shifts for two bytes*/
+#define BYTE_SHIFT_2						(16)
+/** Defines the bit shifts for three bytes*/
+#define BYTE_SHIFT_3						(24)
+/** Defines a mask to get a low byte*/
+#define LOW_BYTE_MASK						(0xFF)
+
+/*********************************************************************************************/
+
+/*!
+ 	 \brief Structure to define an ODT entry (A variable to be sampled).
+ */
+typedef struct
+{
+	uint32_t address;	/*!< Address of the variable*/
+	uint8_t size;		/*!< Size of the variable in bytes*/
+}xcp_odt_entry_t;
+
+/*!
+ 	 \brief Structure to define an ODT (The variables sent in one DAQ frame).
+ */
+typedef struct
+{
+	uint8_t first_entry;	/*!< First entry of the ODT in the entry pool*/
+	uint8_t entry_count;	/*!< Entries written by the master*/
+	uint8_t packed_count;	/*!< Entries after merging the contiguous ones*/
+	uint8_t frame_size;		/*!< DLC of the DAQ frame (PID and data)*/
+}xcp_odt_t;
+
+/*!
+ 	 \brief Structure to define a DAQ list.
+ */
+typedef struct
+{
+	uint8_t first_odt;		/*!< First ODT of the list in the ODT pool (Also its first PID)*/
+	uint8_t odt_count;		/*!< ODTs of the list*/
+	uint16_t event;			/*!< Event the list is bound to*/
+	uint8_t prescaler;		/*!< The list is sent every prescaler events*/
+	uint8_t prescaler_count;/*!< Events since the list was last sent*/
+	uint8_t selected;		/*!< Whether the list was selected for START_STOP_SYNCH*/
+	uint8_t running;		/*!< Whether the list is being sent*/
+}xcp_daq_t;
+
+/*!
+ 	 \brief Structure to define a DAQ frame waiting for the sender thread.
+ */
+typedef struct
+{
+	uint8_t DLC;					/*!< DLC of the frame*/
+	uint8_t data[XCP_FRAME_SIZE];	/*!< PID and sampled data*/
+}xcp_dto_t;
+
+/*!
+ 	 \brief Structure for the XCP handler.
+ */
+typedef struct
+{
+	CAN_Type* base;			/*!< CAN used by the slave*/
+	uint16_t dto_ID;		/*!< ID of the responses and DAQ frames*/
+	SemaphoreHandle_t sem_send;	/*!< Binary semaphore to wake up the sender thread*/
+	uint8_t dto_head;		/*!< Oldest DAQ frame of the queue*/
+	uint8_t dto_count;		/*!< DAQ frames in the queue*/
+	uint32_t dto_overruns;	/*!< DAQ lists dropped because the queue was full*/
+	uint8_t connected;		/*!< Whether a master is connected*/
+	uint32_t mta;			/*!< Memory transfer address*/
+	uint8_t daq_count;		/*!< DAQ lists allocated*/
+	uint8_t odt_count;		/*!< ODTs allocated*/
+	uint8_t entry_count;	/*!< ODT entries allocated*/
+	uint8_t ptr_odt;		/*!< Absolute ODT pointed by SET_DAQ_PTR*/
+	uint8_t ptr_entry;		/*!< Absolute entry pointed by SET_DAQ_PTR*/
+	uint8_t ptr_last_entry;	/*!< Last entry that can be written with the DAQ pointer*/
+}xcp_handler_t;
+
+/*********************************************************************************************/
+
+/** XCP handler*/
+static xcp_handler_t xcp_handler = { NULL };
+/** DAQ lists*/
+static xcp_daq_t xcp_daq[XCP_MAX_DAQ];
+/** ODT pool*/
+static xcp_odt_t xcp_odt[XCP_MAX_ODT];
+/** ODT entry pool, as written by the master*/
+static xcp_odt_entry_t xcp_entry[XCP_MAX_ODT_ENTRY];
+/** ODT entry pool, with the contiguous entries merged*/
+static xcp_odt_entry_t xcp_packed_entry[XCP_MAX_ODT_ENTRY];
+/** DAQ frames sampled by the events, sent by the sender thread*/
+static xcp_dto_t xcp_dto_queue[XCP_DTO_QUEUE_SIZE];
+
+/*********************************************************************************************/
+
+/** This function gets a little endian 32 bit value from a frame*/
+static uint32_t xcp_get_uint32(uint8_t* data)
+{
+	return ((uint32_t)data[0]) | ((uint32_t)data[1] << BYTE_SHIFT) |
+		   ((uint32_t)data[2] << BYTE_SHIFT_2) | ((uint32_t)data[3] << BYTE_SHIFT_3);
+}
+
+/** This function gets a little endian 16 bit value from a frame*/
+static uint16_t xcp_get_uint16(uint8_t* data)
+{
+	return (uint16_t)(((uint16_t)data[0]) | ((uint16_t)data[1] << BYTE_SHIFT));
+}
+
+/** This function sends a DTO frame*/
+static void xcp_send(uint8_t* frame, uint8_t DLC)
+{
+	/** Variable to transmit the frame*/
+	can_message_tx_config_t tx_frame;
+
+	tx_frame.base = xcp_handler.base;
+	tx_frame.ID = xcp_handler.dto_ID;
+	tx_frame.msg = frame;
+	tx_frame.DLC = DLC;
+
+	/** Sends the frame protecting the CAN with a mutex*/
+	rtos_can_transmit(tx_frame);
+}
+
+/** This function checks that a transfer is inside a memory region*/
+static uint8_t xcp_in_region(uint32_t address, uint32_t size, uint32_t start, uint32_t end)
+{
+	/** The addresses below the start wrap around, so they are beyond the region as well*/
+	return ((address - start) < (end - start)) && (size <= (end - address));
+}
+
+/** This function checks that a transfer can be read (RAM or flash)*/
+static uint8_t xcp_readable(uint32_t address, uint32_t size)
+{
+	return xcp_in_region(address, size, XCP_RAM_START, XCP_RAM_END) ||
+		   xcp_in_region(address, size, XCP_FLASH_START, XCP_FLASH_END);
+}
+
+/** This function uploads the memory pointed by the MTA, it returns the error code*/
+static uint8_t xcp_upload(uint8_t size, uint8_t* response)
+{
+	/** Counter for the bytes*/
+	uint8_t counter = INIT_VAL;
+	/** Pointer to the memory being read*/
+	uint8_t* memory = (uint8_t*)(uintptr_t)xcp_handler.mta;
+
+	if((INIT_VAL == size) || (XCP_MAX_UPLOAD < size))
+	{
+		return ERR_OUT_OF_RANGE;
+	}
+
+	if(!xcp_readable(xcp_handler.mta, size))
+	{
+		return ERR_ACCESS_DENIED;
+	}
+
+	for(counter = INIT_VAL ; counter < size ; counter ++)
+	{
+		response[BYTE_1 + counter] = memory[counter];
+	}
+
+	xcp_handler.mta += size;
+
+	return PID_RES;
+}
+
+/** This function merges the contiguous entries of every ODT, so each one is copied with a single loop*/
+static void xcp_pack_odts(void)
+{
+	/** Counters for the ODTs and entries*/
+	uint8_t odt = INIT_VAL;
+	uint8_t entry = INIT_VAL;
+	/** Pointer to the last packed entry of the ODT*/
+	xcp_odt_entry_t* packed;
+
+	/** The events cannot sample while the entries are being packed*/
+	taskENTER_CRITICAL();
+
+	for(odt = INIT_VAL ; odt < xcp_handler.odt_count ; odt ++)
+	{
+		xcp_odt[odt].packed_count = INIT_VAL;
+		xcp_odt[odt].frame_size = BYTE_1;
+		packed = NULL;
+
+		for(entry = xcp_odt[odt].first_entry ; entry < (xcp_odt[odt].first_entry + xcp_odt[odt].entry_count) ; entry ++)
+		{
+			/** Empty entries are skipped*/
+			if(INIT_VAL == xcp_entry[entry].size)
+			{
+				continue;
+			}
+
+			xcp_odt[odt].frame_size += xcp_entry[entry].size;
+
+			/** The entry starts where the previous one ends*/
+			if((NULL != packed) && ((packed->address + packed->size) == xcp_entry[entry].address))
+			{
+				packed->size += xcp_entry[entry].size;
+			}
+
+			else
+			{
+				packed = &xcp_packed_entry[xcp_odt[odt].first_entry + xcp_odt[odt].packed_count];
+				packed->address = xcp_entry[entry].address;
+				packed->size = xcp_entry[entry].size;
+				xcp_odt[odt].packed_count ++;
+			}
+		}
+	}
+
+	taskEXIT_CRITICAL();
+}
+
+/** This function stops all the DAQ lists and frees the pools*/
+static void xcp_free_daq(void)
+{
+	/** Counter for the DAQ lists*/
+	uint8_t counter = INIT_VAL;
+
+	taskENTER_CRITICAL();
+
+	for(counter = INIT_VAL ; counter < XCP_MAX_DAQ ; counter ++)
+	{
+		xcp_daq[counter].running = FLAG_CLEAR;
+		xcp_daq[counter].selected = FLAG_CLEAR;
+		xcp_daq[counter].odt_count = INIT_VAL;
+	}
+
+	xcp_handler.daq_count = INIT_VAL;
+	xcp_handler.odt_count = INIT_VAL;
+	xcp_handler.entry_count = INIT_VAL;
+
+	/** The frames of the stopped lists are not sent*/
+	xcp_handler.dto_count = INIT_VAL;
+
+	taskEXIT_CRITICAL();
+}
+
+/** This function returns the session status byte*/
+static uint8_t xcp_session_status(void)
+{
+	/** Counter for the DAQ lists*/
+	uint8_t counter = INIT_VAL;
+	/** Session status*/
+	uint8_t status = INIT_VAL;
+
+	for(counter = INIT_VAL ; counter < xcp_handler.daq_count ; counter ++)
+	{
+		if(FLAG_SET == xcp_daq[counter].running)
+		{
+			status = SESSION_DAQ_RUNNING;
+		}
+	}
+
+	return status;
+}
+
+/*********************************************************************************************/
+
+/** This function initializes the XCP slave*/
+ID_func_vector_state_t XCP_init(CAN_Type* base, uint16_t cro_ID, uint16_t dto_ID)
+{
+	/** Variable to add the CRO ID to the ID function vector*/
+	ID_function_t ID_func;
+
+	xcp_handler.base = base;
+	xcp_handler.dto_ID = dto_ID;
+	xcp_handler.connected = FLAG_CLEAR;
+	xcp_handler.sem_send = xSemaphoreCreateBinary();
+	xcp_handler.dto_head = INIT_VAL;
+	xcp_handler.dto_overruns = INIT_VAL;
+	xcp_free_daq();
+
+	ID_func.ID = cro_ID;
+	ID_func.ID_func = XCP_command_callback;
+
+	return rtos_add_ID_function(ID_func);
+}
+
+/** This function executes a command received from the master*/
+void XCP_command_callback(can_message_rx_config_t can_message_rx)
+{
+	/** Response frame*/
+	uint8_t response[XCP_FRAME_SIZE] = {PID_RES};
+	/** DLC of the response*/
+	uint8_t response_DLC = BYTE_1;
+	/** Error code, PID_RES when there is no error*/
+	uint8_t error = PID_RES;
+	/** Variables for the command parameters*/
+	uint16_t daq = INIT_VAL;
+	uint8_t size = INIT_VAL;
+	uint8_t counter = INIT_VAL;
+	/** Pointer to the memory being transferred*/
+	uint8_t* memory;
+	/** Pointer to the command data*/
+	uint8_t* cmd = can_message_rx.msg;
+
+	if(INIT_VAL == can_message_rx.DLC)
+	{
+		return;
+	}
+
+	/** Only CONNECT is answered while disconnected*/
+	if((FLAG_CLEAR == xcp_handler.connected) && (CMD_CONNECT != cmd[CMD_POS]))
+	{
+		return;
+	}
+
+	switch(cmd[CMD_POS])
+	{
+		case CMD_CONNECT:
+			xcp_handler.connected = FLAG_SET;
+			response[BYTE_1] = RESOURCE_CAL_DAQ;
+			response[BYTE_2] = COMM_MODE_BASIC;
+			response[BYTE_3] = XCP_FRAME_SIZE;
+			response[BYTE_4] = XCP_FRAME_SIZE;
+			response[BYTE_5] = INIT_VAL;
+			response[BYTE_6] = XCP_VERSION;
+			response[BYTE_7] = XCP_VERSION;
+			response_DLC = XCP_FRAME_SIZE;
+		break;
+
+		case CMD_DISCONNECT:
+			xcp_free_daq();
+			xcp_handler.connected = FLAG_CLEAR;
+		break;
+
+		case CMD_GET_STATUS:
+			response[BYTE_1] = xcp_session_status();
+			response_DLC = BYTE_6;
+		break;
+
+		/** SYNCH is always answered with the ERR_CMD_SYNCH error*/
+		case CMD_SYNCH:
+			error = ERR_CMD_SYNCH;
+		break;
+
+		case CMD_SET_MTA:
+			xcp_handler.mta = xcp_get_uint32(&cmd[BYTE_4]);
+		break;
+
+		case CMD_SHORT_UPLOAD:
+			xcp_handler.mta = xcp_get_uint32(&cmd[BYTE_4]);
+			error = xcp_upload(cmd[BYTE_1], response);
+			response_DLC = BYTE_1 + cmd[BYTE_1];
+		break;
+
+		case CMD_UPLOAD:
+			error = xcp_upload(cmd[BYTE_1], response);
+			response_DLC = BYTE_1 + cmd[BYTE_1];
+		break;
+
+		/** Calibration, the values are written atomically so the tasks never read half a value*/
+		case CMD_DOWNLOAD:
+			size = cmd[BYTE_1];
+
+			if((INIT_VAL == size) || (XCP_MAX_DOWNLOAD < size) || ((BYTE_2 + size) > can_message_rx.DLC))
+			{
+				error = ERR_OUT_OF_RANGE;
+				break;
+			}
+
+			/** Only the RAM can be calibrated*/
+			if(!xcp_in_region(xcp_handler.mta, size, XCP_RAM_START, XCP_RAM_END))
+			{
+				error = ERR_ACCESS_DENIED;
+				break;
+			}
+
+			memory = (uint8_t*)(uintptr_t)xcp_handler.mta;
+
+			taskENTER_CRITICAL();
+			for(counter = INIT_VAL ; counter < size ; counter ++)
+			{
+				memory[counter] = cmd[BYTE_2 + counter];
+			}
+			taskEXIT_CRITICAL();
+
+			xcp_handler.mta += size;
+		break;
+
+		case CMD_GET_DAQ_PROCESSOR_INFO:
+			response[BYTE_1] = DAQ_PROPERTIES;
+			response[BYTE_2] = XCP_MAX_DAQ;
+			response[BYTE_3] = INIT_VAL;
+			response[BYTE_4] = XCP_MAX_EVENT;
+			response[BYTE_5] = INIT_VAL;
+			response[BYTE_6] = INIT_VAL;
+			response[BYTE_7] = DAQ_KEY_BYTE;
+			response_DLC = XCP_FRAME_SIZE;
+		break;
+
+		case CMD_FREE_DAQ:
+			xcp_free_daq();
+		break;
+
+		case CMD_ALLOC_DAQ:
+			daq = xcp_get_uint16(&cmd[BYTE_2]);
+
+			if((INIT_VAL != xcp_handler.odt_count) || (XCP_MAX_DAQ < daq))
+			{
+				error = (XCP_MAX_DAQ < daq) ? ERR_MEMORY_OVERFLOW : ERR_SEQUENCE;
+				break;
+			}
+
+			for(counter = INIT_VAL ; counter < daq ; counter ++)
+			{
+				xcp_daq[counter].odt_count = INIT_VAL;
+				xcp_daq[counter].event = INIT_VAL;
+				xcp_daq[counter].prescaler = BYTE_1;
+				xcp_daq[counter].prescaler_count = INIT_VAL;
+			}
+
+			xcp_handler.daq_count = (uint8_t)daq;
+		break;
+
+		/** The ODTs are taken from the pool in the order they are allocated*/
+		case CMD_ALLOC_ODT:
+			daq = xcp_get_uint16(&cmd[BYTE_2]);
+			size = cmd[BYTE_4];
+
+			if((daq >= xcp_handler.daq_count) || (INIT_VAL != xcp_daq[daq].odt_count) || (INIT_VAL != xcp_handler.entry_count))
+			{
+				error = ERR_SEQUENCE;
+				break;
+			}
+
+			if(XCP_MAX_ODT < (xcp_handler.odt_count + size))
+			{
+				error = ERR_MEMORY_OVERFLOW;
+				break;
+			}
+
+			xcp_daq[daq].first_odt = xcp_handler.odt_count;
+			xcp_daq[daq].odt_count = size;
+
+			for(counter = INIT_VAL ; counter < size ; counter ++)
+			{
+				xcp_odt[xcp_handler.odt_count + counter].entry_count = INIT_VAL;
+				xcp_odt[xcp_handler.odt_count + counter].packed_count = INIT_VAL;
+			}
+
+			xcp_handler.odt_count += size;
+		break;
+
+		case CMD_ALLOC_ODT_ENTRY:
+			daq = xcp_get_uint16(&cmd[BYTE_2]);
+			size = cmd[BYTE_5];
+
+			if((daq >= xcp_handler.daq_count) || (cmd[BYTE_4] >= xcp_daq[daq].odt_count) ||
+			   (INIT_VAL != xcp_odt[xcp_daq[daq].first_odt + cmd[BYTE_4]].entry_count))
+			{
+				error = ERR_SEQUENCE;
+				break;
+			}
+
+			if(XCP_MAX_ODT_ENTRY < (xcp_handler.entry_count + size))
+			{
+				error = ERR_MEMORY_OVERFLOW;
+				break;
+			}
+
+			xcp_odt[xcp_daq[daq].first_odt + cmd[BYTE_4]].first_entry = xcp_handler.entry_count;
+			xcp_odt[xcp_daq[daq].first_odt + cmd[BYTE_4]].entry_count = size;
+
+			for(counter = INIT_VAL ; counter < size ; counter ++)
+			{
+				xcp_entry[xcp_handler.entry_count + counter].size = INIT_VAL;
+			}
+
+			xcp_handler.entry_count += size;
+		break;
+
+		case CMD_SET_DAQ_PTR:
+			daq = xcp_get_uint16(&cmd[BYTE_2]);
+
+			if((daq >= xcp_handler.daq_count) || (cmd[BYTE_4] >= xcp_daq[daq].odt_count) ||
+			   (cmd[BYTE_5] >= xcp_odt[xcp_daq[daq].first_odt + cmd[BYTE_4]].entry_count))
+			{
+				error = ERR_OUT_OF_RANGE;
+				break;
+			}
+
+			xcp_handler.ptr_odt = xcp_daq[daq].first_odt + cmd[BYTE_4];
+			xcp_handler.ptr_entry = xcp_odt[xcp_handler.ptr_odt].first_entry + cmd[BYTE_5];
+			xcp_handler.ptr_last_entry = xcp_odt[xcp_handler.ptr_odt].first_entry + xcp_odt[xcp_handler.ptr_odt].entry_count;
+		break;
+
+		/** Writes the entry pointed by the DAQ pointer and moves to the next one*/
+		case CMD_WRITE_DAQ:
+			size = cmd[BYTE_2];
+
+			if((xcp_handler.ptr_entry >= xcp_handler.ptr_last_entry) || (XCP_ODT_DATA_SIZE < size))
+			{
+				error = ERR_OUT_OF_RANGE;
+				break;
+			}
+
+			/** The events read the entry, so it must be readable as an upload (Empty entries are skipped)*/
+			if((INIT_VAL != size) && !xcp_readable(xcp_get_uint32(&cmd[BYTE_4]), size))
+			{
+				error = ERR_ACCESS_DENIED;
+				break;
+			}
+
+			xcp_entry[xcp_handler.ptr_entry].address = xcp_get_uint32(&cmd[BYTE_4]);
+			xcp_entry[xcp_handler.ptr_entry].size = size;
+			xcp_handler.ptr_entry ++;
+
+			/** The ODT must fit in a single DAQ frame*/
+			size = INIT_VAL;
+			for(counter = xcp_odt[xcp_handler.ptr_odt].first_entry ; counter < xcp_handler.ptr_last_entry ; counter ++)
+			{
+				size += xcp_entry[counter].size;
+			}
+
+			if(XCP_ODT_DATA_SIZE < size)
+			{
+				xcp_handler.ptr_entry --;
+				xcp_entry[xcp_handler.ptr_entry].size = INIT_VAL;
+				error = ERR_DAQ_CONFIG;
+			}
+		break;
+
+		case CMD_SET_DAQ_LIST_MODE:
+			daq = xcp_get_uint16(&cmd[BYTE_2]);
+
+			if((daq >= xcp_handler.daq_count) || (XCP_MAX_EVENT <= xcp_get_uint16(&cmd[BYTE_4])))
+			{
+				error = ERR_OUT_OF_RANGE;
+				break;
+			}
+
+			xcp_daq[daq].event = xcp_get_uint16(&cmd[BYTE_4]);
+			xcp_daq[daq].prescaler = (INIT_VAL == cmd[BYTE_6]) ? BYTE_1 : cmd[BYTE_6];
+			xcp_daq[daq].prescaler_count = INIT_VAL;
+		break;
+
+		case CMD_START_STOP_DAQ_LIST:
+			daq = xcp_get_uint16(&cmd[BYTE_2]);
+
+			if(daq >= xcp_handler.daq_count)
+			{
+				error = ERR_OUT_OF_RANGE;
+				break;
+			}
+
+			if(DAQ_LIST_SELECT == cmd[BYTE_1])
+			{
+				xcp_daq[daq].selected = FLAG_SET;
+			}
+
+			else
+			{
+				xcp_pack_odts();
+				xcp_daq[daq].running = (DAQ_LIST_START == cmd[BYTE_1]) ? FLAG_SET : FLAG_CLEAR;
+			}
+
+			/** The first PID of the list is its first absolute ODT*/
+			response[BYTE_1] = xcp_daq[daq].first_odt;
+			response_DLC = BYTE_2;
+		break;
+
+		case CMD_START_STOP_SYNCH:
+			xcp_pack_odts();
+
+			for(counter = INIT_VAL ; counter < xcp_handler.daq_count ; counter ++)
+			{
+				if(SYNCH_STOP_ALL == cmd[BYTE_1])
+				{
+					xcp_daq[counter].running = FLAG_CLEAR;
+				}
+
+				else if(FLAG_SET == xcp_daq[counter].selected)
+				{
+					xcp_daq[counter].running = (SYNCH_START_SELECTED == cmd[BYTE_1]) ? FLAG_SET : FLAG_CLEAR;
+					xcp_daq[counter].selected = FLAG_CLEAR;
+				}
+			}
+		break;
+
+		default:
+			error = ERR_CMD_UNKNOWN;
+		break;
+	}
+
+	/** Sets the error frame*/
+	if(PID_RES != error)
+	{
+		response[CMD_POS] = PID_ERR;
+		response[BYTE_1] = error;
+		response_DLC = BYTE_2;
+	}
+
+	xcp_send(response, response_DLC);
+}
+
+/** This function samples the DAQ lists of an event and queues their frames*/
+void XCP_event(uint8_t event)
+{
+	/** Counters for the DAQ lists, ODTs, entries and bytes*/
+	uint8_t daq = INIT_VAL;
+	uint8_t odt = INIT_VAL;
+	uint8_t entry = INIT_VAL;
+	uint8_t counter = INIT_VAL;
+	/** Position in the DAQ frame*/
+	uint8_t position = INIT_VAL;
+	/** Whether any frame was queued*/
+	uint8_t queued = FLAG_CLEAR;
+	/** Pointer to the variable being sampled*/
+	uint8_t* memory;
+	/** Pointer to the entry being sampled*/
+	xcp_odt_entry_t* packed;
+	/** Pointer to the frame being sampled*/
+	xcp_dto_t* dto;
+
+	if(FLAG_CLEAR == xcp_handler.connected)
+	{
+		return;
+	}
+
+	for(daq = INIT_VAL ; daq < xcp_handler.daq_count ; daq ++)
+	{
+		if((FLAG_CLEAR == xcp_daq[daq].running) || (event != xcp_daq[daq].event))
+		{
+			continue;
+		}
+
+		if(xcp_daq[daq].prescaler > ++ xcp_daq[daq].prescaler_count)
+		{
+			continue;
+		}
+
+		xcp_daq[daq].prescaler_count = INIT_VAL;
+
+		/** All the ODTs of the list are sampled together, straight into the queue*/
+		taskENTER_CRITICAL();
+
+		/** The list is dropped as a whole if the sender thread fell behind, the event never waits*/
+		if((XCP_DTO_QUEUE_SIZE - xcp_handler.dto_count) < xcp_daq[daq].odt_count)
+		{
+			xcp_handler.dto_overruns ++;
+			taskEXIT_CRITICAL();
+			continue;
+		}
+
+		for(odt = xcp_daq[daq].first_odt ; odt < (xcp_daq[daq].first_odt + xcp_daq[daq].odt_count) ; odt ++)
+		{
+			dto = &xcp_dto_queue[(xcp_handler.dto_head + xcp_handler.dto_count) % XCP_DTO_QUEUE_SIZE];
+			dto->data[CMD_POS] = odt;
+			dto->DLC = xcp_odt[odt].frame_size;
+			position = BYTE_1;
+
+			for(entry = INIT_VAL ; entry < xcp_odt[odt].packed_count ; entry ++)
+			{
+				packed = &xcp_packed_entry[xcp_odt[odt].first_entry + entry];
+				memory = (uint8_t*)(uintptr_t)packed->address;
+
+				for(counter = INIT_VAL ; counter < packed->size ; counter ++)
+				{
+					dto->data[position ++] = memory[counter];
+				}
+			}
+
+			xcp_handler.dto_count ++;
+		}
+
+		taskEXIT_CRITICAL();
+
+		queued = FLAG_SET;
+	}
+
+	/** The frames are sent by the sender thread*/
+	if(FLAG_SET == queued)
+	{
+		xSemaphoreGive(xcp_handler.sem_send);
+	}
+}
+
+/** This function sends the DAQ frames of the queue*/
+uint8_t XCP_send_daq(void)
+{
+	/** Frame being sent, copied so the events can sample while it is transmitted*/
+	xcp_dto_t dto;
+	/** Frames sent*/
+	uint8_t sent = INIT_VAL;
+
+	for(;;)
+	{
+		taskENTER_CRITICAL();
+
+		if(INIT_VAL == xcp_handler.dto_count)
+		{
+			taskEXIT_CRITICAL();
+			break;
+		}
+
+		dto = xcp_dto_queue[xcp_handler.dto_head];
+		xcp_handler.dto_head = (xcp_handler.dto_head + BYTE_1) % XCP_DTO_QUEUE_SIZE;
+		xcp_handler.dto_count --;
+
+		taskEXIT_CRITICAL();
+
+		xcp_send(dto.data, dto.DLC);
+		sent ++;
+	}
+
+	return sent;
+}
+
+/** This function gets the DAQ lists dropped*/
+uint32_t XCP_get_daq_overruns(void)
+{
+	return xcp_handler.dto_overruns;
+}
+
+/** This function is the sender thread of the DAQ frames*/
+void XCP_thread(void* args)
+{
+	/** Infinite cycle*/
+	for(;;)
+	{
+		/** Waits for the frames of an event*/
+		xSemaphoreTake(xcp_handler.sem_send, portMAX_DELAY);
+
+		XCP_send_daq();
+	}
+}
@@ -0,0 +1,115 @@
+/*!
+ 	 \file xcp.h
+
+ 	 \brief This is the header file of the XCP on CAN slave. It handles the
+ 	 	 	 measurement (dynamic DAQ lists bound to firmware events) and the
+ 	 	 	 calibration (memory upload and download) commands of a host tool.
+
+ 	 \note The commands are received with the ID function vector of the RTOS CAN
+ 	 	 	 driver, so the CRO ID must be a valid ID for rtos_add_ID_function.
+ 	 	 	 The events only sample the DAQ lists, their frames are sent by
+ 	 	 	 XCP_thread, so an event never waits for the bus.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	19/10/2026
+ */
+
+#ifndef XCP_H_
+#define XCP_H_
+
+#if defined(HOST_SIM)
+/** The host simulation has no CAN, only the events are sampled*/
+#include <stdint.h>
+#elif defined(XCP_HOST_BUS)
+/** The stand-in master (Host/xcp_master.c) runs the slave on a simulated bus*/
+#include "can_bus_sim.h"
+#else
+#include "rtos_driver.h"
+#endif
+
+/** Defines the default ID of the command frames (Master to slave)*/
+#define XCP_CRO_ID							(0x7F0)
+/** Defines the default ID of the response and DAQ frames (Slave to master)*/
+#define XCP_DTO_ID							(0x7F1)
+
+/** Defines the maximum number of DAQ lists*/
+#define XCP_MAX_DAQ							(4)
+/** Defines the maximum number of ODTs for all the DAQ lists*/
+#define XCP_MAX_ODT							(16)
+/** Defines the maximum number of ODT entries for all the ODTs*/
+#define XCP_MAX_ODT_ENTRY					(64)
+
+/** Defines the event of the speed thread*/
+#define XCP_EVENT_SPEED_TASK				(0)
+/** Defines the event of the CAN rx thread*/
+#define XCP_EVENT_CAN_RX					(1)
+/** Defines the event of the speed control loop*/
+#define XCP_EVENT_CONTROL_LOOP				(2)
+/** Defines the number of events*/
+#define XCP_MAX_EVENT						(3)
+
+#ifndef HOST_SIM
+/*!
+ 	 \brief This function initializes the XCP slave and adds the CRO ID to the ID function vector.
+
+ 	 \param[in] base CAN used by the slave.
+ 	 \param[in] cro_ID ID of the command frames.
+ 	 \param[in] dto_ID ID of the response and DAQ frames.
+
+ 	 \return This function indicates if the CRO ID was added to the ID function vector.
+ */
+ID_func_vector_state_t XCP_init(CAN_Type* base, uint16_t cro_ID, uint16_t dto_ID);
+
+/*!
+ 	 \brief This function is the callback of the CRO ID. It executes a command
+ 	 	 	 and sends its response.
+
+ 	 \param[in] can_message_rx Command received.
+
+ 	 \return void.
+ */
+void XCP_command_callback(can_message_rx_config_t can_message_rx);
+
+/*!
+ 	 \brief This function sends the DAQ frames queued by the events.
+
+ 	 \return Frames sent.
+ */
+uint8_t XCP_send_daq(void);
+
+/*!
+ 	 \brief This function gets the DAQ lists dropped because the sender thread fell behind.
+
+ 	 \return DAQ lists dropped since XCP_init.
+ */
+uint32_t XCP_get_daq_overruns(void);
+
+/*!
+ 	 \brief This function is the sender thread of the DAQ frames. Create it with the
+ 	 	 	 lowest priority, the frames wait in a queue of 2 * XCP_MAX_ODT.
+
+ 	 \param[in] args Not used.
+
+ 	 \return void.
+ */
+void XCP_thread(void* args);
+#endif
+
+/*!
+ 	 \brief This function samples the DAQ lists bound to an event and queues their frames
+ 	 	 	 for XCP_thread. It never blocks: a list that does not fit in the queue is dropped.
+
+ 	 \note Call it from the context where the event happens (e.g. the speed thread).
+ 	 	 	 All the ODTs of a DAQ list are sampled together, so the values are consistent.
+
+ 	 \param[in] event Event that happened (XCP_EVENT_SPEED_TASK, XCP_EVENT_CAN_RX, ...).
+
+ 	 \return void.
+ */
+void XCP_event(uint8_t event);
+
+#endif /* XCP_H_ */